@@ -13,7 +13,7 @@ namespace sltl
 {
   namespace detail
   {
-    syntax::expression_list get_args()
+    inline syntax::expression_list get_args()
     {
       return {};
     }
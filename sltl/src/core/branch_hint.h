@@ -0,0 +1,16 @@
+#pragma once
+
+
+namespace sltl
+{
+namespace core
+{
+  // Overrides whether a conditional may be flattened into select expressions (see syntax::branch_flattening)
+  enum class branch_hint
+  {
+    none,    // flattened if its branches are small enough
+    flatten, // flattened regardless of the size of its branches
+    branch   // never flattened
+  };
+}
+}
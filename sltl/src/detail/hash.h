@@ -0,0 +1,26 @@
+#pragma once
+
+#include "detect.h"
+
+#include <functional>
+
+#include <cstddef>
+
+
+namespace sltl
+{
+namespace detail
+{
+  // Mixes a hash value into a seed (the same mixing step as boost::hash_combine)
+  inline size_t hash_combine(size_t seed, size_t hash)
+  {
+    return seed ^ (hash + 0x9e3779b9U + (seed << 6) + (seed >> 2));
+  }
+
+  template<typename T>
+  using is_hashable_op = decltype(std::hash<T>()(std::declval<const T&>()));
+
+  template<typename T>
+  using is_hashable = detect<T, is_hashable_op>;
+}
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <new>
+#include <utility>
+#include <type_traits>
+
+#include <cassert>
+
+
+namespace sltl
+{
+namespace detail
+{
+  //TODO: replace with std::optional once available (C++17)
+  template<typename T>
+  class optional
+  {
+  public:
+    optional() : _has_value(false) {}
+
+    optional(const T& value) : _has_value(true)
+    {
+      new(&_storage) T(value);
+    }
+
+    optional(const optional& other) : _has_value(other._has_value)
+    {
+      if(_has_value)
+      {
+        new(&_storage) T(*other);
+      }
+    }
+
+    ~optional()
+    {
+      reset();
+    }
+
+    optional& operator=(const optional& other)
+    {
+      if(other._has_value)
+      {
+        *this = *other;
+      }
+      else
+      {
+        reset();
+      }
+
+      return *this;
+    }
+
+    optional& operator=(const T& value)
+    {
+      if(_has_value)
+      {
+        **this = value;
+      }
+      else
+      {
+        new(&_storage) T(value);
+        _has_value = true;
+      }
+
+      return *this;
+    }
+
+    void reset()
+    {
+      if(_has_value)
+      {
+        (**this).~T();
+        _has_value = false;
+      }
+    }
+
+    explicit operator bool() const
+    {
+      return _has_value;
+    }
+
+    T& operator*()
+    {
+      assert(_has_value);
+      return *reinterpret_cast<T*>(&_storage);
+    }
+
+    const T& operator*() const
+    {
+      assert(_has_value);
+      return *reinterpret_cast<const T*>(&_storage);
+    }
+
+  private:
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type _storage;
+    bool _has_value;
+  };
+}
+}
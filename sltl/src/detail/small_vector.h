@@ -0,0 +1,224 @@
+#pragma once
+
+#include <new>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include <cstddef>
+#include <cassert>
+
+
+namespace sltl
+{
+namespace detail
+{
+  // A vector that stores up to N elements inline, only allocating from the free store for longer sequences
+  template<typename T, size_t N>
+  class small_vector
+  {
+    static_assert(N > 0U, "sltl::detail::small_vector: template parameter N must be greater than zero");
+
+  public:
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    small_vector() : _data(get_inline()), _size(0U), _capacity(N) {}
+
+    small_vector(small_vector&& other) : small_vector()
+    {
+      take(std::move(other));
+    }
+
+    ~small_vector()
+    {
+      release();
+    }
+
+    small_vector& operator=(small_vector&& other)
+    {
+      if(this != &other)
+      {
+        release();
+
+        _data = get_inline();
+        _size = 0U;
+        _capacity = N;
+
+        take(std::move(other));
+      }
+
+      return *this;
+    }
+
+    // Non-copyable
+    small_vector(const small_vector&) = delete;
+    small_vector& operator=(const small_vector&) = delete;
+
+    void push_back(T&& t)
+    {
+      reserve(_size + 1U);
+
+      new(_data + _size) T(std::move(t));
+      ++_size;
+    }
+
+    void push_front(T&& t)
+    {
+      reserve(_size + 1U);
+
+      if(_size > 0U)
+      {
+        // Shift the existing elements up by one position
+        new(_data + _size) T(std::move(_data[_size - 1U]));
+        std::move_backward(_data, _data + _size - 1U, _data + _size);
+
+        _data[0] = std::move(t);
+      }
+      else
+      {
+        new(_data) T(std::move(t));
+      }
+
+      ++_size;
+    }
+
+    void reserve(size_t capacity)
+    {
+      if(capacity > _capacity)
+      {
+        const size_t capacity_new = std::max(capacity, _capacity * 2U);
+
+        std::allocator<T> allocator;
+        T* const data = allocator.allocate(capacity_new);
+
+        for(size_t i = 0U; i < _size; ++i)
+        {
+          new(data + i) T(std::move(_data[i]));
+          _data[i].~T();
+        }
+
+        if(!is_inline())
+        {
+          allocator.deallocate(_data, _capacity);
+        }
+
+        _data = data;
+        _capacity = capacity_new;
+      }
+    }
+
+    iterator begin()
+    {
+      return _data;
+    }
+
+    iterator end()
+    {
+      return _data + _size;
+    }
+
+    const_iterator begin() const
+    {
+      return _data;
+    }
+
+    const_iterator end() const
+    {
+      return _data + _size;
+    }
+
+    T& operator[](size_t idx)
+    {
+      assert(idx < _size);
+      return _data[idx];
+    }
+
+    const T& operator[](size_t idx) const
+    {
+      assert(idx < _size);
+      return _data[idx];
+    }
+
+    size_t size() const
+    {
+      return _size;
+    }
+
+    size_t capacity() const
+    {
+      return _capacity;
+    }
+
+    bool empty() const
+    {
+      return (_size == 0U);
+    }
+
+    bool is_inline() const
+    {
+      return (_data == get_inline());
+    }
+
+  private:
+    T* get_inline()
+    {
+      return reinterpret_cast<T*>(&_storage);
+    }
+
+    const T* get_inline() const
+    {
+      return reinterpret_cast<const T*>(&_storage);
+    }
+
+    // Destroys all elements and frees any memory taken from the free store
+    void release()
+    {
+      for(size_t i = 0U; i < _size; ++i)
+      {
+        _data[i].~T();
+      }
+
+      if(!is_inline())
+      {
+        std::allocator<T>().deallocate(_data, _capacity);
+      }
+    }
+
+    // Moves the elements of 'other', which is left empty, into this (currently empty) vector
+    void take(small_vector&& other)
+    {
+      assert(_size == 0U);
+      assert(is_inline());
+
+      if(other.is_inline())
+      {
+        for(size_t i = 0U; i < other._size; ++i)
+        {
+          new(_data + i) T(std::move(other._data[i]));
+          other._data[i].~T();
+        }
+      }
+      else
+      {
+        // The free store memory is simply transferred
+        _data = other._data;
+        _capacity = other._capacity;
+
+        other._data = other.get_inline();
+        other._capacity = N;
+      }
+
+      _size = other._size;
+      other._size = 0U;
+    }
+
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type _storage;
+
+    T* _data;
+    size_t _size;
+    size_t _capacity;
+  };
+}
+}
@@ -26,10 +26,32 @@ namespace detail
     static const bool value = (is_integer<T>::value || is_real<T>::value || std::is_same<bool, T>::value);
   };
 
+  // Returns a value that uniquely identifies the type T, without requiring RTTI. Unlike
+  // std::type_info, two values can be compared (and hashed) as cheaply as any pointer.
+  template<typename T>
+  const void* type_id()
+  {
+    static const char id = 0;
+    return &id;
+  }
+
+  // Types that identify themselves with a static is_kind function (e.g. syntax::node) are checked without RTTI
   template<typename T1, typename T2>
-  bool is_type(T2* const t)
+  auto is_type_impl(T2* const t, int) -> decltype(T1::is_kind(t->get_kind()))
+  {
+    return (t && T1::is_kind(t->get_kind()));
+  }
+
+  template<typename T1, typename T2>
+  bool is_type_impl(T2* const t, long)
   {
     return (dynamic_cast<T1*>(const_cast<typename std::remove_const<T2>::type*>(t)) != nullptr);
   }
+
+  template<typename T1, typename T2>
+  bool is_type(T2* const t)
+  {
+    return is_type_impl<T1>(t, 0);
+  }
 }
 }
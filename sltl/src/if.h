@@ -8,13 +8,18 @@
 
 namespace sltl
 {
+  class else_statement;
+
+  template<typename Fn>
+  else_statement if_then(scalar<bool>::proxy&& condition, Fn fn, core::branch_hint hint = core::branch_hint::none);
+
   class else_statement
   {
   public:
     template<typename Fn>
-    void else_end(Fn fn)
+    void else_end(Fn fn, core::branch_hint hint = core::branch_hint::none)
     {
-      auto& selection = _c.add_else<syntax::conditional>(language::id_else);
+      auto& selection = _c.add_else<syntax::conditional>(language::id_else, hint);
 
       {
         scope s(selection);
@@ -23,9 +28,9 @@ namespace sltl
     }
 
     template<typename Fn>
-    else_statement else_if(scalar<bool>::proxy&& condition, Fn fn)
+    else_statement else_if(scalar<bool>::proxy&& condition, Fn fn, core::branch_hint hint = core::branch_hint::none)
     {
-      auto& selection = _c.add_else<syntax::conditional>(language::id_else_if, condition.move());
+      auto& selection = _c.add_else<syntax::conditional>(language::id_else_if, condition.move(), hint);
 
       {
         scope s(selection);
@@ -41,15 +46,15 @@ namespace sltl
     else_statement(syntax::conditional& c) : _c(c) {}
 
     template<typename Fn>
-    friend else_statement if_then(scalar<bool>::proxy&&, Fn);
+    friend else_statement if_then(scalar<bool>::proxy&&, Fn, core::branch_hint);
 
     syntax::conditional& _c;
   };
 
   template<typename Fn>
-  else_statement if_then(scalar<bool>::proxy&& condition, Fn fn)
+  else_statement if_then(scalar<bool>::proxy&& condition, Fn fn, core::branch_hint hint)
   {
-    auto& selection = syntax::get_current_block().add<syntax::conditional>(language::id_if, condition.move());
+    auto& selection = syntax::get_current_block().add<syntax::conditional>(language::id_if, condition.move(), hint);
 
     {
       scope s(selection);
@@ -0,0 +1,1473 @@
+#include "batch.h"
+
+#include <syntax/io_block.h>
+#include <syntax/operator.h>
+#include <syntax/reference.h>
+#include <syntax/temporary.h>
+#include <syntax/conditional.h>
+#include <syntax/function_call.h>
+#include <syntax/intrinsic_call.h>
+#include <syntax/constructor_call.h>
+#include <syntax/return_statement.h>
+#include <syntax/function_definition.h>
+#include <syntax/variable_declaration.h>
+#include <syntax/expression_statement.h>
+#include <syntax/operator_component_access.h>
+
+#include <cmath>
+#include <tuple>
+#include <limits>
+#include <cassert>
+#include <algorithm>
+#include <type_traits>
+
+// The kernels are compiled for each x86 target where the compiler supports target attributes, otherwise only the generic kernel is
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SLTL_BATCH_TARGET(t) __attribute__((target(t), flatten))
+#endif
+
+
+namespace
+{
+  using namespace sltl;
+  using namespace sltl::interpreter;
+
+  // The lanes of a row are stored as the component type of the row
+  template<typename T, size_t W>
+  using lanes = std::array<T, W>;
+
+  template<size_t W>
+  struct mask
+  {
+    mask(bool is_call) : _is_call(is_call)
+    {
+      _lanes.fill(false);
+      _condition.fill(false);
+    }
+
+    lanes<bool, W> _lanes;
+    lanes<bool, W> _condition;
+
+    bool _is_call;
+  };
+
+  // The rows of each component type are stored together, a row is found by its slot (i.e. its index among the rows of its type)
+  template<size_t W>
+  class lane_rows
+  {
+  public:
+    lane_rows(const std::vector<language::type_id>& types) : _types(types), _slots(types.size())
+    {
+      for(size_t r = 0U; r < types.size(); ++r)
+      {
+        dispatch(types[r], [this, r](auto t)
+        {
+          std::vector<lanes<decltype(t), W>>& rows = get_rows<decltype(t)>();
+
+          _slots[r] = rows.size();
+          rows.emplace_back();
+        });
+      }
+    }
+
+    template<typename T>
+    T* get(batch_row_t r)
+    {
+      assert(_types[r] == language::type_id_helper<T>::value);
+      return get_rows<T>()[_slots[r]].data();
+    }
+
+  private:
+    template<typename T>
+    std::vector<lanes<T, W>>& get_rows()
+    {
+      return std::get<std::vector<lanes<T, W>>>(_rows);
+    }
+
+    const std::vector<language::type_id>& _types;
+
+    std::vector<size_t> _slots;
+    std::tuple<std::vector<lanes<float, W>>, std::vector<lanes<double, W>>, std::vector<lanes<int, W>>, std::vector<lanes<unsigned int, W>>, std::vector<lanes<bool, W>>> _rows;
+  };
+
+  // Converts a component to T, with the result of converting the component as a double (as the evaluator does)
+  template<typename T, typename S>
+  T convert_lane(S s)
+  {
+    return (std::is_same<T, S>::value ? static_cast<T>(s) : static_cast<T>(convert<T>(static_cast<double>(s))));
+  }
+
+  // Every lane is calculated before any are written (as the destination row may also be a source row), which lets the lanes be
+  // calculated together rather than one at a time
+  template<size_t W, typename T, typename Fn>
+  void for_lanes(T* d, Fn fn)
+  {
+    lanes<T, W> result;
+
+    for(size_t l = 0U; l < W; ++l)
+    {
+      result[l] = fn(l);
+    }
+
+    std::copy(result.begin(), result.end(), d);
+  }
+
+  bool is_comparison(operation op)
+  {
+    return (op >= operation::eq);
+  }
+
+  // Integer arithmetic is performed as unsigned, so that the result wraps (rather than overflows) on conversion
+  template<size_t W, typename T>
+  void calculate_lanes(operation op, T* d, const T* lhs, const T* rhs)
+  {
+    typedef typename std::conditional<std::is_floating_point<T>::value, T, unsigned int>::type calculate_t;
+
+    auto fn_lanes = [d, lhs, rhs](auto fn)
+    {
+      for_lanes<W>(d, [=](size_t l) { return static_cast<T>(fn(static_cast<calculate_t>(lhs[l]), static_cast<calculate_t>(rhs[l]))); });
+    };
+
+    switch(op)
+    {
+      case operation::add:
+        fn_lanes([](calculate_t x, calculate_t y) { return x + y; });
+        break;
+      case operation::sub:
+        fn_lanes([](calculate_t x, calculate_t y) { return x - y; });
+        break;
+      case operation::mul:
+        fn_lanes([](calculate_t x, calculate_t y) { return x * y; });
+        break;
+      case operation::div:
+      {
+        // Integer division is performed with a wider type, as the quotient of the lowest int and -1 overflows
+        typedef typename std::conditional<std::is_floating_point<T>::value, T, long long>::type divide_t;
+
+        for_lanes<W>(d, [=](size_t l)
+        {
+          return ((std::is_floating_point<T>::value || (rhs[l] != 0)) ? static_cast<T>(static_cast<divide_t>(lhs[l]) / static_cast<divide_t>(rhs[l])) : static_cast<T>(0));
+        });
+        break;
+      }
+      default:
+        throw std::exception();//TODO: exception type and message
+    }
+  }
+
+  template<size_t W, typename T>
+  void compare_lanes(operation op, bool* d, const T* lhs, const T* rhs)
+  {
+    auto fn_lanes = [d, lhs, rhs](auto fn)
+    {
+      for_lanes<W>(d, [=](size_t l) { return fn(lhs[l], rhs[l]); });
+    };
+
+    switch(op)
+    {
+      case operation::eq:
+        fn_lanes([](T x, T y) { return (x == y); });
+        break;
+      case operation::ne:
+        fn_lanes([](T x, T y) { return (x != y); });
+        break;
+      case operation::lt:
+        fn_lanes([](T x, T y) { return (x < y); });
+        break;
+      case operation::lt_eq:
+        fn_lanes([](T x, T y) { return (x <= y); });
+        break;
+      case operation::gt:
+        fn_lanes([](T x, T y) { return (x > y); });
+        break;
+      case operation::gt_eq:
+        fn_lanes([](T x, T y) { return (x >= y); });
+        break;
+      default:
+        throw std::exception();//TODO: exception type and message
+    }
+  }
+
+  // A source with a single component (i.e. a scalar) is expanded by repeating its row
+  batch_rows expand(const batch_rows& rows, size_t count_rows, size_t count)
+  {
+    if((count_rows != count) && (count_rows != 1U))
+    {
+      throw std::exception();//TODO: exception type and message
+    }
+
+    batch_rows rows_expanded = rows;
+
+    if(count_rows == 1U)
+    {
+      std::fill(rows_expanded.begin(), rows_expanded.end(), rows[0]);
+    }
+
+    return rows_expanded;
+  }
+
+  template<size_t W>
+  bool is_active(const lanes<bool, W>& m)
+  {
+    bool active = false;
+
+    for(size_t l = 0U; l < W; ++l)
+    {
+      active |= m[l];
+    }
+
+    return active;
+  }
+
+  // The lanes where the condition (a row of type 'id') isn't zero
+  template<size_t W>
+  lanes<bool, W> get_condition(language::type_id id, batch_row_t r, lane_rows<W>& rows)
+  {
+    lanes<bool, W> condition;
+
+    dispatch(id, [&](auto t)
+    {
+      const decltype(t)* c = rows.template get<decltype(t)>(r);
+
+      for(size_t l = 0U; l < W; ++l)
+      {
+        condition[l] = (c[l] != 0);
+      }
+    });
+
+    return condition;
+  }
+
+  template<size_t W>
+  void execute(const std::vector<batch_instruction>& instructions, lane_rows<W>& rows, std::vector<mask<W>>& masks)
+  {
+    for(size_t pc = 0U; pc < instructions.size();)
+    {
+      const batch_instruction& ins = instructions[pc++];
+
+      switch(ins._opcode)
+      {
+        case batch_instruction::opcode::literal:
+          dispatch(ins._id, [&](auto t)
+          {
+            const decltype(t) value = convert_lane<decltype(t)>(ins._value);
+
+            for(size_t i = 0U; i < ins._count; ++i)
+            {
+              decltype(t)* d = rows.template get<decltype(t)>(ins._dst[i]);
+
+              for(size_t l = 0U; l < W; ++l)
+              {
+                d[l] = value;
+              }
+            }
+          });
+          break;
+        case batch_instruction::opcode::convert:
+        case batch_instruction::opcode::store:
+          dispatch(ins._id, [&](auto t)
+          {
+            dispatch(ins._id_src, [&](auto s)
+            {
+              // The source is copied first, as the destination rows may also be source rows (e.g. 'v.xy = v.yx')
+              std::array<lanes<decltype(s), W>, std::tuple_size<batch_rows>::value> src;
+
+              for(size_t i = 0U; i < ins._count; ++i)
+              {
+                const decltype(s)* x = rows.template get<decltype(s)>(ins._src[0][i]);
+
+                for(size_t l = 0U; l < W; ++l)
+                {
+                  src[i][l] = x[l];
+                }
+              }
+
+              const lanes<bool, W>& m = masks.back()._lanes;
+              const bool is_store = (ins._opcode == batch_instruction::opcode::store);
+
+              for(size_t i = 0U; i < ins._count; ++i)
+              {
+                decltype(t)* d = rows.template get<decltype(t)>(ins._dst[i]);
+
+                for_lanes<W>(d, [&](size_t l) { return ((!is_store || m[l]) ? convert_lane<decltype(t)>(src[i][l]) : d[l]); });
+              }
+            });
+          });
+          break;
+        case batch_instruction::opcode::calculate:
+          dispatch(ins._id_src, [&](auto t)
+          {
+            for(size_t i = 0U; i < ins._count; ++i)
+            {
+              const decltype(t)* lhs = rows.template get<decltype(t)>(ins._src[0][i]);
+              const decltype(t)* rhs = rows.template get<decltype(t)>(ins._src[1][i]);
+
+              if(is_comparison(ins._operation))
+              {
+                compare_lanes<W>(ins._operation, rows.template get<bool>(ins._dst[i]), lhs, rhs);
+              }
+              else
+              {
+                calculate_lanes<W>(ins._operation, rows.template get<decltype(t)>(ins._dst[i]), lhs, rhs);
+              }
+            }
+          });
+          break;
+        case batch_instruction::opcode::multiply:
+          dispatch(ins._id, [&](auto t)
+          {
+            lanes<decltype(t), W> product;
+
+            for(size_t i = 0U; i < ins._m; ++i)
+            {
+              for(size_t j = 0U; j < ins._n; ++j)
+              {
+                decltype(t)* d = rows.template get<decltype(t)>(ins._dst[(i * ins._n) + j]);
+                std::fill_n(d, W, static_cast<decltype(t)>(0));
+
+                for(size_t k = 0U; k < ins._k; ++k)
+                {
+                  calculate_lanes<W>(operation::mul, product.data(), rows.template get<decltype(t)>(ins._src[0][(i * ins._k) + k]), rows.template get<decltype(t)>(ins._src[1][(k * ins._n) + j]));
+                  calculate_lanes<W>(operation::add, d, d, product.data());
+                }
+              }
+            }
+          });
+          break;
+        case batch_instruction::opcode::select:
+        {
+          const lanes<bool, W> c = get_condition(ins._id_src, ins._src[0][0], rows);
+
+          dispatch(ins._id, [&](auto t)
+          {
+            for(size_t i = 0U; i < ins._count; ++i)
+            {
+              const decltype(t)* a = rows.template get<decltype(t)>(ins._src[1][i]);
+              const decltype(t)* b = rows.template get<decltype(t)>(ins._src[2][i]);
+
+              for_lanes<W>(rows.template get<decltype(t)>(ins._dst[i]), [&](size_t l) { return (c[l] ? a[l] : b[l]); });
+            }
+          });
+          break;
+        }
+        case batch_instruction::opcode::intrinsic:
+          dispatch(ins._id, [&](auto t)
+          {
+            typedef decltype(t) T;
+
+            lanes<T, W> scratch;
+            lanes<T, W> scratch_sum;
+
+            switch(ins._intrinsic)
+            {
+              case core::intrinsic::dot:
+              case core::intrinsic::normalize:
+              {
+                T* d = ((ins._intrinsic == core::intrinsic::dot) ? rows.template get<T>(ins._dst[0]) : scratch.data());
+                std::fill_n(d, W, static_cast<T>(0));
+
+                for(size_t i = 0U; i < ins._count_src; ++i)
+                {
+                  calculate_lanes<W>(operation::mul, scratch_sum.data(), rows.template get<T>(ins._src[0][i]), rows.template get<T>(ins._src[(ins._intrinsic == core::intrinsic::dot) ? 1U : 0U][i]));
+                  calculate_lanes<W>(operation::add, d, d, scratch_sum.data());
+                }
+
+                if(ins._intrinsic == core::intrinsic::normalize)
+                {
+                  for(size_t l = 0U; l < W; ++l)
+                  {
+                    d[l] = convert_lane<T>(std::sqrt(static_cast<double>(d[l])));
+                  }
+
+                  for(size_t i = 0U; i < ins._count; ++i)
+                  {
+                    calculate_lanes<W>(operation::div, rows.template get<T>(ins._dst[i]), rows.template get<T>(ins._src[0][i]), d);
+                  }
+                }
+                break;
+              }
+              case core::intrinsic::clamp:
+                for(size_t i = 0U; i < ins._count; ++i)
+                {
+                  const T* x = rows.template get<T>(ins._src[0][i]);
+                  const T* x_min = rows.template get<T>(ins._src[1][i]);
+                  const T* x_max = rows.template get<T>(ins._src[2][i]);
+
+                  for_lanes<W>(rows.template get<T>(ins._dst[i]), [&](size_t l) { return std::min(std::max(x[l], x_min[l]), x_max[l]); });
+                }
+                break;
+              case core::intrinsic::lerp:
+                for(size_t i = 0U; i < ins._count; ++i)
+                {
+                  T* d = rows.template get<T>(ins._dst[i]);
+
+                  calculate_lanes<W>(operation::sub, scratch_sum.data(), rows.template get<T>(ins._src[1][i]), rows.template get<T>(ins._src[0][i]));
+                  calculate_lanes<W>(operation::mul, scratch_sum.data(), scratch_sum.data(), rows.template get<T>(ins._src[2][i]));
+                  calculate_lanes<W>(operation::add, d, rows.template get<T>(ins._src[0][i]), scratch_sum.data());
+                }
+                break;
+              case core::intrinsic::pow:
+                for(size_t i = 0U; i < ins._count; ++i)
+                {
+                  const T* x = rows.template get<T>(ins._src[0][i]);
+                  const T* y = rows.template get<T>(ins._src[1][i]);
+
+                  for_lanes<W>(rows.template get<T>(ins._dst[i]), [&](size_t l) { return convert_lane<T>(std::pow(static_cast<double>(x[l]), static_cast<double>(y[l]))); });
+                }
+                break;
+              default:
+                throw std::exception();//TODO: exception type and message
+            }
+          });
+          break;
+        case batch_instruction::opcode::mask_push:
+        {
+          const lanes<bool, W> c = get_condition(ins._id_src, ins._src[0][0], rows);
+
+          masks.emplace_back(false);
+          mask<W>& m = masks.back();
+          const mask<W>& m_parent = masks[masks.size() - 2U];
+
+          for(size_t l = 0U; l < W; ++l)
+          {
+            m._condition[l] = c[l];
+            m._lanes[l] = (m_parent._lanes[l] && c[l]);
+          }
+
+          if(!is_active(m._lanes))
+          {
+            pc = ins._target;
+          }
+          break;
+        }
+        case batch_instruction::opcode::mask_else:
+        {
+          mask<W>& m = masks.back();
+          const mask<W>& m_parent = masks[masks.size() - 2U];
+
+          for(size_t l = 0U; l < W; ++l)
+          {
+            m._lanes[l] = (m_parent._lanes[l] && !m._condition[l]);
+          }
+
+          if(!is_active(m._lanes))
+          {
+            pc = ins._target;
+          }
+          break;
+        }
+        case batch_instruction::opcode::mask_pop:
+        case batch_instruction::opcode::call_end:
+          masks.pop_back();
+          break;
+        case batch_instruction::opcode::call_begin:
+          masks.emplace_back(true);
+          masks.back()._lanes = masks[masks.size() - 2U]._lanes;
+          break;
+        case batch_instruction::opcode::ret:
+        {
+          // The returning lanes are deactivated in every mask up to (and including) the mask of the call
+          const lanes<bool, W> returning = masks.back()._lanes;
+
+          for(auto it = masks.rbegin(); it != masks.rend(); ++it)
+          {
+            for(size_t l = 0U; l < W; ++l)
+            {
+              it->_lanes[l] = (it->_lanes[l] && !returning[l]);
+            }
+
+            if(it->_is_call)
+            {
+              break;
+            }
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  template<size_t W>
+  using execute_fn = void (*)(const std::vector<batch_instruction>& instructions, lane_rows<W>& rows, std::vector<mask<W>>& masks);
+
+  // The kernel of each target compiles every call of execute inline (by flatten) so that all of it is compiled for the target
+  enum class kernel_target
+  {
+    generic,
+    avx2,
+    avx512
+  };
+
+  template<size_t W>
+  void execute_generic(const std::vector<batch_instruction>& instructions, lane_rows<W>& rows, std::vector<mask<W>>& masks)
+  {
+    execute<W>(instructions, rows, masks);
+  }
+
+#ifdef SLTL_BATCH_TARGET
+  template<size_t W>
+  SLTL_BATCH_TARGET("avx2") void execute_avx2(const std::vector<batch_instruction>& instructions, lane_rows<W>& rows, std::vector<mask<W>>& masks)
+  {
+    execute<W>(instructions, rows, masks);
+  }
+
+  template<size_t W>
+  SLTL_BATCH_TARGET("avx512f") void execute_avx512(const std::vector<batch_instruction>& instructions, lane_rows<W>& rows, std::vector<mask<W>>& masks)
+  {
+    execute<W>(instructions, rows, masks);
+  }
+#endif
+
+  kernel_target get_kernel_target()
+  {
+#ifdef SLTL_BATCH_TARGET
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("avx512f"))
+    {
+      return kernel_target::avx512;
+    }
+    else if(__builtin_cpu_supports("avx2"))
+    {
+      return kernel_target::avx2;
+    }
+#endif
+
+    return kernel_target::generic;
+  }
+
+  // The CPU features are only checked once
+  kernel_target get_kernel_target_cached()
+  {
+    static const kernel_target target = get_kernel_target();
+    return target;
+  }
+
+  template<size_t W>
+  execute_fn<W> get_kernel()
+  {
+    switch(get_kernel_target_cached())
+    {
+#ifdef SLTL_BATCH_TARGET
+      case kernel_target::avx512:
+        return &execute_avx512<W>;
+      case kernel_target::avx2:
+        return &execute_avx2<W>;
+#endif
+      default:
+        return &execute_generic<W>;
+    }
+  }
+
+  template<size_t W>
+  void read(const batch_variable& v, const void* data, lane_rows<W>& rows, size_t lane)
+  {
+    dispatch(v._type.get_id(), [&](auto t)
+    {
+      const decltype(t)* components = static_cast<const decltype(t)*>(data);
+
+      for(size_t i = 0U, count = get_component_count(v._type); i < count; ++i)
+      {
+        rows.template get<decltype(t)>(v._rows[i])[lane] = components[i];
+      }
+    });
+  }
+
+  template<size_t W>
+  void write(const batch_variable& v, void* data, lane_rows<W>& rows, size_t lane)
+  {
+    dispatch(v._type.get_id(), [&](auto t)
+    {
+      decltype(t)* components = static_cast<decltype(t)*>(data);
+
+      for(size_t i = 0U, count = get_component_count(v._type); i < count; ++i)
+      {
+        components[i] = rows.template get<decltype(t)>(v._rows[i])[lane];
+      }
+    });
+  }
+
+  typedef std::vector<std::pair<const batch_variable*, const binding*>> variables_in;
+  typedef std::vector<std::pair<const batch_variable*, const output_binding*>> variables_out;
+
+  template<size_t W>
+  void run_batches(const batch_program& program, const variables_in& uniforms, const variables_in& inputs, const variables_out& outputs, size_t count)
+  {
+    lane_rows<W> rows(program._row_types);
+
+    // Uniforms are the same for every invocation so are only read once
+    for(const auto& v : uniforms)
+    {
+      for(size_t l = 0U; l < W; ++l)
+      {
+        read(*(v.first), v.second->_data, rows, l);
+      }
+    }
+
+    const execute_fn<W> fn_execute = get_kernel<W>();
+
+    std::vector<mask<W>> masks;
+
+    for(size_t first = 0U; first < count; first += W)
+    {
+      const size_t lane_count = std::min(W, count - first);
+
+      for(const auto& v : inputs)
+      {
+        for(size_t l = 0U; l < lane_count; ++l)
+        {
+          read(*(v.first), static_cast<const char*>(v.second->_data) + ((first + l) * v.second->_stride), rows, l);
+        }
+      }
+
+      // The lanes beyond the last invocation are never active
+      masks.assign(1U, mask<W>(true));
+
+      for(size_t l = 0U; l < lane_count; ++l)
+      {
+        masks.back()._lanes[l] = true;
+      }
+
+      fn_execute(program._instructions, rows, masks);
+
+      for(const auto& v : outputs)
+      {
+        for(size_t l = 0U; l < lane_count; ++l)
+        {
+          write(*(v.first), static_cast<char*>(v.second->_data) + ((first + l) * v.second->_stride), rows, l);
+        }
+      }
+    }
+  }
+
+  namespace ns = sltl::interpreter;
+}
+
+ns::batch_instruction::batch_instruction(opcode op, language::type_id id, size_t count) :
+  _opcode(op),
+  _id(id),
+  _id_src(id),
+  _count(count),
+  _count_src(count),
+  _value(0.0),
+  _operation(operation::none),
+  _intrinsic(core::intrinsic::dot),
+  _m(0U),
+  _k(0U),
+  _n(0U),
+  _target(0U)
+{
+  _dst.fill(0U);
+  _src[0].fill(0U);
+  _src[1].fill(0U);
+  _src[2].fill(0U);
+}
+
+ns::output_binding::output_binding(core::semantic_pair semantic, void* data, size_t stride) : _semantic(semantic._semantic), _semantic_index(semantic._index), _data(data), _stride(stride)
+{
+  if(!_data)
+  {
+    throw std::exception();//TODO: exception type and message
+  }
+}
+
+ns::batch_variable::batch_variable(core::qualifier_storage qualifier, core::semantic_pair semantic, const language::type& type, const batch_rows& rows) : _qualifier(qualifier), _semantic(semantic._semantic), _semantic_index(semantic._index), _type(type), _rows(rows)
+{
+}
+
+ns::batch_program::batch_program()
+{
+}
+
+void ns::batch_program::run(const std::vector<binding>& bindings, const std::vector<output_binding>& outputs, size_t count, batch_width width) const
+{
+  ::variables_in uniforms;
+  ::variables_in inputs;
+  ::variables_out outputs_bound;
+
+  for(const batch_variable& v : _variables)
+  {
+    if(v._qualifier == core::qualifier_storage::out)
+    {
+      auto it = std::find_if(outputs.begin(), outputs.end(), [&v](const output_binding& ob)
+      {
+        return (ob._semantic == v._semantic) && (ob._semantic_index == v._semantic_index);
+      });
+
+      // Outputs without a binding are discarded
+      if(it != outputs.end())
+      {
+        outputs_bound.emplace_back(&v, &(*it));
+      }
+
+      continue;
+    }
+
+    auto it = std::find_if(bindings.begin(), bindings.end(), [&v](const binding& b)
+    {
+      return (b._qualifier == v._qualifier) && (b._semantic == v._semantic) && (b._semantic_index == v._semantic_index);
+    });
+
+    if(it == bindings.end())
+    {
+      throw std::exception();//TODO: exception type and message
+    }
+
+    if(v._qualifier == core::qualifier_storage::uniform)
+    {
+      uniforms.emplace_back(&v, &(*it));
+    }
+    else
+    {
+      inputs.emplace_back(&v, &(*it));
+    }
+  }
+
+  if(get_batch_size(width) == 16U)
+  {
+    run_batches<16U>(*this, uniforms, inputs, outputs_bound, count);
+  }
+  else
+  {
+    run_batches<8U>(*this, uniforms, inputs, outputs_bound, count);
+  }
+}
+
+size_t ns::get_batch_size(batch_width width)
+{
+  switch(width)
+  {
+    case batch_width::lanes_8:
+      return 8U;
+    case batch_width::lanes_16:
+      return 16U;
+    default:
+      return ((get_kernel_target_cached() == kernel_target::avx512) ? 16U : 8U);
+  }
+}
+
+ns::batch_compiler::operand::operand(const language::type& type) : _type(type), _is_lvalue(false)
+{
+  _rows.fill(0U);
+}
+
+ns::batch_compiler::batch_compiler(core::shader_stage)
+{
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(const syntax::io_block& iob, bool is_start)
+{
+  if(is_start)
+  {
+    for(const syntax::statement::ptr& s : iob)
+    {
+      const syntax::variable_declaration& vd = static_cast<const syntax::variable_declaration&>(*s);
+
+      operand o = allocate(vd.get_type());
+      o._is_lvalue = true;
+
+      _program._variables.emplace_back(iob._qualifier, core::semantic_pair(vd._semantic, vd._semantic_index), vd.get_type(), o._rows);
+
+      // Outputs are zero initialized (as they are by the evaluator) at the start of every batch, otherwise an output that isn't
+      // written by every invocation would keep the value of the previous batch
+      if(iob._qualifier == core::qualifier_storage::out)
+      {
+        batch_instruction instruction(batch_instruction::opcode::literal, o._type.get_id(), get_component_count(o._type));
+        instruction._dst = o._rows;
+
+        emit(std::move(instruction));
+      }
+
+      declare(vd, o);
+    }
+  }
+
+  return is_start ? syntax::action_return_t::step_over :
+                    syntax::action_return_t::step_out;
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(const syntax::variable_declaration& vd, bool is_start)
+{
+  if(!is_start)
+  {
+    operand v(vd.get_type());
+
+    if(vd.has_initializer())
+    {
+      operand init = pop();
+
+      batch_rows rows_sorted = init._rows;
+      std::sort(rows_sorted.begin(), rows_sorted.begin() + get_component_count(init._type));
+
+      // An intermediate value (whose rows are all distinct) becomes the variable rather than being copied to it
+      if(!init._is_lvalue && (init._type == vd.get_type()) && (std::adjacent_find(rows_sorted.begin(), rows_sorted.begin() + get_component_count(init._type)) == (rows_sorted.begin() + get_component_count(init._type))))
+      {
+        v._rows = init._rows;
+      }
+      else
+      {
+        v = allocate(vd.get_type());
+        convert(v, init);
+      }
+    }
+    else
+    {
+      // Variables without an initializer are zero initialized
+      v = literal(vd.get_type(), 0.0);
+    }
+
+    v._is_lvalue = true;
+    declare(vd, v);
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(const syntax::reference& r)
+{
+  auto it = _variables.find(&(r._declaration));
+
+  if(it == _variables.end())
+  {
+    throw std::exception();//TODO: exception type and message
+  }
+
+  push(operand(it->second));
+
+  return get_default(false);
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(const syntax::temporary& t, bool is_start)
+{
+  if(!is_start)
+  {
+    if(t.has_initializer())
+    {
+      operand init = pop();
+
+      // A temporary is a copy of its initializer, which only needs to be made when the initializer is a variable
+      if(init._is_lvalue)
+      {
+        operand o = allocate(t.get_type());
+        convert(o, init);
+
+        push(std::move(o));
+      }
+      else
+      {
+        push(std::move(init));
+      }
+    }
+    else
+    {
+      push(literal(t.get_type(), 0.0));
+    }
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(const syntax::operator_unary& ou, bool is_start)
+{
+  if(!is_start)
+  {
+    const operand o = pop();
+    const operation op = (((ou._operator_id == language::id_increment_pre) || (ou._operator_id == language::id_increment_post)) ? operation::add : operation::sub);
+
+    if(!o._is_lvalue)
+    {
+      throw std::exception();//TODO: exception type and message
+    }
+
+    // The postfix operators result in the value of the variable before it was modified
+    operand o_before = o;
+
+    if(!language::is_prefix_operator(ou._operator_id))
+    {
+      o_before = allocate(o._type);
+      convert(o_before, o);
+    }
+
+    const operand o_after = calculate(op, o, literal(language::type(o._type.get_id(), 1U, 1U), 1.0), o._type);
+    convert(o, o_after, batch_instruction::opcode::store);
+
+    push(language::is_prefix_operator(ou._operator_id) ? operand(o_after) : operand(o_before));
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(const syntax::operator_binary& ob, bool is_start)
+{
+  if(!is_start)
+  {
+    const operand rhs = pop();
+    const operand lhs = pop();
+
+    if(language::is_operator_assignment(ob._operator_id))
+    {
+      if(!lhs._is_lvalue)
+      {
+        throw std::exception();//TODO: exception type and message
+      }
+
+      if(ob._operator_id == language::id_assignment)
+      {
+        convert(lhs, rhs, batch_instruction::opcode::store);
+      }
+      else
+      {
+        convert(lhs, calculate(get_operation(ob._operator_id), lhs, rhs, lhs._type), batch_instruction::opcode::store);
+      }
+
+      push(operand(lhs));
+    }
+    else if(ob._operator_id == language::id_matrix_multiplication)
+    {
+      const language::type_dimensions& dimensions_lhs = lhs._type.get_dimensions();
+      const language::type_dimensions& dimensions_rhs = rhs._type.get_dimensions();
+
+      operand o = allocate(ob.get_type());
+
+      // A vector is treated as a row vector when it is the lhs operand and as a column vector when it is the rhs operand
+      batch_instruction instruction(batch_instruction::opcode::multiply, o._type.get_id(), get_component_count(o._type));
+      instruction._m = (dimensions_lhs.is_vector() ? 1U : dimensions_lhs.m());
+      instruction._k = (dimensions_lhs.is_vector() ? get_component_count(lhs._type) : dimensions_lhs.n());
+      instruction._n = (dimensions_rhs.is_vector() ? 1U : dimensions_rhs.n());
+      instruction._dst = o._rows;
+      instruction._src[0] = lhs._rows;
+      instruction._src[1] = rhs._rows;
+
+      if(((instruction._m * instruction._k) != get_component_count(lhs._type)) ||
+         ((instruction._k * instruction._n) != get_component_count(rhs._type)) ||
+         ((instruction._m * instruction._n) != get_component_count(o._type)))
+      {
+        throw std::exception();//TODO: exception type and message
+      }
+
+      emit(std::move(instruction));
+      push(std::move(o));
+    }
+    else
+    {
+      push(calculate(get_operation(ob._operator_id), lhs, rhs, ob.get_type()));
+    }
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(const syntax::operator_ternary& ot, bool is_start)
+{
+  if(is_start)
+  {
+    ot._condition->apply_action(*this);
+    const operand c = pop();
+
+    // Each operand is only evaluated for the lanes that select it
+    batch_instruction instruction_push(batch_instruction::opcode::mask_push, c._type.get_id());
+    instruction_push._src[0] = c._rows;
+
+    const size_t idx_push = emit(std::move(instruction_push));
+    ot._operand_true->apply_action(*this);
+    const operand o_true = pop();
+
+    const size_t idx_else = emit(batch_instruction(batch_instruction::opcode::mask_else));
+    ot._operand_false->apply_action(*this);
+    const operand o_false = pop();
+
+    const size_t idx_pop = emit(batch_instruction(batch_instruction::opcode::mask_pop));
+
+    _program._instructions[idx_push]._target = idx_else;
+    _program._instructions[idx_else]._target = idx_pop;
+
+    operand o = allocate(ot.get_type());
+
+    batch_instruction instruction(batch_instruction::opcode::select, o._type.get_id(), get_component_count(o._type));
+    instruction._id_src = c._type.get_id();
+    instruction._dst = o._rows;
+    instruction._src[0] = c._rows;
+    instruction._src[1] = o_true._rows;
+    instruction._src[2] = o_false._rows;
+
+    emit(std::move(instruction));
+    push(std::move(o));
+  }
+
+  return is_start ? syntax::action_return_t::step_over :
+                    syntax::action_return_t::step_out;
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(const syntax::operator_component_access& oca, bool is_start)
+{
+  if(!is_start)
+  {
+    const operand o = pop();
+    const syntax::component_accessor& accessor = *(oca._accessor);
+
+    // A component access selects rows of its operand so doesn't require an instruction
+    operand o_access(oca.get_type());
+    o_access._is_lvalue = o._is_lvalue;
+
+    size_t i = 0U;
+
+    switch(accessor._mode)
+    {
+      case syntax::component_accessor::mode::scalar:
+        for(; i < static_cast<const syntax::component_accessor_scalar&>(accessor)._count; ++i)
+        {
+          o_access._rows[i] = o._rows[0];
+        }
+        break;
+      case syntax::component_accessor::mode::vector:
+        for(language::type_dimension_t idx : static_cast<const syntax::component_accessor_vector&>(accessor))
+        {
+          if(idx != syntax::component_accessor::_idx_default)
+          {
+            o_access._rows[i++] = o._rows[idx];
+          }
+        }
+        break;
+      case syntax::component_accessor::mode::matrix:
+      {
+        const syntax::component_accessor_matrix& accessor_matrix = static_cast<const syntax::component_accessor_matrix&>(accessor);
+        const size_t n = o._type.get_dimensions().n();
+
+        if(accessor_matrix._idx_n == syntax::component_accessor::_idx_default)
+        {
+          for(; i < n; ++i)
+          {
+            o_access._rows[i] = o._rows[(accessor_matrix._idx_m * n) + i];
+          }
+        }
+        else if(accessor_matrix._idx_m == syntax::component_accessor::_idx_default)
+        {
+          for(; i < o._type.get_dimensions().m(); ++i)
+          {
+            o_access._rows[i] = o._rows[(i * n) + accessor_matrix._idx_n];
+          }
+        }
+        else
+        {
+          o_access._rows[0] = o._rows[(accessor_matrix._idx_m * n) + accessor_matrix._idx_n];
+        }
+        break;
+      }
+    }
+
+    push(std::move(o_access));
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(const syntax::conditional& c, bool is_start)
+{
+  if(is_start)
+  {
+    // An 'else' has no condition so is run with the lanes left active by the preceding mask_else
+    if(const syntax::expression* condition = c.get_condition())
+    {
+      condition->apply_action(*this);
+      const operand o_condition = pop();
+
+      batch_instruction instruction_push(batch_instruction::opcode::mask_push, o_condition._type.get_id());
+      instruction_push._src[0] = o_condition._rows;
+
+      const size_t idx_push = emit(std::move(instruction_push));
+      c.get_statement()->apply_action(*this);
+
+      size_t idx_jump = idx_push;
+
+      if(const syntax::statement* s = c.get_statement_else())
+      {
+        const size_t idx_else = emit(batch_instruction(batch_instruction::opcode::mask_else));
+        _program._instructions[idx_push]._target = idx_else;
+
+        s->apply_action(*this);
+        idx_jump = idx_else;
+      }
+
+      const size_t idx_pop = emit(batch_instruction(batch_instruction::opcode::mask_pop));
+      _program._instructions[idx_jump]._target = idx_pop;
+    }
+    else
+    {
+      c.get_statement()->apply_action(*this);
+    }
+  }
+
+  return is_start ? syntax::action_return_t::step_over :
+                    syntax::action_return_t::step_out;
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(const syntax::constructor_call& cc, bool is_start)
+{
+  if(!is_start)
+  {
+    std::vector<operand> args;
+
+    for(size_t i = 0U; i < cc.get_args().size(); ++i)
+    {
+      args.push_back(pop());
+    }
+
+    std::reverse(args.begin(), args.end());
+
+    operand o = allocate(cc.get_type());
+
+    const size_t count = get_component_count(o._type);
+    const language::type_dimensions& dimensions = o._type.get_dimensions();
+
+    if((args.size() == 1U) && (get_component_count(args[0]._type) == 1U) && (count > 1U) && !dimensions.is_vector())
+    {
+      // A single scalar is set along the diagonal of a matrix
+      batch_instruction instruction_zero(batch_instruction::opcode::literal, o._type.get_id(), count);
+      instruction_zero._dst = o._rows;
+
+      batch_instruction instruction(batch_instruction::opcode::convert, o._type.get_id(), std::min(dimensions.m(), dimensions.n()));
+      instruction._id_src = args[0]._type.get_id();
+
+      for(size_t i = 0U; i < instruction._count; ++i)
+      {
+        instruction._dst[i] = o._rows[(i * dimensions.n()) + i];
+        instruction._src[0][i] = args[0]._rows[0];
+      }
+
+      emit(std::move(instruction_zero));
+      emit(std::move(instruction));
+    }
+    else if((args.size() == 1U) && (get_component_count(args[0]._type) == 1U))
+    {
+      // A single scalar is repeated for every component of a vector
+      convert(o, args[0]);
+    }
+    else
+    {
+      size_t i = 0U;
+
+      for(const operand& arg : args)
+      {
+        const size_t count_arg = get_component_count(arg._type);
+
+        if((i + count_arg) > count)
+        {
+          throw std::exception();//TODO: exception type and message
+        }
+
+        batch_instruction instruction(batch_instruction::opcode::convert, o._type.get_id(), count_arg);
+        instruction._id_src = arg._type.get_id();
+
+        std::copy_n(o._rows.begin() + i, count_arg, instruction._dst.begin());
+        std::copy_n(arg._rows.begin(), count_arg, instruction._src[0].begin());
+
+        emit(std::move(instruction));
+        i += count_arg;
+      }
+
+      if(i != count)
+      {
+        throw std::exception();//TODO: exception type and message
+      }
+    }
+
+    push(std::move(o));
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(const syntax::expression_statement&, bool is_start)
+{
+  if(!is_start)
+  {
+    pop();
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(const syntax::function_call& fc, bool is_start)
+{
+  if(is_start)
+  {
+    std::vector<operand> args;
+
+    for(const syntax::expression::ptr& arg : fc.get_args())
+    {
+      arg->apply_action(*this);
+      args.push_back(pop());
+    }
+
+    call(fc.get_function_definition(), std::move(args));
+  }
+
+  return is_start ? syntax::action_return_t::step_over :
+                    syntax::action_return_t::step_out;
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(const syntax::function_definition& fd, bool is_start)
+{
+  // Functions are compiled where they are called (i.e. inlined), other than 'main' which is the program itself
+  if(is_start && (fd._name == L"main"))
+  {
+    call(fd, std::vector<operand>());
+    pop();
+  }
+
+  return is_start ? syntax::action_return_t::step_over :
+                    syntax::action_return_t::step_out;
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(const syntax::return_statement&, bool is_start)
+{
+  if(!is_start)
+  {
+    if(_returns.empty())
+    {
+      throw std::exception();//TODO: exception type and message
+    }
+
+    if(get_component_count(_returns.back()._type) > 0U)
+    {
+      convert(_returns.back(), pop(), batch_instruction::opcode::store);
+    }
+
+    emit(batch_instruction(batch_instruction::opcode::ret));
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(const syntax::intrinsic_call& ic, bool is_start)
+{
+  if(!is_start)
+  {
+    std::vector<operand> args;
+
+    for(size_t i = 0U; i < ic.get_args().size(); ++i)
+    {
+      args.push_back(pop());
+    }
+
+    std::reverse(args.begin(), args.end());
+
+    if(args.empty() || (args.size() > 3U))
+    {
+      throw std::exception();//TODO: exception type and message
+    }
+
+    operand o = allocate(ic.get_type());
+
+    batch_instruction instruction(batch_instruction::opcode::intrinsic, o._type.get_id(), get_component_count(o._type));
+    instruction._count_src = get_component_count(args[0]._type);
+    instruction._intrinsic = ic.get_intrinsic();
+    instruction._dst = o._rows;
+
+    // Scalar arguments (e.g. the interpolant of lerp) are expanded to match the first argument
+    for(size_t i = 0U; i < args.size(); ++i)
+    {
+      instruction._src[i] = expand(args[i]._rows, get_component_count(args[i]._type), instruction._count_src);
+    }
+
+    emit(std::move(instruction));
+    push(std::move(o));
+  }
+
+  return get_default(is_start);
+}
+
+ns::batch_program ns::batch_compiler::get_result() const
+{
+  return _program;
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(float f)
+{
+  push(literal(language::type_helper<float>(), f));
+  return get_default(false);
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(double d)
+{
+  push(literal(language::type_helper<double>(), d));
+  return get_default(false);
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(int i)
+{
+  push(literal(language::type_helper<int>(), i));
+  return get_default(false);
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(unsigned int ui)
+{
+  push(literal(language::type_helper<unsigned int>(), ui));
+  return get_default(false);
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::operator()(bool b)
+{
+  push(literal(language::type_helper<bool>(), b ? 1.0 : 0.0));
+  return get_default(false);
+}
+
+sltl::syntax::action_return_t ns::batch_compiler::get_default(bool is_start)
+{
+  return is_start ? syntax::action_return_t::step_in :
+                    syntax::action_return_t::step_out;
+}
+
+ns::batch_compiler::operand ns::batch_compiler::allocate(const language::type& type)
+{
+  operand o(type);
+
+  for(size_t i = 0U, count = get_component_count(type); i < count; ++i)
+  {
+    if(_program._row_types.size() > std::numeric_limits<batch_row_t>::max())
+    {
+      throw std::exception();//TODO: exception type and message
+    }
+
+    o._rows[i] = static_cast<batch_row_t>(_program._row_types.size());
+    _program._row_types.push_back(type.get_id());
+  }
+
+  return o;
+}
+
+ns::batch_compiler::operand ns::batch_compiler::pop()
+{
+  if(_operands.empty())
+  {
+    throw std::exception();//TODO: exception type and message
+  }
+
+  operand o = std::move(_operands.back());
+  _operands.pop_back();
+
+  return o;
+}
+
+void ns::batch_compiler::push(operand&& o)
+{
+  _operands.push_back(std::move(o));
+}
+
+void ns::batch_compiler::declare(const syntax::declaration& d, const operand& o)
+{
+  // A declaration is compiled again each time its function is inlined
+  auto result = _variables.emplace(&d, o);
+
+  if(!(result.second))
+  {
+    result.first->second = o;
+  }
+}
+
+ns::batch_compiler::operand ns::batch_compiler::literal(const language::type& type, double d)
+{
+  operand o = allocate(type);
+
+  batch_instruction instruction(batch_instruction::opcode::literal, type.get_id(), get_component_count(type));
+  instruction._dst = o._rows;
+  instruction._value = d;
+
+  emit(std::move(instruction));
+
+  return o;
+}
+
+void ns::batch_compiler::convert(const operand& dst, const operand& src, batch_instruction::opcode op)
+{
+  const size_t count = get_component_count(dst._type);
+
+  batch_instruction instruction(op, dst._type.get_id(), count);
+  instruction._id_src = src._type.get_id();
+  instruction._dst = dst._rows;
+  instruction._src[0] = expand(src._rows, get_component_count(src._type), count);
+
+  emit(std::move(instruction));
+}
+
+ns::batch_compiler::operand ns::batch_compiler::calculate(operation op, const operand& lhs, const operand& rhs, const language::type& type)
+{
+  operand o = allocate(type);
+
+  const size_t count = get_component_count(type);
+
+  batch_instruction instruction(batch_instruction::opcode::calculate, type.get_id(), count);
+  instruction._id_src = lhs._type.get_id();
+  instruction._operation = op;
+  instruction._dst = o._rows;
+  instruction._src[0] = expand(lhs._rows, get_component_count(lhs._type), count);
+  instruction._src[1] = expand(rhs._rows, get_component_count(rhs._type), count);
+
+  emit(std::move(instruction));
+
+  return o;
+}
+
+void ns::batch_compiler::call(const syntax::function_definition& fd, std::vector<operand>&& args)
+{
+  if(args.size() != fd.get_params().size())
+  {
+    throw std::exception();//TODO: exception type and message
+  }
+
+  std::vector<const syntax::parameter_declaration*> param_declarations;
+  std::vector<operand> params;
+
+  for(const syntax::parameter_declaration::ptr& pd : fd.get_params())
+  {
+    param_declarations.push_back(pd.get());
+  }
+
+  for(size_t i = 0U; i < args.size(); ++i)
+  {
+    const syntax::parameter_declaration& pd = *(param_declarations[i]);
+
+    operand p = ((pd._qualifier == core::qualifier_param::out) ? literal(pd.get_type(), 0.0) : allocate(pd.get_type()));
+
+    if(pd._qualifier != core::qualifier_param::out)
+    {
+      convert(p, args[i]);
+    }
+
+    p._is_lvalue = true;
+    params.push_back(p);
+
+    declare(pd, p);
+  }
+
+  _returns.push_back(allocate(fd.get_type()));
+
+  emit(batch_instruction(batch_instruction::opcode::call_begin));
+  fd.get_body().apply_action(*this);
+  emit(batch_instruction(batch_instruction::opcode::call_end));
+
+  // The final values of 'out' and 'inout' parameters are copied back to their arguments
+  for(size_t i = 0U; i < args.size(); ++i)
+  {
+    if(param_declarations[i]->_qualifier != core::qualifier_param::in)
+    {
+      if(!args[i]._is_lvalue)
+      {
+        throw std::exception();//TODO: exception type and message
+      }
+
+      convert(args[i], params[i], batch_instruction::opcode::store);
+    }
+  }
+
+  operand o = std::move(_returns.back());
+  _returns.pop_back();
+
+  push(std::move(o));
+}
+
+size_t ns::batch_compiler::emit(batch_instruction&& instruction)
+{
+  _program._instructions.push_back(std::move(instruction));
+  return (_program._instructions.size() - 1U);
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "operation.h"
+#include "interpreter.h"
+
+#include <syntax/action.h>
+
+#include <type.h>
+
+#include <core/semantic.h>
+#include <core/intrinsic.h>
+#include <core/qualifier.h>
+#include <core/shader_stage.h>
+
+#include <array>
+#include <vector>
+#include <unordered_map>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // Forward declarations - sltl::syntax namespace
+  class declaration;
+}
+
+namespace interpreter
+{
+  // The number of invocations that are run together (i.e. the lanes of each row), each instruction is applied to every lane of its
+  // rows at once. The automatic width is 16 lanes where the CPU supports AVX-512 and 8 lanes otherwise, though either width can be
+  // run on any CPU (where the compiler supports it each kernel is also compiled for AVX2 and AVX-512, and the best one is used).
+  enum class batch_width
+  {
+    automatic,
+    lanes_8,
+    lanes_16
+  };
+
+  size_t get_batch_size(batch_width width = batch_width::automatic);
+
+  // A row holds a single component of a value for every lane in the batch (i.e. the values are stored as a structure-of-arrays),
+  // the lanes of a row are stored as the component type of the value
+  typedef unsigned short batch_row_t;
+  typedef std::array<batch_row_t, std::tuple_size<components>::value> batch_rows;
+
+  // A single step of a batch program. Every component of the destination is calculated from the matching component of each
+  // source, a scalar source is expanded (by repeating its row) when the program is compiled so that the rows always match.
+  struct batch_instruction
+  {
+    enum class opcode
+    {
+      literal,    // sets the destination rows to _value
+      convert,    // copies the source rows to the destination rows, converting each component to _id
+      store,      // as convert, but only the active lanes of the destination are written
+      calculate,  // applies _operation to the source rows, the operands are of type _id_src
+      multiply,   // multiplies a _m by _k matrix (source 0) with a _k by _n matrix (source 1)
+      select,     // selects the rows of source 1 (where source 0, of type _id_src, is true) or source 2
+      intrinsic,  // calls _intrinsic, dot and normalize sum the _count_src components of each source
+      mask_push,  // deactivates the lanes where source 0 (of type _id_src) is false, jumping to _target if no lane is active
+      mask_else,  // activates the lanes (of the enclosing mask) deactivated by the matching mask_push, jumping to _target if no lane is active
+      mask_pop,   // restores the lanes active before the matching mask_push
+      call_begin, // marks the start of a function call
+      call_end,   // restores the lanes active before the matching call_begin
+      ret         // deactivates the active lanes until the matching call_end
+    };
+
+    batch_instruction(opcode op, language::type_id id = language::id_float, size_t count = 0U);
+
+    opcode _opcode;
+
+    language::type_id _id;
+    language::type_id _id_src;
+
+    size_t _count;
+    size_t _count_src;
+
+    batch_rows _dst;
+    batch_rows _src[3];
+
+    double _value;
+
+    operation _operation;
+    core::intrinsic _intrinsic;
+
+    size_t _m;
+    size_t _k;
+    size_t _n;
+
+    size_t _target;
+  };
+
+  // Binds an output variable to host memory, see binding
+  struct output_binding
+  {
+    output_binding(core::semantic_pair semantic, void* data, size_t stride);
+
+    const core::semantic _semantic;
+    const core::semantic_index_t _semantic_index;
+
+    void* const _data;
+    const size_t _stride;
+  };
+
+  // The io variables of a batch program and the rows that hold their values
+  struct batch_variable
+  {
+    batch_variable(core::qualifier_storage qualifier, core::semantic_pair semantic, const language::type& type, const batch_rows& rows);
+
+    core::qualifier_storage _qualifier;
+
+    core::semantic _semantic;
+    core::semantic_index_t _semantic_index;
+
+    language::type _type;
+    batch_rows _rows;
+  };
+
+  class batch_program
+  {
+  public:
+    batch_program();
+
+    // Runs 'count' invocations of the shader. The in bindings are read (and the out bindings written) at their stride for each
+    // invocation, while the uniform bindings are read once. The results match those of the evaluator, other than integer division
+    // by zero which results in zero rather than an exception (as the divisor may belong to an inactive lane).
+    void run(const std::vector<binding>& bindings, const std::vector<output_binding>& outputs, size_t count, batch_width width = batch_width::automatic) const;
+
+    // The component type of each row
+    std::vector<language::type_id> _row_types;
+
+    std::vector<batch_instruction> _instructions;
+    std::vector<batch_variable> _variables;
+  };
+
+  // Compiles a shader into a batch program. Function calls are inlined and each branch of a conditional is run with the lanes
+  // that don't take it deactivated, a branch is skipped entirely when none of the lanes in the batch take it.
+  class batch_compiler : public syntax::const_action_result<batch_program>
+  {
+  public:
+    batch_compiler(batch_compiler&&) = default;
+    batch_compiler(core::shader_stage);
+
+    // Non-copyable and non-assignable
+    batch_compiler(const batch_compiler&) = delete;
+    batch_compiler& operator=(batch_compiler&&) = delete;
+    batch_compiler& operator=(const batch_compiler&) = delete;
+
+    syntax::action_return_t operator()(const syntax::io_block& iob, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::variable_declaration& vd, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::reference& r) override;
+    syntax::action_return_t operator()(const syntax::temporary& t, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::operator_unary& ou, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::operator_binary& ob, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::operator_ternary& ot, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::operator_component_access& oca, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::conditional& c, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::constructor_call& cc, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::expression_statement& es, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::function_call& fc, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::function_definition& fd, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::return_statement& rs, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::intrinsic_call& ic, bool is_start = true) override;
+
+    batch_program get_result() const override;
+
+  protected:
+    syntax::action_return_t operator()(float f) override;
+    syntax::action_return_t operator()(double d) override;
+    syntax::action_return_t operator()(int i) override;
+    syntax::action_return_t operator()(unsigned int ui) override;
+    syntax::action_return_t operator()(bool b) override;
+
+    syntax::action_return_t get_default(bool is_start) override;
+
+  private:
+    // The rows of an intermediate value, the rows of an lvalue belong to the variable it was read from
+    struct operand
+    {
+      operand(const language::type& type);
+
+      language::type _type;
+      batch_rows _rows;
+
+      bool _is_lvalue;
+    };
+
+    operand allocate(const language::type& type);
+    operand pop();
+    void push(operand&& o);
+
+    void declare(const syntax::declaration& d, const operand& o);
+
+    operand literal(const language::type& type, double d);
+    void convert(const operand& dst, const operand& src, batch_instruction::opcode op = batch_instruction::opcode::convert);
+    operand calculate(operation op, const operand& lhs, const operand& rhs, const language::type& type);
+    void call(const syntax::function_definition& fd, std::vector<operand>&& args);
+
+    size_t emit(batch_instruction&& instruction);
+
+    batch_program _program;
+
+    std::unordered_map<const syntax::declaration*, operand> _variables;
+
+    std::vector<operand> _operands;
+    std::vector<operand> _returns;
+  };
+}
+}
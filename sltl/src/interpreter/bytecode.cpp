@@ -0,0 +1,864 @@
+#include "bytecode.h"
+#include "operation.h"
+
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace
+{
+  using namespace sltl;
+  using namespace sltl::interpreter;
+
+  const char bytecode_magic[4] = { 'S', 'L', 'T', 'B' };
+  const std::uint32_t bytecode_version = 1U;
+
+  // The components are calculated as they are by the evaluator (with the operation known when the handler is linked), so integer
+  // division by zero is an error while integer overflow wraps
+  template<typename T, operation Op>
+  double calculate(double lhs, double rhs)
+  {
+    calculate_status status;
+
+    const double result = calculate_component<T>(Op, lhs, rhs, status);
+
+    if(status == calculate_status::division_by_zero)
+    {
+      throw std::runtime_error("sltl bytecode: integer division by zero");
+    }
+
+    return result;
+  }
+
+  size_t get_target(bytecode_word low, bytecode_word high)
+  {
+    return static_cast<size_t>(low) | (static_cast<size_t>(high) << 16U);
+  }
+
+  // Writes and reads the words of a saved program, each is stored as four little-endian bytes
+  void write_word(std::ostream& os, std::uint32_t word)
+  {
+    const char bytes[4] = { static_cast<char>(word & 0xFFU), static_cast<char>((word >> 8U) & 0xFFU), static_cast<char>((word >> 16U) & 0xFFU), static_cast<char>((word >> 24U) & 0xFFU) };
+    os.write(bytes, sizeof(bytes));
+  }
+
+  std::uint32_t read_word(std::istream& is)
+  {
+    unsigned char bytes[4];
+
+    if(!is.read(reinterpret_cast<char*>(bytes), sizeof(bytes)))
+    {
+      throw std::runtime_error("sltl bytecode: unexpected end of stream");
+    }
+
+    return static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8U) | (static_cast<std::uint32_t>(bytes[2]) << 16U) | (static_cast<std::uint32_t>(bytes[3]) << 24U);
+  }
+
+  // Reads a word that must be within the range [first, last], e.g. the values of an enum
+  template<typename T>
+  T read_word(std::istream& is, T first, T last, const char* message)
+  {
+    const std::uint32_t word = read_word(is);
+
+    if((word < static_cast<std::uint32_t>(first)) || (word > static_cast<std::uint32_t>(last)))
+    {
+      throw std::runtime_error(message);
+    }
+
+    return static_cast<T>(word);
+  }
+
+  // The type of the components of an instruction, which must be one of the types supported by dispatch
+  sltl::language::type_id to_type_id(std::uint32_t word)
+  {
+    if((word < sltl::language::id_float) || (word > sltl::language::id_bool))
+    {
+      throw std::runtime_error("sltl bytecode: bad type id");
+    }
+
+    return static_cast<sltl::language::type_id>(word);
+  }
+
+  void read(const batch_variable& v, const void* data, std::vector<double>& rows)
+  {
+    dispatch(v._type.get_id(), [&](auto t)
+    {
+      const decltype(t)* components = static_cast<const decltype(t)*>(data);
+
+      for(size_t i = 0U, count = get_component_count(v._type); i < count; ++i)
+      {
+        rows[v._rows[i]] = static_cast<double>(components[i]);
+      }
+    });
+  }
+
+  void write(const batch_variable& v, void* data, const std::vector<double>& rows)
+  {
+    dispatch(v._type.get_id(), [&](auto t)
+    {
+      decltype(t)* components = static_cast<decltype(t)*>(data);
+
+      for(size_t i = 0U, count = get_component_count(v._type); i < count; ++i)
+      {
+        components[i] = static_cast<decltype(t)>(rows[v._rows[i]]);
+      }
+    });
+  }
+
+  // The handlers of the linked instructions, each returns the index of the next instruction to run
+  template<typename LI>
+  size_t run_literal(const LI& li, const bytecode_word* code, double* rows, size_t pc)
+  {
+    const bytecode_word* w = code + li._operands;
+
+    for(size_t i = 0U; i < w[0]; ++i)
+    {
+      rows[w[2U + i]] = li._value;
+    }
+
+    return pc + 1U;
+  }
+
+  template<typename LI, typename T>
+  size_t run_convert(const LI& li, const bytecode_word* code, double* rows, size_t pc)
+  {
+    const bytecode_word* w = code + li._operands;
+    const size_t count = w[1];
+
+    const bytecode_word* dst = w + 2U;
+    const bytecode_word* src = dst + count;
+
+    // The source is copied first, as the destination rows may also be source rows (e.g. 'v.xy = v.yx')
+    double values[std::tuple_size<components>::value];
+
+    for(size_t i = 0U; i < count; ++i)
+    {
+      values[i] = rows[src[i]];
+    }
+
+    for(size_t i = 0U; i < count; ++i)
+    {
+      rows[dst[i]] = convert<T>(values[i]);
+    }
+
+    return pc + 1U;
+  }
+
+  template<typename LI, typename T, operation Op>
+  size_t run_calculate(const LI& li, const bytecode_word* code, double* rows, size_t pc)
+  {
+    const bytecode_word* w = code + li._operands;
+    const size_t count = w[2];
+
+    const bytecode_word* dst = w + 3U;
+    const bytecode_word* lhs = dst + count;
+    const bytecode_word* rhs = lhs + count;
+
+    for(size_t i = 0U; i < count; ++i)
+    {
+      rows[dst[i]] = calculate<T, Op>(rows[lhs[i]], rows[rhs[i]]);
+    }
+
+    return pc + 1U;
+  }
+
+  template<typename LI, typename T>
+  size_t run_multiply(const LI& li, const bytecode_word* code, double* rows, size_t pc)
+  {
+    const bytecode_word* w = code + li._operands;
+    const size_t m = w[1];
+    const size_t k = w[2];
+    const size_t n = w[3];
+
+    const bytecode_word* dst = w + 4U;
+    const bytecode_word* lhs = dst + (m * n);
+    const bytecode_word* rhs = lhs + (m * k);
+
+    for(size_t i = 0U; i < m; ++i)
+    {
+      for(size_t j = 0U; j < n; ++j)
+      {
+        double sum = 0.0;
+
+        for(size_t l = 0U; l < k; ++l)
+        {
+          sum = calculate<T, operation::add>(sum, calculate<T, operation::mul>(rows[lhs[(i * k) + l]], rows[rhs[(l * n) + j]]));
+        }
+
+        rows[dst[(i * n) + j]] = sum;
+      }
+    }
+
+    return pc + 1U;
+  }
+
+  template<typename LI>
+  size_t run_select(const LI& li, const bytecode_word* code, double* rows, size_t pc)
+  {
+    const bytecode_word* w = code + li._operands;
+    const size_t count = w[0];
+    const bool condition = (rows[w[1]] != 0.0);
+
+    const bytecode_word* dst = w + 2U;
+    const bytecode_word* src = (condition ? (dst + count) : (dst + (count * 2U)));
+
+    for(size_t i = 0U; i < count; ++i)
+    {
+      rows[dst[i]] = rows[src[i]];
+    }
+
+    return pc + 1U;
+  }
+
+  template<typename T>
+  double dot(const bytecode_word* x, const bytecode_word* y, size_t count, const double* rows)
+  {
+    double sum = 0.0;
+
+    for(size_t i = 0U; i < count; ++i)
+    {
+      sum = calculate<T, operation::add>(sum, calculate<T, operation::mul>(rows[x[i]], rows[y[i]]));
+    }
+
+    return sum;
+  }
+
+  template<typename LI, typename T>
+  size_t run_dot(const LI& li, const bytecode_word* code, double* rows, size_t pc)
+  {
+    const bytecode_word* w = code + li._operands;
+    const size_t count = w[1];
+
+    rows[w[2]] = dot<T>(w + 3U, w + 3U + count, count, rows);
+
+    return pc + 1U;
+  }
+
+  template<typename LI, typename T>
+  size_t run_normalize(const LI& li, const bytecode_word* code, double* rows, size_t pc)
+  {
+    const bytecode_word* w = code + li._operands;
+    const size_t count = w[1];
+
+    const bytecode_word* dst = w + 2U;
+    const bytecode_word* x = dst + count;
+
+    const double length = convert<T>(std::sqrt(dot<T>(x, x, count, rows)));
+
+    for(size_t i = 0U; i < count; ++i)
+    {
+      rows[dst[i]] = calculate<T, operation::div>(rows[x[i]], length);
+    }
+
+    return pc + 1U;
+  }
+
+  template<typename LI>
+  size_t run_clamp(const LI& li, const bytecode_word* code, double* rows, size_t pc)
+  {
+    const bytecode_word* w = code + li._operands;
+    const size_t count = w[0];
+
+    const bytecode_word* dst = w + 1U;
+    const bytecode_word* x = dst + count;
+    const bytecode_word* x_min = x + count;
+    const bytecode_word* x_max = x_min + count;
+
+    for(size_t i = 0U; i < count; ++i)
+    {
+      rows[dst[i]] = std::min(std::max(rows[x[i]], rows[x_min[i]]), rows[x_max[i]]);
+    }
+
+    return pc + 1U;
+  }
+
+  template<typename LI, typename T>
+  size_t run_lerp(const LI& li, const bytecode_word* code, double* rows, size_t pc)
+  {
+    const bytecode_word* w = code + li._operands;
+    const size_t count = w[1];
+
+    const bytecode_word* dst = w + 2U;
+    const bytecode_word* x = dst + count;
+    const bytecode_word* y = x + count;
+    const bytecode_word* s = y + count;
+
+    for(size_t i = 0U; i < count; ++i)
+    {
+      const double difference = calculate<T, operation::sub>(rows[y[i]], rows[x[i]]);
+      rows[dst[i]] = calculate<T, operation::add>(rows[x[i]], calculate<T, operation::mul>(difference, rows[s[i]]));
+    }
+
+    return pc + 1U;
+  }
+
+  template<typename LI, typename T>
+  size_t run_pow(const LI& li, const bytecode_word* code, double* rows, size_t pc)
+  {
+    const bytecode_word* w = code + li._operands;
+    const size_t count = w[1];
+
+    const bytecode_word* dst = w + 2U;
+    const bytecode_word* x = dst + count;
+    const bytecode_word* y = x + count;
+
+    for(size_t i = 0U; i < count; ++i)
+    {
+      rows[dst[i]] = convert<T>(std::pow(rows[x[i]], rows[y[i]]));
+    }
+
+    return pc + 1U;
+  }
+
+  template<typename LI>
+  size_t run_jump(const LI& li, const bytecode_word*, double*, size_t)
+  {
+    return li._target;
+  }
+
+  template<typename LI>
+  size_t run_jump_if_false(const LI& li, const bytecode_word* code, double* rows, size_t pc)
+  {
+    return ((rows[code[li._operands]] != 0.0) ? (pc + 1U) : li._target);
+  }
+
+  template<typename LI, typename T>
+  typename LI::handler get_handler_calculate(operation op)
+  {
+    switch(op)
+    {
+      case operation::add:
+        return &run_calculate<LI, T, operation::add>;
+      case operation::sub:
+        return &run_calculate<LI, T, operation::sub>;
+      case operation::mul:
+        return &run_calculate<LI, T, operation::mul>;
+      case operation::div:
+        return &run_calculate<LI, T, operation::div>;
+      case operation::eq:
+        return &run_calculate<LI, T, operation::eq>;
+      case operation::ne:
+        return &run_calculate<LI, T, operation::ne>;
+      case operation::lt:
+        return &run_calculate<LI, T, operation::lt>;
+      case operation::lt_eq:
+        return &run_calculate<LI, T, operation::lt_eq>;
+      case operation::gt:
+        return &run_calculate<LI, T, operation::gt>;
+      case operation::gt_eq:
+        return &run_calculate<LI, T, operation::gt_eq>;
+      default:
+        throw std::runtime_error("sltl bytecode: bad operation");
+    }
+  }
+
+  namespace ns = sltl::interpreter;
+}
+
+ns::bytecode_program::bytecode_program(const batch_program& program) : _row_count(program._row_types.size()), _variables(program._variables)
+{
+  const std::vector<batch_instruction>& instructions = program._instructions;
+
+  // The code offset of each batch instruction, used to resolve the jump targets once every instruction has been lowered
+  std::vector<size_t> offsets(instructions.size() + 1U);
+  std::vector<std::pair<size_t, size_t>> jumps;
+
+  auto fn_emit = [this](const auto& words)
+  {
+    _code.insert(_code.end(), std::begin(words), std::end(words));
+  };
+
+  auto fn_emit_rows = [this](const batch_rows& rows, size_t count)
+  {
+    _code.insert(_code.end(), rows.begin(), rows.begin() + count);
+  };
+
+  auto fn_emit_jump = [this, &jumps](bytecode_op op, size_t idx_target)
+  {
+    _code.push_back(static_cast<bytecode_word>(op));
+    jumps.emplace_back(_code.size(), idx_target);
+  };
+
+  auto fn_constant = [this](double d)
+  {
+    auto it = std::find_if(_constants.begin(), _constants.end(), [d](double c) { return std::memcmp(&c, &d, sizeof(double)) == 0; });
+
+    if(it == _constants.end())
+    {
+      _constants.push_back(d);
+      it = _constants.end() - 1U;
+    }
+
+    return static_cast<bytecode_word>(std::distance(_constants.begin(), it));
+  };
+
+  for(size_t i = 0U; i < instructions.size(); ++i)
+  {
+    const batch_instruction& ins = instructions[i];
+    const bytecode_word count = static_cast<bytecode_word>(ins._count);
+
+    offsets[i] = _code.size();
+
+    switch(ins._opcode)
+    {
+      case batch_instruction::opcode::literal:
+        fn_emit(std::initializer_list<bytecode_word>{ static_cast<bytecode_word>(bytecode_op::literal), count, fn_constant(ins._value) });
+        fn_emit_rows(ins._dst, count);
+        break;
+      case batch_instruction::opcode::convert:
+      case batch_instruction::opcode::store:
+        // Only the active invocation is run, so there's no difference between a store and a conversion
+        fn_emit(std::initializer_list<bytecode_word>{ static_cast<bytecode_word>(bytecode_op::convert), static_cast<bytecode_word>(ins._id), count });
+        fn_emit_rows(ins._dst, count);
+        fn_emit_rows(ins._src[0], count);
+        break;
+      case batch_instruction::opcode::calculate:
+        fn_emit(std::initializer_list<bytecode_word>{ static_cast<bytecode_word>(bytecode_op::calculate), static_cast<bytecode_word>(ins._operation), static_cast<bytecode_word>(ins._id_src), count });
+        fn_emit_rows(ins._dst, count);
+        fn_emit_rows(ins._src[0], count);
+        fn_emit_rows(ins._src[1], count);
+        break;
+      case batch_instruction::opcode::multiply:
+        fn_emit(std::initializer_list<bytecode_word>{ static_cast<bytecode_word>(bytecode_op::multiply), static_cast<bytecode_word>(ins._id), static_cast<bytecode_word>(ins._m), static_cast<bytecode_word>(ins._k), static_cast<bytecode_word>(ins._n) });
+        fn_emit_rows(ins._dst, ins._m * ins._n);
+        fn_emit_rows(ins._src[0], ins._m * ins._k);
+        fn_emit_rows(ins._src[1], ins._k * ins._n);
+        break;
+      case batch_instruction::opcode::select:
+        fn_emit(std::initializer_list<bytecode_word>{ static_cast<bytecode_word>(bytecode_op::select), count, ins._src[0][0] });
+        fn_emit_rows(ins._dst, count);
+        fn_emit_rows(ins._src[1], count);
+        fn_emit_rows(ins._src[2], count);
+        break;
+      case batch_instruction::opcode::intrinsic:
+        switch(ins._intrinsic)
+        {
+          case core::intrinsic::dot:
+            fn_emit(std::initializer_list<bytecode_word>{ static_cast<bytecode_word>(bytecode_op::dot), static_cast<bytecode_word>(ins._id), static_cast<bytecode_word>(ins._count_src), ins._dst[0] });
+            fn_emit_rows(ins._src[0], ins._count_src);
+            fn_emit_rows(ins._src[1], ins._count_src);
+            break;
+          case core::intrinsic::normalize:
+            fn_emit(std::initializer_list<bytecode_word>{ static_cast<bytecode_word>(bytecode_op::normalize), static_cast<bytecode_word>(ins._id), count });
+            fn_emit_rows(ins._dst, count);
+            fn_emit_rows(ins._src[0], count);
+            break;
+          case core::intrinsic::clamp:
+            fn_emit(std::initializer_list<bytecode_word>{ static_cast<bytecode_word>(bytecode_op::clamp), count });
+            fn_emit_rows(ins._dst, count);
+            fn_emit_rows(ins._src[0], count);
+            fn_emit_rows(ins._src[1], count);
+            fn_emit_rows(ins._src[2], count);
+            break;
+          case core::intrinsic::lerp:
+            fn_emit(std::initializer_list<bytecode_word>{ static_cast<bytecode_word>(bytecode_op::lerp), static_cast<bytecode_word>(ins._id), count });
+            fn_emit_rows(ins._dst, count);
+            fn_emit_rows(ins._src[0], count);
+            fn_emit_rows(ins._src[1], count);
+            fn_emit_rows(ins._src[2], count);
+            break;
+          case core::intrinsic::pow:
+            fn_emit(std::initializer_list<bytecode_word>{ static_cast<bytecode_word>(bytecode_op::pow), static_cast<bytecode_word>(ins._id), count });
+            fn_emit_rows(ins._dst, count);
+            fn_emit_rows(ins._src[0], count);
+            fn_emit_rows(ins._src[1], count);
+            break;
+          default:
+            throw std::runtime_error("sltl bytecode: unsupported intrinsic");
+        }
+        break;
+      case batch_instruction::opcode::mask_push:
+        // A branch that isn't taken is jumped over, to the start of the else branch (after its jump) if there is one
+        _code.push_back(static_cast<bytecode_word>(bytecode_op::jump_if_false));
+        _code.push_back(ins._src[0][0]);
+        jumps.emplace_back(_code.size(), (instructions[ins._target]._opcode == batch_instruction::opcode::mask_else) ? (ins._target + 1U) : ins._target);
+        _code.insert(_code.end(), 2U, 0U);
+        break;
+      case batch_instruction::opcode::mask_else:
+        // The end of a taken branch jumps over its else branch
+        fn_emit_jump(bytecode_op::jump, ins._target);
+        _code.insert(_code.end(), 2U, 0U);
+        break;
+      case batch_instruction::opcode::ret:
+      {
+        // A return jumps to the end of its (inlined) function
+        size_t idx_end = i + 1U;
+
+        for(size_t depth = 0U; idx_end < instructions.size(); ++idx_end)
+        {
+          if(instructions[idx_end]._opcode == batch_instruction::opcode::call_begin)
+          {
+            ++depth;
+          }
+          else if(instructions[idx_end]._opcode == batch_instruction::opcode::call_end)
+          {
+            if(depth-- == 0U)
+            {
+              break;
+            }
+          }
+        }
+
+        fn_emit_jump(bytecode_op::jump, idx_end);
+        _code.insert(_code.end(), 2U, 0U);
+        break;
+      }
+      case batch_instruction::opcode::mask_pop:
+      case batch_instruction::opcode::call_begin:
+      case batch_instruction::opcode::call_end:
+        break;
+    }
+  }
+
+  offsets.back() = _code.size();
+
+  for(const auto& jump : jumps)
+  {
+    const size_t target = offsets[jump.second];
+
+    _code[jump.first] = static_cast<bytecode_word>(target & 0xFFFFU);
+    _code[jump.first + 1U] = static_cast<bytecode_word>(target >> 16U);
+  }
+
+  link();
+}
+
+ns::bytecode_program::bytecode_program(std::istream& is) : _row_count(0U)
+{
+  char magic[sizeof(bytecode_magic)];
+
+  if(!is.read(magic, sizeof(magic)) || !std::equal(std::begin(magic), std::end(magic), std::begin(bytecode_magic)) || (read_word(is) != bytecode_version))
+  {
+    throw std::runtime_error("sltl bytecode: bad magic/version");
+  }
+
+  _row_count = read_word(is);
+
+  for(size_t i = 0U, count = read_word(is); i < count; ++i)
+  {
+    const core::qualifier_storage qualifier = read_word(is, core::qualifier_storage::in, core::qualifier_storage::uniform, "sltl bytecode: bad qualifier");
+    const core::semantic semantic = read_word(is, core::semantic::none, core::semantic::user, "sltl bytecode: bad semantic");
+    const core::semantic_index_t semantic_index = read_word(is, std::numeric_limits<core::semantic_index_t>::min(), std::numeric_limits<core::semantic_index_t>::max(), "sltl bytecode: bad semantic index");
+    const language::type_id id = to_type_id(read_word(is));
+    const language::type_dimension_t m = read_word<language::type_dimension_t>(is, 1U, 4U, "sltl bytecode: bad type dimensions");
+    const language::type_dimension_t n = read_word<language::type_dimension_t>(is, 1U, 4U, "sltl bytecode: bad type dimensions");
+
+    const language::type type(id, m, n);
+
+    if(get_component_count(type) > std::tuple_size<batch_rows>::value)
+    {
+      throw std::runtime_error("sltl bytecode: bad variable type");
+    }
+
+    batch_rows rows;
+    rows.fill(0U);
+
+    for(size_t j = 0U; j < get_component_count(type); ++j)
+    {
+      rows[j] = static_cast<batch_row_t>(read_word(is));
+
+      if(rows[j] >= _row_count)
+      {
+        throw std::runtime_error("sltl bytecode: bad row index");
+      }
+    }
+
+    _variables.emplace_back(qualifier, core::semantic_pair(semantic, semantic_index), type, rows);
+  }
+
+  for(size_t i = 0U, count = read_word(is); i < count; ++i)
+  {
+    const std::uint64_t bits = static_cast<std::uint64_t>(read_word(is)) | (static_cast<std::uint64_t>(read_word(is)) << 32U);
+
+    double d;
+    std::memcpy(&d, &bits, sizeof(double));
+
+    _constants.push_back(d);
+  }
+
+  for(size_t i = 0U, count = read_word(is); i < count; ++i)
+  {
+    _code.push_back(static_cast<bytecode_word>(read_word(is)));
+  }
+
+  link();
+}
+
+void ns::bytecode_program::save(std::ostream& os) const
+{
+  os.write(bytecode_magic, sizeof(bytecode_magic));
+
+  write_word(os, bytecode_version);
+  write_word(os, static_cast<std::uint32_t>(_row_count));
+  write_word(os, static_cast<std::uint32_t>(_variables.size()));
+
+  for(const batch_variable& v : _variables)
+  {
+    write_word(os, static_cast<std::uint32_t>(v._qualifier));
+    write_word(os, static_cast<std::uint32_t>(v._semantic));
+    write_word(os, static_cast<std::uint32_t>(v._semantic_index));
+    write_word(os, static_cast<std::uint32_t>(v._type.get_id()));
+    write_word(os, static_cast<std::uint32_t>(v._type.get_dimensions().m()));
+    write_word(os, static_cast<std::uint32_t>(v._type.get_dimensions().n()));
+
+    for(size_t i = 0U; i < get_component_count(v._type); ++i)
+    {
+      write_word(os, v._rows[i]);
+    }
+  }
+
+  write_word(os, static_cast<std::uint32_t>(_constants.size()));
+
+  for(double d : _constants)
+  {
+    std::uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(double));
+
+    write_word(os, static_cast<std::uint32_t>(bits & 0xFFFFFFFFU));
+    write_word(os, static_cast<std::uint32_t>(bits >> 32U));
+  }
+
+  write_word(os, static_cast<std::uint32_t>(_code.size()));
+
+  for(bytecode_word w : _code)
+  {
+    write_word(os, w);
+  }
+}
+
+void ns::bytecode_program::run(const std::vector<binding>& bindings, const std::vector<output_binding>& outputs, size_t count) const
+{
+  std::vector<double> rows(_row_count, 0.0);
+
+  std::vector<std::pair<const batch_variable*, const binding*>> variables_in;
+  std::vector<std::pair<const batch_variable*, const output_binding*>> variables_out;
+
+  for(const batch_variable& v : _variables)
+  {
+    if(v._qualifier == core::qualifier_storage::out)
+    {
+      auto it = std::find_if(outputs.begin(), outputs.end(), [&v](const output_binding& ob)
+      {
+        return (ob._semantic == v._semantic) && (ob._semantic_index == v._semantic_index);
+      });
+
+      // Outputs without a binding are discarded
+      if(it != outputs.end())
+      {
+        variables_out.emplace_back(&v, &(*it));
+      }
+
+      continue;
+    }
+
+    auto it = std::find_if(bindings.begin(), bindings.end(), [&v](const binding& b)
+    {
+      return (b._qualifier == v._qualifier) && (b._semantic == v._semantic) && (b._semantic_index == v._semantic_index);
+    });
+
+    if(it == bindings.end())
+    {
+      throw std::runtime_error("sltl bytecode: no binding for variable");
+    }
+
+    // Uniforms are the same for every invocation so are only read once
+    if(v._qualifier == core::qualifier_storage::uniform)
+    {
+      read(v, it->_data, rows);
+    }
+    else
+    {
+      variables_in.emplace_back(&v, &(*it));
+    }
+  }
+
+  for(size_t idx = 0U; idx < count; ++idx)
+  {
+    for(const auto& v : variables_in)
+    {
+      read(*(v.first), static_cast<const char*>(v.second->_data) + (idx * v.second->_stride), rows);
+    }
+
+    for(size_t pc = 0U; pc < _linked.size();)
+    {
+      const linked_instruction& li = _linked[pc];
+      pc = li._handler(li, _code.data(), rows.data(), pc);
+    }
+
+    for(const auto& v : variables_out)
+    {
+      write(*(v.first), static_cast<char*>(v.second->_data) + (idx * v.second->_stride), rows);
+    }
+  }
+}
+
+const std::vector<ns::bytecode_word>& ns::bytecode_program::get_code() const
+{
+  return _code;
+}
+
+const std::vector<double>& ns::bytecode_program::get_constants() const
+{
+  return _constants;
+}
+
+void ns::bytecode_program::link()
+{
+  typedef linked_instruction li_t;
+
+  // The index of the linked instruction that starts at each code offset, used to resolve the jump targets
+  std::vector<size_t> indices(_code.size() + 1U, static_cast<size_t>(-1));
+
+  auto fn_word = [this](size_t offset)
+  {
+    if(offset >= _code.size())
+    {
+      throw std::runtime_error("sltl bytecode: bad code offset");
+    }
+
+    return _code[offset];
+  };
+
+  // Checks that the operands (and rows) of the instruction are within the code and return the offset of the next instruction
+  auto fn_operands = [this, &fn_word](size_t offset, size_t operand_count, size_t row_count)
+  {
+    for(size_t i = 0U; i < row_count; ++i)
+    {
+      if(fn_word(offset + operand_count + i) >= _row_count)
+      {
+        throw std::runtime_error("sltl bytecode: bad row index");
+      }
+    }
+
+    return offset + operand_count + row_count;
+  };
+
+  auto fn_count = [](bytecode_word count)
+  {
+    if((count == 0U) || (count > std::tuple_size<batch_rows>::value))
+    {
+      throw std::runtime_error("sltl bytecode: bad component count");
+    }
+
+    return static_cast<size_t>(count);
+  };
+
+  _linked.clear();
+
+  for(size_t offset = 0U; offset < _code.size();)
+  {
+    indices[offset] = _linked.size();
+
+    li_t li;
+    li._operands = offset + 1U;
+    li._target = 0U;
+    li._value = 0.0;
+
+    const bytecode_op op = static_cast<bytecode_op>(_code[offset]);
+    const size_t o = li._operands;
+
+    switch(op)
+    {
+      case bytecode_op::literal:
+      {
+        const size_t count = fn_count(fn_word(o));
+        const size_t idx_constant = fn_word(o + 1U);
+
+        if(idx_constant >= _constants.size())
+        {
+          throw std::runtime_error("sltl bytecode: bad constant index");
+        }
+
+        li._handler = &run_literal<li_t>;
+        li._value = _constants[idx_constant];
+
+        offset = fn_operands(o, 2U, count);
+        break;
+      }
+      case bytecode_op::convert:
+        li._handler = dispatch(to_type_id(fn_word(o)), [](auto t) -> li_t::handler { return &run_convert<li_t, decltype(t)>; });
+        offset = fn_operands(o, 2U, fn_count(fn_word(o + 1U)) * 2U);
+        break;
+      case bytecode_op::calculate:
+      {
+        const operation operation_id = static_cast<operation>(fn_word(o));
+
+        li._handler = dispatch(to_type_id(fn_word(o + 1U)), [operation_id](auto t) { return get_handler_calculate<li_t, decltype(t)>(operation_id); });
+        offset = fn_operands(o, 3U, fn_count(fn_word(o + 2U)) * 3U);
+        break;
+      }
+      case bytecode_op::multiply:
+      {
+        const size_t m = fn_count(fn_word(o + 1U));
+        const size_t k = fn_count(fn_word(o + 2U));
+        const size_t n = fn_count(fn_word(o + 3U));
+
+        if(((m * n) > std::tuple_size<batch_rows>::value) || ((m * k) > std::tuple_size<batch_rows>::value) || ((k * n) > std::tuple_size<batch_rows>::value))
+        {
+          throw std::runtime_error("sltl bytecode: bad matrix dimensions");
+        }
+
+        li._handler = dispatch(to_type_id(fn_word(o)), [](auto t) -> li_t::handler { return &run_multiply<li_t, decltype(t)>; });
+        offset = fn_operands(o, 4U, (m * n) + (m * k) + (k * n));
+        break;
+      }
+      case bytecode_op::select:
+        li._handler = &run_select<li_t>;
+        offset = fn_operands(o, 1U, 1U + (fn_count(fn_word(o)) * 3U));
+        break;
+      case bytecode_op::dot:
+        li._handler = dispatch(to_type_id(fn_word(o)), [](auto t) -> li_t::handler { return &run_dot<li_t, decltype(t)>; });
+        offset = fn_operands(o, 2U, 1U + (fn_count(fn_word(o + 1U)) * 2U));
+        break;
+      case bytecode_op::normalize:
+        li._handler = dispatch(to_type_id(fn_word(o)), [](auto t) -> li_t::handler { return &run_normalize<li_t, decltype(t)>; });
+        offset = fn_operands(o, 2U, fn_count(fn_word(o + 1U)) * 2U);
+        break;
+      case bytecode_op::clamp:
+        li._handler = &run_clamp<li_t>;
+        offset = fn_operands(o, 1U, fn_count(fn_word(o)) * 4U);
+        break;
+      case bytecode_op::lerp:
+        li._handler = dispatch(to_type_id(fn_word(o)), [](auto t) -> li_t::handler { return &run_lerp<li_t, decltype(t)>; });
+        offset = fn_operands(o, 2U, fn_count(fn_word(o + 1U)) * 4U);
+        break;
+      case bytecode_op::pow:
+        li._handler = dispatch(to_type_id(fn_word(o)), [](auto t) -> li_t::handler { return &run_pow<li_t, decltype(t)>; });
+        offset = fn_operands(o, 2U, fn_count(fn_word(o + 1U)) * 3U);
+        break;
+      case bytecode_op::jump:
+        li._handler = &run_jump<li_t>;
+        li._target = get_target(fn_word(o), fn_word(o + 1U));
+        offset = o + 2U;
+        break;
+      case bytecode_op::jump_if_false:
+        li._handler = &run_jump_if_false<li_t>;
+        li._target = get_target(fn_word(fn_operands(o, 0U, 1U)), fn_word(o + 2U));
+        offset = o + 3U;
+        break;
+      default:
+        throw std::runtime_error("sltl bytecode: bad opcode");
+    }
+
+    _linked.push_back(li);
+  }
+
+  indices.back() = _linked.size();
+
+  // Jump targets are resolved from code offsets to the index of the instruction at that offset
+  for(li_t& li : _linked)
+  {
+    if((li._handler == &run_jump<li_t>) || (li._handler == &run_jump_if_false<li_t>))
+    {
+      if((li._target >= indices.size()) || (indices[li._target] == static_cast<size_t>(-1)))
+      {
+        throw std::runtime_error("sltl bytecode: bad jump target");
+      }
+
+      li._target = indices[li._target];
+    }
+  }
+}
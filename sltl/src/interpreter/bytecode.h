@@ -0,0 +1,87 @@
+#pragma once
+
+#include "batch.h"
+#include "interpreter.h"
+
+#include <vector>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+
+namespace sltl
+{
+namespace interpreter
+{
+  typedef std::uint16_t bytecode_word;
+
+  // Each instruction is an opcode word followed by its operand words, the operands of every instruction other than
+  // a jump end with its row lists (destination first). Types are encoded as their language::type_id.
+  enum class bytecode_op : bytecode_word
+  {
+    literal,       // count, constant, dst[count]
+    convert,       // type, count, dst[count], src[count]
+    calculate,     // operation, type, count, dst[count], lhs[count], rhs[count]
+    multiply,      // type, m, k, n, dst[m*n], lhs[m*k], rhs[k*n]
+    select,        // count, condition, dst[count], src_true[count], src_false[count]
+    dot,           // type, count, dst, x[count], y[count]
+    normalize,     // type, count, dst[count], x[count]
+    clamp,         // count, dst[count], x[count], min[count], max[count]
+    lerp,          // type, count, dst[count], x[count], y[count], s[count]
+    pow,           // type, count, dst[count], x[count], y[count]
+    jump,          // target (low word), target (high word)
+    jump_if_false, // condition, target (low word), target (high word)
+    count
+  };
+
+  // A single invocation register machine. A program is lowered from a batch program (whose registers are already rows of
+  // components) with each mask replaced by a jump, so only the branches that are taken are run. Every instruction is linked
+  // to a handler specialized for its type (and operation) once, rather than being decoded each time it is run.
+  class bytecode_program
+  {
+  public:
+    bytecode_program(const batch_program& program);
+
+    // Loads a program written by save, throwing if the program isn't valid
+    bytecode_program(std::istream& is);
+
+    bytecode_program(bytecode_program&&) = default;
+    bytecode_program(const bytecode_program&) = default;
+
+    // Non-assignable
+    bytecode_program& operator=(bytecode_program&&) = delete;
+    bytecode_program& operator=(const bytecode_program&) = delete;
+
+    void save(std::ostream& os) const;
+
+    // Runs 'count' invocations of the shader, see batch_program::run. Integer division by zero throws as it does for the evaluator.
+    void run(const std::vector<binding>& bindings, const std::vector<output_binding>& outputs, size_t count) const;
+
+    const std::vector<bytecode_word>& get_code() const;
+    const std::vector<double>& get_constants() const;
+
+  private:
+    struct linked_instruction
+    {
+      typedef size_t (*handler)(const linked_instruction& li, const bytecode_word* code, double* rows, size_t pc);
+
+      handler _handler;
+
+      size_t _operands; // the offset of the first operand word in the code
+      size_t _target;   // the index of the linked instruction jumped to
+
+      double _value;
+    };
+
+    void link();
+
+    size_t _row_count;
+
+    std::vector<batch_variable> _variables;
+    std::vector<double> _constants;
+    std::vector<bytecode_word> _code;
+
+    std::vector<linked_instruction> _linked;
+  };
+}
+}
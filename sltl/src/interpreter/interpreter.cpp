@@ -0,0 +1,840 @@
+#include "interpreter.h"
+#include "operation.h"
+
+#include <syntax/block.h>
+#include <syntax/io_block.h>
+#include <syntax/operator.h>
+#include <syntax/reference.h>
+#include <syntax/temporary.h>
+#include <syntax/conditional.h>
+#include <syntax/function_call.h>
+#include <syntax/intrinsic_call.h>
+#include <syntax/constructor_call.h>
+#include <syntax/return_statement.h>
+#include <syntax/function_definition.h>
+#include <syntax/variable_declaration.h>
+#include <syntax/expression_statement.h>
+#include <syntax/operator_component_access.h>
+
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+
+
+namespace
+{
+  using namespace sltl;
+  using namespace sltl::interpreter;
+
+  // Integer division by zero is an error, while signed integer overflow wraps
+  double calculate(language::type_id id, operation op, double lhs, double rhs)
+  {
+    calculate_status status;
+
+    const double result = interpreter::calculate_component(id, op, lhs, rhs, status);
+
+    if(status == calculate_status::division_by_zero)
+    {
+      throw std::exception();//TODO: exception type and message
+    }
+
+    return result;
+  }
+
+  // Scalar operands (of the scalar-vector and scalar-matrix operators) apply to every component
+  value calculate(operation op, const value& lhs, const value& rhs, const language::type& type)
+  {
+    const size_t count_lhs = get_component_count(lhs._type);
+    const size_t count_rhs = get_component_count(rhs._type);
+    const size_t count = std::max(count_lhs, count_rhs);
+
+    if(((count_lhs != count) && (count_lhs != 1U)) || ((count_rhs != count) && (count_rhs != 1U)) || (count != get_component_count(type)))
+    {
+      throw std::exception();//TODO: exception type and message
+    }
+
+    value v(type);
+
+    for(size_t i = 0U; i < count; ++i)
+    {
+      v._components[i] = calculate(lhs._type.get_id(), op, lhs._components[(count_lhs == 1U) ? 0U : i], rhs._components[(count_rhs == 1U) ? 0U : i]);
+    }
+
+    return v;
+  }
+
+  // A vector is treated as a row vector when it is the lhs operand and as a column vector when it is the rhs operand
+  value multiply(const value& lhs, const value& rhs, const language::type& type)
+  {
+    const language::type_dimensions& dimensions_lhs = lhs._type.get_dimensions();
+    const language::type_dimensions& dimensions_rhs = rhs._type.get_dimensions();
+
+    const size_t lhs_m = (dimensions_lhs.is_vector() ? 1U : dimensions_lhs.m());
+    const size_t lhs_n = (dimensions_lhs.is_vector() ? get_component_count(lhs._type) : dimensions_lhs.n());
+    const size_t rhs_m = (dimensions_rhs.is_vector() ? get_component_count(rhs._type) : dimensions_rhs.m());
+    const size_t rhs_n = (dimensions_rhs.is_vector() ? 1U : dimensions_rhs.n());
+
+    if((lhs_n != rhs_m) || ((lhs_m * rhs_n) != get_component_count(type)))
+    {
+      throw std::exception();//TODO: exception type and message
+    }
+
+    const language::type_id id = type.get_id();
+
+    value v(type);
+
+    for(size_t i = 0U; i < lhs_m; ++i)
+    {
+      for(size_t j = 0U; j < rhs_n; ++j)
+      {
+        double sum = 0.0;
+
+        for(size_t k = 0U; k < lhs_n; ++k)
+        {
+          sum = calculate(id, operation::add, sum, calculate(id, operation::mul, lhs._components[(i * lhs_n) + k], rhs._components[(k * rhs_n) + j]));
+        }
+
+        v._components[(i * rhs_n) + j] = sum;
+      }
+    }
+
+    return v;
+  }
+
+  double dot(const value& x, const value& y)
+  {
+    const language::type_id id = x._type.get_id();
+
+    double sum = 0.0;
+
+    for(size_t i = 0U, count = get_component_count(x._type); i < count; ++i)
+    {
+      sum = calculate(id, operation::add, sum, calculate(id, operation::mul, x._components[i], y._components[i]));
+    }
+
+    return sum;
+  }
+
+  value call_intrinsic(core::intrinsic intrinsic, const std::vector<value>& args, const language::type& type)
+  {
+    const language::type_id id = type.get_id();
+    const size_t count = get_component_count(type);
+
+    value v(type);
+
+    auto fn_args = [&args](size_t arg_count)
+    {
+      if(args.size() != arg_count)
+      {
+        throw std::exception();//TODO: exception type and message
+      }
+    };
+
+    switch(intrinsic)
+    {
+      case core::intrinsic::dot:
+        fn_args(2U);
+        v._components[0] = dot(args[0], args[1]);
+        break;
+      case core::intrinsic::normalize:
+      {
+        fn_args(1U);
+
+        const double length = convert(id, std::sqrt(dot(args[0], args[0])));
+
+        for(size_t i = 0U; i < count; ++i)
+        {
+          v._components[i] = calculate(id, operation::div, args[0]._components[i], length);
+        }
+        break;
+      }
+      case core::intrinsic::clamp:
+        fn_args(3U);
+
+        for(size_t i = 0U; i < count; ++i)
+        {
+          v._components[i] = std::min(std::max(args[0]._components[i], args[1]._components[i]), args[2]._components[i]);
+        }
+        break;
+      case core::intrinsic::lerp:
+        fn_args(3U);
+
+        // The interpolant is always a scalar
+        for(size_t i = 0U; i < count; ++i)
+        {
+          const double difference = calculate(id, operation::sub, args[1]._components[i], args[0]._components[i]);
+          v._components[i] = calculate(id, operation::add, args[0]._components[i], calculate(id, operation::mul, difference, args[2]._components[0]));
+        }
+        break;
+      case core::intrinsic::pow:
+        fn_args(2U);
+
+        for(size_t i = 0U; i < count; ++i)
+        {
+          v._components[i] = convert(id, std::pow(args[0]._components[i], args[1]._components[i]));
+        }
+        break;
+      default:
+        throw std::exception();//TODO: exception type and message
+    }
+
+    return v;
+  }
+
+  value access(const value& operand, const syntax::component_accessor& accessor, const language::type& type)
+  {
+    value v(type);
+
+    auto fn_copy = [&v, &operand](size_t idx_v, size_t idx_operand)
+    {
+      v._components[idx_v] = operand._components[idx_operand];
+      v._storage[idx_v] = operand._storage[idx_operand];
+    };
+
+    switch(accessor._mode)
+    {
+      case syntax::component_accessor::mode::scalar:
+        // A scalar is repeated, e.g. 'f.xxx'
+        for(size_t i = 0U; i < static_cast<const syntax::component_accessor_scalar&>(accessor)._count; ++i)
+        {
+          fn_copy(i, 0U);
+        }
+        break;
+      case syntax::component_accessor::mode::vector:
+      {
+        size_t i = 0U;
+
+        for(language::type_dimension_t idx : static_cast<const syntax::component_accessor_vector&>(accessor))
+        {
+          if(idx != syntax::component_accessor::_idx_default)
+          {
+            fn_copy(i++, idx);
+          }
+        }
+        break;
+      }
+      case syntax::component_accessor::mode::matrix:
+      {
+        const syntax::component_accessor_matrix& accessor_matrix = static_cast<const syntax::component_accessor_matrix&>(accessor);
+        const size_t n = operand._type.get_dimensions().n();
+
+        if(accessor_matrix._idx_n == syntax::component_accessor::_idx_default)
+        {
+          // A row
+          for(size_t j = 0U; j < n; ++j)
+          {
+            fn_copy(j, (accessor_matrix._idx_m * n) + j);
+          }
+        }
+        else if(accessor_matrix._idx_m == syntax::component_accessor::_idx_default)
+        {
+          // A column
+          for(size_t i = 0U; i < operand._type.get_dimensions().m(); ++i)
+          {
+            fn_copy(i, (i * n) + accessor_matrix._idx_n);
+          }
+        }
+        else
+        {
+          fn_copy(0U, (accessor_matrix._idx_m * n) + accessor_matrix._idx_n);
+        }
+        break;
+      }
+    }
+
+    return v;
+  }
+
+  value construct(const std::vector<value>& args, const language::type& type)
+  {
+    const language::type_id id = type.get_id();
+    const size_t count = get_component_count(type);
+
+    value v(type);
+
+    if((args.size() == 1U) && (get_component_count(args[0]._type) == 1U) && (count > 1U))
+    {
+      const double component = convert(id, args[0]._components[0]);
+
+      // A single scalar is either repeated (for a vector) or set along the diagonal (for a matrix)
+      for(size_t i = 0U; i < count; ++i)
+      {
+        const bool is_set = type.get_dimensions().is_vector() || ((i / type.get_dimensions().n()) == (i % type.get_dimensions().n()));
+        v._components[i] = (is_set ? component : 0.0);
+      }
+
+      return v;
+    }
+
+    size_t i = 0U;
+
+    for(const value& arg : args)
+    {
+      for(size_t j = 0U, count_arg = get_component_count(arg._type); j < count_arg; ++j)
+      {
+        if(i == count)
+        {
+          throw std::exception();//TODO: exception type and message
+        }
+
+        v._components[i++] = convert(id, arg._components[j]);
+      }
+    }
+
+    if(i != count)
+    {
+      throw std::exception();//TODO: exception type and message
+    }
+
+    return v;
+  }
+
+  // Writes the components of 'rhs' to the variable that 'lhs' was read from
+  void store(value& lhs, const value& rhs)
+  {
+    const language::type_id id = lhs._type.get_id();
+
+    for(size_t i = 0U, count = get_component_count(lhs._type); i < count; ++i)
+    {
+      if(!lhs._storage[i])
+      {
+        throw std::exception();//TODO: exception type and message
+      }
+
+      *(lhs._storage[i]) = lhs._components[i] = convert(id, rhs._components[i]);
+    }
+  }
+
+  template<typename T>
+  void read(const void* data, components& c, size_t count)
+  {
+    std::transform(static_cast<const T*>(data), static_cast<const T*>(data) + count, c.begin(), [](T t) { return static_cast<double>(t); });
+  }
+
+  void read(const language::type& type, const void* data, components& c)
+  {
+    const size_t count = get_component_count(type);
+
+    switch(type.get_id())
+    {
+      case language::id_float:
+        read<float>(data, c, count);
+        break;
+      case language::id_double:
+        read<double>(data, c, count);
+        break;
+      case language::id_int:
+        read<int>(data, c, count);
+        break;
+      case language::id_uint:
+        read<unsigned int>(data, c, count);
+        break;
+      case language::id_bool:
+        read<bool>(data, c, count);
+        break;
+      default:
+        throw std::exception();//TODO: exception type and message
+    }
+  }
+
+  namespace ns = sltl::interpreter;
+}
+
+ns::binding::binding(core::qualifier_storage qualifier, core::semantic_pair semantic, const void* data, size_t stride) : _qualifier(qualifier), _semantic(semantic._semantic), _semantic_index(semantic._index), _data(data), _stride(stride)
+{
+  if(((_qualifier != core::qualifier_storage::in) && (_qualifier != core::qualifier_storage::uniform)) || !_data)
+  {
+    throw std::exception();//TODO: exception type and message
+  }
+}
+
+ns::output_value::output_value(core::semantic_pair semantic, const language::type& type) : _semantic(semantic._semantic), _semantic_index(semantic._index), _type(type)
+{
+}
+
+ns::value::value(const language::type& type) : _type(type)
+{
+  _components.fill(0.0);
+  _storage.fill(nullptr);
+}
+
+ns::evaluator::frame::frame(const language::type& type_return) : _type_return(type_return), _value_return(type_return), _is_returning(false)
+{
+}
+
+ns::evaluator::evaluator(core::shader_stage, std::vector<binding> bindings) : _bindings(std::move(bindings))
+{
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::block& b, bool is_start)
+{
+  if(is_start)
+  {
+    // The root block of a test tree isn't part of a function so is run with its own frame
+    const bool is_root = _frames.empty();
+
+    if(is_root)
+    {
+      _frames.emplace_back(language::type_helper<void>());
+    }
+
+    for(const syntax::statement::ptr& s : b)
+    {
+      if(_frames.back()._is_returning)
+      {
+        break;
+      }
+
+      s->apply_action(*this);
+    }
+
+    if(is_root)
+    {
+      _frames.pop_back();
+    }
+  }
+
+  return is_start ? syntax::action_return_t::step_over :
+                    syntax::action_return_t::step_out;
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::io_block& iob, bool is_start)
+{
+  if(is_start)
+  {
+    for(const syntax::statement::ptr& s : iob)
+    {
+      const syntax::variable_declaration& vd = static_cast<const syntax::variable_declaration&>(*s);
+      components& c = (_variables_io[&vd] = components());
+
+      c.fill(0.0);
+
+      if(iob._qualifier == core::qualifier_storage::out)
+      {
+        _outputs.push_back(&vd);
+        continue;
+      }
+
+      auto it = std::find_if(_bindings.begin(), _bindings.end(), [&iob, &vd](const binding& b)
+      {
+        return (b._qualifier == iob._qualifier) && (b._semantic == vd._semantic) && (b._semantic_index == vd._semantic_index);
+      });
+
+      if(it == _bindings.end())
+      {
+        throw std::exception();//TODO: exception type and message
+      }
+
+      read(vd.get_type(), it->_data, c);
+    }
+  }
+
+  return is_start ? syntax::action_return_t::step_over :
+                    syntax::action_return_t::step_out;
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::variable_declaration& vd, bool is_start)
+{
+  if(!is_start)
+  {
+    components& c = declare(vd);
+
+    // Variables without an initializer are zero initialized
+    if(vd.has_initializer())
+    {
+      const value v = pop();
+      std::transform(v._components.begin(), v._components.end(), c.begin(), [&vd](double d) { return convert(vd.get_type().get_id(), d); });
+    }
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::reference& r)
+{
+  auto fn_find = [&r](std::unordered_map<const syntax::declaration*, components>& variables)
+  {
+    auto it = variables.find(&(r._declaration));
+    return ((it != variables.end()) ? &(it->second) : nullptr);
+  };
+
+  components* c = (_frames.empty() ? nullptr : fn_find(_frames.back()._variables));
+
+  if(!c && !(c = fn_find(_variables_io)))
+  {
+    throw std::exception();//TODO: exception type and message
+  }
+
+  value v(r.get_type());
+
+  for(size_t i = 0U, count = get_component_count(v._type); i < count; ++i)
+  {
+    v._components[i] = (*c)[i];
+    v._storage[i] = &((*c)[i]);
+  }
+
+  push(std::move(v));
+
+  return get_default(false);
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::temporary& t, bool is_start)
+{
+  if(!is_start)
+  {
+    value v(t.get_type());
+
+    // A temporary is a copy of its initializer (if any) and is otherwise zero initialized
+    if(t.has_initializer())
+    {
+      v._components = pop()._components;
+    }
+
+    push(std::move(v));
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::operator_unary& ou, bool is_start)
+{
+  if(!is_start)
+  {
+    value v = pop();
+    value v_result = v;
+
+    const operation op = (((ou._operator_id == language::id_increment_pre) || (ou._operator_id == language::id_increment_post)) ? operation::add : operation::sub);
+
+    for(size_t i = 0U, count = get_component_count(v._type); i < count; ++i)
+    {
+      v_result._components[i] = calculate(v._type.get_id(), op, v._components[i], 1.0);
+    }
+
+    store(v, v_result);
+
+    // The postfix operators result in the value of the variable before it was modified
+    push(language::is_prefix_operator(ou._operator_id) ? std::move(v_result) : std::move(v));
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::operator_binary& ob, bool is_start)
+{
+  if(!is_start)
+  {
+    const value rhs = pop();
+    value lhs = pop();
+
+    if(ob._operator_id == language::id_assignment)
+    {
+      store(lhs, rhs);
+      push(std::move(lhs));
+    }
+    else if(language::is_operator_assignment(ob._operator_id))
+    {
+      store(lhs, calculate(get_operation(ob._operator_id), lhs, rhs, lhs._type));
+      push(std::move(lhs));
+    }
+    else if(ob._operator_id == language::id_matrix_multiplication)
+    {
+      push(multiply(lhs, rhs, ob.get_type()));
+    }
+    else
+    {
+      push(calculate(get_operation(ob._operator_id), lhs, rhs, ob.get_type()));
+    }
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::operator_ternary& ot, bool is_start)
+{
+  if(is_start)
+  {
+    // Only the selected operand is evaluated
+    ot._condition->apply_action(*this);
+
+    if(pop()._components[0] != 0.0)
+    {
+      ot._operand_true->apply_action(*this);
+    }
+    else
+    {
+      ot._operand_false->apply_action(*this);
+    }
+  }
+
+  return is_start ? syntax::action_return_t::step_over :
+                    syntax::action_return_t::step_out;
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::operator_component_access& oca, bool is_start)
+{
+  if(!is_start)
+  {
+    push(access(pop(), *(oca._accessor), oca.get_type()));
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::conditional& c, bool is_start)
+{
+  if(is_start)
+  {
+    bool is_taken = true;
+
+    // An 'else' has no condition so is always taken (if it is reached)
+    if(const syntax::expression* condition = c.get_condition())
+    {
+      condition->apply_action(*this);
+      is_taken = (pop()._components[0] != 0.0);
+    }
+
+    if(is_taken)
+    {
+      c.get_statement()->apply_action(*this);
+    }
+    else if(const syntax::statement* s = c.get_statement_else())
+    {
+      s->apply_action(*this);
+    }
+  }
+
+  return is_start ? syntax::action_return_t::step_over :
+                    syntax::action_return_t::step_out;
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::constructor_call& cc, bool is_start)
+{
+  if(!is_start)
+  {
+    std::vector<value> args;
+
+    for(size_t i = 0U; i < cc.get_args().size(); ++i)
+    {
+      args.push_back(pop());
+    }
+
+    std::reverse(args.begin(), args.end());
+
+    push(construct(args, cc.get_type()));
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::expression_statement&, bool is_start)
+{
+  if(!is_start)
+  {
+    pop();
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::function_call& fc, bool is_start)
+{
+  if(is_start)
+  {
+    std::vector<value> args;
+
+    for(const syntax::expression::ptr& arg : fc.get_args())
+    {
+      arg->apply_action(*this);
+      args.push_back(pop());
+    }
+
+    call(fc.get_function_definition(), std::move(args));
+  }
+
+  return is_start ? syntax::action_return_t::step_over :
+                    syntax::action_return_t::step_out;
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::function_definition& fd, bool is_start)
+{
+  // Functions are only run when they are called, other than 'main' which is run once the io_blocks have been bound
+  if(is_start && (fd._name == L"main"))
+  {
+    call(fd, std::vector<value>());
+    pop();
+  }
+
+  return is_start ? syntax::action_return_t::step_over :
+                    syntax::action_return_t::step_out;
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::return_statement&, bool is_start)
+{
+  if(!is_start)
+  {
+    frame& f = _frames.back();
+
+    if(f._type_return != language::type_helper<void>())
+    {
+      f._value_return._components = pop()._components;
+    }
+
+    f._is_returning = true;
+  }
+
+  return get_default(is_start);
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(const syntax::intrinsic_call& ic, bool is_start)
+{
+  if(!is_start)
+  {
+    std::vector<value> args;
+
+    for(size_t i = 0U; i < ic.get_args().size(); ++i)
+    {
+      args.push_back(pop());
+    }
+
+    std::reverse(args.begin(), args.end());
+
+    push(call_intrinsic(ic.get_intrinsic(), args, ic.get_type()));
+  }
+
+  return get_default(is_start);
+}
+
+std::vector<ns::output_value> ns::evaluator::get_result() const
+{
+  std::vector<output_value> outputs;
+
+  for(const syntax::variable_declaration* vd : _outputs)
+  {
+    const components& c = _variables_io.at(vd);
+
+    outputs.emplace_back(core::semantic_pair(vd->_semantic, vd->_semantic_index), vd->get_type());
+    outputs.back()._components.assign(c.begin(), c.begin() + get_component_count(vd->get_type()));
+  }
+
+  return outputs;
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(float f)
+{
+  value v{ language::type_helper<float>() };
+  v._components[0] = f;
+
+  push(std::move(v));
+
+  return get_default(false);
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(double d)
+{
+  value v{ language::type_helper<double>() };
+  v._components[0] = d;
+
+  push(std::move(v));
+
+  return get_default(false);
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(int i)
+{
+  value v{ language::type_helper<int>() };
+  v._components[0] = i;
+
+  push(std::move(v));
+
+  return get_default(false);
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(unsigned int ui)
+{
+  value v{ language::type_helper<unsigned int>() };
+  v._components[0] = ui;
+
+  push(std::move(v));
+
+  return get_default(false);
+}
+
+sltl::syntax::action_return_t ns::evaluator::operator()(bool b)
+{
+  value v{ language::type_helper<bool>() };
+  v._components[0] = (b ? 1.0 : 0.0);
+
+  push(std::move(v));
+
+  return get_default(false);
+}
+
+sltl::syntax::action_return_t ns::evaluator::get_default(bool is_start)
+{
+  return is_start ? syntax::action_return_t::step_in :
+                    syntax::action_return_t::step_out;
+}
+
+ns::components& ns::evaluator::declare(const syntax::declaration& d)
+{
+  components& c = _frames.back()._variables[&d];
+  c.fill(0.0);
+
+  return c;
+}
+
+ns::value ns::evaluator::pop()
+{
+  if(_values.empty())
+  {
+    throw std::exception();//TODO: exception type and message
+  }
+
+  value v = std::move(_values.back());
+  _values.pop_back();
+
+  return v;
+}
+
+void ns::evaluator::push(value&& v)
+{
+  _values.push_back(std::move(v));
+}
+
+void ns::evaluator::call(const syntax::function_definition& fd, std::vector<value>&& args)
+{
+  _frames.emplace_back(fd.get_type());
+
+  auto it_arg = args.begin();
+
+  for(const syntax::parameter_declaration::ptr& pd : fd.get_params())
+  {
+    components& c = declare(*pd);
+    std::copy(it_arg->_components.begin(), it_arg->_components.end(), c.begin());
+
+    ++it_arg;
+  }
+
+  fd.get_body().apply_action(*this);
+
+  // The final values of 'out' and 'inout' parameters are copied back to their arguments
+  it_arg = args.begin();
+
+  for(const syntax::parameter_declaration::ptr& pd : fd.get_params())
+  {
+    if(pd->_qualifier != core::qualifier_param::in)
+    {
+      value v(pd->get_type());
+      v._components = _frames.back()._variables.at(pd.get());
+
+      store(*it_arg, v);
+    }
+
+    ++it_arg;
+  }
+
+  value v = std::move(_frames.back()._value_return);
+  _frames.pop_back();
+
+  push(std::move(v));
+}
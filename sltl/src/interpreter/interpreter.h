@@ -0,0 +1,142 @@
+#pragma once
+
+#include <syntax/action.h>
+
+#include <type.h>
+
+#include <core/semantic.h>
+#include <core/qualifier.h>
+#include <core/shader_stage.h>
+
+#include <array>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // Forward declarations - sltl::syntax namespace
+  class declaration;
+  class variable_declaration;
+}
+
+namespace interpreter
+{
+  // Binds an input or uniform variable to host memory, which holds the variable's components in row-major order. Each
+  // component is stored as the variable's component type (i.e. bool, int, unsigned int, float or double).
+  struct binding
+  {
+    binding(core::qualifier_storage qualifier, core::semantic_pair semantic, const void* data, size_t stride = 0U);
+
+    const core::qualifier_storage _qualifier;
+
+    const core::semantic _semantic;
+    const core::semantic_index_t _semantic_index;
+
+    const void* const _data;
+
+    // The number of bytes between the data of consecutive invocations, only used when running a batch of invocations
+    const size_t _stride;
+  };
+
+  // The value of an output variable once the shader has run, its components are in row-major order
+  struct output_value
+  {
+    output_value(core::semantic_pair semantic, const language::type& type);
+
+    const core::semantic _semantic;
+    const core::semantic_index_t _semantic_index;
+
+    const language::type _type;
+
+    std::vector<double> _components;
+  };
+
+  typedef std::array<double, language::type_dimensions::max_dimensions * language::type_dimensions::max_dimensions> components;
+
+  // An intermediate value of the evaluator. The components of an lvalue also refer to the storage of the variable they were read from.
+  struct value
+  {
+    value(const language::type& type);
+
+    language::type _type;
+
+    components _components;
+    std::array<double*, std::tuple_size<components>::value> _storage;
+  };
+
+  // Runs a shader on the CPU, e.g. to check that an optimisation doesn't change the result of a shader. Every component
+  // is held as a double but arithmetic is performed at the precision of its type. The 'main' function is run once the
+  // shader's io_blocks have been bound, with each input and uniform variable read from the host memory of its binding.
+  class evaluator : public syntax::const_action_result<std::vector<output_value>>
+  {
+  public:
+    evaluator(evaluator&&) = default;
+    evaluator(core::shader_stage, std::vector<binding> bindings);
+
+    // Non-copyable and non-assignable
+    evaluator(const evaluator&) = delete;
+    evaluator& operator=(evaluator&&) = delete;
+    evaluator& operator=(const evaluator&) = delete;
+
+    syntax::action_return_t operator()(const syntax::block& b, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::io_block& iob, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::variable_declaration& vd, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::reference& r) override;
+    syntax::action_return_t operator()(const syntax::temporary& t, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::operator_unary& ou, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::operator_binary& ob, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::operator_ternary& ot, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::operator_component_access& oca, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::conditional& c, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::constructor_call& cc, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::expression_statement& es, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::function_call& fc, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::function_definition& fd, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::return_statement& rs, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::intrinsic_call& ic, bool is_start = true) override;
+
+    std::vector<output_value> get_result() const override;
+
+  protected:
+    syntax::action_return_t operator()(float f) override;
+    syntax::action_return_t operator()(double d) override;
+    syntax::action_return_t operator()(int i) override;
+    syntax::action_return_t operator()(unsigned int ui) override;
+    syntax::action_return_t operator()(bool b) override;
+
+    syntax::action_return_t get_default(bool is_start) override;
+
+  private:
+    // The local variables and parameters of a function call
+    struct frame
+    {
+      frame(const language::type& type_return);
+
+      std::unordered_map<const syntax::declaration*, components> _variables;
+
+      const language::type _type_return;
+      value _value_return;
+
+      bool _is_returning;
+    };
+
+    components& declare(const syntax::declaration& d);
+    value pop();
+    void push(value&& v);
+
+    void call(const syntax::function_definition& fd, std::vector<value>&& args);
+
+    const std::vector<binding> _bindings;
+
+    std::unordered_map<const syntax::declaration*, components> _variables_io;
+    std::vector<const syntax::variable_declaration*> _outputs;
+
+    std::deque<frame> _frames;
+    std::vector<value> _values;
+  };
+}
+}
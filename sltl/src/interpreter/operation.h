@@ -0,0 +1,219 @@
+#pragma once
+
+#include <type.h>
+
+#include <cmath>
+#include <limits>
+#include <exception>
+#include <type_traits>
+
+
+namespace sltl
+{
+namespace interpreter
+{
+  // The component-wise operation applied by a binary operator (or by the arithmetic of an assignment operator)
+  enum class operation
+  {
+    none,
+    add,
+    sub,
+    mul,
+    div,
+    eq,
+    ne,
+    lt,
+    lt_eq,
+    gt,
+    gt_eq
+  };
+
+  // Assignment and matrix multiplication aren't applied component by component so have no operation
+  inline operation get_operation(language::operator_binary_id id)
+  {
+    switch(id)
+    {
+      case language::id_addition:
+      case language::id_element_wise_addition:
+      case language::id_assignment_addition:
+        return operation::add;
+      case language::id_subtraction:
+      case language::id_element_wise_subtraction:
+      case language::id_assignment_subtraction:
+        return operation::sub;
+      case language::id_multiplication:
+      case language::id_element_wise_multiplication:
+      case language::id_assignment_multiplication:
+      case language::id_scalar_vector_multiplication:
+      case language::id_scalar_matrix_multiplication:
+      case language::id_vector_scalar_multiplication:
+      case language::id_matrix_scalar_multiplication:
+        return operation::mul;
+      case language::id_division:
+      case language::id_element_wise_division:
+      case language::id_assignment_division:
+      case language::id_scalar_vector_division:
+      case language::id_scalar_matrix_division:
+      case language::id_vector_scalar_division:
+      case language::id_matrix_scalar_division:
+        return operation::div;
+      case language::id_element_wise_eq:
+        return operation::eq;
+      case language::id_element_wise_ne:
+        return operation::ne;
+      case language::id_lt:
+      case language::id_element_wise_lt:
+        return operation::lt;
+      case language::id_lt_eq:
+      case language::id_element_wise_lt_eq:
+        return operation::lt_eq;
+      case language::id_gt:
+      case language::id_element_wise_gt:
+        return operation::gt;
+      case language::id_gt_eq:
+      case language::id_element_wise_gt_eq:
+        return operation::gt_eq;
+      default:
+        return operation::none;
+    }
+  }
+
+  inline size_t get_component_count(const language::type& type)
+  {
+    return type.get_dimensions().m() * type.get_dimensions().n();
+  }
+
+  // Calls 'fn' with a value of the component type matching 'id'
+  template<typename Fn>
+  auto dispatch(language::type_id id, Fn&& fn) -> decltype(fn(float()))
+  {
+    switch(id)
+    {
+      case language::id_float:
+        return fn(float());
+      case language::id_double:
+        return fn(double());
+      case language::id_int:
+        return fn(int());
+      case language::id_uint:
+        return fn(static_cast<unsigned int>(0U));
+      case language::id_bool:
+        return fn(bool());
+      default:
+        throw std::exception();//TODO: exception type and message
+    }
+  }
+
+  // Rounds the component to the precision (and range) of T
+  template<typename T>
+  double convert(double d)
+  {
+    return static_cast<T>(d);
+  }
+
+  template<>
+  inline double convert<unsigned int>(double d)
+  {
+    return static_cast<unsigned int>(static_cast<long long>(d));
+  }
+
+  template<>
+  inline double convert<bool>(double d)
+  {
+    return ((d != 0.0) ? 1.0 : 0.0);
+  }
+
+  inline double convert(language::type_id id, double d)
+  {
+    return dispatch(id, [d](auto t)
+    {
+      return convert<decltype(t)>(d);
+    });
+  }
+
+  // How the result of calculate_component differs from the result of the operation (rounded to the precision of a real type)
+  enum class calculate_status
+  {
+    exact,
+    wrapped,         // signed integer overflow, the result wraps as it would for an unsigned integer
+    not_finite,      // the real result is infinity or NaN
+    division_by_zero // integer division by zero, the result is zero
+  };
+
+  // Applies the operation to a pair of components of type T, a comparison results in one (true) or zero (false). Integer
+  // arithmetic is performed with a wider type (unsigned for an unsigned T, whose product may not fit a signed type), so that
+  // the result wraps (rather than overflows) on conversion. This is shared by the evaluator and constant folding so that a
+  // folded expression always has the value the evaluator would calculate.
+  template<typename T>
+  double calculate_component(operation op, double lhs, double rhs, calculate_status& status)
+  {
+    typedef typename std::conditional<std::is_floating_point<T>::value, T,
+            typename std::conditional<std::is_signed<T>::value, long long, unsigned long long>::type>::type calculate_t;
+
+    const calculate_t c_lhs = static_cast<T>(lhs);
+    const calculate_t c_rhs = static_cast<T>(rhs);
+
+    calculate_t result;
+
+    status = calculate_status::exact;
+
+    switch(op)
+    {
+      case operation::add:
+        result = c_lhs + c_rhs;
+        break;
+      case operation::sub:
+        result = c_lhs - c_rhs;
+        break;
+      case operation::mul:
+        result = c_lhs * c_rhs;
+        break;
+      case operation::div:
+        if(!std::is_floating_point<T>::value && (c_rhs == 0))
+        {
+          status = calculate_status::division_by_zero;
+          return 0.0;
+        }
+
+        result = c_lhs / c_rhs;
+        break;
+      case operation::eq:
+        return ((c_lhs == c_rhs) ? 1.0 : 0.0);
+      case operation::ne:
+        return ((c_lhs != c_rhs) ? 1.0 : 0.0);
+      case operation::lt:
+        return ((c_lhs < c_rhs) ? 1.0 : 0.0);
+      case operation::lt_eq:
+        return ((c_lhs <= c_rhs) ? 1.0 : 0.0);
+      case operation::gt:
+        return ((c_lhs > c_rhs) ? 1.0 : 0.0);
+      case operation::gt_eq:
+        return ((c_lhs >= c_rhs) ? 1.0 : 0.0);
+      default:
+        throw std::exception();//TODO: exception type and message
+    }
+
+    if(std::is_floating_point<T>::value)
+    {
+      if(!std::isfinite(result))
+      {
+        status = calculate_status::not_finite;
+      }
+    }
+    else if(std::is_signed<T>::value && ((result < std::numeric_limits<T>::lowest()) || (result > std::numeric_limits<T>::max())))
+    {
+      status = calculate_status::wrapped;
+    }
+
+    return static_cast<T>(result);
+  }
+
+  inline double calculate_component(language::type_id id, operation op, double lhs, double rhs, calculate_status& status)
+  {
+    return dispatch(id, [op, lhs, rhs, &status](auto t)
+    {
+      return calculate_component<decltype(t)>(op, lhs, rhs, status);
+    });
+  }
+}
+}
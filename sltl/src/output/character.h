@@ -0,0 +1,115 @@
+#pragma once
+
+#include <string>
+
+#include <cstddef>
+
+
+// Selects the narrow or wide form of a character or string literal, depending on the character type C
+#define SLTL_TEXT(C, t) ::sltl::detail::text_select<C>::select(t, L ## t)
+
+namespace sltl
+{
+namespace detail
+{
+  template<typename C>
+  struct text_select;
+
+  template<>
+  struct text_select<char>
+  {
+    template<typename N, typename W>
+    static constexpr N select(N n, W)
+    {
+      return n;
+    }
+  };
+
+  template<>
+  struct text_select<wchar_t>
+  {
+    template<typename N, typename W>
+    static constexpr W select(N, W w)
+    {
+      return w;
+    }
+  };
+
+  // Appends the UTF-8 encoding of a wide string (UTF-16 or UTF-32, depending on the size of wchar_t)
+  inline void append_utf8(std::string& str, const wchar_t* wstr, size_t length)
+  {
+    for(size_t i = 0; i < length; ++i)
+    {
+      unsigned long cp = static_cast<unsigned long>(wstr[i]);
+
+      if(cp < 0x80U)
+      {
+        str.push_back(static_cast<char>(cp));
+        continue;
+      }
+
+      // Combine UTF-16 surrogate pairs
+      if((cp >= 0xD800U) && (cp <= 0xDBFFU) && ((i + 1U) < length))
+      {
+        const unsigned long cp_low = static_cast<unsigned long>(wstr[i + 1U]);
+
+        if((cp_low >= 0xDC00U) && (cp_low <= 0xDFFFU))
+        {
+          cp = 0x10000U + ((cp - 0xD800U) << 10) + (cp_low - 0xDC00U);
+          ++i;
+        }
+      }
+
+      if(cp < 0x800U)
+      {
+        str.push_back(static_cast<char>(0xC0U | (cp >> 6)));
+        str.push_back(static_cast<char>(0x80U | (cp & 0x3FU)));
+      }
+      else if(cp < 0x10000U)
+      {
+        str.push_back(static_cast<char>(0xE0U | (cp >> 12)));
+        str.push_back(static_cast<char>(0x80U | ((cp >> 6) & 0x3FU)));
+        str.push_back(static_cast<char>(0x80U | (cp & 0x3FU)));
+      }
+      else
+      {
+        str.push_back(static_cast<char>(0xF0U | (cp >> 18)));
+        str.push_back(static_cast<char>(0x80U | ((cp >> 12) & 0x3FU)));
+        str.push_back(static_cast<char>(0x80U | ((cp >> 6) & 0x3FU)));
+        str.push_back(static_cast<char>(0x80U | (cp & 0x3FU)));
+      }
+    }
+  }
+
+  template<typename C>
+  struct string_convert;
+
+  template<>
+  struct string_convert<char>
+  {
+    static std::string convert(const std::wstring& wstr)
+    {
+      std::string str;
+      str.reserve(wstr.size());
+      append_utf8(str, wstr.data(), wstr.size());
+      return str;
+    }
+  };
+
+  template<>
+  struct string_convert<wchar_t>
+  {
+    static const std::wstring& convert(const std::wstring& wstr)
+    {
+      return wstr;
+    }
+  };
+
+  // Converts the (wide) names stored in the syntax tree to the output character type. No copy is made for wide output.
+  template<typename C>
+  auto to_basic_string(const std::wstring& wstr) -> decltype(string_convert<C>::convert(wstr))
+  {
+    return string_convert<C>::convert(wstr);
+  }
+}
+}
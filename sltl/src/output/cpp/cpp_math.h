@@ -0,0 +1,496 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+
+// The vector and matrix types used by the code generated by output_cpp. This header has no other dependencies, so it can be
+// compiled by a host project along with the generated code (which expects the sltl::cpp::math names to be visible).
+namespace sltl
+{
+namespace cpp
+{
+namespace math
+{
+  template<typename T, std::size_t N>
+  struct vector;
+
+  template<typename T, std::size_t M, std::size_t N>
+  struct matrix;
+
+  namespace detail
+  {
+    // Writes the components of each constructor argument in turn, converting them to the type of the destination
+    template<typename D>
+    struct component_writer
+    {
+      template<typename U>
+      void operator()(U u)
+      {
+        _dst.component(_idx++) = static_cast<typename D::value_type>(u);
+      }
+
+      D& _dst;
+      std::size_t _idx;
+    };
+
+    template<typename W, typename U>
+    std::enable_if_t<std::is_arithmetic<U>::value> write(W& w, U u)
+    {
+      w(u);
+    }
+
+    template<typename W, typename U, std::size_t N>
+    void write(W& w, const vector<U, N>& v)
+    {
+      for(std::size_t i = 0U; i < N; ++i)
+      {
+        w(v[i]);
+      }
+    }
+
+    template<typename W, typename U, std::size_t M, std::size_t N>
+    void write(W& w, const matrix<U, M, N>& m)
+    {
+      for(std::size_t i = 0U; i < M; ++i)
+      {
+        write(w, m[i]);
+      }
+    }
+
+    // A single scalar argument is copied to every component
+    template<typename D, typename U>
+    std::enable_if_t<std::is_arithmetic<U>::value> construct(D& dst, U u)
+    {
+      for(std::size_t i = 0U; i < D::component_count; ++i)
+      {
+        dst.component(i) = static_cast<typename D::value_type>(u);
+      }
+    }
+
+    template<typename D, typename... A>
+    void construct(D& dst, const A&... a)
+    {
+      component_writer<D> w = { dst, 0U };
+
+      // Arguments are written in order as the elements of a braced initializer list are evaluated from left to right
+      const int expand[] = { (write(w, a), 0)... };
+      static_cast<void>(expand);
+    }
+
+    template<typename T, std::size_t K>
+    struct swizzle_type
+    {
+      typedef vector<T, K> type;
+    };
+
+    template<typename T>
+    struct swizzle_type<T, 1U>
+    {
+      typedef T type;
+    };
+  }
+
+  template<typename T, std::size_t N>
+  struct vector
+  {
+    typedef T value_type;
+    static constexpr std::size_t component_count = N;
+
+    // The components are left uninitialized, as they are for a scalar
+    vector() = default;
+
+    template<typename A0, typename... A>
+    explicit vector(A0 a0, A... a)
+    {
+      detail::construct(*this, a0, a...);
+    }
+
+    T& operator[](std::size_t i)
+    {
+      return _c[i];
+    }
+
+    const T& operator[](std::size_t i) const
+    {
+      return _c[i];
+    }
+
+    T& component(std::size_t i)
+    {
+      return _c[i];
+    }
+
+    vector& operator+=(const vector& v)
+    {
+      return *this = (*this + v);
+    }
+
+    vector& operator-=(const vector& v)
+    {
+      return *this = (*this - v);
+    }
+
+    vector& operator*=(const vector& v)
+    {
+      return *this = (*this * v);
+    }
+
+    vector& operator/=(const vector& v)
+    {
+      return *this = (*this / v);
+    }
+
+    vector& operator*=(T t)
+    {
+      return *this = (*this * t);
+    }
+
+    vector& operator/=(T t)
+    {
+      return *this = (*this / t);
+    }
+
+    // The element-wise operators are written as simple loops over the components so that they can be auto-vectorized
+    template<typename Fn>
+    friend vector apply(const vector& lhs, const vector& rhs, Fn fn)
+    {
+      vector result;
+
+      for(std::size_t i = 0U; i < N; ++i)
+      {
+        result._c[i] = fn(lhs._c[i], rhs._c[i]);
+      }
+
+      return result;
+    }
+
+    friend vector operator+(const vector& lhs, const vector& rhs) { return apply(lhs, rhs, [](T l, T r) { return l + r; }); }
+    friend vector operator-(const vector& lhs, const vector& rhs) { return apply(lhs, rhs, [](T l, T r) { return l - r; }); }
+    friend vector operator*(const vector& lhs, const vector& rhs) { return apply(lhs, rhs, [](T l, T r) { return l * r; }); }
+    friend vector operator/(const vector& lhs, const vector& rhs) { return apply(lhs, rhs, [](T l, T r) { return l / r; }); }
+
+    friend vector operator*(const vector& lhs, T rhs) { return lhs * vector(rhs); }
+    friend vector operator/(const vector& lhs, T rhs) { return lhs / vector(rhs); }
+    friend vector operator*(T lhs, const vector& rhs) { return vector(lhs) * rhs; }
+    friend vector operator/(T lhs, const vector& rhs) { return vector(lhs) / rhs; }
+
+    T _c[N];
+  };
+
+  template<typename T, std::size_t M, std::size_t N>
+  struct matrix
+  {
+    typedef T value_type;
+    static constexpr std::size_t component_count = M * N;
+
+    matrix() = default;
+
+    // The components are written row by row
+    template<typename A0, typename... A>
+    explicit matrix(A0 a0, A... a)
+    {
+      detail::construct(*this, a0, a...);
+    }
+
+    vector<T, N>& operator[](std::size_t i)
+    {
+      return _r[i];
+    }
+
+    const vector<T, N>& operator[](std::size_t i) const
+    {
+      return _r[i];
+    }
+
+    T& component(std::size_t i)
+    {
+      return _r[i / N][i % N];
+    }
+
+    matrix& operator+=(const matrix& m)
+    {
+      return *this = (*this + m);
+    }
+
+    matrix& operator-=(const matrix& m)
+    {
+      return *this = (*this - m);
+    }
+
+    matrix& operator*=(T t)
+    {
+      return *this = (*this * t);
+    }
+
+    matrix& operator/=(T t)
+    {
+      return *this = (*this / t);
+    }
+
+    template<typename Fn>
+    friend matrix apply(const matrix& lhs, const matrix& rhs, Fn fn)
+    {
+      matrix result;
+
+      for(std::size_t i = 0U; i < M; ++i)
+      {
+        result._r[i] = apply(lhs._r[i], rhs._r[i], fn);
+      }
+
+      return result;
+    }
+
+    friend matrix operator+(const matrix& lhs, const matrix& rhs) { return apply(lhs, rhs, [](T l, T r) { return l + r; }); }
+    friend matrix operator-(const matrix& lhs, const matrix& rhs) { return apply(lhs, rhs, [](T l, T r) { return l - r; }); }
+    friend matrix operator*(const matrix& lhs, const matrix& rhs) { return apply(lhs, rhs, [](T l, T r) { return l * r; }); }
+    friend matrix operator/(const matrix& lhs, const matrix& rhs) { return apply(lhs, rhs, [](T l, T r) { return l / r; }); }
+
+    friend matrix operator*(const matrix& lhs, T rhs) { return lhs * matrix(rhs); }
+    friend matrix operator/(const matrix& lhs, T rhs) { return lhs / matrix(rhs); }
+    friend matrix operator*(T lhs, const matrix& rhs) { return matrix(lhs) * rhs; }
+    friend matrix operator/(T lhs, const matrix& rhs) { return matrix(lhs) / rhs; }
+
+    vector<T, N> _r[M];
+  };
+
+  // Component access, a swizzle that is assigned to uses swizzle_ref rather than swizzle
+  template<std::size_t... I, typename T, std::size_t N>
+  typename detail::swizzle_type<T, sizeof...(I)>::type swizzle(const vector<T, N>& v)
+  {
+    return typename detail::swizzle_type<T, sizeof...(I)>::type(v[I]...);
+  }
+
+  template<std::size_t... I, typename T>
+  std::enable_if_t<std::is_arithmetic<T>::value, typename detail::swizzle_type<T, sizeof...(I)>::type> swizzle(T t)
+  {
+    return typename detail::swizzle_type<T, sizeof...(I)>::type((static_cast<void>(I), t)...);
+  }
+
+  template<typename T, std::size_t N, std::size_t... I>
+  struct swizzle_proxy
+  {
+    typedef vector<T, sizeof...(I)> value_type;
+
+    swizzle_proxy& operator=(const value_type& v)
+    {
+      std::size_t i = 0U;
+
+      const int expand[] = { (_v[I] = v[i++], 0)... };
+      static_cast<void>(expand);
+
+      return *this;
+    }
+
+    swizzle_proxy& operator+=(const value_type& v) { return *this = (swizzle<I...>(_v) + v); }
+    swizzle_proxy& operator-=(const value_type& v) { return *this = (swizzle<I...>(_v) - v); }
+    swizzle_proxy& operator*=(const value_type& v) { return *this = (swizzle<I...>(_v) * v); }
+    swizzle_proxy& operator/=(const value_type& v) { return *this = (swizzle<I...>(_v) / v); }
+    swizzle_proxy& operator*=(T t) { return *this = (swizzle<I...>(_v) * t); }
+    swizzle_proxy& operator/=(T t) { return *this = (swizzle<I...>(_v) / t); }
+
+    vector<T, N>& _v;
+  };
+
+  template<std::size_t I, typename T, std::size_t N>
+  T& swizzle_ref(vector<T, N>& v)
+  {
+    return v[I];
+  }
+
+  template<std::size_t I, typename T>
+  std::enable_if_t<std::is_arithmetic<T>::value, T&> swizzle_ref(T& t)
+  {
+    static_assert(I == 0U, "sltl::cpp::math::swizzle_ref: a scalar only has a single component");
+    return t;
+  }
+
+  template<std::size_t I0, std::size_t I1, std::size_t... I, typename T, std::size_t N>
+  swizzle_proxy<T, N, I0, I1, I...> swizzle_ref(vector<T, N>& v)
+  {
+    return swizzle_proxy<T, N, I0, I1, I...>{ v };
+  }
+
+  template<typename T, std::size_t M, std::size_t N, std::size_t J>
+  struct column_proxy
+  {
+    column_proxy& operator=(const vector<T, M>& v)
+    {
+      for(std::size_t i = 0U; i < M; ++i)
+      {
+        _m[i][J] = v[i];
+      }
+
+      return *this;
+    }
+
+    matrix<T, M, N>& _m;
+  };
+
+  template<std::size_t J, typename T, std::size_t M, std::size_t N>
+  vector<T, M> column(const matrix<T, M, N>& m)
+  {
+    vector<T, M> result;
+
+    for(std::size_t i = 0U; i < M; ++i)
+    {
+      result[i] = m[i][J];
+    }
+
+    return result;
+  }
+
+  template<std::size_t J, typename T, std::size_t M, std::size_t N>
+  column_proxy<T, M, N, J> column_ref(matrix<T, M, N>& m)
+  {
+    return column_proxy<T, M, N, J>{ m };
+  }
+
+  // Intrinsics, the scalar overloads are templates so that any matching overloads declared by <cmath> are preferred
+  template<typename T>
+  std::enable_if_t<std::is_floating_point<T>::value, T> dot(T x, T y)
+  {
+    return x * y;
+  }
+
+  template<typename T, std::size_t N>
+  T dot(const vector<T, N>& x, const vector<T, N>& y)
+  {
+    T result = T();
+
+    for(std::size_t i = 0U; i < N; ++i)
+    {
+      result += x[i] * y[i];
+    }
+
+    return result;
+  }
+
+  template<typename T>
+  std::enable_if_t<std::is_floating_point<T>::value, T> normalize(T x)
+  {
+    return x / std::abs(x);
+  }
+
+  template<typename T, std::size_t N>
+  vector<T, N> normalize(const vector<T, N>& x)
+  {
+    return x / std::sqrt(dot(x, x));
+  }
+
+  template<typename T>
+  std::enable_if_t<std::is_floating_point<T>::value, T> clamp(T x, T min, T max)
+  {
+    return (x < min) ? min : ((x > max) ? max : x);
+  }
+
+  template<typename T, std::size_t N>
+  vector<T, N> clamp(const vector<T, N>& x, const vector<T, N>& min, const vector<T, N>& max)
+  {
+    vector<T, N> result;
+
+    for(std::size_t i = 0U; i < N; ++i)
+    {
+      result[i] = clamp(x[i], min[i], max[i]);
+    }
+
+    return result;
+  }
+
+  template<typename T>
+  std::enable_if_t<std::is_floating_point<T>::value, T> lerp(T x, T y, T s)
+  {
+    return x + ((y - x) * s);
+  }
+
+  template<typename T, std::size_t N>
+  vector<T, N> lerp(const vector<T, N>& x, const vector<T, N>& y, T s)
+  {
+    return x + ((y - x) * s);
+  }
+
+  template<typename T>
+  std::enable_if_t<std::is_floating_point<T>::value, T> pow(T x, T y)
+  {
+    return std::pow(x, y);
+  }
+
+  template<typename T, std::size_t N>
+  vector<T, N> pow(const vector<T, N>& x, const vector<T, N>& y)
+  {
+    return apply(x, y, [](T l, T r) { return std::pow(l, r); });
+  }
+
+  // Linear algebraic multiplication, a vector is a row vector as the lhs operand and a column vector as the rhs operand
+  template<typename T, std::size_t M, std::size_t K, std::size_t N>
+  matrix<T, M, N> mul(const matrix<T, M, K>& lhs, const matrix<T, K, N>& rhs)
+  {
+    matrix<T, M, N> result(static_cast<T>(0));
+
+    for(std::size_t i = 0U; i < M; ++i)
+    {
+      for(std::size_t k = 0U; k < K; ++k)
+      {
+        result[i] += rhs[k] * lhs[i][k];
+      }
+    }
+
+    return result;
+  }
+
+  template<typename T, std::size_t K, std::size_t N>
+  vector<T, N> mul(const vector<T, K>& lhs, const matrix<T, K, N>& rhs)
+  {
+    vector<T, N> result(static_cast<T>(0));
+
+    for(std::size_t k = 0U; k < K; ++k)
+    {
+      result += rhs[k] * lhs[k];
+    }
+
+    return result;
+  }
+
+  template<typename T, std::size_t M, std::size_t K>
+  vector<T, M> mul(const matrix<T, M, K>& lhs, const vector<T, K>& rhs)
+  {
+    vector<T, M> result;
+
+    for(std::size_t i = 0U; i < M; ++i)
+    {
+      result[i] = dot(lhs[i], rhs);
+    }
+
+    return result;
+  }
+
+  template<typename T, std::size_t K>
+  T mul(const vector<T, K>& lhs, const vector<T, K>& rhs)
+  {
+    return dot(lhs, rhs);
+  }
+
+  // Element-wise comparison
+  template<typename T, std::size_t N, typename Fn>
+  vector<bool, N> compare(const vector<T, N>& lhs, const vector<T, N>& rhs, Fn fn)
+  {
+    vector<bool, N> result;
+
+    for(std::size_t i = 0U; i < N; ++i)
+    {
+      result[i] = fn(lhs[i], rhs[i]);
+    }
+
+    return result;
+  }
+
+  template<typename T, std::size_t N> vector<bool, N> equal(const vector<T, N>& lhs, const vector<T, N>& rhs)                 { return compare(lhs, rhs, [](T l, T r) { return l == r; }); }
+  template<typename T, std::size_t N> vector<bool, N> not_equal(const vector<T, N>& lhs, const vector<T, N>& rhs)             { return compare(lhs, rhs, [](T l, T r) { return l != r; }); }
+  template<typename T, std::size_t N> vector<bool, N> less_than(const vector<T, N>& lhs, const vector<T, N>& rhs)             { return compare(lhs, rhs, [](T l, T r) { return l < r; }); }
+  template<typename T, std::size_t N> vector<bool, N> less_than_equal(const vector<T, N>& lhs, const vector<T, N>& rhs)       { return compare(lhs, rhs, [](T l, T r) { return l <= r; }); }
+  template<typename T, std::size_t N> vector<bool, N> greater_than(const vector<T, N>& lhs, const vector<T, N>& rhs)          { return compare(lhs, rhs, [](T l, T r) { return l > r; }); }
+  template<typename T, std::size_t N> vector<bool, N> greater_than_equal(const vector<T, N>& lhs, const vector<T, N>& rhs)    { return compare(lhs, rhs, [](T l, T r) { return l >= r; }); }
+}
+}
+}
@@ -0,0 +1,682 @@
+#include "output_cpp.h"
+
+#include <syntax/block.h>
+#include <syntax/io_block.h>
+#include <syntax/reference.h>
+#include <syntax/operator.h>
+#include <syntax/operator_component_access.h>
+#include <syntax/constructor_call.h>
+#include <syntax/function_definition.h>
+#include <syntax/variable_declaration.h>
+#include <syntax/parameter_declaration.h>
+
+#include <output/language.h>
+#include <output/character.h>
+
+#include <type.h>
+
+#include <sstream>
+#include <algorithm>
+
+
+namespace
+{
+  namespace ns = sltl::cpp;
+
+  template<typename C>
+  std::basic_string<C> to_type_string(const sltl::language::type& t)
+  {
+    using namespace sltl;
+
+    std::basic_stringstream<C> ss;
+
+    const language::type_id id = t.get_id();
+    const language::type_dimensions& dimensions = t.get_dimensions();
+
+    if(dimensions.is_void())
+    {
+      assert(id == language::id_void);
+      assert(dimensions.m() == 0U);
+      assert(dimensions.n() == 0U);
+
+      ss << SLTL_TEXT(C, "void");
+    }
+    else
+    {
+      if(dimensions.is_vector())
+      {
+        ss << SLTL_TEXT(C, "vector<");
+      }
+      else if(dimensions.is_matrix())
+      {
+        ss << SLTL_TEXT(C, "matrix<");
+      }
+
+      switch(id)
+      {
+        case language::id_float:
+          ss << SLTL_TEXT(C, "float");
+          break;
+        case language::id_double:
+          ss << SLTL_TEXT(C, "double");
+          break;
+        case language::id_int:
+          ss << SLTL_TEXT(C, "int");
+          break;
+        case language::id_uint:
+          // A single keyword so that the type name can be used in a functional cast
+          ss << SLTL_TEXT(C, "unsigned");
+          break;
+        case language::id_bool:
+          ss << SLTL_TEXT(C, "bool");
+          break;
+        default:
+          assert((id != language::id_unknown) && (id != language::id_void));
+      }
+
+      if(dimensions.is_vector())
+      {
+        ss << SLTL_TEXT(C, ", ") << (is_row_vector(dimensions) ? dimensions.n() : dimensions.m()) << SLTL_TEXT(C, '>');
+      }
+      else if(dimensions.is_matrix())
+      {
+        ss << SLTL_TEXT(C, ", ") << dimensions.m() << SLTL_TEXT(C, ", ") << dimensions.n() << SLTL_TEXT(C, '>');
+      }
+    }
+
+    return ss.str();
+  }
+
+  template<typename C>
+  std::basic_string<C> to_type_string(const sltl::syntax::io_block& iob, sltl::core::shader_stage stage)
+  {
+    std::basic_stringstream<C> ss;
+
+    switch(stage)
+    {
+      case sltl::core::shader_stage::vertex:
+        ss << SLTL_TEXT(C, "vs_");
+        break;
+      case sltl::core::shader_stage::geometry:
+        ss << SLTL_TEXT(C, "gs_");
+        break;
+      case sltl::core::shader_stage::fragment:
+        ss << SLTL_TEXT(C, "fs_");
+        break;
+      default:
+        assert(stage == sltl::core::shader_stage::test);
+    }
+
+    switch(iob._qualifier)
+    {
+      case sltl::core::qualifier_storage::in:
+        ss << SLTL_TEXT(C, "input");
+        break;
+      case sltl::core::qualifier_storage::out:
+        ss << SLTL_TEXT(C, "output");
+        break;
+      case sltl::core::qualifier_storage::uniform:
+        ss << SLTL_TEXT(C, "uniform");
+        break;
+      default:
+        assert(iob._qualifier != sltl::core::qualifier_storage::none);
+    }
+
+    return ss.str();
+  }
+
+  template<typename C>
+  std::basic_string<C> to_type_prefix_string(const sltl::language::type& t)
+  {
+    using namespace sltl;
+
+    // Variable names can't begin with a numeral so we need a type specific prefix
+    const language::type_dimensions& dimensions = t.get_dimensions();
+
+    assert(t.get_id() != language::id_void);
+    assert(t.get_id() != language::id_unknown);
+
+    if(dimensions.is_vector())
+    {
+      return SLTL_TEXT(C, "v");
+    }
+    else if(dimensions.is_matrix())
+    {
+      return SLTL_TEXT(C, "m");
+    }
+
+    assert(dimensions.is_scalar());
+
+    switch(t.get_id())
+    {
+      case language::id_double:
+        return SLTL_TEXT(C, "d");
+      case language::id_int:
+        return SLTL_TEXT(C, "i");
+      case language::id_uint:
+        return SLTL_TEXT(C, "u");
+      case language::id_bool:
+        return SLTL_TEXT(C, "b");
+      default:
+        assert(t.get_id() == language::id_float);
+    }
+
+    return SLTL_TEXT(C, "f");
+  }
+
+  template<typename C>
+  const C* to_qualifier_prefix_string(sltl::core::qualifier_storage id)
+  {
+    switch(id)
+    {
+      case sltl::core::qualifier_storage::in:
+        return SLTL_TEXT(C, "in");
+      case sltl::core::qualifier_storage::out:
+        return SLTL_TEXT(C, "out");
+      case sltl::core::qualifier_storage::uniform:
+        return SLTL_TEXT(C, "cb");
+      default:
+        // A variable that isn't a member of an io_block has no prefix
+        assert(id == sltl::core::qualifier_storage::none);
+    }
+
+    return nullptr;
+  }
+
+  // The namespace containing the output of each shader stage, so that the output of several stages can be compiled together
+  template<typename C>
+  const C* to_namespace_string(sltl::core::shader_stage stage)
+  {
+    switch(stage)
+    {
+      case sltl::core::shader_stage::vertex:
+        return SLTL_TEXT(C, "vs");
+      case sltl::core::shader_stage::geometry:
+        return SLTL_TEXT(C, "gs");
+      case sltl::core::shader_stage::fragment:
+        return SLTL_TEXT(C, "fs");
+      default:
+        assert(stage == sltl::core::shader_stage::test);
+    }
+
+    return SLTL_TEXT(C, "test");
+  }
+
+  // The indices of the components read by a scalar or vector accessor, as template arguments
+  template<typename C>
+  std::basic_string<C> to_swizzle_string(const sltl::syntax::component_accessor& accessor)
+  {
+    using namespace sltl;
+
+    std::basic_stringstream<C> ss;
+
+    auto fn_write = [&ss](language::type_dimension_t idx)
+    {
+      if(ss.tellp() > 0)
+      {
+        ss << SLTL_TEXT(C, ", ");
+      }
+
+      ss << idx;
+    };
+
+    if(accessor._mode == syntax::component_accessor::mode::scalar)
+    {
+      for(language::type_dimension_t i = 0U; i < static_cast<const syntax::component_accessor_scalar&>(accessor)._count; ++i)
+      {
+        fn_write(0U);
+      }
+    }
+    else
+    {
+      const auto& accessor_vector = static_cast<const syntax::component_accessor_vector&>(accessor);
+      std::for_each(accessor_vector.begin(), std::find(accessor_vector.begin(), accessor_vector.end(), syntax::component_accessor::_idx_default), fn_write);
+    }
+
+    return ss.str();
+  }
+}
+
+template<typename C>
+ns::basic_output_cpp<C>::basic_output_cpp(sltl::core::shader_stage stage, sltl::detail::enum_flags<sltl::output_flags> flags) : basic_output<C>(stage, flags),
+  _block_in(nullptr),
+  _block_out(nullptr),
+  _block_uniform(nullptr)
+{
+  write_prelude();
+}
+
+template<typename C>
+ns::basic_output_cpp<C>::basic_output_cpp(sltl::core::shader_stage stage, sltl::basic_output_sink<C>& sink, sltl::detail::enum_flags<sltl::output_flags> flags) : basic_output<C>(stage, sink, flags),
+  _block_in(nullptr),
+  _block_out(nullptr),
+  _block_uniform(nullptr)
+{
+  write_prelude();
+}
+
+template<typename C>
+sltl::syntax::action_return_t ns::basic_output_cpp<C>::operator()(const sltl::syntax::io_block& iob, bool is_start)
+{
+  if(!iob.is_empty())
+  {
+    if(is_start)
+    {
+      if(_flags.template has_flag<output_flags::flag_extra_newlines>())
+      {
+        _os << get_newline();
+      }
+
+      // Store the pointers to the io_blocks for use later while processing the 'main' function definition
+      switch(iob._qualifier)
+      {
+        case core::qualifier_storage::in:
+          _block_in = &iob;
+          break;
+        case core::qualifier_storage::out:
+          _block_out = &iob;
+          break;
+        case core::qualifier_storage::uniform:
+          _block_uniform = &iob;
+          break;
+        default:
+          assert(iob._qualifier != core::qualifier_storage::none);
+      }
+
+      _os << get_indent(indent_t::current);
+      _os << to_keyword_string<C>(language::id_struct) << SLTL_TEXT(C, ' ') << ::to_type_string<C>(iob, _stage);
+      _os << get_newline();
+
+      _os << get_indent(indent_t::increase);
+      basic_output<C>::operator()(language::bracket_tag<language::id_brace>(), true);
+      _os << get_newline();
+    }
+    else
+    {
+      _os << get_indent(indent_t::decrease);
+      basic_output<C>::operator()(language::bracket_tag<language::id_brace>(), false);
+      _os << get_terminal_newline();
+    }
+  }
+
+  return is_start ? syntax::action_return_t::step_in :
+                    syntax::action_return_t::step_out;
+}
+
+template<typename C>
+sltl::syntax::action_return_t ns::basic_output_cpp<C>::operator()(const sltl::syntax::parameter_declaration& pd)
+{
+  // The 'out' and 'inout' parameters are passed by reference
+  _os << get_type_name(pd.get_type()) << ((pd._qualifier == core::qualifier_param::in) ? SLTL_TEXT(C, " ") : SLTL_TEXT(C, "& ")) << get_parameter_name(pd);
+
+  return syntax::action_return_t::step_out;
+}
+
+template<typename C>
+sltl::syntax::action_return_t ns::basic_output_cpp<C>::operator()(const sltl::syntax::reference& r)
+{
+  if(auto vd = syntax::declaration_cast<const syntax::variable_declaration>(&r._declaration))
+  {
+    // Prefix input, output and uniform variables with the name of their struct parameter (followed by a period)
+    if(auto prefix = ::to_qualifier_prefix_string<C>(vd->_qualifier))
+    {
+      _os << prefix << SLTL_TEXT(C, '.');
+    }
+  }
+
+  return basic_output<C>::operator()(r);
+}
+
+template<typename C>
+sltl::syntax::action_return_t ns::basic_output_cpp<C>::operator()(const sltl::syntax::variable_declaration& vd, bool is_start)
+{
+  if(is_start)
+  {
+    _os << get_indent(indent_t::current);
+    _os << get_type_name(vd.get_type()) << SLTL_TEXT(C, ' ') << get_variable_name(vd);
+
+    if(vd.has_initializer())
+    {
+      _os << SLTL_TEXT(C, " = ");
+    }
+    else if(vd._qualifier == core::qualifier_storage::none)
+    {
+      // Local variables without an initializer are value-initialized (i.e. zero)
+      _os << SLTL_TEXT(C, "{}");
+    }
+  }
+  else
+  {
+    _os << get_terminal_newline();
+  }
+
+  return is_start ? syntax::action_return_t::step_in :
+                    syntax::action_return_t::step_out;
+}
+
+template<typename C>
+sltl::syntax::action_return_t ns::basic_output_cpp<C>::operator()(const sltl::syntax::operator_unary& ou, bool is_start)
+{
+  if(is_start)
+  {
+    set_assignable(ou._operand.get());
+  }
+
+  return basic_output<C>::operator()(ou, is_start);
+}
+
+template<typename C>
+sltl::syntax::action_return_t ns::basic_output_cpp<C>::operator()(const sltl::syntax::operator_binary& ob, bool is_start)
+{
+  if(is_start && language::is_operator_assignment(ob._operator_id))
+  {
+    set_assignable(ob._operand_lhs.get());
+  }
+
+  return basic_output<C>::operator()(ob, is_start);
+}
+
+template<typename C>
+sltl::syntax::action_return_t ns::basic_output_cpp<C>::operator()(const sltl::syntax::operator_component_access& oca, bool is_start)
+{
+  const syntax::component_accessor& accessor = *oca._accessor;
+  const bool is_assignable = (_assignable.count(&oca) != 0U);
+
+  if(accessor._mode == syntax::component_accessor::mode::matrix)
+  {
+    const auto& accessor_matrix = static_cast<const syntax::component_accessor_matrix&>(accessor);
+
+    if(accessor_matrix._idx_m == syntax::component_accessor::_idx_default)
+    {
+      // A column is copied to (or from) a vector as the matrix is stored as an array of rows
+      if(is_start)
+      {
+        _os << (is_assignable ? SLTL_TEXT(C, "column_ref<") : SLTL_TEXT(C, "column<")) << accessor_matrix._idx_n << SLTL_TEXT(C, ">(");
+      }
+      else
+      {
+        _os << SLTL_TEXT(C, ')');
+      }
+    }
+    else if(!is_start)
+    {
+      _os << SLTL_TEXT(C, '[') << accessor_matrix._idx_m << SLTL_TEXT(C, ']');
+
+      if(accessor_matrix._idx_n != syntax::component_accessor::_idx_default)
+      {
+        _os << SLTL_TEXT(C, '[') << accessor_matrix._idx_n << SLTL_TEXT(C, ']');
+      }
+    }
+  }
+  else
+  {
+    if(is_start)
+    {
+      _os << (is_assignable ? SLTL_TEXT(C, "swizzle_ref<") : SLTL_TEXT(C, "swizzle<")) << ::to_swizzle_string<C>(accessor) << SLTL_TEXT(C, ">(");
+    }
+    else
+    {
+      _os << SLTL_TEXT(C, ')');
+    }
+  }
+
+  if(!is_start)
+  {
+    _assignable.erase(&oca);
+  }
+
+  return is_start ? syntax::action_return_t::step_in :
+                    syntax::action_return_t::step_out;
+}
+
+template<typename C>
+sltl::syntax::action_return_t ns::basic_output_cpp<C>::operator()(const sltl::syntax::constructor_call& cc, bool is_start)
+{
+  const language::type type = cc.get_type();
+
+  // Vectors and matrices are list-initialized so that the arguments are evaluated in order (as they are in the shader)
+  if(type.get_dimensions().is_scalar())
+  {
+    return basic_output<C>::operator()(cc, is_start);
+  }
+
+  if(is_start)
+  {
+    _os << get_type_name(type);
+  }
+
+  basic_output<C>::operator()(language::bracket_tag<language::id_brace>(), is_start);
+
+  return is_start ? syntax::action_return_t::step_in :
+                    syntax::action_return_t::step_out;
+}
+
+template<typename C>
+sltl::syntax::action_return_t ns::basic_output_cpp<C>::operator()(const sltl::syntax::function_definition& fd, bool is_start)
+{
+  syntax::action_return_t return_val;
+
+  if((fd._name == L"main") && is_start)
+  {
+    if(_flags.template has_flag<output_flags::flag_extra_newlines>())
+    {
+      _os << get_newline();
+    }
+
+    assert(fd.get_type() == language::type_helper<void>());
+    assert(fd.get_params().size() == 0U);
+
+    // Replace the main function's empty parameter list with a reference to each io_block
+    _os << get_indent(indent_t::current);
+    _os << get_type_name(language::type_helper<void>()) << SLTL_TEXT(C, " invoke(");
+
+    const C* separator = SLTL_TEXT(C, "");
+
+    for(const syntax::io_block* iob : { _block_in, _block_out, _block_uniform })
+    {
+      if(iob)
+      {
+        const C* qualifier = ((iob == _block_out) ? SLTL_TEXT(C, "") : SLTL_TEXT(C, "const "));
+
+        _os << separator << qualifier << ::to_type_string<C>(*iob, _stage) << SLTL_TEXT(C, "& ") << ::to_qualifier_prefix_string<C>(iob->_qualifier);
+        separator = SLTL_TEXT(C, ", ");
+      }
+    }
+
+    _os << SLTL_TEXT(C, ')') << get_newline();
+
+    const bool is_continuing = fd.get_body().apply_action(*this);
+
+    if(is_continuing)
+    {
+      write_dispatch();
+    }
+
+    // The 'success' return value is 'step_over' as all child nodes have already been traversed
+    return_val = (is_continuing ?
+      syntax::action_return_t::step_over :
+      syntax::action_return_t::stop);
+  }
+  else
+  {
+    return_val = basic_output<C>::operator()(fd, is_start);
+  }
+
+  return return_val;
+}
+
+template<typename C>
+void ns::basic_output_cpp<C>::set_assignable(const syntax::expression* exp)
+{
+  // The operand of an assignable component access must also be assignable
+  while(auto oca = syntax::node_cast<const syntax::operator_component_access>(exp))
+  {
+    _assignable.insert(oca);
+    exp = oca->_operand.get();
+  }
+}
+
+template<typename C>
+void ns::basic_output_cpp<C>::write_prelude()
+{
+  _os << SLTL_TEXT(C, "#include \"output/cpp/cpp_math.h\"") << get_newline();
+
+  if(_flags.template has_flag<output_flags::flag_extra_newlines>())
+  {
+    _os << get_newline();
+  }
+
+  _os << SLTL_TEXT(C, "namespace ") << ::to_namespace_string<C>(_stage) << get_newline();
+  _os << SLTL_TEXT(C, '{') << get_newline();
+  _os << SLTL_TEXT(C, "using namespace sltl::cpp::math;") << get_newline();
+}
+
+template<typename C>
+void ns::basic_output_cpp<C>::write_dispatch()
+{
+  if(_flags.template has_flag<output_flags::flag_extra_newlines>())
+  {
+    _os << get_newline();
+  }
+
+  // The io_block arrays are indexed by invocation, the uniform block is shared by every invocation
+  std::basic_stringstream<C> ss_params;
+  std::basic_stringstream<C> ss_args;
+
+  for(const syntax::io_block* iob : { _block_in, _block_out, _block_uniform })
+  {
+    if(iob)
+    {
+      const C* name = ::to_qualifier_prefix_string<C>(iob->_qualifier);
+
+      ss_params << ((iob == _block_out) ? SLTL_TEXT(C, "") : SLTL_TEXT(C, "const ")) << ::to_type_string<C>(*iob, _stage);
+
+      if(iob == _block_uniform)
+      {
+        ss_params << SLTL_TEXT(C, "& ") << name << SLTL_TEXT(C, ", ");
+        ss_args << name << SLTL_TEXT(C, ", ");
+      }
+      else
+      {
+        ss_params << SLTL_TEXT(C, "* ") << name << SLTL_TEXT(C, ", ");
+        ss_args << name << SLTL_TEXT(C, "[i], ");
+      }
+    }
+  }
+
+  ss_params << SLTL_TEXT(C, "std::size_t count");
+
+  string_type args = ss_args.str();
+
+  if(!args.empty())
+  {
+    args.resize(args.size() - 2U);
+  }
+
+  _os << get_indent(indent_t::current);
+  _os << get_type_name(language::type_helper<void>()) << SLTL_TEXT(C, " dispatch(") << ss_params.str() << SLTL_TEXT(C, ')') << get_newline();
+
+  _os << get_indent(indent_t::increase);
+  basic_output<C>::operator()(language::bracket_tag<language::id_brace>(), true);
+  _os << get_newline();
+
+  _os << get_indent(indent_t::current);
+  _os << SLTL_TEXT(C, "for(std::size_t i = 0U; i < count; ++i)") << get_newline();
+
+  _os << get_indent(indent_t::increase);
+  basic_output<C>::operator()(language::bracket_tag<language::id_brace>(), true);
+  _os << get_newline();
+
+  _os << get_indent(indent_t::current);
+  _os << SLTL_TEXT(C, "invoke(") << args << SLTL_TEXT(C, ')') << get_terminal_newline();
+
+  _os << get_indent(indent_t::decrease);
+  basic_output<C>::operator()(language::bracket_tag<language::id_brace>(), false);
+  _os << get_newline();
+
+  _os << get_indent(indent_t::decrease);
+  basic_output<C>::operator()(language::bracket_tag<language::id_brace>(), false);
+  _os << get_newline();
+
+  // Close the namespace opened by write_prelude
+  _os << SLTL_TEXT(C, '}') << get_newline();
+}
+
+template<typename C>
+typename ns::basic_output_cpp<C>::string_type ns::basic_output_cpp<C>::get_type_name(const sltl::language::type& type) const
+{
+  return ::to_type_string<C>(_flags.template has_flag<output_flags::flag_transpose_type>() ? type.transpose() : type);
+}
+
+template<typename C>
+typename ns::basic_output_cpp<C>::string_type ns::basic_output_cpp<C>::get_variable_name(const sltl::syntax::variable_declaration& vd) const
+{
+  std::basic_stringstream<C> ss;
+
+  ss << ::to_type_prefix_string<C>(vd.get_type());
+  ss << sltl::detail::to_basic_string<C>(vd._name);
+
+  return ss.str();
+}
+
+template<typename C>
+typename ns::basic_output_cpp<C>::string_type ns::basic_output_cpp<C>::get_parameter_name(const sltl::syntax::parameter_declaration& pd) const
+{
+  std::basic_stringstream<C> ss;
+
+  ss << SLTL_TEXT(C, "p_");
+  ss << ::to_type_prefix_string<C>(pd.get_type());
+  ss << sltl::detail::to_basic_string<C>(pd._name);
+
+  return ss.str();
+}
+
+template<typename C>
+const C* ns::basic_output_cpp<C>::to_intrinsic_string(sltl::core::intrinsic intrinsic) const
+{
+  switch(intrinsic)
+  {
+    case core::intrinsic::dot:
+      return SLTL_TEXT(C, "dot");
+    case core::intrinsic::normalize:
+      return SLTL_TEXT(C, "normalize");
+    case core::intrinsic::clamp:
+      return SLTL_TEXT(C, "clamp");
+    case core::intrinsic::lerp:
+      return SLTL_TEXT(C, "lerp");
+    case core::intrinsic::pow:
+      return SLTL_TEXT(C, "pow");
+  }
+
+  return nullptr;
+}
+
+template<typename C>
+const C* ns::basic_output_cpp<C>::to_intrinsic_operator_string(const sltl::syntax::operator_binary& ob) const
+{
+  switch(ob._operator_id)
+  {
+    case language::id_element_wise_eq:
+      return SLTL_TEXT(C, "equal");
+    case language::id_element_wise_ne:
+      return SLTL_TEXT(C, "not_equal");
+    case language::id_element_wise_lt:
+      return SLTL_TEXT(C, "less_than");
+    case language::id_element_wise_lt_eq:
+      return SLTL_TEXT(C, "less_than_equal");
+    case language::id_element_wise_gt:
+      return SLTL_TEXT(C, "greater_than");
+    case language::id_element_wise_gt_eq:
+      return SLTL_TEXT(C, "greater_than_equal");
+    case language::id_matrix_multiplication:
+      return SLTL_TEXT(C, "mul");
+    default:
+      // The remaining operators aren't output as a call to an intrinsic function
+      break;
+  }
+
+  return nullptr;
+}
+
+template class ns::basic_output_cpp<char>;
+template class ns::basic_output_cpp<wchar_t>;
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <output/output.h>
+
+#include <unordered_set>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // Forward declarations - sltl::syntax namespace
+  class expression;
+}
+
+namespace cpp
+{
+  // Outputs a shader as C++ source, using the types and functions declared in cpp_math.h. The io blocks become structs
+  // and the 'main' function becomes 'invoke', which runs a single invocation, followed by 'dispatch', which runs 'invoke'
+  // for each element of the input and output arrays. The output includes cpp_math.h (relative to the sltl source
+  // directory) and is contained in a namespace named after the shader stage (vs, gs, fs or test), which is closed
+  // after 'dispatch' so only the output of a shader with a 'main' function is complete.
+  template<typename C>
+  class basic_output_cpp : public basic_output<C>
+  {
+  public:
+    typedef typename basic_output<C>::string_type string_type;
+
+    basic_output_cpp(basic_output_cpp&&) = default;
+    basic_output_cpp(core::shader_stage stage, detail::enum_flags<output_flags> flags = output_flags::flag_none);
+    basic_output_cpp(core::shader_stage stage, basic_output_sink<C>& sink, detail::enum_flags<output_flags> flags = output_flags::flag_none);
+
+    // Non-copyable and non-assignable
+    basic_output_cpp(const basic_output_cpp&) = delete;
+    basic_output_cpp& operator=(basic_output_cpp&&) = delete;
+    basic_output_cpp& operator=(const basic_output_cpp&) = delete;
+
+    using basic_output<C>::operator();
+
+    syntax::action_return_t operator()(const syntax::io_block& iob, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::parameter_declaration& pd) override;
+    syntax::action_return_t operator()(const syntax::reference& r) override;
+    syntax::action_return_t operator()(const syntax::variable_declaration& vd, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::operator_unary& ou, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::operator_binary& ob, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::operator_component_access& oca, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::constructor_call& cc, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::function_definition& fd, bool is_start = true) override;
+
+  protected:
+    string_type get_type_name(const language::type& type) const override;
+    string_type get_variable_name(const syntax::variable_declaration& vd) const override;
+    string_type get_parameter_name(const syntax::parameter_declaration& pd) const override;
+
+    const C* to_intrinsic_string(core::intrinsic intrinsic) const override;
+    const C* to_intrinsic_operator_string(const syntax::operator_binary& ob) const override;
+
+    // Members of the dependent base class
+    using basic_output<C>::_os;
+    using basic_output<C>::_flags;
+    using basic_output<C>::_stage;
+    using basic_output<C>::get_indent;
+    using basic_output<C>::get_newline;
+    using basic_output<C>::get_terminal_newline;
+
+    typedef typename basic_output<C>::indent_t indent_t;
+
+  private:
+    // Component access is output as a call to swizzle (or column), which returns a copy of the components, unless it is
+    // the operand of an assignment or increment where the call is to swizzle_ref (or column_ref) instead
+    void set_assignable(const syntax::expression* exp);
+
+    void write_prelude();
+    void write_dispatch();
+
+    const syntax::io_block* _block_in;
+    const syntax::io_block* _block_out;
+    const syntax::io_block* _block_uniform;
+
+    std::unordered_set<const syntax::operator_component_access*> _assignable;
+  };
+
+  typedef basic_output_cpp<wchar_t> output_cpp;
+  typedef basic_output_cpp<char>    output_cpp_narrow;
+}
+}
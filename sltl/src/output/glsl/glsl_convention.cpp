@@ -1,6 +1,8 @@
 #include "glsl_convention.h"
 #include "glsl_language.h"
 
+#include <output/character.h>
+
 #include <syntax/variable_declaration.h>
 
 #include <type.h>
@@ -15,10 +17,11 @@ namespace
   namespace ns = sltl::glsl;
 }
 
-std::wstring ns::to_type_prefix_string(const sltl::language::type& t)
+template<typename C>
+std::basic_string<C> ns::to_type_prefix_string(const sltl::language::type& t)
 {
   // Variable names can't begin with a numeral so we need a type specific prefix
-  std::wstring prefix_string;
+  std::basic_string<C> prefix_string;
 
   const language::type_id id = t.get_id();
   const language::type_dimensions& dimensions = t.get_dimensions();
@@ -28,19 +31,19 @@ std::wstring ns::to_type_prefix_string(const sltl::language::type& t)
     switch(id)
     {
       case language::id_float:
-        prefix_string = L'f';
+        prefix_string = SLTL_TEXT(C, 'f');
         break;
       case language::id_double:
-        prefix_string = L'd';
+        prefix_string = SLTL_TEXT(C, 'd');
         break;
       case language::id_int:
-        prefix_string = L'i';
+        prefix_string = SLTL_TEXT(C, 'i');
         break;
       case language::id_uint:
-        prefix_string = L'u';
+        prefix_string = SLTL_TEXT(C, 'u');
         break;
       case language::id_bool:
-        prefix_string = L'b';
+        prefix_string = SLTL_TEXT(C, 'b');
         break;
       default:
         assert((id != language::id_unknown) && (id != language::id_void));
@@ -51,14 +54,14 @@ std::wstring ns::to_type_prefix_string(const sltl::language::type& t)
     assert(id != language::id_void);
     assert(id != language::id_unknown);
 
-    prefix_string = L'v';
+    prefix_string = SLTL_TEXT(C, 'v');
   }
   else if(dimensions.is_matrix())
   {
     assert((id == language::id_float) ||
            (id == language::id_double));
 
-    prefix_string = L'm';
+    prefix_string = SLTL_TEXT(C, 'm');
   }
   else
   {
@@ -68,52 +71,65 @@ std::wstring ns::to_type_prefix_string(const sltl::language::type& t)
   return prefix_string;
 }
 
-const wchar_t* ns::to_qualifier_prefix_string(sltl::core::qualifier_storage id)
+template<typename C>
+const C* ns::to_qualifier_prefix_string(sltl::core::qualifier_storage id)
 {
   switch(id)
   {
   case sltl::core::qualifier_storage::in:
-    return L"i";
+    return SLTL_TEXT(C, "i");
   case sltl::core::qualifier_storage::out:
-    return L"o";
+    return SLTL_TEXT(C, "o");
   case sltl::core::qualifier_storage::uniform:
-    return L"u";
+    return SLTL_TEXT(C, "u");
   }
 
   return nullptr;
 }
 
-const wchar_t* ns::to_parameter_prefix_string(sltl::core::qualifier_param id)
+template<typename C>
+const C* ns::to_parameter_prefix_string(sltl::core::qualifier_param id)
 {
   switch(id)
   {
     case sltl::core::qualifier_param::in:
     case sltl::core::qualifier_param::inout:
     case sltl::core::qualifier_param::out:
-      return L"p";
+      return SLTL_TEXT(C, "p");
   }
 
   return nullptr;
 }
 
-std::wstring ns::get_variable_name(const sltl::syntax::variable_declaration& vd)
+template<typename C>
+std::basic_string<C> ns::get_variable_name(const sltl::syntax::variable_declaration& vd)
 {
-  std::wstringstream ss;
+  std::basic_stringstream<C> ss;
 
   if(is_variable_built_in(vd))
   {
-    ss << to_built_in_string(vd);
+    ss << to_built_in_string<C>(vd);
   }
   else
   {
     // Prepend the storage qualifier to the variable name to ensure it is globally unique
-    if(auto qualifier = to_qualifier_prefix_string(vd._qualifier))
+    if(auto qualifier = to_qualifier_prefix_string<C>(vd._qualifier))
     {
-      ss << qualifier << L'_';
+      ss << qualifier << SLTL_TEXT(C, '_');
     }
 
-    ss << to_type_prefix_string(vd.get_type()) << vd._name;
+    ss << to_type_prefix_string<C>(vd.get_type()) << sltl::detail::to_basic_string<C>(vd._name);
   }
 
   return ss.str();
 }
+
+// Explicit instantiations for the narrow and wide character types
+#define SLTL_GLSL_CONVENTION_INSTANTIATE(C) \
+  template std::basic_string<C> ns::to_type_prefix_string<C>(const sltl::language::type&); \
+  template const C* ns::to_qualifier_prefix_string<C>(sltl::core::qualifier_storage); \
+  template const C* ns::to_parameter_prefix_string<C>(sltl::core::qualifier_param); \
+  template std::basic_string<C> ns::get_variable_name<C>(const sltl::syntax::variable_declaration&);
+
+SLTL_GLSL_CONVENTION_INSTANTIATE(char)
+SLTL_GLSL_CONVENTION_INSTANTIATE(wchar_t)
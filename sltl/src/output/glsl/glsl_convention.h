@@ -21,11 +21,16 @@ namespace sltl
 
 namespace glsl
 {
-  std::wstring to_type_prefix_string(const language::type& t);
+  template<typename C = wchar_t>
+  std::basic_string<C> to_type_prefix_string(const language::type& t);
 
-  const wchar_t* to_qualifier_prefix_string(core::qualifier_storage id);
-  const wchar_t* to_parameter_prefix_string(core::qualifier_param id);
+  template<typename C = wchar_t>
+  const C* to_qualifier_prefix_string(core::qualifier_storage id);
 
-  std::wstring get_variable_name(const syntax::variable_declaration& vd);
+  template<typename C = wchar_t>
+  const C* to_parameter_prefix_string(core::qualifier_param id);
+
+  template<typename C = wchar_t>
+  std::basic_string<C> get_variable_name(const syntax::variable_declaration& vd);
 }
 }
@@ -1,5 +1,7 @@
 #include "glsl_language.h"
 
+#include <output/character.h>
+
 #include <syntax/variable_declaration.h>
 
 #include <sstream>
@@ -39,9 +41,10 @@ bool ns::is_variable_built_in(const sltl::syntax::variable_declaration& vd)
   return is_variable_built_in(vd._semantic, vd._semantic_index);
 }
 
-std::wstring ns::to_type_string(const sltl::language::type& t)
+template<typename C>
+std::basic_string<C> ns::to_type_string(const sltl::language::type& t)
 {
-  std::wstringstream ss;
+  std::basic_stringstream<C> ss;
 
   const language::type_id id = t.get_id();
   const language::type_dimensions& dimensions = t.get_dimensions();
@@ -52,26 +55,26 @@ std::wstring ns::to_type_string(const sltl::language::type& t)
     assert(dimensions.m() == 0U);
     assert(dimensions.n() == 0U);
 
-    ss << L"void";
+    ss << SLTL_TEXT(C, "void");
   }
   else if(dimensions.is_scalar())
   {
     switch(id)
     {
       case language::id_float:
-        ss << L"float";
+        ss << SLTL_TEXT(C, "float");
         break;
       case language::id_double:
-        ss << L"double";
+        ss << SLTL_TEXT(C, "double");
         break;
       case language::id_int:
-        ss << L"int";
+        ss << SLTL_TEXT(C, "int");
         break;
       case language::id_uint:
-        ss << L"unsigned int";
+        ss << SLTL_TEXT(C, "unsigned int");
         break;
       case language::id_bool:
-        ss << L"bool";
+        ss << SLTL_TEXT(C, "bool");
         break;
       default:
         assert((id != language::id_unknown) && (id != language::id_void));
@@ -82,19 +85,19 @@ std::wstring ns::to_type_string(const sltl::language::type& t)
     switch(id)
     {
       case language::id_float:
-        ss << L"vec";
+        ss << SLTL_TEXT(C, "vec");
         break;
       case language::id_double:
-        ss << L"dvec";
+        ss << SLTL_TEXT(C, "dvec");
         break;
       case language::id_int:
-        ss << L"ivec";
+        ss << SLTL_TEXT(C, "ivec");
         break;
       case language::id_uint:
-        ss << L"uvec";
+        ss << SLTL_TEXT(C, "uvec");
         break;
       case language::id_bool:
-        ss << L"bvec";
+        ss << SLTL_TEXT(C, "bvec");
         break;
       default:
         assert((id != language::id_unknown) && (id != language::id_void));
@@ -107,17 +110,17 @@ std::wstring ns::to_type_string(const sltl::language::type& t)
     switch(id)
     {
       case language::id_float:
-        ss << L"mat";
+        ss << SLTL_TEXT(C, "mat");
         break;
       case language::id_double:
-        ss << L"dmat";
+        ss << SLTL_TEXT(C, "dmat");
         break;
       default:
         assert((id == language::id_float) || (id == language::id_double));
     }
 
     // GLSL has column-major matrices so always output 'nxm'
-    ss << dimensions.n() << L'x' << dimensions.m();
+    ss << dimensions.n() << SLTL_TEXT(C, 'x') << dimensions.m();
   }
   else
   {
@@ -127,7 +130,8 @@ std::wstring ns::to_type_string(const sltl::language::type& t)
   return ss.str();
 }
 
-std::wstring ns::to_built_in_string(sltl::core::semantic semantic, sltl::core::semantic_index_t semantic_index)
+template<typename C>
+std::basic_string<C> ns::to_built_in_string(sltl::core::semantic semantic, sltl::core::semantic_index_t semantic_index)
 {
   assert(is_variable_built_in(semantic, semantic_index));
 
@@ -135,7 +139,7 @@ std::wstring ns::to_built_in_string(sltl::core::semantic semantic, sltl::core::s
 
   //TODO: validation that the built-in is of the correct type and used in the correct shader stage
 
-  std::wstringstream ss;
+  std::basic_stringstream<C> ss;
 
   switch(semantic_system_pair.first)
   {
@@ -143,12 +147,12 @@ std::wstring ns::to_built_in_string(sltl::core::semantic semantic, sltl::core::s
     //TODO: if the variable is vertex shader output then this is gl_Position
     //TODO: if the variable is pixel shader input then this is gl_FragCoord
     //TODO: note that index must be zero for position semantic
-    ss << L"gl_Position";
+    ss << SLTL_TEXT(C, "gl_Position");
     break;
   case core::semantic_system::depth:
     //TODO: only valid as a fragment shader output
     //TODO: note that index must be zero for depth semantic
-    ss << L"gl_FragDepth";
+    ss << SLTL_TEXT(C, "gl_FragDepth");
     break;
   }
 
@@ -157,28 +161,40 @@ std::wstring ns::to_built_in_string(sltl::core::semantic semantic, sltl::core::s
 
   if(semantic_system_pair.second > 0)
   {
-    ss << L'[' << semantic_system_pair.second << L']';
+    ss << SLTL_TEXT(C, '[') << semantic_system_pair.second << SLTL_TEXT(C, ']');
   }
 
   return ss.str();
 }
 
-std::wstring ns::to_built_in_string(const sltl::syntax::variable_declaration& vd)
+template<typename C>
+std::basic_string<C> ns::to_built_in_string(const sltl::syntax::variable_declaration& vd)
 {
-  return to_built_in_string(vd._semantic, vd._semantic_index);
+  return to_built_in_string<C>(vd._semantic, vd._semantic_index);
 }
 
-const wchar_t* ns::to_qualifier_string(sltl::core::qualifier_storage id)
+template<typename C>
+const C* ns::to_qualifier_string(sltl::core::qualifier_storage id)
 {
   switch(id)
   {
   case sltl::core::qualifier_storage::in:
-    return L"in";
+    return SLTL_TEXT(C, "in");
   case sltl::core::qualifier_storage::out:
-    return L"out";
+    return SLTL_TEXT(C, "out");
   case sltl::core::qualifier_storage::uniform:
-    return L"uniform";
+    return SLTL_TEXT(C, "uniform");
   }
 
   return nullptr;
 }
+
+// Explicit instantiations for the narrow and wide character types
+#define SLTL_GLSL_LANGUAGE_INSTANTIATE(C) \
+  template std::basic_string<C> ns::to_type_string<C>(const sltl::language::type&); \
+  template std::basic_string<C> ns::to_built_in_string<C>(sltl::core::semantic, sltl::core::semantic_index_t); \
+  template std::basic_string<C> ns::to_built_in_string<C>(const sltl::syntax::variable_declaration&); \
+  template const C* ns::to_qualifier_string<C>(sltl::core::qualifier_storage);
+
+SLTL_GLSL_LANGUAGE_INSTANTIATE(char)
+SLTL_GLSL_LANGUAGE_INSTANTIATE(wchar_t)
@@ -25,11 +25,16 @@ namespace glsl
   bool is_variable_built_in(core::semantic semantic, core::semantic_index_t semantic_index);
   bool is_variable_built_in(const syntax::variable_declaration& vd);
 
-  std::wstring to_type_string(const language::type& t);
+  template<typename C = wchar_t>
+  std::basic_string<C> to_type_string(const language::type& t);
 
-  std::wstring to_built_in_string(core::semantic semantic, core::semantic_index_t semantic_index);
-  std::wstring to_built_in_string(const syntax::variable_declaration& vd);
+  template<typename C = wchar_t>
+  std::basic_string<C> to_built_in_string(core::semantic semantic, core::semantic_index_t semantic_index);
 
-  const wchar_t* to_qualifier_string(core::qualifier_storage id);
+  template<typename C = wchar_t>
+  std::basic_string<C> to_built_in_string(const syntax::variable_declaration& vd);
+
+  template<typename C = wchar_t>
+  const C* to_qualifier_string(core::qualifier_storage id);
 }
 }
@@ -11,12 +11,16 @@
 
 #include <core/qualifier.h>
 
+#include <output/character.h>
+
+#include <sstream>
+
 
 namespace
 {
   namespace ns = sltl::glsl;
 
-  bool is_variable_omitted(const sltl::syntax::variable_declaration& vd, ns::output_glsl::layout_manager& layout_manager)
+  bool is_variable_omitted(const sltl::syntax::variable_declaration& vd, ns::layout_manager& layout_manager)
   {
     if(vd._qualifier != sltl::core::qualifier_storage::none)
     {
@@ -44,27 +48,28 @@ namespace
     return false;
   }
 
-  bool is_layout_flag_valid(const sltl::syntax::variable_declaration& vd, ns::output_glsl::layout_flags flag)
+  bool is_layout_flag_valid(const sltl::syntax::variable_declaration& vd, ns::layout_flags flag)
   {
     switch(vd._qualifier)
     {
       case sltl::core::qualifier_storage::in:
-        return (flag == ns::output_glsl::layout_flags::flag_in);
+        return (flag == ns::layout_flags::flag_in);
       case sltl::core::qualifier_storage::out:
-        return (flag == ns::output_glsl::layout_flags::flag_out);
+        return (flag == ns::layout_flags::flag_out);
       case sltl::core::qualifier_storage::uniform:
-        return (flag == ns::output_glsl::layout_flags::flag_uniform);
+        return (flag == ns::layout_flags::flag_uniform);
       default:
         return false;
     }
   }
 
-  const wchar_t* to_version_string(ns::output_version version)
+  template<typename C>
+  const C* to_version_string(ns::output_version version)
   {
     switch(version)
     {
       case ns::output_version::v330:
-        return L"#version 330";
+        return SLTL_TEXT(C, "#version 330");
       default:
         assert(version == ns::output_version::none);
     }
@@ -72,9 +77,10 @@ namespace
     return nullptr;
   }
 
-  std::wstring get_qualifier_layout(const sltl::syntax::variable_declaration& vd, ns::output_glsl::layout_manager& layout_manager)
+  template<typename C>
+  std::basic_string<C> get_qualifier_layout(const sltl::syntax::variable_declaration& vd, ns::layout_manager& layout_manager)
   {
-    std::wstringstream ss;
+    std::basic_stringstream<C> ss;
 
     if(vd._semantic != sltl::core::semantic::none)
     {
@@ -84,9 +90,9 @@ namespace
       {
         const auto result = layout_map.insert(vd);
 
-        ss << L"layout(location = ";
+        ss << SLTL_TEXT(C, "layout(location = ");
         ss << result.first;
-        ss << L')';
+        ss << SLTL_TEXT(C, ')');
 
         assert(result.second);
       }
@@ -95,31 +101,32 @@ namespace
     return ss.str();
   }
 
-  const wchar_t* get_qualifier_storage(const sltl::syntax::variable_declaration& vd)
+  template<typename C>
+  const C* get_qualifier_storage(const sltl::syntax::variable_declaration& vd)
   {
     if(ns::is_variable_built_in(vd))
     {
       throw std::exception();//TODO: exception type and message
     }
 
-    return ns::to_qualifier_string(vd._qualifier);
+    return ns::to_qualifier_string<C>(vd._qualifier);
   }
 
-  sltl::detail::enum_flags<ns::output_glsl::layout_flags> get_default_layout_flags(sltl::core::shader_stage stage)
+  sltl::detail::enum_flags<ns::layout_flags> get_default_layout_flags(sltl::core::shader_stage stage)
   {
-    sltl::detail::enum_flags<ns::output_glsl::layout_flags> flags = ns::output_glsl::layout_flags::flag_none;
+    sltl::detail::enum_flags<ns::layout_flags> flags = ns::layout_flags::flag_none;
 
     switch(stage)
     {
       case sltl::core::shader_stage::vertex:
-        flags = ns::output_glsl::layout_flags::flag_out;
+        flags = ns::layout_flags::flag_out;
         break;
       case sltl::core::shader_stage::geometry:
-        flags = ns::output_glsl::layout_flags::flag_out |
-                ns::output_glsl::layout_flags::flag_in;
+        flags = ns::layout_flags::flag_out |
+                ns::layout_flags::flag_in;
         break;
       case sltl::core::shader_stage::fragment:
-        flags = ns::output_glsl::layout_flags::flag_in;
+        flags = ns::layout_flags::flag_in;
         break;
       default:
         assert(stage == sltl::core::shader_stage::test);
@@ -130,21 +137,41 @@ namespace
   }
 }
 
-// output_glsl definitions
+// basic_output_glsl definitions
+
+template<typename C>
+ns::basic_output_glsl<C>::basic_output_glsl(sltl::core::shader_stage stage, output_version version, sltl::detail::enum_flags<sltl::output_flags> flags) : basic_output_glsl(stage, layout_manager(get_default_layout_flags(stage)), version, flags)
+{
+}
+
+template<typename C>
+ns::basic_output_glsl<C>::basic_output_glsl(sltl::core::shader_stage stage, layout_manager&& manager, output_version version, sltl::detail::enum_flags<sltl::output_flags> flags) : basic_output<C>(stage, flags), _layout_manager(std::move(manager))
+{
+  write_version(version);
+}
+
+template<typename C>
+ns::basic_output_glsl<C>::basic_output_glsl(sltl::core::shader_stage stage, sltl::basic_output_sink<C>& sink, output_version version, sltl::detail::enum_flags<sltl::output_flags> flags) : basic_output_glsl(stage, sink, layout_manager(get_default_layout_flags(stage)), version, flags)
+{
+}
 
-ns::output_glsl::output_glsl(sltl::core::shader_stage stage, output_version version, sltl::detail::enum_flags<sltl::output_flags> flags) : output_glsl(stage, layout_manager(get_default_layout_flags(stage)), version, flags)
+template<typename C>
+ns::basic_output_glsl<C>::basic_output_glsl(sltl::core::shader_stage stage, sltl::basic_output_sink<C>& sink, layout_manager&& manager, output_version version, sltl::detail::enum_flags<sltl::output_flags> flags) : basic_output<C>(stage, sink, flags), _layout_manager(std::move(manager))
 {
+  write_version(version);
 }
 
-ns::output_glsl::output_glsl(sltl::core::shader_stage stage, layout_manager&& manager, output_version version, sltl::detail::enum_flags<sltl::output_flags> flags) : output(stage, flags), _layout_manager(std::move(manager))
+template<typename C>
+void ns::basic_output_glsl<C>::write_version(output_version version)
 {
-  if(const auto v_str = to_version_string(version))
+  if(const auto v_str = to_version_string<C>(version))
   {
-    _ss << v_str << std::endl;
+    _os << v_str << get_newline();
   }
 }
 
-sltl::syntax::action_return_t ns::output_glsl::operator()(const sltl::syntax::variable_declaration& vd, bool is_start)
+template<typename C>
+sltl::syntax::action_return_t ns::basic_output_glsl<C>::operator()(const sltl::syntax::variable_declaration& vd, bool is_start)
 {
   syntax::action_return_t return_val;
 
@@ -152,26 +179,26 @@ sltl::syntax::action_return_t ns::output_glsl::operator()(const sltl::syntax::va
   {
     if(!is_variable_omitted(vd, _layout_manager))
     {
-      _ss << get_indent(indent_t::current);
+      _os << get_indent(indent_t::current);
 
-      const auto qualifier_layout = get_qualifier_layout(vd, _layout_manager);
-      const auto qualifier_storage = get_qualifier_storage(vd);
+      const auto qualifier_layout = get_qualifier_layout<C>(vd, _layout_manager);
+      const auto qualifier_storage = get_qualifier_storage<C>(vd);
 
       if(!qualifier_layout.empty())
       {
-        _ss << qualifier_layout << L' ';
+        _os << qualifier_layout << SLTL_TEXT(C, ' ');
       }
 
       if(qualifier_storage)
       {
-        _ss << qualifier_storage << L' ';
+        _os << qualifier_storage << SLTL_TEXT(C, ' ');
       }
 
-      _ss << get_type_name(vd.get_type()) << L' ' << get_variable_name(vd);
+      _os << get_type_name(vd.get_type()) << SLTL_TEXT(C, ' ') << get_variable_name(vd);
 
       if(vd.has_initializer())
       {
-        _ss << L" = ";
+        _os << SLTL_TEXT(C, " = ");
       }
 
       return_val = syntax::action_return_t::step_in;
@@ -185,7 +212,7 @@ sltl::syntax::action_return_t ns::output_glsl::operator()(const sltl::syntax::va
   {
     if(!is_variable_omitted(vd, _layout_manager))
     {
-      _ss << get_terminal_newline();
+      _os << get_terminal_newline();
     }
 
     return_val = syntax::action_return_t::step_out;
@@ -194,47 +221,52 @@ sltl::syntax::action_return_t ns::output_glsl::operator()(const sltl::syntax::va
   return return_val;
 }
 
-std::wstring ns::output_glsl::get_type_name(const sltl::language::type& type) const
+template<typename C>
+typename ns::basic_output_glsl<C>::string_type ns::basic_output_glsl<C>::get_type_name(const sltl::language::type& type) const
 {
-  return to_type_string(_flags.has_flag<output_flags::flag_transpose_type>() ? type.transpose() : type);
+  return to_type_string<C>(_flags.template has_flag<output_flags::flag_transpose_type>() ? type.transpose() : type);
 }
 
-std::wstring ns::output_glsl::get_variable_name(const sltl::syntax::variable_declaration& vd) const
+template<typename C>
+typename ns::basic_output_glsl<C>::string_type ns::basic_output_glsl<C>::get_variable_name(const sltl::syntax::variable_declaration& vd) const
 {
-  return sltl::glsl::get_variable_name(vd);
+  return sltl::glsl::get_variable_name<C>(vd);
 }
 
-std::wstring ns::output_glsl::get_parameter_name(const sltl::syntax::parameter_declaration& pd) const
+template<typename C>
+typename ns::basic_output_glsl<C>::string_type ns::basic_output_glsl<C>::get_parameter_name(const sltl::syntax::parameter_declaration& pd) const
 {
-  std::wstringstream ss(to_parameter_prefix_string(pd._qualifier), std::ios::in | std::ios::out | std::ios::ate);
+  std::basic_stringstream<C> ss(to_parameter_prefix_string<C>(pd._qualifier), std::ios::in | std::ios::out | std::ios::ate);
 
-  ss << L'_';
-  ss << to_type_prefix_string(pd.get_type());
-  ss << pd._name;
+  ss << SLTL_TEXT(C, '_');
+  ss << to_type_prefix_string<C>(pd.get_type());
+  ss << sltl::detail::to_basic_string<C>(pd._name);
 
   return ss.str();
 }
 
-const wchar_t* ns::output_glsl::to_intrinsic_string(sltl::core::intrinsic intrinsic) const
+template<typename C>
+const C* ns::basic_output_glsl<C>::to_intrinsic_string(sltl::core::intrinsic intrinsic) const
 {
   switch(intrinsic)
   {
     case core::intrinsic::dot:
-      return L"dot";
+      return SLTL_TEXT(C, "dot");
     case core::intrinsic::normalize:
-      return L"normalize";
+      return SLTL_TEXT(C, "normalize");
     case core::intrinsic::clamp:
-      return L"clamp";
+      return SLTL_TEXT(C, "clamp");
     case core::intrinsic::lerp:
-      return L"mix";
+      return SLTL_TEXT(C, "mix");
     case core::intrinsic::pow:
-      return L"pow";
+      return SLTL_TEXT(C, "pow");
   }
 
   return nullptr;
 }
 
-const wchar_t* ns::output_glsl::to_intrinsic_operator_string(const sltl::syntax::operator_binary& ob) const
+template<typename C>
+const C* ns::basic_output_glsl<C>::to_intrinsic_operator_string(const sltl::syntax::operator_binary& ob) const
 {
   const language::type& t = ob.get_type();
   const language::type_id t_id = t.get_id();
@@ -243,62 +275,62 @@ const wchar_t* ns::output_glsl::to_intrinsic_operator_string(const sltl::syntax:
   {
     case language::id_element_wise_eq:
       assert(t.get_dimensions().is_vector());
-      return L"equal";
+      return SLTL_TEXT(C, "equal");
     case language::id_element_wise_ne:
       assert(t.get_dimensions().is_vector());
-      return L"notEqual";
+      return SLTL_TEXT(C, "notEqual");
     case language::id_element_wise_lt:
       assert(t.get_dimensions().is_vector());
       assert(t_id != language::id_bool);
-      return L"lessThan";
+      return SLTL_TEXT(C, "lessThan");
     case language::id_element_wise_lt_eq:
       assert(t.get_dimensions().is_vector());
       assert(t_id != language::id_bool);
-      return L"lessThanEqual";
+      return SLTL_TEXT(C, "lessThanEqual");
     case language::id_element_wise_gt:
       assert(t.get_dimensions().is_vector());
       assert(t_id != language::id_bool);
-      return L"greaterThan";
+      return SLTL_TEXT(C, "greaterThan");
     case language::id_element_wise_gt_eq:
       assert(t.get_dimensions().is_vector());
       assert(t_id != language::id_bool);
-      return L"greaterThanEqual";
+      return SLTL_TEXT(C, "greaterThanEqual");
     case language::id_element_wise_multiplication:
-      return t.get_dimensions().is_matrix() ? L"matrixCompMult" : nullptr;
+      return t.get_dimensions().is_matrix() ? SLTL_TEXT(C, "matrixCompMult") : static_cast<const C*>(nullptr);
   }
 
   return nullptr;
 }
 
-// output_glsl::layout_map_key definitions
+// layout_map_key definitions
 
-ns::output_glsl::layout_map_key::layout_map_key(const sltl::syntax::variable_declaration& vd) : _s(vd._semantic), _idx(vd._semantic_index)
+ns::layout_map_key::layout_map_key(const sltl::syntax::variable_declaration& vd) : _s(vd._semantic), _idx(vd._semantic_index)
 {
   assert(vd._qualifier == core::qualifier_storage::in ||
          vd._qualifier == core::qualifier_storage::out ||
          vd._qualifier == core::qualifier_storage::uniform);
 }
 
-ns::output_glsl::layout_map_key::layout_map_key(const layout_map_key& key) : _s(key._s), _idx(key._idx)
+ns::layout_map_key::layout_map_key(const layout_map_key& key) : _s(key._s), _idx(key._idx)
 {
 }
 
-bool ns::output_glsl::layout_map_key::operator<(const ns::output_glsl::layout_map_key& rhs) const
+bool ns::layout_map_key::operator<(const ns::layout_map_key& rhs) const
 {
   return ((_s < rhs._s) || (!(rhs._s < _s) && (_idx < rhs._idx)));
 }
 
-// output_glsl::layout_map definitions
+// layout_map definitions
 
-ns::output_glsl::layout_map::layout_map(layout_flags flag) : _flag(flag), _location_next(0U)
+ns::layout_map::layout_map(layout_flags flag) : _flag(flag), _location_next(0U)
 {
 }
 
-ns::output_glsl::layout_map::layout_map(layout_map&& map) : _flag(map._flag), _location_next(map._location_next), _location_map(std::move(map._location_map))
+ns::layout_map::layout_map(layout_map&& map) : _flag(map._flag), _location_next(map._location_next), _location_map(std::move(map._location_map))
 {
 }
 
-std::pair<ns::output_glsl::layout_index_t, bool> ns::output_glsl::layout_map::insert(const sltl::syntax::variable_declaration& vd)
+std::pair<ns::layout_index_t, bool> ns::layout_map::insert(const sltl::syntax::variable_declaration& vd)
 {
   // Ensure the storage qualifier matches the map's flag and that the semantic isn't 'none'
   if(!is_layout_flag_valid(vd, _flag) || (vd._semantic == core::semantic::none))
@@ -318,12 +350,12 @@ std::pair<ns::output_glsl::layout_index_t, bool> ns::output_glsl::layout_map::in
   return std::make_pair(result.first->second, result.second);
 }
 
-bool ns::output_glsl::layout_map::is_layout_enabled() const
+bool ns::layout_map::is_layout_enabled() const
 {
   return (_flag != layout_flags::flag_none);
 }
 
-bool ns::output_glsl::layout_map::is_layout_qualified(const sltl::syntax::variable_declaration& vd) const
+bool ns::layout_map::is_layout_qualified(const sltl::syntax::variable_declaration& vd) const
 {
   // Ensure the storage qualifier matches the map's flag and that the semantic isn't 'none'
   if(!is_layout_flag_valid(vd, _flag) || (vd._semantic == core::semantic::none))
@@ -334,12 +366,12 @@ bool ns::output_glsl::layout_map::is_layout_qualified(const sltl::syntax::variab
   return (_location_map.find(layout_map_key(vd)) != _location_map.end());
 }
 
-void ns::output_glsl::layout_map::set_location_next(layout_index_t location)
+void ns::layout_map::set_location_next(layout_index_t location)
 {
   _location_next = location;
 }
 
-ns::output_glsl::layout_index_t ns::output_glsl::layout_map::get_location(const sltl::syntax::variable_declaration& vd) const
+ns::layout_index_t ns::layout_map::get_location(const sltl::syntax::variable_declaration& vd) const
 {
   // Ensure the storage qualifier matches the map's flag and that the semantic isn't 'none'
   if(!is_layout_flag_valid(vd, _flag) || (vd._semantic == core::semantic::none))
@@ -351,7 +383,7 @@ ns::output_glsl::layout_index_t ns::output_glsl::layout_map::get_location(const
   return _location_map.at(layout_map_key(vd));
 }
 
-ns::output_glsl::layout_index_t ns::output_glsl::layout_map::get_location_next(const sltl::syntax::variable_declaration& vd) const
+ns::layout_index_t ns::layout_map::get_location_next(const sltl::syntax::variable_declaration& vd) const
 {
   // Ensure the storage qualifier matches the map's flag
   if(!is_layout_flag_valid(vd, _flag))
@@ -391,23 +423,23 @@ ns::output_glsl::layout_index_t ns::output_glsl::layout_map::get_location_next(c
   return _location_next + ((((id == language::id_double) && (d1 > 2U)) ? 2U : 1U) * d2);
 }
 
-// output::layout_manager definitions
+// layout_manager definitions
 
-ns::output_glsl::layout_manager::layout_manager(sltl::detail::enum_flags<layout_flags> flags) :
+ns::layout_manager::layout_manager(sltl::detail::enum_flags<layout_flags> flags) :
   _layout_in(flags.has_flag<layout_flags::flag_in>() ? layout_flags::flag_in : layout_flags::flag_none),
   _layout_out(flags.has_flag<layout_flags::flag_out>() ? layout_flags::flag_out : layout_flags::flag_none),
   _layout_uniform(flags.has_flag<layout_flags::flag_uniform>() ? layout_flags::flag_uniform : layout_flags::flag_none)
 {
 }
 
-ns::output_glsl::layout_manager::layout_manager(layout_manager&& manager) :
+ns::layout_manager::layout_manager(layout_manager&& manager) :
   _layout_in(std::move(manager._layout_in)),
   _layout_out(std::move(manager._layout_out)),
   _layout_uniform(std::move(manager._layout_uniform))
 {
 }
 
-ns::output_glsl::layout_map& ns::output_glsl::layout_manager::get_layout_map(const sltl::syntax::variable_declaration& vd)
+ns::layout_map& ns::layout_manager::get_layout_map(const sltl::syntax::variable_declaration& vd)
 {
   switch(vd._qualifier)
   {
@@ -427,12 +459,15 @@ ns::output_glsl::layout_map& ns::output_glsl::layout_manager::get_layout_map(con
 
 // non-member definitions
 
-sltl::detail::enum_flags<ns::output_glsl::layout_flags> ns::operator|(sltl::detail::enum_flags<output_glsl::layout_flags> lhs, ns::output_glsl::layout_flags rhs)
+sltl::detail::enum_flags<ns::layout_flags> ns::operator|(sltl::detail::enum_flags<layout_flags> lhs, ns::layout_flags rhs)
 {
   return lhs |= rhs;
 }
 
-sltl::detail::enum_flags<ns::output_glsl::layout_flags> ns::operator&(sltl::detail::enum_flags<output_glsl::layout_flags> lhs, ns::output_glsl::layout_flags rhs)
+sltl::detail::enum_flags<ns::layout_flags> ns::operator&(sltl::detail::enum_flags<layout_flags> lhs, ns::layout_flags rhs)
 {
   return lhs &= rhs;
 }
+
+template class ns::basic_output_glsl<char>;
+template class ns::basic_output_glsl<wchar_t>;
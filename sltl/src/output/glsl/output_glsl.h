@@ -18,110 +18,135 @@ namespace glsl
     v330
   };
 
-  class output_glsl : public output
+  enum class layout_flags : unsigned int
+  {
+    flag_none    = 0x0,
+    flag_in      = 0x1,
+    flag_out     = flag_in  << 1,
+    flag_uniform = flag_out << 1
+  };
+
+  typedef unsigned int layout_index_t;
+
+  class layout_map_key
+  {
+  public:
+    layout_map_key(const syntax::variable_declaration& vd);
+    layout_map_key(const layout_map_key& key);
+
+    // Non-assignable
+    layout_map_key& operator=(layout_map_key&&) = delete;
+    layout_map_key& operator=(const layout_map_key&) = delete;
+
+    bool operator<(const layout_map_key& rhs) const;
+
+  private:
+    const core::semantic _s;
+    const core::semantic_index_t _idx;
+  };
+
+  class layout_map
+  {
+  public:
+    layout_map(layout_flags flag);
+    layout_map(layout_map&& map);
+
+    // Non-copyable and non-assignable
+    layout_map(const layout_map&) = delete;
+    layout_map& operator=(layout_map&&) = delete;
+    layout_map& operator=(const layout_map&) = delete;
+
+    //TODO: if the map was pre-populated then a successful insertion shouldn't be possible - should throw in this situation
+    std::pair<layout_index_t, bool> insert(const syntax::variable_declaration& vd);
+
+    bool is_layout_enabled() const;
+    bool is_layout_qualified(const syntax::variable_declaration& vd) const;
+
+    void set_location_next(layout_index_t location);
+
+    layout_index_t get_location(const syntax::variable_declaration& vd) const;
+    layout_index_t get_location_next(const syntax::variable_declaration& vd) const;
+
+    const layout_flags _flag;
+
+  private:
+    layout_index_t _location_next;
+    std::map<layout_map_key, layout_index_t> _location_map;
+  };
+
+  class layout_manager
+  {
+  public:
+    //TODO: need a way to pre-populate layout_map(s) via io::block(s)
+    layout_manager(detail::enum_flags<layout_flags> flags);
+    layout_manager(layout_manager&& manager);
+
+    // Non-copyable and non-assignable
+    layout_manager(const layout_manager&) = delete;
+    layout_manager& operator=(layout_manager&&) = delete;
+    layout_manager& operator=(const layout_manager&) = delete;
+
+    layout_map& get_layout_map(const syntax::variable_declaration& vd);
+
+  private:
+    layout_map _layout_in;
+    layout_map _layout_out;
+    layout_map _layout_uniform;
+  };
+
+  template<typename C>
+  class basic_output_glsl : public basic_output<C>
   {
   public:
-    enum class layout_flags : unsigned int
-    {
-      flag_none    = 0x0,
-      flag_in      = 0x1,
-      flag_out     = flag_in  << 1,
-      flag_uniform = flag_out << 1
-    };
-
-    typedef unsigned int layout_index_t;
-
-    class layout_map_key
-    {
-    public:
-      layout_map_key(const syntax::variable_declaration& vd);
-      layout_map_key(const layout_map_key& key);
-
-      // Non-assignable
-      layout_map_key& operator=(layout_map_key&&) = delete;
-      layout_map_key& operator=(const layout_map_key&) = delete;
-
-      bool operator<(const layout_map_key& rhs) const;
-
-    private:
-      const core::semantic _s;
-      const core::semantic_index_t _idx;
-    };
-
-    class layout_map
-    {
-    public:
-      layout_map(layout_flags flag);
-      layout_map(layout_map&& map);
-
-      // Non-copyable and non-assignable
-      layout_map(const layout_map&) = delete;
-      layout_map& operator=(layout_map&&) = delete;
-      layout_map& operator=(const layout_map&) = delete;
-
-      //TODO: if the map was pre-populated then a successful insertion shouldn't be possible - should throw in this situation
-      std::pair<layout_index_t, bool> insert(const syntax::variable_declaration& vd);
-
-      bool is_layout_enabled() const;
-      bool is_layout_qualified(const syntax::variable_declaration& vd) const;
-
-      void set_location_next(layout_index_t location);
-
-      layout_index_t get_location(const syntax::variable_declaration& vd) const;
-      layout_index_t get_location_next(const syntax::variable_declaration& vd) const;
-
-      const layout_flags _flag;
-
-    private:
-      layout_index_t _location_next;
-      std::map<layout_map_key, layout_index_t> _location_map;
-    };
-
-    class layout_manager
-    {
-    public:
-      //TODO: need a way to pre-populate layout_map(s) via io::block(s)
-      layout_manager(detail::enum_flags<layout_flags> flags);
-      layout_manager(layout_manager&& manager);
-
-      // Non-copyable and non-assignable
-      layout_manager(const layout_manager&) = delete;
-      layout_manager& operator=(layout_manager&&) = delete;
-      layout_manager& operator=(const layout_manager&) = delete;
-
-      layout_map& get_layout_map(const syntax::variable_declaration& vd);
-
-    private:
-      layout_map _layout_in;
-      layout_map _layout_out;
-      layout_map _layout_uniform;
-    };
-
-    output_glsl(output_glsl&&) = default;
-    output_glsl(core::shader_stage stage, output_version version = output_version::v330, detail::enum_flags<output_flags> flags = output_flags::flag_none);
-    output_glsl(core::shader_stage stage, layout_manager&& manager, output_version version = output_version::v330, detail::enum_flags<output_flags> flags = output_flags::flag_none);
+    typedef glsl::layout_flags layout_flags;
+    typedef glsl::layout_index_t layout_index_t;
+    typedef glsl::layout_map_key layout_map_key;
+    typedef glsl::layout_map layout_map;
+    typedef glsl::layout_manager layout_manager;
+
+    typedef typename basic_output<C>::string_type string_type;
+
+    basic_output_glsl(basic_output_glsl&&) = default;
+    basic_output_glsl(core::shader_stage stage, output_version version = output_version::v330, detail::enum_flags<output_flags> flags = output_flags::flag_none);
+    basic_output_glsl(core::shader_stage stage, layout_manager&& manager, output_version version = output_version::v330, detail::enum_flags<output_flags> flags = output_flags::flag_none);
+    basic_output_glsl(core::shader_stage stage, basic_output_sink<C>& sink, output_version version = output_version::v330, detail::enum_flags<output_flags> flags = output_flags::flag_none);
+    basic_output_glsl(core::shader_stage stage, basic_output_sink<C>& sink, layout_manager&& manager, output_version version = output_version::v330, detail::enum_flags<output_flags> flags = output_flags::flag_none);
 
     // Non-copyable and non-assignable
-    output_glsl(const output_glsl&) = delete;
-    output_glsl& operator=(output_glsl&&) = delete;
-    output_glsl& operator=(const output_glsl&) = delete;
+    basic_output_glsl(const basic_output_glsl&) = delete;
+    basic_output_glsl& operator=(basic_output_glsl&&) = delete;
+    basic_output_glsl& operator=(const basic_output_glsl&) = delete;
 
     syntax::action_return_t operator()(const syntax::variable_declaration& vd, bool is_start = true) override;
 
   protected:
-    std::wstring get_type_name(const language::type& type) const override;
-    std::wstring get_variable_name(const syntax::variable_declaration& vd) const override;
-    std::wstring get_parameter_name(const syntax::parameter_declaration& pd) const override;
+    string_type get_type_name(const language::type& type) const override;
+    string_type get_variable_name(const syntax::variable_declaration& vd) const override;
+    string_type get_parameter_name(const syntax::parameter_declaration& pd) const override;
+
+    const C* to_intrinsic_string(core::intrinsic intrinsic) const override;
+    const C* to_intrinsic_operator_string(const syntax::operator_binary& ob) const override;
+
+    // Members of the dependent base class
+    using basic_output<C>::_os;
+    using basic_output<C>::_flags;
+    using basic_output<C>::get_indent;
+    using basic_output<C>::get_newline;
+    using basic_output<C>::get_terminal_newline;
 
-    const wchar_t* to_intrinsic_string(core::intrinsic intrinsic) const override;
-    const wchar_t* to_intrinsic_operator_string(const syntax::operator_binary& ob) const override;
+    typedef typename basic_output<C>::indent_t indent_t;
 
   private:
+    void write_version(output_version version);
+
     layout_manager _layout_manager;
   };
 
+  typedef basic_output_glsl<wchar_t> output_glsl;
+  typedef basic_output_glsl<char>    output_glsl_narrow;
+
   // Overloaded bitwise operators make the detail::enum_flags helper class more useful
-  detail::enum_flags<output_glsl::layout_flags> operator|(detail::enum_flags<output_glsl::layout_flags> lhs, output_glsl::layout_flags rhs);
-  detail::enum_flags<output_glsl::layout_flags> operator&(detail::enum_flags<output_glsl::layout_flags> lhs, output_glsl::layout_flags rhs);
+  detail::enum_flags<layout_flags> operator|(detail::enum_flags<layout_flags> lhs, layout_flags rhs);
+  detail::enum_flags<layout_flags> operator&(detail::enum_flags<layout_flags> lhs, layout_flags rhs);
 }
 }
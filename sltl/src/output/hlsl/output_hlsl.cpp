@@ -9,9 +9,12 @@
 #include <syntax/parameter_declaration.h>
 
 #include <output/language.h>
+#include <output/character.h>
 
 #include <type.h>
 
+#include <sstream>
+
 
 namespace
 {
@@ -44,7 +47,8 @@ namespace
     return is_system_value_semantic(vd._semantic, vd._semantic_index);
   }
 
-  std::wstring to_system_value_semantic_string(sltl::core::semantic semantic, sltl::core::semantic_index_t semantic_index)
+  template<typename C>
+  std::basic_string<C> to_system_value_semantic_string(sltl::core::semantic semantic, sltl::core::semantic_index_t semantic_index)
   {
     assert(is_system_value_semantic(semantic, semantic_index));
 
@@ -52,36 +56,38 @@ namespace
 
     //TODO: validation that the built-in is of the correct type and used in the correct shader stage
 
-    std::wstringstream ss;
+    std::basic_stringstream<C> ss;
 
-    ss << L"SV_";
+    ss << SLTL_TEXT(C, "SV_");
 
     switch(semantic_system_pair.first)
     {
     case sltl::core::semantic_system::position:
       //TODO: note that index must be zero for position semantic
-      ss << L"Position";
+      ss << SLTL_TEXT(C, "Position");
       break;
     case sltl::core::semantic_system::depth:
       //TODO: only valid as a fragment shader output
       //TODO: note that index must be zero for depth semantic
-      ss << L"Depth";
+      ss << SLTL_TEXT(C, "Depth");
       break;
     }
 
     return ss.str();
   }
 
-  std::wstring to_system_value_semantic_string(const sltl::syntax::variable_declaration& vd)
+  template<typename C>
+  std::basic_string<C> to_system_value_semantic_string(const sltl::syntax::variable_declaration& vd)
   {
-    return to_system_value_semantic_string(vd._semantic, vd._semantic_index);
+    return to_system_value_semantic_string<C>(vd._semantic, vd._semantic_index);
   }
 
-  std::wstring to_type_string(const sltl::language::type& t)
+  template<typename C>
+  std::basic_string<C> to_type_string(const sltl::language::type& t)
   {
     using namespace sltl;
 
-    std::wstringstream ss;
+    std::basic_stringstream<C> ss;
 
     const language::type_id id = t.get_id();
     const language::type_dimensions& dimensions = t.get_dimensions();
@@ -92,26 +98,26 @@ namespace
       assert(dimensions.m() == 0U);
       assert(dimensions.n() == 0U);
 
-      ss << L"void";
+      ss << SLTL_TEXT(C, "void");
     }
     else
     {
       switch(id)
       {
         case language::id_float:
-          ss << L"float";
+          ss << SLTL_TEXT(C, "float");
           break;
         case language::id_double:
-          ss << L"double";
+          ss << SLTL_TEXT(C, "double");
           break;
         case language::id_int:
-          ss << L"int";
+          ss << SLTL_TEXT(C, "int");
           break;
         case language::id_uint:
-          ss << L"uint";
+          ss << SLTL_TEXT(C, "uint");
           break;
         case language::id_bool:
-          ss << L"bool";
+          ss << SLTL_TEXT(C, "bool");
           break;
         default:
           assert((id != language::id_unknown) && (id != language::id_void));
@@ -125,33 +131,34 @@ namespace
       if(dimensions.is_matrix())
       {
         // HLSL has row-major matrices so always output 'mxn'
-        ss << dimensions.m() << L'x' << dimensions.n();
+        ss << dimensions.m() << SLTL_TEXT(C, 'x') << dimensions.n();
       }
     }
 
     return ss.str();
   }
 
-  std::wstring to_type_string(const sltl::syntax::io_block& iob, sltl::core::shader_stage stage)
+  template<typename C>
+  std::basic_string<C> to_type_string(const sltl::syntax::io_block& iob, sltl::core::shader_stage stage)
   {
-    std::wstringstream ss;
+    std::basic_stringstream<C> ss;
 
     if(iob._qualifier == sltl::core::qualifier_storage::uniform)
     {
-      ss << L"cb";
+      ss << SLTL_TEXT(C, "cb");
     }
     else
     {
       switch(stage)
       {
         case sltl::core::shader_stage::vertex:
-          ss << L"vs";
+          ss << SLTL_TEXT(C, "vs");
           break;
         case sltl::core::shader_stage::geometry:
-          ss << L"gs";
+          ss << SLTL_TEXT(C, "gs");
           break;
         case sltl::core::shader_stage::fragment:
-          ss << L"ps";
+          ss << SLTL_TEXT(C, "ps");
           break;
         default:
           assert(stage == sltl::core::shader_stage::test);
@@ -159,16 +166,16 @@ namespace
 
       if(stage != sltl::core::shader_stage::test)
       {
-        ss << L'_';
+        ss << SLTL_TEXT(C, '_');
       }
 
       switch(iob._qualifier)
       {
         case sltl::core::qualifier_storage::in:
-          ss << L"input";
+          ss << SLTL_TEXT(C, "input");
           break;
         case sltl::core::qualifier_storage::out:
-          ss << L"output";
+          ss << SLTL_TEXT(C, "output");
           break;
         default:
           assert((iob._qualifier != sltl::core::qualifier_storage::none) && (iob._qualifier != sltl::core::qualifier_storage::uniform));
@@ -178,12 +185,13 @@ namespace
     return ss.str();
   }
 
-  std::wstring to_type_prefix_string(const sltl::language::type& t)
+  template<typename C>
+  std::basic_string<C> to_type_prefix_string(const sltl::language::type& t)
   {
     using namespace sltl;
 
     // Variable names can't begin with a numeral so we need a type specific prefix
-    std::wstring prefix_string;
+    std::basic_string<C> prefix_string;
 
     const language::type_id id = t.get_id();
     const language::type_dimensions& dimensions = t.get_dimensions();
@@ -196,19 +204,19 @@ namespace
       switch(id)
       {
         case language::id_float:
-          prefix_string = L'f';
+          prefix_string = SLTL_TEXT(C, 'f');
           break;
         case language::id_double:
-          prefix_string = L'd';
+          prefix_string = SLTL_TEXT(C, 'd');
           break;
         case language::id_int:
-          prefix_string = L'i';
+          prefix_string = SLTL_TEXT(C, 'i');
           break;
         case language::id_uint:
-          prefix_string = L'u';
+          prefix_string = SLTL_TEXT(C, 'u');
           break;
         case language::id_bool:
-          prefix_string = L'b';
+          prefix_string = SLTL_TEXT(C, 'b');
           break;
         default:
           assert((id != language::id_unknown) && (id != language::id_void));
@@ -219,14 +227,14 @@ namespace
       assert(id != language::id_void);
       assert(id != language::id_unknown);
 
-      prefix_string = L'v';
+      prefix_string = SLTL_TEXT(C, 'v');
     }
     else if(dimensions.is_matrix())
     {
       assert(id != language::id_void);
       assert(id != language::id_unknown);
 
-      prefix_string = L'm';
+      prefix_string = SLTL_TEXT(C, 'm');
     }
     else
     {
@@ -236,98 +244,110 @@ namespace
     return prefix_string;
   }
 
-  const wchar_t* to_parameter_prefix_string(sltl::core::qualifier_param id)
+  template<typename C>
+  const C* to_parameter_prefix_string(sltl::core::qualifier_param id)
   {
     switch(id)
     {
       case sltl::core::qualifier_param::in:
       case sltl::core::qualifier_param::inout:
       case sltl::core::qualifier_param::out:
-        return L"p";
+        return SLTL_TEXT(C, "p");
     }
 
     return nullptr;
   }
 
-  const wchar_t* to_qualifier_prefix_string(sltl::core::qualifier_storage id)
+  template<typename C>
+  const C* to_qualifier_prefix_string(sltl::core::qualifier_storage id)
   {
     switch(id)
     {
     case sltl::core::qualifier_storage::in:
-      return L"in";
+      return SLTL_TEXT(C, "in");
     case sltl::core::qualifier_storage::out:
-      return L"out";
+      return SLTL_TEXT(C, "out");
     case sltl::core::qualifier_storage::uniform:
-      return L"cb";
+      return SLTL_TEXT(C, "cb");
     }
 
     return nullptr;
   }
 
-  std::wstring get_variable_name(const sltl::syntax::variable_declaration& vd)
+  template<typename C>
+  std::basic_string<C> get_variable_name(const sltl::syntax::variable_declaration& vd)
   {
-    std::wstringstream ss;
+    std::basic_stringstream<C> ss;
 
-    ss << ::to_type_prefix_string(vd.get_type());
-    ss << vd._name;
+    ss << ::to_type_prefix_string<C>(vd.get_type());
+    ss << sltl::detail::to_basic_string<C>(vd._name);
 
     return ss.str();
   }
 }
 
-ns::output_hlsl::output_hlsl(sltl::core::shader_stage stage, sltl::detail::enum_flags<sltl::output_flags> flags) : output(stage, flags),
+template<typename C>
+ns::basic_output_hlsl<C>::basic_output_hlsl(sltl::core::shader_stage stage, sltl::detail::enum_flags<sltl::output_flags> flags) : basic_output<C>(stage, flags),
   _block_in(nullptr),
   _block_out(nullptr)
 {
 }
 
-sltl::syntax::action_return_t ns::output_hlsl::operator()(const sltl::syntax::io_block& iob, bool is_start)
+template<typename C>
+ns::basic_output_hlsl<C>::basic_output_hlsl(sltl::core::shader_stage stage, sltl::basic_output_sink<C>& sink, sltl::detail::enum_flags<sltl::output_flags> flags) : basic_output<C>(stage, sink, flags),
+  _block_in(nullptr),
+  _block_out(nullptr)
+{
+}
+
+template<typename C>
+sltl::syntax::action_return_t ns::basic_output_hlsl<C>::operator()(const sltl::syntax::io_block& iob, bool is_start)
 {
   if(!iob.is_empty())
   {
     if(is_start)
     {
-      if(_flags.has_flag<output_flags::flag_extra_newlines>())
+      if(_flags.template has_flag<output_flags::flag_extra_newlines>())
       {
-        _ss << get_newline();
+        _os << get_newline();
       }
 
-      const wchar_t* keyword = nullptr;
+      const C* keyword = nullptr;
 
       // Store the pointers to the 'in' and 'out' io_blocks for use later while processing the 'main' function definition
       switch(iob._qualifier)
       {
         case core::qualifier_storage::in:
           _block_in = &iob;
-          keyword = to_keyword_string(language::id_struct);
+          keyword = to_keyword_string<C>(language::id_struct);
           break;
         case core::qualifier_storage::out:
           _block_out = &iob;
-          keyword = to_keyword_string(language::id_struct);
+          keyword = to_keyword_string<C>(language::id_struct);
           break;
         case core::qualifier_storage::uniform:
-          keyword = L"cbuffer";
+          keyword = SLTL_TEXT(C, "cbuffer");
           break;
         default:
           assert(iob._qualifier != core::qualifier_storage::none);
       }
 
       // Output the struct keyword followed by the type name
-      _ss << get_indent(indent_t::current);
-      _ss << keyword << L' ' << to_type_string(iob, _stage);
-      _ss << get_newline();
+      _os << get_indent(indent_t::current);
+      _os << keyword << SLTL_TEXT(C, ' ') << to_type_string<C>(iob, _stage);
+      _os << get_newline();
 
       // Output the opening brace
-      _ss << get_indent(indent_t::increase);
-      output::operator()(language::bracket_tag<language::id_brace>(), true);
-      _ss << get_newline();
+      _os << get_indent(indent_t::increase);
+      basic_output<C>::operator()(language::bracket_tag<language::id_brace>(), true);
+      _os << get_newline();
     }
     else
     {
       // Output the closing brace
-      _ss << get_indent(indent_t::decrease);
-      output::operator()(language::bracket_tag<language::id_brace>(), false);
-      _ss << get_terminal_newline();
+      _os << get_indent(indent_t::decrease);
+      basic_output<C>::operator()(language::bracket_tag<language::id_brace>(), false);
+      _os << get_terminal_newline();
     }
   }
 
@@ -335,54 +355,57 @@ sltl::syntax::action_return_t ns::output_hlsl::operator()(const sltl::syntax::io
                     syntax::action_return_t::step_out;
 }
 
-sltl::syntax::action_return_t ns::output_hlsl::operator()(const sltl::syntax::reference& r)
+template<typename C>
+sltl::syntax::action_return_t ns::basic_output_hlsl<C>::operator()(const sltl::syntax::reference& r)
 {
-  if(auto vd = dynamic_cast<const syntax::variable_declaration*>(&r._declaration))
+  if(auto vd = syntax::declaration_cast<const syntax::variable_declaration>(&r._declaration))
   {
     // Prefix input, output and uniform variables with a struct or cbuffer name (followed by a period)
-    if(auto prefix = ::to_qualifier_prefix_string(vd->_qualifier))
+    if(auto prefix = ::to_qualifier_prefix_string<C>(vd->_qualifier))
     {
-      _ss << prefix << L'.';
+      _os << prefix << SLTL_TEXT(C, '.');
     }
   }
 
-  return output::operator()(r);
+  return basic_output<C>::operator()(r);
 }
 
-sltl::syntax::action_return_t ns::output_hlsl::operator()(const sltl::syntax::variable_declaration& vd, bool is_start)
+template<typename C>
+sltl::syntax::action_return_t ns::basic_output_hlsl<C>::operator()(const sltl::syntax::variable_declaration& vd, bool is_start)
 {
   if(is_start)
   {
-    _ss << get_indent(indent_t::current);
-    _ss << get_type_name(vd.get_type()) << L' ' << get_variable_name(vd);
+    _os << get_indent(indent_t::current);
+    _os << get_type_name(vd.get_type()) << SLTL_TEXT(C, ' ') << get_variable_name(vd);
 
     if(::is_system_value_semantic(vd))
     {
-      _ss << L" : " << ::to_system_value_semantic_string(vd);
+      _os << SLTL_TEXT(C, " : ") << ::to_system_value_semantic_string<C>(vd);
     }
     else if(vd.has_initializer())
     {
-      _ss << L" = ";
+      _os << SLTL_TEXT(C, " = ");
     }
   }
   else
   {
-    _ss << get_terminal_newline();
+    _os << get_terminal_newline();
   }
 
   return is_start ? syntax::action_return_t::step_in :
                     syntax::action_return_t::step_out;
 }
 
-sltl::syntax::action_return_t ns::output_hlsl::operator()(const sltl::syntax::function_definition& fd, bool is_start)
+template<typename C>
+sltl::syntax::action_return_t ns::basic_output_hlsl<C>::operator()(const sltl::syntax::function_definition& fd, bool is_start)
 {
   syntax::action_return_t return_val;
 
   if((fd._name == L"main") && is_start)
   {
-    if(_flags.has_flag<output_flags::flag_extra_newlines>())
+    if(_flags.template has_flag<output_flags::flag_extra_newlines>())
     {
-      _ss << get_newline();
+      _os << get_newline();
     }
 
     assert(fd.get_type() == language::type_helper<void>());
@@ -390,44 +413,44 @@ sltl::syntax::action_return_t ns::output_hlsl::operator()(const sltl::syntax::fu
 
     const syntax::block& function_body = fd.get_body();
 
-    std::wstring block_out_type;
-    std::wstring block_out_name;
+    string_type block_out_type;
+    string_type block_out_name;
 
-    _ss << get_indent(indent_t::current);
+    _os << get_indent(indent_t::current);
 
     // Replace the main function's 'void' return type with the output io_block's type
     if(_block_out)
     {
-      block_out_type = ::to_type_string(*_block_out, _stage);
-      block_out_name = ::to_qualifier_prefix_string(_block_out->_qualifier);
+      block_out_type = ::to_type_string<C>(*_block_out, _stage);
+      block_out_name = ::to_qualifier_prefix_string<C>(_block_out->_qualifier);
 
-      _ss << block_out_type;
+      _os << block_out_type;
     }
     else
     {
-      _ss << get_type_name(language::type_helper<void>());
+      _os << get_type_name(language::type_helper<void>());
     }
 
-    _ss << L' ' << fd._name << L'(';
+    _os << SLTL_TEXT(C, ' ') << sltl::detail::to_basic_string<C>(fd._name) << SLTL_TEXT(C, '(');
 
     // Replace the main function's empty parameter list with an input io_block parameter
     if(_block_in)
     {
-      _ss << ::to_type_string(*_block_in, _stage) << L' ' << ::to_qualifier_prefix_string(_block_in->_qualifier);
+      _os << ::to_type_string<C>(*_block_in, _stage) << SLTL_TEXT(C, ' ') << ::to_qualifier_prefix_string<C>(_block_in->_qualifier);
     }
 
-    _ss << L')';
-    _ss << get_newline();
+    _os << SLTL_TEXT(C, ')');
+    _os << get_newline();
 
     // Output the function body's opening brace
-    syntax::action_return_t return_val_body_start = output::operator()(function_body, true);
+    syntax::action_return_t return_val_body_start = basic_output<C>::operator()(function_body, true);
 
     // Output a variable declaration statement for the output io_block
     if(_block_out)
     {
-      _ss << get_indent(indent_t::current);
-      _ss << block_out_type << L' ' << block_out_name;
-      _ss << get_terminal_newline();
+      _os << get_indent(indent_t::current);
+      _os << block_out_type << SLTL_TEXT(C, ' ') << block_out_name;
+      _os << get_terminal_newline();
     }
 
     auto it = function_body.begin();
@@ -445,13 +468,13 @@ sltl::syntax::action_return_t ns::output_hlsl::operator()(const sltl::syntax::fu
       // Output a return statement for the output io_block
       if(_block_out)
       {
-        _ss << get_indent(indent_t::current);
-        _ss << to_keyword_string(language::id_return) << L' ' << block_out_name;
-        _ss << get_terminal_newline();
+        _os << get_indent(indent_t::current);
+        _os << to_keyword_string<C>(language::id_return) << SLTL_TEXT(C, ' ') << block_out_name;
+        _os << get_terminal_newline();
       }
 
       // Output the function body's closing brace
-      syntax::action_return_t return_val_body_end = output::operator()(function_body, false);
+      syntax::action_return_t return_val_body_end = basic_output<C>::operator()(function_body, false);
 
       assert(return_val_body_start == syntax::action_return_t::step_in);
       assert(return_val_body_end   == syntax::action_return_t::step_out);
@@ -464,59 +487,67 @@ sltl::syntax::action_return_t ns::output_hlsl::operator()(const sltl::syntax::fu
   }
   else
   {
-    return_val = output::operator()(fd, is_start);
+    return_val = basic_output<C>::operator()(fd, is_start);
   }
 
   return return_val;
 }
 
-std::wstring ns::output_hlsl::get_type_name(const sltl::language::type& type) const
+template<typename C>
+typename ns::basic_output_hlsl<C>::string_type ns::basic_output_hlsl<C>::get_type_name(const sltl::language::type& type) const
 {
-  return ::to_type_string(_flags.has_flag<output_flags::flag_transpose_type>() ? type.transpose() : type);
+  return ::to_type_string<C>(_flags.template has_flag<output_flags::flag_transpose_type>() ? type.transpose() : type);
 }
 
-std::wstring ns::output_hlsl::get_variable_name(const sltl::syntax::variable_declaration& vd) const
+template<typename C>
+typename ns::basic_output_hlsl<C>::string_type ns::basic_output_hlsl<C>::get_variable_name(const sltl::syntax::variable_declaration& vd) const
 {
-  return ::get_variable_name(vd);
+  return ::get_variable_name<C>(vd);
 }
 
-std::wstring ns::output_hlsl::get_parameter_name(const sltl::syntax::parameter_declaration& pd) const
+template<typename C>
+typename ns::basic_output_hlsl<C>::string_type ns::basic_output_hlsl<C>::get_parameter_name(const sltl::syntax::parameter_declaration& pd) const
 {
-  std::wstringstream ss(::to_parameter_prefix_string(pd._qualifier), std::ios::in | std::ios::out | std::ios::ate);
+  std::basic_stringstream<C> ss(::to_parameter_prefix_string<C>(pd._qualifier), std::ios::in | std::ios::out | std::ios::ate);
 
-  ss << L'_';
-  ss << ::to_type_prefix_string(pd.get_type());
-  ss << pd._name;
+  ss << SLTL_TEXT(C, '_');
+  ss << ::to_type_prefix_string<C>(pd.get_type());
+  ss << sltl::detail::to_basic_string<C>(pd._name);
 
   return ss.str();
 }
 
-const wchar_t* ns::output_hlsl::to_intrinsic_string(sltl::core::intrinsic intrinsic) const
+template<typename C>
+const C* ns::basic_output_hlsl<C>::to_intrinsic_string(sltl::core::intrinsic intrinsic) const
 {
   switch(intrinsic)
   {
     case core::intrinsic::dot:
-      return L"dot";
+      return SLTL_TEXT(C, "dot");
     case core::intrinsic::normalize:
-      return L"normalize";
+      return SLTL_TEXT(C, "normalize");
     case core::intrinsic::clamp:
-      return L"clamp";
+      return SLTL_TEXT(C, "clamp");
     case core::intrinsic::lerp:
-      return L"lerp";
+      return SLTL_TEXT(C, "lerp");
     case core::intrinsic::pow:
-      return L"pow";
+      return SLTL_TEXT(C, "pow");
   }
 
   return nullptr;
 }
 
-const wchar_t* ns::output_hlsl::to_intrinsic_operator_string(const sltl::syntax::operator_binary& ob) const
+template<typename C>
+const C* ns::basic_output_hlsl<C>::to_intrinsic_operator_string(const sltl::syntax::operator_binary& ob) const
 {
   switch(ob._operator_id)
   {
     case language::id_matrix_multiplication:
-      return L"mul";
+      return SLTL_TEXT(C, "mul");
   }
 
   return nullptr;
 }
+
+template class ns::basic_output_hlsl<char>;
+template class ns::basic_output_hlsl<wchar_t>;
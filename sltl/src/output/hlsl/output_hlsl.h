@@ -7,16 +7,22 @@ namespace sltl
 {
 namespace hlsl
 {
-  class output_hlsl : public output
+  template<typename C>
+  class basic_output_hlsl : public basic_output<C>
   {
   public:
-    output_hlsl(output_hlsl&&) = default;
-    output_hlsl(core::shader_stage stage, detail::enum_flags<output_flags> flags = output_flags::flag_none);
+    typedef typename basic_output<C>::string_type string_type;
+
+    basic_output_hlsl(basic_output_hlsl&&) = default;
+    basic_output_hlsl(core::shader_stage stage, detail::enum_flags<output_flags> flags = output_flags::flag_none);
+    basic_output_hlsl(core::shader_stage stage, basic_output_sink<C>& sink, detail::enum_flags<output_flags> flags = output_flags::flag_none);
 
     // Non-copyable and non-assignable
-    output_hlsl(const output_hlsl&) = delete;
-    output_hlsl& operator=(output_hlsl&&) = delete;
-    output_hlsl& operator=(const output_hlsl&) = delete;
+    basic_output_hlsl(const basic_output_hlsl&) = delete;
+    basic_output_hlsl& operator=(basic_output_hlsl&&) = delete;
+    basic_output_hlsl& operator=(const basic_output_hlsl&) = delete;
+
+    using basic_output<C>::operator();
 
     syntax::action_return_t operator()(const syntax::io_block& iob, bool is_start = true) override;
     syntax::action_return_t operator()(const syntax::reference& r) override;
@@ -24,16 +30,29 @@ namespace hlsl
     syntax::action_return_t operator()(const syntax::function_definition& fd, bool is_start = true) override;
 
   protected:
-    std::wstring get_type_name(const language::type& type) const override;
-    std::wstring get_variable_name(const syntax::variable_declaration& vd) const override;
-    std::wstring get_parameter_name(const syntax::parameter_declaration& pd) const override;
+    string_type get_type_name(const language::type& type) const override;
+    string_type get_variable_name(const syntax::variable_declaration& vd) const override;
+    string_type get_parameter_name(const syntax::parameter_declaration& pd) const override;
+
+    const C* to_intrinsic_string(core::intrinsic intrinsic) const override;
+    const C* to_intrinsic_operator_string(const syntax::operator_binary& ob) const override;
 
-    const wchar_t* to_intrinsic_string(core::intrinsic intrinsic) const override;
-    const wchar_t* to_intrinsic_operator_string(const syntax::operator_binary& ob) const override;
+    // Members of the dependent base class
+    using basic_output<C>::_os;
+    using basic_output<C>::_flags;
+    using basic_output<C>::_stage;
+    using basic_output<C>::get_indent;
+    using basic_output<C>::get_newline;
+    using basic_output<C>::get_terminal_newline;
+
+    typedef typename basic_output<C>::indent_t indent_t;
 
   private:
     const syntax::io_block* _block_in;
     const syntax::io_block* _block_out;
   };
+
+  typedef basic_output_hlsl<wchar_t> output_hlsl;
+  typedef basic_output_hlsl<char>    output_hlsl_narrow;
 }
 }
@@ -1,4 +1,5 @@
 #include "language.h"
+#include "character.h"
 
 
 namespace
@@ -6,123 +7,139 @@ namespace
   namespace ns = sltl;
 }
 
-const wchar_t* ns::to_operator_unary_string(language::operator_unary_id id)
+template<typename C>
+const C* ns::to_operator_unary_string(language::operator_unary_id id)
 {
   switch(id)
   {
   case language::id_increment_pre:
   case language::id_increment_post:
-    return L"++";
+    return SLTL_TEXT(C, "++");
    case language::id_decrement_pre:
    case language::id_decrement_post:
-    return L"--";
+    return SLTL_TEXT(C, "--");
   }
 
   return nullptr;
 }
 
-const wchar_t* ns::to_operator_binary_string(language::operator_binary_id id)
+template<typename C>
+const C* ns::to_operator_binary_string(language::operator_binary_id id)
 {
   switch(id)
   {
     case language::id_addition:
-      return L"+";
+      return SLTL_TEXT(C, "+");
     case language::id_subtraction:
-      return L"-";
+      return SLTL_TEXT(C, "-");
     case language::id_multiplication:
-      return L"*";
+      return SLTL_TEXT(C, "*");
     case language::id_division:
-      return L"/";
+      return SLTL_TEXT(C, "/");
     case language::id_element_wise_addition:
-      return L"+";
+      return SLTL_TEXT(C, "+");
     case language::id_element_wise_subtraction:
-      return L"-";
+      return SLTL_TEXT(C, "-");
     case language::id_element_wise_multiplication:
-      return L"*";
+      return SLTL_TEXT(C, "*");
     case language::id_element_wise_division:
-      return L"/";
+      return SLTL_TEXT(C, "/");
     case language::id_assignment:
-      return L"=";
+      return SLTL_TEXT(C, "=");
     case language::id_assignment_addition:
-      return L"+=";
+      return SLTL_TEXT(C, "+=");
     case language::id_assignment_subtraction:
-      return L"-=";
+      return SLTL_TEXT(C, "-=");
     case language::id_assignment_multiplication:
-      return L"*=";
+      return SLTL_TEXT(C, "*=");
     case language::id_assignment_division:
-      return L"/=";
+      return SLTL_TEXT(C, "/=");
     case language::id_lt:
-      return L"<";
+      return SLTL_TEXT(C, "<");
     case language::id_lt_eq:
-      return L"<=";
+      return SLTL_TEXT(C, "<=");
     case language::id_gt:
-      return L">";
+      return SLTL_TEXT(C, ">");
     case language::id_gt_eq:
-      return L">=";
+      return SLTL_TEXT(C, ">=");
     case language::id_matrix_multiplication:
-      return L"*";
+      return SLTL_TEXT(C, "*");
     case language::id_scalar_vector_multiplication:
-      return L"*";
+      return SLTL_TEXT(C, "*");
     case language::id_scalar_vector_division:
-      return L"/";
+      return SLTL_TEXT(C, "/");
     case language::id_scalar_matrix_multiplication:
-      return L"*";
+      return SLTL_TEXT(C, "*");
     case language::id_scalar_matrix_division:
-      return L"/";
+      return SLTL_TEXT(C, "/");
     case language::id_vector_scalar_multiplication:
-      return L"*";
+      return SLTL_TEXT(C, "*");
     case language::id_vector_scalar_division:
-      return L"/";
+      return SLTL_TEXT(C, "/");
     case language::id_matrix_scalar_multiplication:
-      return L"*";
+      return SLTL_TEXT(C, "*");
     case language::id_matrix_scalar_division:
-      return L"/";
+      return SLTL_TEXT(C, "/");
   }
 
   return nullptr;
 }
 
-const wchar_t* ns::to_conditional_string(language::conditional_id id)
+template<typename C>
+const C* ns::to_conditional_string(language::conditional_id id)
 {
   switch(id)
   {
   case language::id_if:
-    return L"if";
+    return SLTL_TEXT(C, "if");
   case language::id_else:
-    return L"else";
+    return SLTL_TEXT(C, "else");
   case language::id_else_if:
-    return L"else if";
+    return SLTL_TEXT(C, "else if");
   }
 
   return nullptr;
 }
 
-const wchar_t* ns::to_component_string(language::type_dimension_t component_idx)
+template<typename C>
+const C* ns::to_component_string(language::type_dimension_t component_idx)
 {
   switch(component_idx)
   {
   case 0:
-    return L"x";
+    return SLTL_TEXT(C, "x");
   case 1:
-    return L"y";
+    return SLTL_TEXT(C, "y");
   case 2:
-    return L"z";
+    return SLTL_TEXT(C, "z");
   case 3:
-    return L"w";
+    return SLTL_TEXT(C, "w");
   }
 
   return nullptr;
 }
 
-const wchar_t* ns::to_keyword_string(language::keyword_id id)
+template<typename C>
+const C* ns::to_keyword_string(language::keyword_id id)
 {
   switch(id)
   {
   case language::id_struct:
-    return L"struct";
+    return SLTL_TEXT(C, "struct");
   case language::id_return:
-    return L"return";
+    return SLTL_TEXT(C, "return");
   }
 
   return nullptr;
 }
+
+// Explicit instantiations for the narrow and wide character types
+#define SLTL_LANGUAGE_INSTANTIATE(C) \
+  template const C* ns::to_operator_unary_string<C>(language::operator_unary_id); \
+  template const C* ns::to_operator_binary_string<C>(language::operator_binary_id); \
+  template const C* ns::to_conditional_string<C>(language::conditional_id); \
+  template const C* ns::to_component_string<C>(language::type_dimension_t); \
+  template const C* ns::to_keyword_string<C>(language::keyword_id);
+
+SLTL_LANGUAGE_INSTANTIATE(char)
+SLTL_LANGUAGE_INSTANTIATE(wchar_t)
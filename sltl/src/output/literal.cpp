@@ -0,0 +1,370 @@
+#include "literal.h"
+
+#include <limits>
+#include <type_traits>
+#include <initializer_list>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+
+
+namespace
+{
+  namespace ns = sltl::detail;
+
+  // The decimal digits of a real number, the value is d0.d1d2...dn x 10^exponent
+  struct real_digits
+  {
+    char _digits[std::numeric_limits<double>::max_digits10 + 1];
+    size_t _length;
+    int _exponent;
+  };
+
+  size_t write_unsigned(char* buffer, unsigned long long value)
+  {
+    char digits[std::numeric_limits<unsigned long long>::digits10 + 1];
+    size_t length = 0U;
+
+    do
+    {
+      digits[length++] = static_cast<char>('0' + (value % 10U));
+      value /= 10U;
+    }
+    while(value != 0U);
+
+    for(size_t i = 0U; i < length; ++i)
+    {
+      buffer[i] = digits[length - i - 1U];
+    }
+
+    return length;
+  }
+
+  size_t write_string(char* buffer, const char* str)
+  {
+    const size_t length = std::strlen(str);
+    std::memcpy(buffer, str, length);
+    return length;
+  }
+
+  size_t write_exponent(char* buffer, int exponent)
+  {
+    size_t length = 0U;
+
+    buffer[length++] = 'e';
+    buffer[length++] = (exponent < 0) ? '-' : '+';
+
+    return length + write_unsigned(buffer + length, static_cast<unsigned long long>(std::abs(exponent)));
+  }
+
+  float parse_real(const char* str, float)
+  {
+    return std::strtof(str, nullptr);
+  }
+
+  double parse_real(const char* str, double)
+  {
+    return std::strtod(str, nullptr);
+  }
+
+  // Extracts the significant digits and decimal exponent from the output of printf's %e conversion.
+  // Any character that isn't a digit is skipped, so the (locale specific) decimal point is ignored.
+  void read_scientific(const char* str, real_digits& rd)
+  {
+    rd._length = 0U;
+
+    for(; *str && (*str != 'e'); ++str)
+    {
+      if((*str >= '0') && (*str <= '9'))
+      {
+        rd._digits[rd._length++] = *str;
+      }
+    }
+
+    assert(*str == 'e');
+
+    rd._exponent = std::atoi(str + 1);
+  }
+
+  // The powers of ten that are exactly representable by a double
+  const double pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+
+  const int pow10_max = static_cast<int>(sizeof(pow10) / sizeof(pow10[0])) - 1;
+
+  // The value d x 10^-k, correctly rounded as d and 10^k are both exactly representable
+  double scale_down(double d, int k)
+  {
+    return (k >= 0) ? (d / pow10[k]) : (d * pow10[-k]);
+  }
+
+  // Checks that reading the decimal value would produce the value t (when rounded to the type
+  // of t). The candidate is within half a double ulp of the decimal value, or equal to it if exact.
+  bool is_round_trip(double candidate, bool, double t)
+  {
+    return (candidate == t);
+  }
+
+  bool is_round_trip(double candidate, bool is_exact, float t)
+  {
+    // Both midpoints between t and its neighbours are exactly representable as doubles
+    const double mid_lo = (static_cast<double>(t) + std::nextafter(t, 0.0f)) / 2.0;
+    const double mid_hi = (static_cast<double>(t) + std::nextafter(t, std::numeric_limits<float>::infinity())) / 2.0;
+
+    if((candidate == mid_lo) || (candidate == mid_hi))
+    {
+      // An exact tie is rounded to the neighbour with an even mantissa
+      int exponent;
+      const float mantissa = std::frexp(t, &exponent);
+
+      return is_exact && (std::fmod(std::ldexp(mantissa, std::numeric_limits<float>::digits), 2.0f) == 0.0f);
+    }
+
+    return (candidate > mid_lo) && (candidate < mid_hi);
+  }
+
+  // Searches for the shortest digits using double arithmetic. Candidates are only accepted
+  // when the arithmetic is exact, otherwise false is returned to fall back to the slow path.
+  template<typename T>
+  bool to_real_digits_fast(T t, real_digits& rd)
+  {
+    const double v = t;
+
+    // The largest number of digits for which the candidate mantissa is exactly representable
+    const int precision_max = std::is_same<T, float>::value ? std::numeric_limits<float>::max_digits10 : 15;
+
+    if(!((v >= 1e-5) && (v < 1e15)))
+    {
+      return false;
+    }
+
+    int e = static_cast<int>(std::floor(std::log10(v)));
+
+    // Correct any error in the logarithm, so that 10^e <= v < 10^(e+1)
+    if(scale_down(v, e) < 1.0)
+    {
+      --e;
+    }
+    else if(scale_down(v, e + 1) >= 1.0)
+    {
+      ++e;
+    }
+
+    for(int precision = 1; precision <= precision_max; ++precision)
+    {
+      const int k = precision - 1 - e;
+
+      if((k > pow10_max) || (-k > pow10_max))
+      {
+        return false;
+      }
+
+      // The rounding of 'scaled' might be off by one, so both of its neighbouring integers are tried
+      const double scaled = scale_down(v, -k);
+      const double d_floor = std::floor(scaled);
+      const double d_nearest = ((scaled - d_floor) < 0.5) ? d_floor : d_floor + 1.0;
+      const double d_other = (d_nearest == d_floor) ? d_floor + 1.0 : d_floor;
+
+      for(double d : { d_nearest, d_other })
+      {
+        const double candidate = scale_down(d, k);
+        const bool is_exact = (k <= 0) || (std::fma(candidate, pow10[k], -d) == 0.0);
+
+        if((d > 0.0) && is_round_trip(candidate, is_exact, t))
+        {
+          rd._length = write_unsigned(rd._digits, static_cast<unsigned long long>(d));
+          rd._exponent = static_cast<int>(rd._length) - 1 - k;
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  // Finds the shortest sequence of digits that parses back to the same (positive and finite) value
+  template<typename T>
+  void to_real_digits(T t, real_digits& rd)
+  {
+    assert(t > T());
+
+    const T t_integral = std::floor(t);
+
+    // Whole numbers that are exactly representable by the mantissa are written without any searching
+    if((t == t_integral) && (t < static_cast<T>(1ULL << std::numeric_limits<T>::digits)))
+    {
+      rd._length = write_unsigned(rd._digits, static_cast<unsigned long long>(t_integral));
+      rd._exponent = static_cast<int>(rd._length) - 1;
+    }
+    else if(!to_real_digits_fast(t, rd))
+    {
+      char str[64];
+
+      // Slow path, for very small or very large values and those needing many digits
+      for(int precision = 1; precision <= std::numeric_limits<T>::max_digits10; ++precision)
+      {
+        std::snprintf(str, sizeof(str), "%.*e", precision - 1, static_cast<double>(t));
+
+        read_scientific(str, rd);
+
+        // Parse the digits as an integral mantissa, which avoids needing a (locale specific) decimal point
+        size_t length = rd._length;
+        std::memcpy(str, rd._digits, length);
+        length += write_exponent(str + length, rd._exponent - static_cast<int>(rd._length - 1U));
+        str[length] = '\0';
+
+        if(parse_real(str, t) == t)
+        {
+          break;
+        }
+      }
+    }
+
+    // Trailing zeros are not significant
+    while((rd._length > 1U) && (rd._digits[rd._length - 1U] == '0'))
+    {
+      --rd._length;
+    }
+  }
+
+  template<typename T>
+  size_t format_real(char* buffer, T t, const char* suffix)
+  {
+    size_t length = 0U;
+
+    if(std::signbit(t))
+    {
+      buffer[length++] = '-';
+      t = -t;
+    }
+
+    if(std::isnan(t))
+    {
+      length += write_string(buffer + length, "nan");
+    }
+    else if(std::isinf(t))
+    {
+      length += write_string(buffer + length, "inf");
+    }
+    else
+    {
+      real_digits rd = { {}, 1U, 0 };
+
+      if(t == T())
+      {
+        rd._digits[0] = '0';
+      }
+      else
+      {
+        to_real_digits(t, rd);
+      }
+
+      const int digit_count = static_cast<int>(rd._length);
+
+      // Fixed notation is used unless the value is very small or very large. In either case
+      // a decimal point is always written, so the literal isn't interpreted as an integer.
+      if((rd._exponent >= -5) && (rd._exponent < std::numeric_limits<double>::max_digits10))
+      {
+        if(rd._exponent < 0)
+        {
+          buffer[length++] = '0';
+          buffer[length++] = '.';
+
+          for(int i = -1; i > rd._exponent; --i)
+          {
+            buffer[length++] = '0';
+          }
+
+          std::memcpy(buffer + length, rd._digits, rd._length);
+          length += rd._length;
+        }
+        else
+        {
+          for(int i = 0; i <= rd._exponent; ++i)
+          {
+            buffer[length++] = (i < digit_count) ? rd._digits[i] : '0';
+          }
+
+          buffer[length++] = '.';
+
+          if(digit_count > (rd._exponent + 1))
+          {
+            const size_t fraction_length = static_cast<size_t>(digit_count - (rd._exponent + 1));
+
+            std::memcpy(buffer + length, rd._digits + (rd._exponent + 1), fraction_length);
+            length += fraction_length;
+          }
+          else
+          {
+            buffer[length++] = '0';
+          }
+        }
+      }
+      else
+      {
+        buffer[length++] = rd._digits[0];
+        buffer[length++] = '.';
+
+        if(rd._length > 1U)
+        {
+          std::memcpy(buffer + length, rd._digits + 1, rd._length - 1U);
+          length += (rd._length - 1U);
+        }
+        else
+        {
+          buffer[length++] = '0';
+        }
+
+        length += write_exponent(buffer + length, rd._exponent);
+      }
+    }
+
+    length += write_string(buffer + length, suffix);
+
+    assert(length <= ns::literal_length_max);
+
+    return length;
+  }
+}
+
+size_t ns::format_literal(char* buffer, float f)
+{
+  return format_real(buffer, f, "f");
+}
+
+size_t ns::format_literal(char* buffer, double d)
+{
+  return format_real(buffer, d, "lf");
+}
+
+size_t ns::format_literal(char* buffer, int i)
+{
+  if(i < 0)
+  {
+    buffer[0] = '-';
+
+    // Negate using unsigned arithmetic so the minimum value doesn't overflow
+    return 1U + write_unsigned(buffer + 1, 0ULL - static_cast<unsigned long long>(static_cast<long long>(i)));
+  }
+
+  return write_unsigned(buffer, static_cast<unsigned long long>(i));
+}
+
+size_t ns::format_literal(char* buffer, unsigned int ui)
+{
+  const size_t length = write_unsigned(buffer, ui);
+
+  buffer[length] = 'U';
+
+  return length + 1U;
+}
+
+size_t ns::format_literal(char* buffer, bool b)
+{
+  return write_string(buffer, b ? "true" : "false");
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+
+namespace sltl
+{
+namespace detail
+{
+  // The size of a buffer large enough to hold any formatted literal, including its suffix
+  const size_t literal_length_max = 40U;
+
+  // Locale-independent formatting of literal values, the text is written to the buffer (which
+  // must hold at least literal_length_max characters) and its length is returned. Real numbers
+  // are written using the shortest representation that round-trips to the same value.
+  size_t format_literal(char* buffer, float f);
+  size_t format_literal(char* buffer, double d);
+  size_t format_literal(char* buffer, int i);
+  size_t format_literal(char* buffer, unsigned int ui);
+  size_t format_literal(char* buffer, bool b);
+}
+}
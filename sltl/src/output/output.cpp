@@ -1,6 +1,8 @@
 #include "output.h"
 
 #include "language.h"
+#include "character.h"
+#include "literal.h"
 
 #include <syntax/block.h>
 #include <syntax/variable_declaration.h>
@@ -18,9 +20,10 @@
 
 #include <type.h>
 
-#include <detail/numeric.h>
 #include <detail/type_traits.h>
 
+#include <sstream>
+
 #include <cassert>
 
 
@@ -28,108 +31,98 @@ namespace
 {
   namespace ns = sltl;
 
-  template<typename T>
-  auto to_string(T t) -> typename std::enable_if<std::is_floating_point<T>::value, std::wstring>::type
-  {
-    std::wstringstream ss;
-
-    // Output a decimal point when the floating point value has no fractional part
-    if(ns::detail::has_fractional_part(t))
-    {
-      ss << t;
-    }
-    else
-    {
-      ss << t << L".0";
-    }
-
-    return ss.str();
-  }
-
-  std::wstring to_string(float f)
-  {
-    return to_string<float>(f) + L'f';
-  }
-
-  std::wstring to_string(double d)
-  {
-    return to_string<double>(d) + L"lf";
-  }
-
-  std::wstring to_string(int i)
-  {
-    return std::to_wstring(i);
-  }
-
-  std::wstring to_string(unsigned int ui)
+  template<typename C, typename T>
+  void write_literal(ns::basic_output_stream<C>& os, T t)
   {
-    return std::to_wstring(ui) + L'U';
+    char buffer[ns::detail::literal_length_max];
+    os.write_ascii(buffer, ns::detail::format_literal(buffer, t));
   }
 
-  std::wstring to_string(bool b)
+  template<typename C>
+  void write_zero_initialization(ns::basic_output_stream<C>& os, const ns::language::type& type)
   {
-    std::wstringstream ss;
-    ss << std::boolalpha << b;
-    return ss.str();
-  }
-
-  std::wstring get_zero_initialization(const ns::language::type& type)
-  {
-    std::wstring value;
-
     typedef unsigned int uint_t;
 
     switch(type.get_id())
     {
       case ns::language::id_float:
-        value = to_string(float());
+        write_literal(os, float());
         break;
       case ns::language::id_double:
-        value = to_string(double());
+        write_literal(os, double());
         break;
       case ns::language::id_int:
-        value = to_string(int());
+        write_literal(os, int());
         break;
       case ns::language::id_uint:
-        value = to_string(uint_t());
+        write_literal(os, uint_t());
         break;
       case ns::language::id_bool:
-        value = to_string(bool());
+        write_literal(os, bool());
         break;
       default:
         assert((type.get_id() != ns::language::id_unknown) && (type.get_id() != ns::language::id_void));
     }
-
-    return value;
   }
 }
 
-ns::output::output(core::shader_stage stage, detail::enum_flags<output_flags> flags) : _flags(flags), _stage(stage), _indent_count(0U)
+template<typename C>
+ns::basic_output<C>::basic_output(core::shader_stage stage, detail::enum_flags<output_flags> flags) : _sink_default(std::make_unique<basic_output_sink_buffer<C>>()),
+  _sink(_sink_default.get()),
+  _os(*_sink),
+  _flags(flags),
+  _stage(stage),
+  _indent_count(0U)
 {
 }
 
-std::wstring ns::output::get_result() const
+template<typename C>
+ns::basic_output<C>::basic_output(core::shader_stage stage, basic_output_sink<C>& sink, detail::enum_flags<output_flags> flags) : _sink_default(),
+  _sink(&sink),
+  _os(*_sink),
+  _flags(flags),
+  _stage(stage),
+  _indent_count(0U)
 {
-  return _ss.str();
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::block&, bool is_start)
+template<typename C>
+typename ns::basic_output<C>::string_type ns::basic_output<C>::get_result() const
+{
+  if(auto sink = dynamic_cast<const basic_output_sink_buffer<C>*>(_sink))
+  {
+    return sink->get_buffer();
+  }
+  else
+  {
+    throw std::exception();//TODO: exception type and message
+  }
+}
+
+template<typename C>
+void ns::basic_output<C>::flush()
+{
+  _os.flush();
+}
+
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::block&, bool is_start)
 {
   syntax::action_return_t return_val;
 
   if(is_start)
   {
-    _ss << get_indent(indent_t::increase);
+    _os << get_indent(indent_t::increase);
     operator()(language::bracket_tag<language::id_brace>(), true);
-    _ss << get_newline();
+    _os << get_newline();
 
     return_val = syntax::action_return_t::step_in;
   }
   else
   {
-    _ss << get_indent(indent_t::decrease);
+    _os << get_indent(indent_t::decrease);
     operator()(language::bracket_tag<language::id_brace>(), false);
-    _ss << get_newline();
+    _os << get_newline();
 
     return_val = syntax::action_return_t::step_out;
   }
@@ -137,7 +130,8 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::block&, bool is
   return return_val;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::io_block&, bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::io_block&, bool is_start)
 {
   syntax::action_return_t return_val;
 
@@ -145,7 +139,7 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::io_block&, bool
   {
     if(_flags.has_flag<output_flags::flag_extra_newlines>())
     {
-      _ss << get_newline();
+      _os << get_newline();
     }
 
     return_val = syntax::action_return_t::step_in;
@@ -158,14 +152,16 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::io_block&, bool
   return return_val;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::parameter_declaration& pd)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::parameter_declaration& pd)
 {
-  _ss << get_type_name(pd.get_type()) << L' ' << get_parameter_name(pd);
+  _os << get_type_name(pd.get_type()) << SLTL_TEXT(C, ' ') << get_parameter_name(pd);
 
   return syntax::action_return_t::step_out;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::parameter_list& pl, bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::parameter_list& pl, bool is_start)
 {
   syntax::action_return_t return_val;
 
@@ -178,7 +174,7 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::parameter_list&
     {
       while((*it)->apply_action(*this) && (++it != it_end))
       {
-        _ss << L", ";
+        _os << SLTL_TEXT(C, ", ");
       }
     }
 
@@ -195,22 +191,27 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::parameter_list&
   return return_val;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::reference& r)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::reference& r)
 {
-  if(auto vd = dynamic_cast<const syntax::variable_declaration*>(&r._declaration))
-  {
-    _ss << get_variable_name(*vd);
-  }
-
-  if(auto pd = dynamic_cast<const syntax::parameter_declaration*>(&r._declaration))
+  switch(r._declaration.get_declaration_kind())
   {
-    _ss << get_parameter_name(*pd);
+    case syntax::declaration_kind::variable_declaration:
+      _os << get_variable_name(static_cast<const syntax::variable_declaration&>(r._declaration));
+      break;
+    case syntax::declaration_kind::parameter_declaration:
+      _os << get_parameter_name(static_cast<const syntax::parameter_declaration&>(r._declaration));
+      break;
+    case syntax::declaration_kind::function_definition:
+    case syntax::declaration_kind::intrinsic_declaration:
+      throw std::exception();//TODO: exception type and message
   }
 
   return syntax::action_return_t::step_out;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::temporary& t, bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::temporary& t, bool is_start)
 {
   const syntax::expression* initializer = t.get_initializer();
 
@@ -220,19 +221,19 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::temporary& t, b
 
     if(!initializer || !detail::is_type<syntax::constructor_call>(initializer))
     {
-      _ss << get_type_name(type) << L'(';
+      _os << get_type_name(type) << SLTL_TEXT(C, '(');
     }
 
     if(!initializer)
     {
-      _ss << get_zero_initialization(type);
+      write_zero_initialization(_os, type);
     }
   }
   else
   {
     if(!initializer || !detail::is_type<syntax::constructor_call>(initializer))
     {
-      _ss << L')';
+      _os << SLTL_TEXT(C, ')');
     }
   }
 
@@ -240,7 +241,8 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::temporary& t, b
                     syntax::action_return_t::step_out;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::operator_unary& ou, bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::operator_unary& ou, bool is_start)
 {
   syntax::action_return_t return_val;
 
@@ -248,7 +250,7 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::operator_unary&
   {
     if(language::is_prefix_operator(ou._operator_id))
     {
-      _ss << to_operator_unary_string(ou._operator_id);
+      _os << to_operator_unary_string<C>(ou._operator_id);
     }
 
     if(detail::is_type<syntax::operator_binary>(ou._operand.get()))
@@ -267,7 +269,7 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::operator_unary&
 
     if(language::is_postfix_operator(ou._operator_id))
     {
-      _ss << to_operator_unary_string(ou._operator_id);
+      _os << to_operator_unary_string<C>(ou._operator_id);
     }
 
     return_val = syntax::action_return_t::step_out;
@@ -276,7 +278,8 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::operator_unary&
   return return_val;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::operator_binary& ob, bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::operator_binary& ob, bool is_start)
 {
   syntax::action_return_t return_val;
 
@@ -286,7 +289,7 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::operator_binary
     {
       bool is_parentheses_required = false;
 
-      if(const auto* const ob = dynamic_cast<const syntax::operator_binary*>(exp))
+      if(const auto* const ob = syntax::node_cast<const syntax::operator_binary>(exp))
       {
         is_parentheses_required = !to_intrinsic_operator_string(*ob);
       }
@@ -298,7 +301,7 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::operator_binary
 
     if(intrinsic_op)
     {
-      _ss << intrinsic_op << L'(';
+      _os << intrinsic_op << SLTL_TEXT(C, '(');
     }
     else if(fn_is_parentheses_required(ob._operand_lhs.get()))
     {
@@ -314,7 +317,7 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::operator_binary
 
     if(intrinsic_op)
     {
-      _ss << L", ";
+      _os << SLTL_TEXT(C, ", ");
     }
     else
     {
@@ -323,7 +326,7 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::operator_binary
         operator()(language::bracket_tag<language::id_parenthesis>(), false);
       }
 
-      _ss << L' ' << to_operator_binary_string(ob._operator_id) << L' ';
+      _os << SLTL_TEXT(C, ' ') << to_operator_binary_string<C>(ob._operator_id) << SLTL_TEXT(C, ' ');
 
       if(fn_is_parentheses_required(ob._operand_rhs.get()))
       {
@@ -338,7 +341,7 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::operator_binary
 
     if(intrinsic_op)
     {
-      _ss << L')';
+      _os << SLTL_TEXT(C, ')');
     }
     else if(fn_is_parentheses_required(ob._operand_rhs.get()))
     {
@@ -358,7 +361,54 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::operator_binary
   return return_val;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::operator_component_access& oca, bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::operator_ternary& ot, bool is_start)
+{
+  syntax::action_return_t return_val;
+
+  if(is_start)
+  {
+    // The conditional operator has a lower precedence than any binary operator (other than assignment) so is always parenthesized
+    operator()(language::bracket_tag<language::id_parenthesis>(), true);
+
+    bool is_continuing;
+
+    if(!(is_continuing = ot._condition->apply_action(*this)))
+    {
+      goto stop_label;
+    }
+
+    _os << SLTL_TEXT(C, " ? ");
+
+    if(!(is_continuing = ot._operand_true->apply_action(*this)))
+    {
+      goto stop_label;
+    }
+
+    _os << SLTL_TEXT(C, " : ");
+
+    if(!(is_continuing = ot._operand_false->apply_action(*this)))
+    {
+      goto stop_label;
+    }
+
+    operator()(language::bracket_tag<language::id_parenthesis>(), false);
+
+    // The 'success' return value is 'step_over' as all child nodes have already been traversed
+    stop_label: return_val = (is_continuing ?
+      syntax::action_return_t::step_over :
+      syntax::action_return_t::stop);
+  }
+  else
+  {
+    return_val = syntax::action_return_t::step_out;
+  }
+
+  return return_val;
+}
+
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::operator_component_access& oca, bool is_start)
 {
   syntax::action_return_t return_val;
 
@@ -370,56 +420,56 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::operator_compon
   {
     struct
     {
-      std::wstring operator()(const syntax::component_accessor_scalar& access) const
+      string_type operator()(const syntax::component_accessor_scalar& access) const
       {
-        std::wstringstream ss;
+        std::basic_stringstream<C> ss;
 
         for(size_t i = 0; i < access._count; ++i)
         {
-          ss << L'x';
+          ss << SLTL_TEXT(C, 'x');
         }
 
         return ss.str();
       }
 
-      std::wstring operator()(const syntax::component_accessor_vector& access) const
+      string_type operator()(const syntax::component_accessor_vector& access) const
       {
         const auto it_find  = std::find(
           access.begin(),
           access.end(),
           syntax::component_accessor::_idx_default);
 
-        std::wstringstream ss;
+        std::basic_stringstream<C> ss;
 
         std::for_each(std::begin(access._indices), it_find, [&ss](language::type_dimension_t idx)
         {
-          ss << to_component_string(idx);
+          ss << to_component_string<C>(idx);
         });
 
         return ss.str();
       }
 
-      std::wstring operator()(const syntax::component_accessor_matrix& access) const
+      string_type operator()(const syntax::component_accessor_matrix& access) const
       {
-        std::wstringstream ss;
+        std::basic_stringstream<C> ss;
 
-        ss << L'[';
+        ss << SLTL_TEXT(C, '[');
         ss << access._idx_n;
-        ss << L']';
+        ss << SLTL_TEXT(C, ']');
 
         if(access._idx_m != syntax::component_accessor::_idx_default)
         {
-          ss << L'[';
+          ss << SLTL_TEXT(C, '[');
           ss << access._idx_m;
-          ss << L']';
+          ss << SLTL_TEXT(C, ']');
         }
 
         return ss.str();
       }
     } fn;
 
-    _ss << L'.';
-    _ss << syntax::visit(*oca._accessor, fn);
+    _os << SLTL_TEXT(C, '.');
+    _os << syntax::visit(*oca._accessor, fn);
 
     return_val = syntax::action_return_t::step_out;
   }
@@ -427,7 +477,8 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::operator_compon
   return return_val;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::conditional& c, bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::conditional& c, bool is_start)
 {
   syntax::action_return_t return_val;
 
@@ -435,11 +486,11 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::conditional& c,
   {
     if(_flags.has_flag<output_flags::flag_extra_newlines>())
     {
-      _ss << get_newline();
+      _os << get_newline();
     }
 
-    _ss << get_indent(indent_t::current);
-    _ss << to_conditional_string(c._id);
+    _os << get_indent(indent_t::current);
+    _os << to_conditional_string<C>(c._id);
 
     bool is_continuing = true;
 
@@ -455,7 +506,7 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::conditional& c,
       operator()(language::bracket_tag<language::id_parenthesis>(), false);
     }
 
-    _ss << get_newline();
+    _os << get_newline();
 
     if(const auto* statement = c.get_statement())
     {
@@ -480,11 +531,12 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::conditional& c,
   return return_val;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::constructor_call& cc, bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::constructor_call& cc, bool is_start)
 {
   if(is_start)
   {
-    _ss << get_type_name(cc.get_type());
+    _os << get_type_name(cc.get_type());
   }
 
   operator()(language::bracket_tag<language::id_parenthesis>(), is_start);
@@ -493,22 +545,24 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::constructor_cal
                     syntax::action_return_t::step_out;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::expression_statement&, bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::expression_statement&, bool is_start)
 {
   if(is_start)
   {
-    _ss << get_indent(indent_t::current);
+    _os << get_indent(indent_t::current);
   }
   else
   {
-    _ss << get_terminal_newline();
+    _os << get_terminal_newline();
   }
 
   return is_start ? syntax::action_return_t::step_in :
                     syntax::action_return_t::step_out;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::expression_list& el, bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::expression_list& el, bool is_start)
 {
   syntax::action_return_t return_val;
 
@@ -521,7 +575,7 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::expression_list
     {
       while((*it)->apply_action(*this) && (++it != it_end))
       {
-        _ss << L", ";
+        _os << SLTL_TEXT(C, ", ");
       }
     }
 
@@ -538,11 +592,12 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::expression_list
   return return_val;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::function_call& fc, bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::function_call& fc, bool is_start)
 {
   if(is_start)
   {
-    _ss << fc.get_function_name();
+    _os << detail::to_basic_string<C>(fc.get_function_name());
   }
 
   operator()(language::bracket_tag<language::id_parenthesis>(), is_start);
@@ -551,7 +606,8 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::function_call&
                     syntax::action_return_t::step_out;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::function_definition& fd, bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::function_definition& fd, bool is_start)
 {
   syntax::action_return_t return_val;
 
@@ -559,11 +615,11 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::function_defini
   {
     if(_flags.has_flag<output_flags::flag_extra_newlines>())
     {
-      _ss << get_newline();
+      _os << get_newline();
     }
 
-    _ss << get_indent(indent_t::current);
-    _ss << get_type_name(fd.get_type()) << L' ' << fd._name << L'(';
+    _os << get_indent(indent_t::current);
+    _os << get_type_name(fd.get_type()) << SLTL_TEXT(C, ' ') << detail::to_basic_string<C>(fd._name) << SLTL_TEXT(C, '(');
 
     bool is_continuing;
 
@@ -572,7 +628,7 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::function_defini
       goto stop_label;
     }
 
-    _ss << L')' << get_newline();
+    _os << SLTL_TEXT(C, ')') << get_newline();
 
     if(!(is_continuing = fd.get_body().apply_action(*this)))
     {
@@ -592,32 +648,34 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::function_defini
   return return_val;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::return_statement&, bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::return_statement&, bool is_start)
 {
   if(is_start)
   {
     if(_flags.has_flag<output_flags::flag_extra_newlines>())
     {
-      _ss << get_newline();
+      _os << get_newline();
     }
 
-    _ss << get_indent(indent_t::current);
-    _ss << to_keyword_string(language::id_return) << L' ';
+    _os << get_indent(indent_t::current);
+    _os << to_keyword_string<C>(language::id_return) << SLTL_TEXT(C, ' ');
   }
   else
   {
-    _ss << get_terminal_newline();
+    _os << get_terminal_newline();
   }
 
   return is_start ? syntax::action_return_t::step_in :
                     syntax::action_return_t::step_out;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::intrinsic_call& ic, bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::intrinsic_call& ic, bool is_start)
 {
   if(is_start)
   {
-    _ss << to_intrinsic_string(ic.get_intrinsic());
+    _os << to_intrinsic_string(ic.get_intrinsic());
   }
 
   operator()(language::bracket_tag<language::id_parenthesis>(), is_start);
@@ -626,68 +684,77 @@ ns::syntax::action_return_t ns::output::operator()(const syntax::intrinsic_call&
                     syntax::action_return_t::step_out;
 }
 
-ns::syntax::action_return_t ns::output::operator()(const syntax::intrinsic_declaration& id, bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(const syntax::intrinsic_declaration& id, bool is_start)
 {
   // The initial return value is 'step_over' as there is no need to traverse any child nodes
   return is_start ? syntax::action_return_t::step_over :
                     syntax::action_return_t::step_out;
 }
 
-ns::syntax::action_return_t ns::output::operator()(float f)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(float f)
 {
-  _ss << to_string(f);
+  write_literal(_os, f);
   return syntax::action_return_t::step_out;
 }
 
-ns::syntax::action_return_t ns::output::operator()(double d)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(double d)
 {
-  _ss << to_string(d);
+  write_literal(_os, d);
   return syntax::action_return_t::step_out;
 }
 
-ns::syntax::action_return_t ns::output::operator()(int i)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(int i)
 {
-  _ss << to_string(i);
+  write_literal(_os, i);
   return syntax::action_return_t::step_out;
 }
 
-ns::syntax::action_return_t ns::output::operator()(unsigned int ui)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(unsigned int ui)
 {
-  _ss << to_string(ui);
+  write_literal(_os, ui);
   return syntax::action_return_t::step_out;
 }
 
-ns::syntax::action_return_t ns::output::operator()(bool b)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::operator()(bool b)
 {
-  _ss << to_string(b);
+  write_literal(_os, b);
   return syntax::action_return_t::step_out;
 }
 
-void ns::output::operator()(language::bracket_tag<language::id_brace>, bool is_start)
+template<typename C>
+void ns::basic_output<C>::operator()(language::bracket_tag<language::id_brace>, bool is_start)
 {
   if(is_start)
   {
-    _ss << L'{';
+    _os << SLTL_TEXT(C, '{');
   }
   else
   {
-    _ss << L'}';
+    _os << SLTL_TEXT(C, '}');
   }
 }
 
-void ns::output::operator()(language::bracket_tag<language::id_parenthesis>, bool is_start)
+template<typename C>
+void ns::basic_output<C>::operator()(language::bracket_tag<language::id_parenthesis>, bool is_start)
 {
   if(is_start)
   {
-    _ss << L'(';
+    _os << SLTL_TEXT(C, '(');
   }
   else
   {
-    _ss << L')';
+    _os << SLTL_TEXT(C, ')');
   }
 }
 
-ns::syntax::action_return_t ns::output::get_default(bool is_start)
+template<typename C>
+ns::syntax::action_return_t ns::basic_output<C>::get_default(bool is_start)
 {
   assert(false);
 
@@ -695,7 +762,8 @@ ns::syntax::action_return_t ns::output::get_default(bool is_start)
                     syntax::action_return_t::step_out;
 }
 
-std::wstring ns::output::get_indent(indent_t indent_op)
+template<typename C>
+typename ns::basic_output<C>::string_type ns::basic_output<C>::get_indent(indent_t indent_op)
 {
   size_t indent_count = _indent_count;
 
@@ -709,7 +777,7 @@ std::wstring ns::output::get_indent(indent_t indent_op)
       break;
   }
 
-  wchar_t indent_character = L' ';
+  C indent_character = SLTL_TEXT(C, ' ');
 
   if(_flags.has_flag<output_flags::flag_indent_space>())
   {
@@ -717,23 +785,30 @@ std::wstring ns::output::get_indent(indent_t indent_op)
   }
   else
   {
-    indent_character = L'\t';
+    indent_character = SLTL_TEXT(C, '\t');
   }
 
-  return std::wstring(indent_count, indent_character);
+  return string_type(indent_count, indent_character);
 }
 
-const wchar_t ns::output::get_newline() const
+template<typename C>
+const C ns::basic_output<C>::get_newline() const
 {
-  return L'\n';
+  return SLTL_TEXT(C, '\n');
 }
 
-const wchar_t ns::output::get_terminal() const
+template<typename C>
+const C ns::basic_output<C>::get_terminal() const
 {
-  return L';';
+  return SLTL_TEXT(C, ';');
 }
 
-const wchar_t* ns::output::get_terminal_newline() const
+template<typename C>
+const C* ns::basic_output<C>::get_terminal_newline() const
 {
-  return L";\n";
+  return SLTL_TEXT(C, ";\n");
 }
+
+// Explicit instantiations for the narrow and wide character types
+template class ns::basic_output<char>;
+template class ns::basic_output<wchar_t>;
@@ -9,8 +9,10 @@
 
 #include <detail/enum_flags.h>
 
+#include "output_sink.h"
+
+#include <memory>
 #include <string>
-#include <sstream>
 
 
 namespace sltl
@@ -23,16 +25,23 @@ namespace sltl
     flag_transpose_type = 0x4
   };
 
-  class output : public syntax::const_action_result<std::wstring>
+  // The base class of the language specific output actions. The generated text is either narrow
+  // UTF-8 (C is char) or wide (C is wchar_t), with no conversion between the two.
+  template<typename C>
+  class basic_output : public syntax::const_action_result<std::basic_string<C>>
   {
   public:
-    output(output&&) = default;
-    output(core::shader_stage stage, detail::enum_flags<output_flags> flags = output_flags::flag_none);
+    typedef C char_type;
+    typedef std::basic_string<C> string_type;
+
+    basic_output(basic_output&&) = default;
+    basic_output(core::shader_stage stage, detail::enum_flags<output_flags> flags = output_flags::flag_none);
+    basic_output(core::shader_stage stage, basic_output_sink<C>& sink, detail::enum_flags<output_flags> flags = output_flags::flag_none);
 
     // Non-copyable and non-assignable
-    output(const output&) = delete;
-    output& operator=(output&&) = delete;
-    output& operator=(const output&) = delete;
+    basic_output(const basic_output&) = delete;
+    basic_output& operator=(basic_output&&) = delete;
+    basic_output& operator=(const basic_output&) = delete;
 
     syntax::action_return_t operator()(const syntax::block&, bool is_start = true) override;
     syntax::action_return_t operator()(const syntax::io_block&, bool is_start = true) override;
@@ -42,6 +51,7 @@ namespace sltl
     syntax::action_return_t operator()(const syntax::temporary& t, bool is_start = true) override;
     syntax::action_return_t operator()(const syntax::operator_unary& ou, bool is_start = true) override;
     syntax::action_return_t operator()(const syntax::operator_binary& ob, bool is_start = true) override;
+    syntax::action_return_t operator()(const syntax::operator_ternary& ot, bool is_start = true) override;
     syntax::action_return_t operator()(const syntax::operator_component_access& oca, bool is_start = true) override;
     syntax::action_return_t operator()(const syntax::conditional& c, bool is_start = true) override;
     syntax::action_return_t operator()(const syntax::constructor_call& cc, bool is_start = true) override;
@@ -53,7 +63,10 @@ namespace sltl
     syntax::action_return_t operator()(const syntax::intrinsic_call& ic, bool is_start = true) override;
     syntax::action_return_t operator()(const syntax::intrinsic_declaration& id, bool is_start = true) override;
 
-    std::wstring get_result() const override;
+    // Only available when the output is written to a buffer sink (the default)
+    string_type get_result() const override;
+
+    void flush();
 
   protected:
     syntax::action_return_t operator()(float f) override;
@@ -67,12 +80,12 @@ namespace sltl
 
     syntax::action_return_t get_default(bool is_start) override;
 
-    virtual std::wstring get_type_name(const language::type& type) const = 0;
-    virtual std::wstring get_variable_name(const syntax::variable_declaration& vd) const = 0;
-    virtual std::wstring get_parameter_name(const syntax::parameter_declaration& pd) const = 0;
+    virtual string_type get_type_name(const language::type& type) const = 0;
+    virtual string_type get_variable_name(const syntax::variable_declaration& vd) const = 0;
+    virtual string_type get_parameter_name(const syntax::parameter_declaration& pd) const = 0;
 
-    virtual const wchar_t* to_intrinsic_string(core::intrinsic intrinsic) const = 0;
-    virtual const wchar_t* to_intrinsic_operator_string(const syntax::operator_binary& ob) const = 0;
+    virtual const C* to_intrinsic_string(core::intrinsic intrinsic) const = 0;
+    virtual const C* to_intrinsic_operator_string(const syntax::operator_binary& ob) const = 0;
 
     enum class indent_t
     {
@@ -81,13 +94,16 @@ namespace sltl
       decrease
     };
 
-    std::wstring get_indent(indent_t indent_op);
+    string_type get_indent(indent_t indent_op);
 
-    const wchar_t  get_newline() const;
-    const wchar_t  get_terminal() const;
-    const wchar_t* get_terminal_newline() const;
+    const C  get_newline() const;
+    const C  get_terminal() const;
+    const C* get_terminal_newline() const;
 
-    std::wstringstream _ss;
+    // Generated text is written directly to the sink, which is owned by the output when one isn't specified
+    std::unique_ptr<basic_output_sink<C>> _sink_default;
+    basic_output_sink<C>* const _sink;
+    basic_output_stream<C> _os;
 
     const detail::enum_flags<output_flags> _flags;
     const core::shader_stage _stage;
@@ -95,4 +111,7 @@ namespace sltl
   private:
     size_t _indent_count;
   };
+
+  typedef basic_output<wchar_t> output;
+  typedef basic_output<char>    output_narrow;
 }
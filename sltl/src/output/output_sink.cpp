@@ -0,0 +1,194 @@
+#include "output_sink.h"
+#include "character.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <algorithm>
+#include <exception>
+
+
+namespace
+{
+  namespace ns = sltl;
+
+  void append_chunk(std::string& chunk, const char* str, size_t length)
+  {
+    chunk.append(str, length);
+  }
+
+  void append_chunk(std::string& chunk, const wchar_t* str, size_t length)
+  {
+    ns::detail::append_utf8(chunk, str, length);
+  }
+
+  bool write_fd(int fd, const char* data, size_t size)
+  {
+    while(size > 0U)
+    {
+#ifdef _WIN32
+      const auto result = ::_write(fd, data, static_cast<unsigned int>(size));
+#else
+      const auto result = ::write(fd, data, size);
+#endif
+
+      if(result < 0)
+      {
+        // A write interrupted by a signal (before any data was written) is retried
+        if(errno == EINTR)
+        {
+          continue;
+        }
+
+        return false;
+      }
+      else if(result == 0)
+      {
+        return false;
+      }
+
+      data += result;
+      size -= static_cast<size_t>(result);
+    }
+
+    return true;
+  }
+}
+
+template<typename C>
+const size_t ns::basic_output_sink_callback<C>::chunk_size_default;
+
+template<typename C>
+const size_t ns::basic_output_sink_fd<C>::chunk_size_default;
+
+// output_sink_buffer definitions
+
+template<typename C>
+ns::basic_output_sink_buffer<C>::basic_output_sink_buffer(size_t capacity)
+{
+  _buffer.reserve(capacity);
+}
+
+template<typename C>
+void ns::basic_output_sink_buffer<C>::write(const C* str, size_t length)
+{
+  _buffer.append(str, length);
+}
+
+template<typename C>
+const std::basic_string<C>& ns::basic_output_sink_buffer<C>::get_buffer() const
+{
+  return _buffer;
+}
+
+template<typename C>
+std::basic_string<C> ns::basic_output_sink_buffer<C>::release()
+{
+  std::basic_string<C> buffer;
+  buffer.swap(_buffer);
+  return buffer;
+}
+
+// output_sink_callback definitions
+
+template<typename C>
+ns::basic_output_sink_callback<C>::basic_output_sink_callback(callback_t callback, size_t chunk_size) : _callback(std::move(callback)), _chunk(std::max<size_t>(chunk_size, 1U)), _chunk_length(0U)
+{
+}
+
+template<typename C>
+ns::basic_output_sink_callback<C>::~basic_output_sink_callback()
+{
+  flush();
+}
+
+template<typename C>
+void ns::basic_output_sink_callback<C>::write(const C* str, size_t length)
+{
+  while(length > 0U)
+  {
+    // Text that would completely fill an empty chunk is passed straight to the callback
+    if((_chunk_length == 0U) && (length >= _chunk.size()))
+    {
+      _callback(str, length);
+      return;
+    }
+
+    const size_t count = std::min(length, _chunk.size() - _chunk_length);
+
+    std::copy(str, str + count, _chunk.data() + _chunk_length);
+
+    _chunk_length += count;
+    str += count;
+    length -= count;
+
+    if(_chunk_length == _chunk.size())
+    {
+      flush();
+    }
+  }
+}
+
+template<typename C>
+void ns::basic_output_sink_callback<C>::flush()
+{
+  if(_chunk_length > 0U)
+  {
+    _callback(_chunk.data(), _chunk_length);
+    _chunk_length = 0U;
+  }
+}
+
+// output_sink_fd definitions
+
+template<typename C>
+ns::basic_output_sink_fd<C>::basic_output_sink_fd(int fd, size_t chunk_size) : _fd(fd), _chunk_size(chunk_size)
+{
+  _chunk.reserve(chunk_size + 4U);
+}
+
+template<typename C>
+ns::basic_output_sink_fd<C>::~basic_output_sink_fd()
+{
+  // Destructors must not throw, so any failure to write the remaining text is ignored
+  write_fd(_fd, _chunk.data(), _chunk.size());
+}
+
+template<typename C>
+void ns::basic_output_sink_fd<C>::write(const C* str, size_t length)
+{
+  append_chunk(_chunk, str, length);
+
+  if(_chunk.size() >= _chunk_size)
+  {
+    flush();
+  }
+}
+
+template<typename C>
+void ns::basic_output_sink_fd<C>::flush()
+{
+  if(!_chunk.empty())
+  {
+    const bool is_written = write_fd(_fd, _chunk.data(), _chunk.size());
+
+    _chunk.clear();
+
+    if(!is_written)
+    {
+      throw std::exception();//TODO: exception type and message
+    }
+  }
+}
+
+// Explicit instantiations for the narrow and wide character types
+template class ns::basic_output_sink_buffer<char>;
+template class ns::basic_output_sink_buffer<wchar_t>;
+template class ns::basic_output_sink_callback<char>;
+template class ns::basic_output_sink_callback<wchar_t>;
+template class ns::basic_output_sink_fd<char>;
+template class ns::basic_output_sink_fd<wchar_t>;
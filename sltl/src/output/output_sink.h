@@ -0,0 +1,149 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+#include <cstddef>
+
+
+namespace sltl
+{
+  // The destination of the text generated by an output action. The character type C is either char (UTF-8) or wchar_t.
+  template<typename C>
+  class basic_output_sink
+  {
+  public:
+    virtual ~basic_output_sink() = default;
+
+    virtual void write(const C* str, size_t length) = 0;
+
+    // Writes any text held by the sink to its destination
+    virtual void flush() {}
+  };
+
+  // Accumulates the generated text in a single growable contiguous buffer
+  template<typename C>
+  class basic_output_sink_buffer : public basic_output_sink<C>
+  {
+  public:
+    basic_output_sink_buffer() = default;
+    basic_output_sink_buffer(size_t capacity);
+
+    void write(const C* str, size_t length) override;
+
+    const std::basic_string<C>& get_buffer() const;
+
+    // Transfers the buffer's contents to the caller, leaving the buffer empty
+    std::basic_string<C> release();
+
+  private:
+    std::basic_string<C> _buffer;
+  };
+
+  // Passes the generated text to a user callback in chunks of (at most) the specified size
+  template<typename C>
+  class basic_output_sink_callback : public basic_output_sink<C>
+  {
+  public:
+    typedef std::function<void(const C* str, size_t length)> callback_t;
+
+    basic_output_sink_callback(callback_t callback, size_t chunk_size = chunk_size_default);
+    ~basic_output_sink_callback();
+
+    void write(const C* str, size_t length) override;
+    void flush() override;
+
+    static const size_t chunk_size_default = 4096U;
+
+  private:
+    callback_t _callback;
+    std::vector<C> _chunk;
+    size_t _chunk_length;
+  };
+
+  // Writes the generated text, encoded as UTF-8, to a file descriptor. The descriptor is not closed by the sink.
+  template<typename C>
+  class basic_output_sink_fd : public basic_output_sink<C>
+  {
+  public:
+    basic_output_sink_fd(int fd, size_t chunk_size = chunk_size_default);
+    ~basic_output_sink_fd();
+
+    void write(const C* str, size_t length) override;
+    void flush() override;
+
+    static const size_t chunk_size_default = 4096U;
+
+  private:
+    const int _fd;
+    std::string _chunk;
+    const size_t _chunk_size;
+  };
+
+  // A minimal stream used by output actions to write text directly to a sink
+  template<typename C>
+  class basic_output_stream
+  {
+  public:
+    basic_output_stream(basic_output_sink<C>& sink) : _sink(&sink) {}
+
+    basic_output_stream& operator<<(C ch)
+    {
+      _sink->write(&ch, 1U);
+      return *this;
+    }
+
+    basic_output_stream& operator<<(const C* str)
+    {
+      _sink->write(str, std::char_traits<C>::length(str));
+      return *this;
+    }
+
+    basic_output_stream& operator<<(const std::basic_string<C>& str)
+    {
+      _sink->write(str.data(), str.size());
+      return *this;
+    }
+
+    // Writes narrow ASCII text, widening each character when necessary
+    basic_output_stream& write_ascii(const char* str, size_t length)
+    {
+      C buffer[64];
+
+      while(length > 0U)
+      {
+        const size_t count = std::min(length, sizeof(buffer) / sizeof(C));
+
+        std::copy(str, str + count, buffer);
+        _sink->write(buffer, count);
+
+        str += count;
+        length -= count;
+      }
+
+      return *this;
+    }
+
+    void flush()
+    {
+      _sink->flush();
+    }
+
+  private:
+    basic_output_sink<C>* _sink;
+  };
+
+  typedef basic_output_sink<wchar_t>          output_sink;
+  typedef basic_output_sink_buffer<wchar_t>   output_sink_buffer;
+  typedef basic_output_sink_callback<wchar_t> output_sink_callback;
+  typedef basic_output_sink_fd<wchar_t>       output_sink_fd;
+  typedef basic_output_stream<wchar_t>        output_stream;
+
+  typedef basic_output_sink<char>          output_sink_narrow;
+  typedef basic_output_sink_buffer<char>   output_sink_buffer_narrow;
+  typedef basic_output_sink_callback<char> output_sink_callback_narrow;
+  typedef basic_output_sink_fd<char>       output_sink_fd_narrow;
+  typedef basic_output_stream<char>        output_stream_narrow;
+}
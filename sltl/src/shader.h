@@ -3,6 +3,9 @@
 #include "syntax/action.h"
 #include "syntax/tree.h"
 #include "syntax/block_manager.h"
+#include "syntax/specialization.h"
+#include "syntax/branch_pruning.h"
+#include "syntax/constant_folding.h"
 
 #include "io/io.h"
 
@@ -60,6 +63,27 @@ namespace sltl
       return apply_action_impl<Fn>(*this, is_error, std::forward<T>(t)...).get_result();
     }
 
+    // Applies an existing action, e.g. an output constructed with a user supplied output_sink
+    template<typename Fn, bool is_error = true>
+    auto apply_action(Fn& fn) -> typename std::enable_if<std::is_base_of<syntax::action, Fn>::value>::type
+    {
+      apply_action_impl(*this, fn, is_error);
+    }
+
+    template<typename Fn, bool is_error = true>
+    auto apply_action(Fn& fn) const -> typename std::enable_if<std::is_base_of<syntax::const_action, Fn>::value>::type
+    {
+      apply_action_impl(*this, fn, is_error);
+    }
+
+    // Substitutes the values of the bound uniforms, then removes any branches that can no longer be taken
+    void specialize(std::vector<syntax::uniform_binding> bindings)
+    {
+      apply_action<syntax::specialization>(std::move(bindings));
+      apply_action<syntax::constant_folding>();
+      apply_action<syntax::branch_pruning>();
+    }
+
     const core::shader_stage _stage;
 
   private:
@@ -67,13 +91,17 @@ namespace sltl
     static auto apply_action_impl(S& s, bool is_error, T&& ...t) -> typename std::enable_if<std::is_same<typename std::remove_const<S>::type, shader>::value, Fn>::type
     {
       Fn fn(s._stage, std::forward<T>(t)...);
+      apply_action_impl(s, fn, is_error);
+      return std::move(fn);
+    }
 
+    template<typename S, typename Fn>
+    static void apply_action_impl(S& s, Fn& fn, bool is_error)
+    {
       if(!s._tree->apply_action(fn) && is_error)
       {
         throw std::exception();//TODO: better exception type and message?
       }
-
-      return std::move(fn);
     }
 
     syntax::tree::ptr _tree;
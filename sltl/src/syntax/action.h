@@ -6,6 +6,7 @@ namespace sltl
 namespace syntax
 {
   // Forward declarations - sltl::syntax namespace
+  class tree;
   class block;
   class io_block;
   class variable_declaration;
@@ -15,6 +16,7 @@ namespace syntax
   class temporary;
   class operator_unary;
   class operator_binary;
+  class operator_ternary;
   class operator_component_access;
   class conditional;
   class constructor_call;
@@ -49,6 +51,7 @@ namespace syntax
     virtual action_return_t operator()(syntax::temporary&, bool is_start = true) { return get_default(is_start); }
     virtual action_return_t operator()(syntax::operator_unary&, bool is_start = true) { return get_default(is_start); }
     virtual action_return_t operator()(syntax::operator_binary&, bool is_start = true) { return get_default(is_start); }
+    virtual action_return_t operator()(syntax::operator_ternary&, bool is_start = true) { return get_default(is_start); }
     virtual action_return_t operator()(syntax::operator_component_access&, bool is_start = true) { return get_default(is_start); }
     virtual action_return_t operator()(syntax::conditional&, bool is_start = true) { return get_default(is_start); }
     virtual action_return_t operator()(syntax::constructor_call&, bool is_start = true) { return get_default(is_start); }
@@ -66,6 +69,9 @@ namespace syntax
       return (*this)(cd._t);
     }
 
+    // Called once the action has been applied to every node of the tree
+    virtual void complete(syntax::tree&) {}
+
   protected:
     virtual action_return_t operator()(float) { return get_default(false); }
     virtual action_return_t operator()(double) { return get_default(false); }
@@ -95,6 +101,7 @@ namespace syntax
     virtual action_return_t operator()(const syntax::temporary&, bool is_start = true) { return get_default(is_start); }
     virtual action_return_t operator()(const syntax::operator_unary&, bool is_start = true) { return get_default(is_start); }
     virtual action_return_t operator()(const syntax::operator_binary&, bool is_start = true) { return get_default(is_start); }
+    virtual action_return_t operator()(const syntax::operator_ternary&, bool is_start = true) { return get_default(is_start); }
     virtual action_return_t operator()(const syntax::operator_component_access&, bool is_start = true) { return get_default(is_start); }
     virtual action_return_t operator()(const syntax::conditional&, bool is_start = true) { return get_default(is_start); }
     virtual action_return_t operator()(const syntax::constructor_call&, bool is_start = true) { return get_default(is_start); }
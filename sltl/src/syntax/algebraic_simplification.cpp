@@ -0,0 +1,396 @@
+#include "algebraic_simplification.h"
+
+#include "operand.h"
+#include "literal.h"
+#include "reference.h"
+
+#include <type.h>
+
+#include <cmath>
+#include <algorithm>
+
+
+namespace
+{
+  using namespace sltl;
+  using namespace sltl::syntax;
+
+  // The largest exponent for which pow is replaced by repeated multiplication
+  const int pow_exponent_max = 5;
+
+  // Gets the value of a scalar literal or of a vector constructor whose arguments are all literals of the same value
+  bool get_constant(const expression& e, double& value)
+  {
+    auto fn_literal = [](const expression& l, double& v)
+    {
+      if((l.get_kind() == node_kind::literal) && (l.get_type().get_id() != language::id_bool))
+      {
+        v = visit_literal(l, [](const auto& lit) { return static_cast<double>(lit._t); });
+        return true;
+      }
+
+      return false;
+    };
+
+    if(auto t = node_cast<temporary>(&e))
+    {
+      return t->has_initializer() && get_constant(*(t->get_initializer()), value);
+    }
+    else if(auto cc = node_cast<constructor_call>(&e))
+    {
+      const expression_list& args = cc->get_args();
+
+      if(!cc->get_type().get_dimensions().is_vector() || (args.size() == 0U))
+      {
+        return false;
+      }
+
+      return std::all_of(args.begin(), args.end(), [&fn_literal, &value, is_first = true](const expression::ptr& arg) mutable
+      {
+        double v;
+
+        if(!fn_literal(*arg, v) || (!is_first && (v != value)))
+        {
+          return false;
+        }
+
+        value = v;
+        is_first = false;
+        return true;
+      });
+    }
+
+    return fn_literal(e, value);
+  }
+
+  // The declaration of the variable that is assigned to, ignoring any component access (e.g. 'v' for 'v.x = 1.0f')
+  const declaration* get_target(const expression& e)
+  {
+    if(auto oca = node_cast<operator_component_access>(&e))
+    {
+      return get_target(*(oca->_operand));
+    }
+    else if(auto r = node_cast<reference>(&e))
+    {
+      return &(r->_declaration);
+    }
+    else
+    {
+      return nullptr;
+    }
+  }
+
+  bool is_intrinsic(const expression& e, core::intrinsic i)
+  {
+    return (e.get_kind() == node_kind::intrinsic_call) && (static_cast<const intrinsic_call&>(e).get_intrinsic() == i);
+  }
+
+  expression::ptr simplify_pow(intrinsic_call& ic)
+  {
+    expression::ptr& x = *(ic.get_args().begin());
+    expression::ptr& y = *(ic.get_args().begin() + 1);
+
+    double exponent;
+
+    // The base is repeated once for each multiplication, so it must be cheap to evaluate
+    if((x->get_kind() == node_kind::reference) && get_constant(*y, exponent) && (exponent >= 1.0) && (exponent <= pow_exponent_max) && (std::trunc(exponent) == exponent))
+    {
+      const declaration& d = static_cast<const reference&>(*x)._declaration;
+      const language::operator_binary_id id = (x->get_type().get_dimensions().is_scalar() ? language::id_multiplication : language::id_element_wise_multiplication);
+
+      expression::ptr exp = std::move(x);
+
+      for(int i = 1; i < static_cast<int>(exponent); ++i)
+      {
+        exp = expression::make<operator_binary>(id, std::move(exp), expression::make<reference>(d));
+      }
+
+      return exp;
+    }
+
+    return nullptr;
+  }
+
+  expression::ptr simplify_reciprocal(operator_binary& ob)
+  {
+    language::operator_binary_id id;
+
+    switch(ob._operator_id)
+    {
+      case language::id_division:
+        id = language::id_multiplication;
+        break;
+      case language::id_vector_scalar_division:
+        id = language::id_vector_scalar_multiplication;
+        break;
+      case language::id_matrix_scalar_division:
+        id = language::id_matrix_scalar_multiplication;
+        break;
+      default:
+        return nullptr;
+    }
+
+    const language::type_id type_id = ob._operand_rhs->get_type().get_id();
+
+    if((ob._operand_rhs->get_kind() != node_kind::literal) || ((type_id != language::id_float) && (type_id != language::id_double)))
+    {
+      return nullptr;
+    }
+
+    expression::ptr reciprocal = visit_literal(*(ob._operand_rhs), [](const auto& l) -> expression::ptr
+    {
+      typedef std::decay_t<decltype(l._t)> value_t;
+
+      const value_t r = value_t(1) / l._t;
+
+      return (std::isfinite(r) && (r != value_t(0))) ? expression::make<literal<value_t>>(r) : nullptr;
+    });
+
+    return reciprocal ? expression::make<operator_binary>(id, std::move(ob._operand_lhs), std::move(reciprocal)) : nullptr;
+  }
+
+  expression::ptr simplify_identity(operator_binary& ob)
+  {
+    double identity;
+    bool is_commutative;
+
+    switch(ob._operator_id)
+    {
+      case language::id_addition:
+      case language::id_element_wise_addition:
+        identity = 0.0;
+        is_commutative = true;
+        break;
+      case language::id_subtraction:
+      case language::id_element_wise_subtraction:
+        identity = 0.0;
+        is_commutative = false;
+        break;
+      case language::id_multiplication:
+      case language::id_element_wise_multiplication:
+      case language::id_scalar_vector_multiplication:
+      case language::id_scalar_matrix_multiplication:
+      case language::id_vector_scalar_multiplication:
+      case language::id_matrix_scalar_multiplication:
+        identity = 1.0;
+        is_commutative = true;
+        break;
+      case language::id_division:
+      case language::id_element_wise_division:
+      case language::id_vector_scalar_division:
+      case language::id_matrix_scalar_division:
+        identity = 1.0;
+        is_commutative = false;
+        break;
+      default:
+        return nullptr;
+    }
+
+    // The remaining operand must have the type of the whole expression (e.g. 'f * vec3(1.0f)' is a vector, not a scalar)
+    auto fn_is_identity = [&ob, identity](const expression& operand_identity, const expression& operand)
+    {
+      double value;
+      return get_constant(operand_identity, value) && (value == identity) && (operand.get_type() == ob.get_type());
+    };
+
+    if(fn_is_identity(*(ob._operand_rhs), *(ob._operand_lhs)))
+    {
+      return std::move(ob._operand_lhs);
+    }
+    else if(is_commutative && fn_is_identity(*(ob._operand_lhs), *(ob._operand_rhs)))
+    {
+      return std::move(ob._operand_rhs);
+    }
+    else
+    {
+      return nullptr;
+    }
+  }
+
+  namespace ns = sltl::syntax;
+}
+
+ns::algebraic_simplification::algebraic_simplification(core::shader_stage, detail::enum_flags<simplification_flags> flags) : _flags(flags)
+{
+}
+
+// The operands of each node are simplified once the node has been stepped out of, so simplification proceeds from the leaves
+// towards the root. The statements are visited in order, so an assignment to a normalized variable is seen before later uses.
+
+ns::action_return_t ns::algebraic_simplification::operator()(variable_declaration& vd, bool is_start)
+{
+  if(!is_start)
+  {
+    simplify(vd);
+
+    bool is_normalized = false;
+
+    for_each_operand(vd, [&is_normalized](expression::ptr& initializer)
+    {
+      is_normalized = is_intrinsic(*initializer, core::intrinsic::normalize);
+    });
+
+    if(is_normalized)
+    {
+      _normalized.insert(&vd);
+    }
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::algebraic_simplification::operator()(temporary& t, bool is_start)
+{
+  if(!is_start)
+  {
+    simplify(t);
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::algebraic_simplification::operator()(operator_unary& ou, bool is_start)
+{
+  if(!is_start)
+  {
+    simplify(ou);
+    _normalized.erase(get_target(*(ou._operand)));
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::algebraic_simplification::operator()(operator_binary& ob, bool is_start)
+{
+  if(!is_start)
+  {
+    simplify(ob);
+
+    if(language::is_operator_assignment(ob._operator_id))
+    {
+      _normalized.erase(get_target(*(ob._operand_lhs)));
+    }
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::algebraic_simplification::operator()(operator_component_access& oca, bool is_start)
+{
+  if(!is_start)
+  {
+    simplify(oca);
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::algebraic_simplification::operator()(constructor_call& cc, bool is_start)
+{
+  if(!is_start)
+  {
+    simplify(cc);
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::algebraic_simplification::operator()(function_call& fc, bool is_start)
+{
+  if(!is_start)
+  {
+    simplify(fc);
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::algebraic_simplification::operator()(intrinsic_call& ic, bool is_start)
+{
+  if(!is_start)
+  {
+    simplify(ic);
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::algebraic_simplification::operator()(expression_statement& es, bool is_start)
+{
+  if(!is_start)
+  {
+    simplify(es);
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::algebraic_simplification::operator()(return_statement& rs, bool is_start)
+{
+  if(!is_start)
+  {
+    simplify(rs);
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::algebraic_simplification::get_default(bool is_start)
+{
+  return is_start ? action_return_t::step_in :
+                    action_return_t::step_out;
+}
+
+void ns::algebraic_simplification::simplify(node& n)
+{
+  for_each_operand(n, [this](expression::ptr& exp)
+  {
+    expression::ptr exp_simplified;
+
+    if(auto ob = node_cast<operator_binary>(exp.get()))
+    {
+      if(_flags.has_flag<simplification_flags::flag_identity>())
+      {
+        exp_simplified = simplify_identity(*ob);
+      }
+
+      if(!exp_simplified && _flags.has_flag<simplification_flags::flag_reciprocal>())
+      {
+        exp_simplified = simplify_reciprocal(*ob);
+      }
+    }
+    else if(is_intrinsic(*exp, core::intrinsic::pow) && _flags.has_flag<simplification_flags::flag_pow>())
+    {
+      exp_simplified = simplify_pow(static_cast<intrinsic_call&>(*exp));
+    }
+    else if(is_intrinsic(*exp, core::intrinsic::normalize) && _flags.has_flag<simplification_flags::flag_normalize>())
+    {
+      expression::ptr& x = *(static_cast<intrinsic_call&>(*exp).get_args().begin());
+
+      const bool is_normalized = is_intrinsic(*x, core::intrinsic::normalize) ||
+        ((x->get_kind() == node_kind::reference) && (_normalized.find(&(static_cast<const reference&>(*x)._declaration)) != _normalized.end()));
+
+      if(is_normalized)
+      {
+        exp_simplified = std::move(x);
+      }
+    }
+
+    if(exp_simplified)
+    {
+      exp = std::move(exp_simplified);
+    }
+  });
+}
+
+// non-member definitions
+
+sltl::detail::enum_flags<ns::simplification_flags> ns::operator|(sltl::detail::enum_flags<simplification_flags> lhs, ns::simplification_flags rhs)
+{
+  return lhs |= rhs;
+}
+
+sltl::detail::enum_flags<ns::simplification_flags> ns::operator&(sltl::detail::enum_flags<simplification_flags> lhs, ns::simplification_flags rhs)
+{
+  return lhs &= rhs;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "action.h"
+
+#include <core/shader_stage.h>
+
+#include <detail/enum_flags.h>
+
+#include <unordered_set>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // Forward declarations - sltl::syntax namespace
+  class node;
+  class declaration;
+
+  enum class simplification_flags
+  {
+    flag_none       = 0x0,
+    flag_pow        = 0x1, // pow(x, n) for a small integer n becomes a chain of n - 1 multiplications
+    flag_reciprocal = 0x2, // x / c becomes x * (1 / c) for a floating point constant c
+    flag_identity   = 0x4, // x + 0, x - 0, x * 1 and x / 1 become x
+    flag_normalize  = 0x8, // normalize(x) becomes x if x is already normalized
+    flag_all        = 0xF
+  };
+
+  // Rewrites expressions into cheaper but equivalent forms, each rewrite is enabled by one of the simplification flags
+  class algebraic_simplification : public action
+  {
+  public:
+    algebraic_simplification(algebraic_simplification&&) = default;
+    algebraic_simplification(core::shader_stage, detail::enum_flags<simplification_flags> flags = simplification_flags::flag_all);
+
+    // Non-copyable and non-assignable
+    algebraic_simplification(const algebraic_simplification&) = delete;
+    algebraic_simplification& operator=(algebraic_simplification&&) = delete;
+    algebraic_simplification& operator=(const algebraic_simplification&) = delete;
+
+    action_return_t operator()(variable_declaration& vd, bool is_start = true) override;
+    action_return_t operator()(temporary& t, bool is_start = true) override;
+    action_return_t operator()(operator_unary& ou, bool is_start = true) override;
+    action_return_t operator()(operator_binary& ob, bool is_start = true) override;
+    action_return_t operator()(operator_component_access& oca, bool is_start = true) override;
+    action_return_t operator()(constructor_call& cc, bool is_start = true) override;
+    action_return_t operator()(function_call& fc, bool is_start = true) override;
+    action_return_t operator()(intrinsic_call& ic, bool is_start = true) override;
+    action_return_t operator()(expression_statement& es, bool is_start = true) override;
+    action_return_t operator()(return_statement& rs, bool is_start = true) override;
+
+  protected:
+    action_return_t get_default(bool is_start) override;
+
+  private:
+    void simplify(node& n);
+
+    const detail::enum_flags<simplification_flags> _flags;
+
+    // Variables that were initialized with a normalized value and have not been assigned to since
+    std::unordered_set<const declaration*> _normalized;
+  };
+
+  // Overloaded bitwise operators make the detail::enum_flags helper class more useful
+  detail::enum_flags<simplification_flags> operator|(detail::enum_flags<simplification_flags> lhs, simplification_flags rhs);
+  detail::enum_flags<simplification_flags> operator&(detail::enum_flags<simplification_flags> lhs, simplification_flags rhs);
+}
+}
@@ -0,0 +1,172 @@
+#include "arena.h"
+
+#include <new>
+#include <algorithm>
+
+#include <cassert>
+
+
+namespace
+{
+  namespace ns = sltl::syntax;
+
+  // Each node allocation is prefixed with a header recording the arena it was allocated
+  // from. The header size is a multiple of the fundamental alignment so the node itself
+  // remains suitably aligned.
+  const size_t header_size = alignof(std::max_align_t);
+
+  static_assert(header_size >= sizeof(ns::arena*), "sltl::syntax::arena: allocation header is too small");
+
+  size_t align_size(size_t size)
+  {
+    return (size + (header_size - 1U)) & ~(header_size - 1U);
+  }
+
+  thread_local ns::arena* arena_current = nullptr;
+  thread_local std::unique_ptr<ns::arena> arena_cache;
+}
+
+const size_t ns::arena::chunk_size_min;
+const size_t ns::arena::chunk_size_max;
+
+ns::arena::arena() : _chunk_current(0U), _chunk_offset(0U), _size(0U)
+{
+}
+
+void* ns::arena::allocate(size_t size)
+{
+  size = align_size(size);
+
+  while(_chunk_current < _chunks.size())
+  {
+    chunk& c = _chunks[_chunk_current];
+
+    if((c._size - _chunk_offset) >= size)
+    {
+      void* p = c._data.get() + _chunk_offset;
+
+      _chunk_offset += size;
+      _size += size;
+
+      return p;
+    }
+
+    // The remainder of the current chunk is wasted, move on to the next chunk (if any)
+    ++_chunk_current;
+    _chunk_offset = 0U;
+  }
+
+  // Each new chunk is double the size of its predecessor, up to a maximum size. Allocations
+  // that are larger than this maximum are given a chunk of their own.
+  const size_t chunk_size = std::max(size, _chunks.empty() ? chunk_size_min : std::min(_chunks.back()._size * 2U, chunk_size_max));
+
+  _chunks.push_back({ std::unique_ptr<unsigned char[]>(new unsigned char[chunk_size]), chunk_size });
+
+  _chunk_current = _chunks.size() - 1U;
+  _chunk_offset = size;
+  _size += size;
+
+  return _chunks.back()._data.get();
+}
+
+void ns::arena::reset()
+{
+  _chunk_current = 0U;
+  _chunk_offset = 0U;
+  _size = 0U;
+}
+
+size_t ns::arena::get_size() const
+{
+  return _size;
+}
+
+size_t ns::arena::get_capacity() const
+{
+  size_t capacity = 0U;
+
+  for(const chunk& c : _chunks)
+  {
+    capacity += c._size;
+  }
+
+  return capacity;
+}
+
+ns::arena::ptr ns::arena::make()
+{
+  if(arena_cache)
+  {
+    return ptr(arena_cache.release());
+  }
+  else
+  {
+    return ptr(new arena());
+  }
+}
+
+void ns::arena::clear_cache()
+{
+  arena_cache.reset();
+}
+
+void ns::arena::recycler::operator()(arena* a) const
+{
+  std::unique_ptr<arena> a_owner(a);
+
+  // Only a single arena is retained per thread, the largest arena is kept
+  if(!arena_cache || (arena_cache->get_capacity() < a->get_capacity()))
+  {
+    a->reset();
+    arena_cache = std::move(a_owner);
+  }
+}
+
+ns::arena_manager::arena_manager() : _arena(arena::make()), _arena_prev(arena_current)
+{
+  arena_current = _arena.get();
+}
+
+ns::arena_manager::~arena_manager()
+{
+  arena_current = _arena_prev;
+}
+
+ns::arena::ptr ns::arena_manager::transfer()
+{
+  assert(_arena);
+
+  return std::move(_arena);
+}
+
+ns::arena* ns::get_current_arena()
+{
+  return arena_current;
+}
+
+void* ns::allocate_node(size_t size)
+{
+  arena* const a = arena_current;
+
+  unsigned char* const p = static_cast<unsigned char*>(a ?
+    a->allocate(header_size + size) :
+    ::operator new(header_size + size));
+
+  new(p) arena*(a);
+
+  return p + header_size;
+}
+
+void ns::deallocate_node(void* p)
+{
+  if(p)
+  {
+    unsigned char* const p_header = static_cast<unsigned char*>(p) - header_size;
+
+    // Memory allocated from an arena is only released when the arena itself is reset or destroyed
+    if(!*reinterpret_cast<arena**>(p_header))
+    {
+      ::operator delete(p_header);
+    }
+  }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <detail/scoped_singleton.h>
+
+#include <memory>
+#include <vector>
+
+#include <cstddef>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // A monotonic allocator used to store the nodes of a syntax tree. Memory is only
+  // released in bulk, either when the arena is reset or when it is destroyed.
+  class arena
+  {
+  public:
+    // Arenas are recycled, rather than deleted, so that successive trees built on
+    // the same thread can reuse the memory already reserved by a previous tree
+    struct recycler
+    {
+      void operator()(arena* a) const;
+    };
+
+    typedef std::unique_ptr<arena, recycler> ptr;
+
+    arena();
+
+    // Non-copyable, non-movable and non-assignable
+    arena(arena&&) = delete;
+    arena(const arena&) = delete;
+    arena& operator=(arena&&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    void* allocate(size_t size);
+
+    // Rewinds the arena to its first chunk, retaining all of the memory it has reserved.
+    // Any objects still allocated from the arena must already have been destroyed.
+    void reset();
+
+    size_t get_size() const;
+    size_t get_capacity() const;
+
+    // Returns the calling thread's recycled arena if there is one, otherwise a new arena
+    static ptr make();
+
+    // Releases the memory held by the calling thread's recycled arena (if any)
+    static void clear_cache();
+
+    static const size_t chunk_size_min = 16U * 1024U;
+    static const size_t chunk_size_max = 1024U * 1024U;
+
+  private:
+    struct chunk
+    {
+      std::unique_ptr<unsigned char[]> _data;
+      size_t _size;
+    };
+
+    std::vector<chunk> _chunks;
+
+    size_t _chunk_current;
+    size_t _chunk_offset;
+    size_t _size;
+  };
+
+  class arena_manager
+  {
+  public:
+    arena_manager();
+    ~arena_manager();
+
+    // Non-copyable, non-movable and non-assignable
+    arena_manager(arena_manager&&) = delete;
+    arena_manager(const arena_manager&) = delete;
+    arena_manager& operator=(arena_manager&&) = delete;
+    arena_manager& operator=(const arena_manager&) = delete;
+
+    // Transfers ownership of the arena, and therefore the memory of every node allocated
+    // from it, to the caller. Nodes created before this manager is destroyed will still
+    // be allocated from the transferred arena.
+    arena::ptr transfer();
+
+  private:
+    arena::ptr _arena;
+    arena* _arena_prev;
+  };
+
+  arena* get_current_arena();
+
+  // Allocation functions used by the class-specific operator new/delete overloads of syntax
+  // tree types. Memory is taken from the current arena when an arena_manager is active on
+  // the calling thread, otherwise it is taken from the free store.
+  void* allocate_node(size_t size);
+  void deallocate_node(void* p);
+
+  typedef detail::scoped_singleton<arena_manager, detail::scope_t::thread> arena_manager_guard;
+}
+}
@@ -4,6 +4,8 @@
 
 #include <sstream>
 
+#include <cassert>
+
 
 namespace
 {
@@ -16,13 +18,13 @@ namespace
 //3. not all scopes need to append their names to ensure uniqueness e.g.shader and function scopes can avoid appending the scopes name and still be unqiue
 //TODO: move the name generation logic into a separate namespace/file (like language), also need a special prefix (not s) for scopes
 
-ns::block::block(type t) : block_base((t == local) ? nullptr : L"root"), _t(t)
+ns::block::block(type t) : block_base(node_kind::block, (t == local) ? nullptr : L"root"), _t(t), _parent(nullptr), _scope(nullptr)
 {
 }
 
 ns::statement& ns::block::add_impl(statement::ptr&& s)
 {
-  auto b = dynamic_cast<const block*>(s.get());
+  auto b = node_cast<const block>(s.get());
 
   if(b && (b->_t == block::global))
   {
@@ -34,7 +36,10 @@ ns::statement& ns::block::add_impl(statement::ptr&& s)
 
 ns::variable_declaration& ns::block::add_variable_declaration(std::wstring&& name, expression::ptr&& initializer)
 {
-  return add_variable_declaration_impl(statement::make<variable_declaration>(std::move(name), std::move(initializer)));
+  auto& vd = add_variable_declaration_impl(statement::make<variable_declaration>(std::move(name), std::move(initializer)));
+  symbol_add(vd._name);
+
+  return vd;
 }
 
 ns::variable_declaration& ns::block::add_variable_declaration(std::wstring&& name, const sltl::language::type& type, sltl::core::semantic_pair semantic)
@@ -44,17 +49,52 @@ ns::variable_declaration& ns::block::add_variable_declaration(std::wstring&& nam
     throw std::exception();//TODO: exception type and message
   }
 
-  return add_variable_declaration_impl(statement::make<variable_declaration>(std::move(name), type, core::qualifier_storage::none, semantic));
+  auto& vd = add_variable_declaration_impl(statement::make<variable_declaration>(std::move(name), type, core::qualifier_storage::none, semantic));
+  symbol_add(vd._name);
+
+  return vd;
 }
 
 void ns::block::push()
 {
   block_manager_guard()->push({}, *this);
+
+  // Variables declared before the block was pushed become visible to lookups within the enclosing scope
+  for(auto& v : _variable_map)
+  {
+    symbol_add(v.first);
+  }
 }
 
 void ns::block::pop()
 {
   block_manager_guard()->pop({}, *this);
+
+  for(auto& v : _variable_map)
+  {
+    symbol_remove(v.first);
+  }
+
+  _parent = nullptr;
+  _scope = nullptr;
+}
+
+void ns::block::erase(const statement& s)
+{
+  if(auto vd = node_cast<const variable_declaration>(&s))
+  {
+    symbol_remove(vd->_name);
+  }
+
+  block_base::erase(s);
+}
+
+ns::variable_declaration& ns::block::insert_variable_declaration(const statement& s, expression::ptr&& initializer)
+{
+  auto& vd = block_base::insert_variable_declaration(s, std::move(initializer));
+  symbol_add(vd._name);
+
+  return vd;
 }
 
 std::wstring ns::block::get_child_name()
@@ -72,38 +112,59 @@ std::wstring ns::block::get_child_name()
 
 ns::variable_info* ns::block::variable_info_find(const std::wstring& name)
 {
-  return variable_info_find(name, block_manager_guard()->get_block_stack());
-}
-
-ns::variable_info* ns::block::variable_info_find(const std::wstring& name, std::stack<std::reference_wrapper<block>> block_stack)
-{
-  if(block_stack.empty() || (block_stack.top().get() != *this))
+  if(!_scope || (&(block_manager_guard()->get_block()) != this))
   {
     throw std::exception();//TODO: exception type and message
   }
 
-  variable_info* vi = block_base::variable_info_find(name);
+  // Only 'local' blocks are nested within their parent statements, so the symbol table of the nearest
+  // 'global' block holds exactly the variables visible from this block (variable names are unique)
+  auto it = _scope->_symbols.find(name);
 
-  if(!vi && (_t == block::local)) // Only 'local' blocks are nested within their parent statements
+  if(it != _scope->_symbols.end())
+  {
+    return it->second;
+  }
+  else
   {
-    block_stack.pop();
+    return nullptr;
+  }
+}
 
-    if(!block_stack.empty())
+size_t ns::block::get_symbol_count() const
+{
+  return _symbols.size();
+}
+
+void ns::block::symbol_add(const std::wstring& name)
+{
+  if(_scope)
+  {
+    variable_info* vi = block_base::variable_info_find(name);
+
+    assert(vi);
+
+    if(!(_scope->_symbols.emplace(name, vi).second))
     {
-      auto& parent_block = block_stack.top().get();
-      vi  = parent_block.variable_info_find(name, std::move(block_stack));
+      throw std::exception();//TODO: exception type and message
     }
   }
+}
 
-  return vi;
+void ns::block::symbol_remove(const std::wstring& name)
+{
+  if(_scope)
+  {
+    _scope->_symbols.erase(name);
+  }
 }
 
 bool ns::block::apply_action(action& act)
 {
-  return apply_action_impl(act, *this, _statements.begin(), _statements.end());
+  return apply_action_impl(act, *this, begin(), end());
 }
 
 bool ns::block::apply_action(const_action& cact) const
 {
-  return apply_action_impl(cact, *this, _statements.begin(), _statements.end());
+  return apply_action_impl(cact, *this, begin(), end());
 }
@@ -2,7 +2,7 @@
 
 #include "block_base.h"
 
-#include <stack>
+#include <unordered_map>
 
 
 namespace sltl
@@ -15,6 +15,8 @@ namespace syntax
 
   class block : public block_base
   {
+    friend class block_manager;
+
   public:
     enum type
     {
@@ -27,8 +29,20 @@ namespace syntax
     void push() override;
     void pop() override;
 
+    void erase(const statement& s) override;
+
+    variable_declaration& insert_variable_declaration(const statement& s, expression::ptr&& initializer) override;
+
     variable_info* variable_info_find(const std::wstring& name) override;
 
+    // The number of variables in the symbol table of a 'global' block, i.e. those visible from the blocks pushed within it
+    size_t get_symbol_count() const;
+
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::block);
+    }
+
     bool apply_action(action& act) override;
     bool apply_action(const_action& cact) const override;
 
@@ -43,7 +57,15 @@ namespace syntax
     std::wstring get_child_name() override;
 
   private:
-    variable_info* variable_info_find(const std::wstring& name, std::stack<std::reference_wrapper<block>> block_stack);
+    void symbol_add(const std::wstring& name);
+    void symbol_remove(const std::wstring& name);
+
+    // Links to the enclosing block and to the nearest 'global' block, only valid while the block is pushed
+    block* _parent;
+    block* _scope;
+
+    // The variables of every block pushed within a 'global' block, only used by 'global' blocks
+    std::unordered_map<std::wstring, variable_info*> _symbols;
   };
 }
 }
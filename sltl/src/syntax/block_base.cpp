@@ -1,4 +1,5 @@
 #include "block_base.h"
+#include "type_cache.h"
 #include "block_manager.h"
 
 #include <algorithm>
@@ -9,8 +10,8 @@ namespace
   namespace ns = sltl::syntax;
 }
 
-ns::block_base::block_base(std::wstring&& name) : _current_child_id(0), _name(std::move(name)) {}
-ns::block_base::block_base(const wchar_t* name) : block_base(name ? name : ns::get_current_block().get_child_name()) {}
+ns::block_base::block_base(node_kind kind, std::wstring&& name) : statement(kind), _statements_erased(0), _current_child_id(0), _name(std::move(name)) {}
+ns::block_base::block_base(node_kind kind, const wchar_t* name) : block_base(kind, name ? name : ns::get_current_block().get_child_name()) {}
 
 ns::statement& ns::block_base::add_impl(statement::ptr&& s)
 {
@@ -25,7 +26,7 @@ ns::variable_declaration& ns::block_base::add_variable_declaration_impl(statemen
   auto& vd_statement = _statements.back();
   auto& vd = static_cast<variable_declaration&>(*vd_statement);
 
-  auto result = _variable_map.emplace(vd._name, variable_info());
+  auto result = _variable_map.emplace(vd._name, variable_info(_statements.size() - 1));
 
   if(!(result.second))
   {
@@ -37,36 +38,153 @@ ns::variable_declaration& ns::block_base::add_variable_declaration_impl(statemen
 
 void ns::block_base::erase(const statement& s)
 {
+  size_t statement_index;
+
   // Remove the associated variable_info data if the erased statement is a variable_declaration
-  if(auto vd = dynamic_cast<const variable_declaration*>(&s))
+  if(auto vd = node_cast<const variable_declaration>(&s))
   {
     auto it = _variable_map.find(vd->_name);
 
-    assert(it != _variable_map.end());
+    if((it == _variable_map.end()) || (_statements[it->second.get_statement_index()].get() != &s))
+    {
+      throw std::exception();//TODO: exception type and message
+    }
+
     assert(it->second.get_ref() == 0);
 
+    statement_index = it->second.get_statement_index();
+
     _variable_map.erase(it);
   }
   else
+  {
+    auto it = std::find_if(_statements.begin(), _statements.end(), [&s](const statement::ptr& sp)
+    {
+      return (sp.get() == &s);
+    });
+
+    if(it == _statements.end())
+    {
+      throw std::exception();//TODO: exception type and message
+    }
+
+    statement_index = std::distance(_statements.begin(), it);
+  }
+
+  if(statement_index == (_statements.size() - 1))
+  {
+    _statements.pop_back();
+
+    // Remove any previously erased statements that are now at the back
+    while(!_statements.empty() && !_statements.back())
+    {
+      _statements.pop_back();
+      --_statements_erased;
+    }
+  }
+  else
+  {
+    // The statement is replaced with a null pointer, so the indices of the other statements are unchanged
+    _statements[statement_index].reset();
+
+    if(++_statements_erased > (_statements.size() / 2))
+    {
+      compact();
+    }
+  }
+
+  type_cache::invalidate();
+}
+
+void ns::block_base::replace(const statement& s, statement::ptr&& replacement)
+{
+  // Replacing a variable_declaration would invalidate its variable_info data
+  if(node_cast<const variable_declaration>(&s) || node_cast<const variable_declaration>(replacement.get()))
   {
     throw std::exception();//TODO: exception type and message
   }
 
-  auto it = std::find_if(_statements.rbegin(), _statements.rend(), [&s](const statement::ptr& s_find)
+  auto it = std::find_if(_statements.begin(), _statements.end(), [&s](const statement::ptr& sp)
   {
-    return (s_find.get() == &s);
+    return (sp.get() == &s);
   });
 
-  if(it != _statements.rend())
+  if(it == _statements.end())
   {
-    // Calls to std::next and base are required to convert
-    // the reverse_iterator back into a 'forward' iterator
-    _statements.erase(std::next(it).base());
+    throw std::exception();//TODO: exception type and message
   }
-  else
+
+  *it = std::move(replacement);
+
+  type_cache::invalidate();
+}
+
+void ns::block_base::insert(const statement& s, statement::ptr&& st)
+{
+  // Inserting a variable_declaration requires its variable_info data to be added (see insert_variable_declaration)
+  if(node_cast<const variable_declaration>(st.get()))
   {
     throw std::exception();//TODO: exception type and message
   }
+
+  insert_impl(s, std::move(st));
+}
+
+ns::variable_declaration& ns::block_base::insert_variable_declaration(const statement& s, expression::ptr&& initializer)
+{
+  auto it = insert_impl(s, statement::make<variable_declaration>(get_child_name(), std::move(initializer)));
+  const size_t statement_index = std::distance(_statements.begin(), it);
+
+  auto& vd = static_cast<variable_declaration&>(**it);
+
+  if(!(_variable_map.emplace(vd._name, variable_info(statement_index)).second))
+  {
+    throw std::exception();//TODO: exception type and message
+  }
+
+  return vd;
+}
+
+std::vector<ns::statement::ptr>::iterator ns::block_base::insert_impl(const statement& s, statement::ptr&& st)
+{
+  auto it = std::find_if(_statements.begin(), _statements.end(), [&s](const statement::ptr& sp)
+  {
+    return (sp.get() == &s);
+  });
+
+  if(it == _statements.end())
+  {
+    throw std::exception();//TODO: exception type and message
+  }
+
+  const size_t statement_index = std::distance(_statements.begin(), it);
+
+  // Every statement from the insertion point onwards moves back by one position
+  for(auto& v : _variable_map)
+  {
+    if(v.second.get_statement_index() >= statement_index)
+    {
+      v.second.set_statement_index(v.second.get_statement_index() + 1);
+    }
+  }
+
+  type_cache::invalidate();
+
+  return _statements.insert(it, std::move(st));
+}
+
+void ns::block_base::compact()
+{
+  _statements.erase(std::remove(_statements.begin(), _statements.end(), nullptr), _statements.end());
+  _statements_erased = 0;
+
+  for(size_t i = 0; i < _statements.size(); ++i)
+  {
+    if(auto vd = node_cast<const variable_declaration>(_statements[i].get()))
+    {
+      _variable_map.at(vd->_name).set_statement_index(i);
+    }
+  }
 }
 
 ns::variable_info* ns::block_base::variable_info_find(const std::wstring& name)
@@ -6,9 +6,10 @@
 
 #include <detail/conditional_traits.h>
 
-#include <map>
 #include <vector>
+#include <iterator>
 #include <string>
+#include <unordered_map>
 
 
 namespace sltl
@@ -18,6 +19,68 @@ namespace syntax
   class block_base : public statement
   {
   public:
+    // Iterates over the statements of a block, skipping any statements that have been erased
+    class const_iterator
+    {
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef statement::ptr value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const statement::ptr* pointer;
+      typedef const statement::ptr& reference;
+
+      const_iterator(std::vector<statement::ptr>::const_iterator it, std::vector<statement::ptr>::const_iterator it_end) : _it(it), _it_end(it_end)
+      {
+        skip_erased();
+      }
+
+      reference operator*() const
+      {
+        return *_it;
+      }
+
+      pointer operator->() const
+      {
+        return &(*_it);
+      }
+
+      const_iterator& operator++()
+      {
+        ++_it;
+        skip_erased();
+        return *this;
+      }
+
+      const_iterator operator++(int)
+      {
+        const_iterator it(*this);
+        ++(*this);
+        return it;
+      }
+
+      bool operator==(const const_iterator& rhs) const
+      {
+        return (_it == rhs._it);
+      }
+
+      bool operator!=(const const_iterator& rhs) const
+      {
+        return (_it != rhs._it);
+      }
+
+    private:
+      void skip_erased()
+      {
+        while((_it != _it_end) && !(*_it))
+        {
+          ++_it;
+        }
+      }
+
+      std::vector<statement::ptr>::const_iterator _it;
+      std::vector<statement::ptr>::const_iterator _it_end;
+    };
+
     template<typename T, typename ...A>
     auto add(A&&... a) -> typename std::enable_if<std::is_same<T, variable_declaration>::value, T&>::type
     {
@@ -38,16 +101,25 @@ namespace syntax
     virtual void push() = 0;
     virtual void pop() = 0;
 
-    void erase(const statement& s);
+    virtual void erase(const statement& s);
+
+    // Replaces the statement 's', which must not be a variable_declaration, with the statement 'replacement'
+    void replace(const statement& s, statement::ptr&& replacement);
 
-    std::vector<statement::ptr>::const_iterator begin() const
+    // Inserts the statement 'st', which must not be a variable_declaration, immediately before the statement 's'
+    void insert(const statement& s, statement::ptr&& st);
+
+    // Declares a new variable, with an automatically generated name, immediately before the statement 's'
+    virtual variable_declaration& insert_variable_declaration(const statement& s, expression::ptr&& initializer);
+
+    const_iterator begin() const
     {
-      return _statements.begin();
+      return const_iterator(_statements.begin(), _statements.end());
     }
 
-    std::vector<statement::ptr>::const_iterator end() const
+    const_iterator end() const
     {
-      return _statements.end();
+      return const_iterator(_statements.end(), _statements.end());
     }
 
     bool operator==(const block_base& rhs) const;
@@ -55,9 +127,14 @@ namespace syntax
 
     virtual variable_info* variable_info_find(const std::wstring& name);
 
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::block) || (kind == node_kind::io_block);
+    }
+
   protected:
-    block_base(std::wstring&& name);
-    block_base(const wchar_t* name);
+    block_base(node_kind kind, std::wstring&& name);
+    block_base(node_kind kind, const wchar_t* name);
 
     virtual statement& add_impl(statement::ptr&& s);
 
@@ -69,13 +146,18 @@ namespace syntax
     const std::wstring& get_name() const;
     virtual std::wstring get_child_name();
 
+    // Erased statements are replaced by null pointers, which are removed once they make up half of the statements
     std::vector<statement::ptr> _statements;
+    std::unordered_map<std::wstring, variable_info> _variable_map;
 
   private:
+    std::vector<statement::ptr>::iterator insert_impl(const statement& s, statement::ptr&& st);
+
+    void compact();
+
+    size_t _statements_erased;
     size_t _current_child_id;
     const std::wstring _name;
-
-    std::map<std::wstring, variable_info> _variable_map;
   };
 }
 }
@@ -27,58 +27,56 @@ namespace
   namespace ns = sltl::syntax;
 }
 
+ns::block_manager::block_manager() : _block_top(nullptr)
+{
+}
+
 ns::block_manager::~block_manager()
 {
-  assert(_block_stack.empty());
+  assert(!_block_top);
 }
 
 void ns::block_manager::push(sltl::detail::pass_key<block>, block& b)
 {
-  block_stack_t block_stack_copy = get_block_stack();
-
   // Ensure the passed block has not already been pushed onto the stack
-  while(!block_stack_copy.empty())
+  if(b._scope)
   {
-    if(block_stack_copy.top().get() == b)
-    {
-      throw std::exception();//TODO: exception type and message
-    }
-    else
-    {
-      block_stack_copy.pop();
-    }
+    throw std::exception();//TODO: exception type and message
   }
 
   // Ensure that 'local' blocks have a 'global' ancestor
-  if((b._t == block::local) && _block_stack.empty())
+  if((b._t == block::local) && !_block_top)
   {
     throw std::exception();//TODO: exception type and message
   }
 
-  _block_stack.emplace(b);
+  b._parent = _block_top;
+  b._scope = (b._t == block::local) ? _block_top->_scope : &b;
+
+  _block_top = &b;
 }
 
 void ns::block_manager::pop(sltl::detail::pass_key<block>, block& b)
 {
-  if(_block_stack.empty() ||
-     _block_stack.top().get() != b)
+  if(!_block_top ||
+     *_block_top != b)
   {
     throw std::exception();//TODO: exception type and message
   }
 
-  _block_stack.pop();
+  _block_top = b._parent;
 }
 
 ns::block& ns::block_manager::get_block()
 {
-  assert(!_block_stack.empty());
+  assert(_block_top);
 
-  return _block_stack.top();
+  return *_block_top;
 }
 
-ns::block_manager::block_stack_t ns::block_manager::get_block_stack() const
+bool ns::block_manager::is_empty() const
 {
-  return _block_stack;
+  return !_block_top;
 }
 
 bool ns::is_override_active()
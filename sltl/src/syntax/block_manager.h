@@ -3,9 +3,6 @@
 #include <detail/pass_key.h>
 #include <detail/scoped_singleton.h>
 
-#include <stack>
-#include <functional>
-
 
 namespace sltl
 {
@@ -17,19 +14,20 @@ namespace syntax
 
   class block_manager
   {
-    typedef std::stack<std::reference_wrapper<block>> block_stack_t;
-
   public:
+    block_manager();
     ~block_manager();
 
     void push(detail::pass_key<block>, block& b);
     void pop(detail::pass_key<block>, block& b);
 
     block& get_block();
-    block_stack_t get_block_stack() const;
+
+    bool is_empty() const;
 
   private:
-    block_stack_t _block_stack;
+    // The top of the block stack, blocks below it are reached through their parent links
+    block* _block_top;
   };
 
   bool is_override_active();
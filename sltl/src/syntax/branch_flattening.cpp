@@ -0,0 +1,314 @@
+#include "branch_flattening.h"
+
+#include "block.h"
+#include "operand.h"
+#include "reference.h"
+#include "conditional.h"
+
+#include <unordered_map>
+#include <algorithm>
+#include <iterator>
+
+#include <cassert>
+
+
+namespace
+{
+  using namespace sltl;
+  using namespace sltl::syntax;
+
+  typedef std::unordered_map<const declaration*, const declaration*> declaration_map;
+
+  // The 'if' followed by each of its 'else if' and 'else' conditionals
+  std::vector<conditional*> get_chain(conditional& c)
+  {
+    std::vector<conditional*> chain;
+
+    for(conditional* c_next = &c; c_next; c_next = node_cast<conditional>(c_next->get_statement_else()))
+    {
+      chain.push_back(c_next);
+    }
+
+    return chain;
+  }
+
+  bool is_pure(node& n)
+  {
+    switch(n.get_kind())
+    {
+      case node_kind::operator_unary:
+      case node_kind::function_call:
+        return false;
+      case node_kind::operator_binary:
+        if(language::is_operator_assignment(static_cast<operator_binary&>(n)._operator_id))
+        {
+          return false;
+        }
+        break;
+      default:
+        break;
+    }
+
+    bool is_operand_pure = true;
+
+    for_each_operand(n, [&is_operand_pure](expression::ptr& operand)
+    {
+      is_operand_pure = is_operand_pure && is_pure(*operand);
+    });
+
+    return is_operand_pure;
+  }
+
+  // Gets the operator that a compound assignment applies before assigning (e.g. '+' for '+=')
+  bool get_operator_arithmetic(const operator_binary& ob, language::operator_binary_id& id)
+  {
+    const bool is_matrix = ob._operand_lhs->get_type().get_dimensions().is_matrix();
+
+    switch(ob._operator_id)
+    {
+      case language::id_assignment_addition:
+        id = is_matrix ? language::id_element_wise_addition : language::id_addition;
+        return true;
+      case language::id_assignment_subtraction:
+        id = is_matrix ? language::id_element_wise_subtraction : language::id_subtraction;
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  // Gets the assignment of an expression statement of the form 'x = e' or 'x op= e' (where x is a variable)
+  operator_binary* get_assignment(statement& s)
+  {
+    operator_binary* ob = nullptr;
+
+    if(s.get_kind() == node_kind::expression_statement)
+    {
+      for_each_operand(s, [&ob](expression::ptr& e)
+      {
+        ob = node_cast<operator_binary>(e.get());
+      });
+    }
+
+    return (ob && language::is_operator_assignment(ob->_operator_id) && node_cast<reference>(ob->_operand_lhs.get())) ? ob : nullptr;
+  }
+
+  const declaration& get_declaration(const expression& e)
+  {
+    return static_cast<const reference&>(e)._declaration;
+  }
+
+  void substitute(expression::ptr& e, const declaration_map& declarations)
+  {
+    if(auto r = node_cast<reference>(e.get()))
+    {
+      auto it = declarations.find(&(r->_declaration));
+
+      if(it != declarations.end())
+      {
+        e = expression::make<reference>(*(it->second));
+      }
+    }
+    else
+    {
+      for_each_operand(*e, [&declarations](expression::ptr& operand)
+      {
+        substitute(operand, declarations);
+      });
+    }
+  }
+
+  // Moves the statements of each branch before the conditional. The local variables of a branch are declared (and so
+  // evaluated) whether or not it is taken, while each assignment to any other variable selects the assigned value if
+  // the branch is taken and the variable's current value otherwise. The conditions are all evaluated beforehand.
+  void flatten(block_base& b, conditional& c)
+  {
+    const std::vector<conditional*> chain = get_chain(c);
+    const size_t condition_count = chain.size() - ((chain.back()->_id == language::id_else) ? 1U : 0U);
+
+    const block& b_first = static_cast<const block&>(*(c.get_statement()));
+    const bool is_condition_inlined = (chain.size() == 1U) && (std::distance(b_first.begin(), b_first.end()) == 1);
+
+    expression::ptr condition;
+    std::vector<const declaration*> guards;
+
+    // A lone 'if' with a single statement evaluates its condition at most once so doesn't need to store it
+    if(is_condition_inlined)
+    {
+      condition = c.move();
+    }
+    else
+    {
+      for(size_t i = 0; i < condition_count; ++i)
+      {
+        guards.push_back(&(b.insert_variable_declaration(c, chain[i]->move())));
+      }
+    }
+
+    auto fn_guard = [&condition, &guards, is_condition_inlined](size_t i)
+    {
+      return (is_condition_inlined ? std::move(condition) : expression::make<reference>(*(guards[i])));
+    };
+
+    for(size_t i = 0; i < chain.size(); ++i)
+    {
+      declaration_map locals;
+
+      for(const statement::ptr& s : static_cast<block&>(*(chain[i]->get_statement())))
+      {
+        if(auto vd = node_cast<variable_declaration>(s.get()))
+        {
+          expression::ptr initializer = vd->move();
+          substitute(initializer, locals);
+
+          locals.emplace(vd, &(b.insert_variable_declaration(c, std::move(initializer))));
+          continue;
+        }
+
+        operator_binary* ob = get_assignment(*s);
+        assert(ob);
+
+        substitute(ob->_operand_rhs, locals);
+
+        const declaration& target = get_declaration(*(ob->_operand_lhs));
+        auto it = locals.find(&target);
+
+        if(it != locals.end())
+        {
+          // Assignments to local variables don't need to be selected as the variables are only used by the branch
+          ob->_operand_lhs = expression::make<reference>(*(it->second));
+          b.insert(c, statement::make<expression_statement>(static_cast<expression_statement&>(*s).move()));
+          continue;
+        }
+
+        expression::ptr value;
+
+        if(ob->_operator_id == language::id_assignment)
+        {
+          value = std::move(ob->_operand_rhs);
+        }
+        else
+        {
+          language::operator_binary_id id;
+
+          if(!get_operator_arithmetic(*ob, id))
+          {
+            assert(false);
+            throw std::exception();//TODO: exception type and message
+          }
+
+          value = expression::make<operator_binary>(id, expression::make<reference>(target), std::move(ob->_operand_rhs));
+        }
+
+        // The branch is taken if its own condition is true and the conditions of the preceding branches are false
+        const size_t j = std::min(i, condition_count - 1U);
+
+        expression::ptr select = ((i < condition_count) ?
+          expression::make<operator_ternary>(fn_guard(j), std::move(value), expression::make<reference>(target)) :
+          expression::make<operator_ternary>(fn_guard(j), expression::make<reference>(target), std::move(value)));
+
+        for(size_t k = j; k-- > 0;)
+        {
+          select = expression::make<operator_ternary>(fn_guard(k), expression::make<reference>(target), std::move(select));
+        }
+
+        b.insert(c, statement::make<expression_statement>(expression::make<operator_binary>(language::id_assignment, expression::make<reference>(target), std::move(select))));
+      }
+    }
+
+    b.erase(c);
+  }
+
+  namespace ns = sltl::syntax;
+}
+
+ns::branch_flattening::branch_flattening(core::shader_stage, size_t size_max) : _size_max(size_max)
+{
+}
+
+// Conditionals are flattened when the block containing them is stepped out of, after any conditionals nested
+// within their branches, so that a branch made up of simple conditionals can itself be flattened
+
+ns::action_return_t ns::branch_flattening::operator()(block& b, bool is_start)
+{
+  if(!is_start)
+  {
+    std::vector<conditional*> conditionals;
+
+    for(const statement::ptr& s : b)
+    {
+      auto c = node_cast<conditional>(s.get());
+
+      if(c && is_flattenable(*c))
+      {
+        conditionals.push_back(c);
+      }
+    }
+
+    for(conditional* c : conditionals)
+    {
+      flatten(b, *c);
+    }
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::branch_flattening::get_default(bool is_start)
+{
+  return is_start ? action_return_t::step_in :
+                    action_return_t::step_out;
+}
+
+bool ns::branch_flattening::is_flattenable(conditional& c) const
+{
+  bool is_forced = false;
+  size_t size = 0U;
+
+  for(conditional* c_next : get_chain(c))
+  {
+    if((c_next->_hint == core::branch_hint::branch) || (c_next->get_condition() && !is_pure(*(c_next->get_condition()))))
+    {
+      return false;
+    }
+
+    is_forced = is_forced || (c_next->_hint == core::branch_hint::flatten);
+
+    auto b = node_cast<block>(c_next->get_statement());
+
+    if(!b)
+    {
+      return false;
+    }
+
+    for(const statement::ptr& s : *b)
+    {
+      bool is_statement_flattenable;
+
+      if(auto vd = node_cast<variable_declaration>(s.get()))
+      {
+        is_statement_flattenable = vd->has_initializer() && is_pure(*vd);
+      }
+      else if(auto ob = get_assignment(*s))
+      {
+        language::operator_binary_id id;
+
+        is_statement_flattenable = is_pure(*(ob->_operand_rhs)) &&
+          ((ob->_operator_id == language::id_assignment) || get_operator_arithmetic(*ob, id));
+      }
+      else
+      {
+        is_statement_flattenable = false;
+      }
+
+      if(!is_statement_flattenable)
+      {
+        return false;
+      }
+
+      ++size;
+    }
+  }
+
+  return is_forced || (size <= _size_max);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "action.h"
+
+#include <core/shader_stage.h>
+
+#include <cstddef>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // Replaces a chain of conditionals whose branches only declare local variables and assign to variables with select
+  // expressions (e.g. 'if(c) { x += a; }' becomes 'x = (c ? x + a : x);') so that the shader no longer branches. The
+  // branches must not have side effects other than their assignments. A chain is flattened if its branches contain no
+  // more than 'size_max' statements in total, unless a conditional in the chain has a core::branch_hint that overrides this.
+  class branch_flattening : public action
+  {
+  public:
+    branch_flattening(branch_flattening&&) = default;
+    branch_flattening(core::shader_stage, size_t size_max = 4U);
+
+    // Non-copyable and non-assignable
+    branch_flattening(const branch_flattening&) = delete;
+    branch_flattening& operator=(branch_flattening&&) = delete;
+    branch_flattening& operator=(const branch_flattening&) = delete;
+
+    action_return_t operator()(block& b, bool is_start = true) override;
+
+  protected:
+    action_return_t get_default(bool is_start) override;
+
+  private:
+    bool is_flattenable(conditional& c) const;
+
+    const size_t _size_max;
+  };
+}
+}
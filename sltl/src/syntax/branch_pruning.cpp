@@ -0,0 +1,130 @@
+#include "branch_pruning.h"
+
+#include "block.h"
+#include "literal.h"
+#include "conditional.h"
+
+#include <vector>
+
+
+namespace
+{
+  using namespace sltl;
+  using namespace sltl::syntax;
+
+  // Returns true if the condition is a boolean literal, in which case 'value' is set to the literal's value
+  bool get_condition_value(const conditional& c, bool& value)
+  {
+    const expression* e = c.get_condition();
+
+    if(e && (e->get_kind() == node_kind::literal) && (e->get_type().get_id() == language::id_bool))
+    {
+      value = static_cast<const literal<bool>&>(*e)._t;
+      return true;
+    }
+
+    return false;
+  }
+
+  // Moves the condition and branches of an 'else if' into a new conditional of the given kind
+  statement::ptr make_conditional(language::conditional_id id, conditional& c)
+  {
+    statement::ptr s = ((id == language::id_else) ?
+      statement::make<conditional>(id, c._hint) :
+      statement::make<conditional>(id, c.move(), c._hint));
+
+    conditional& c_new = static_cast<conditional&>(*s);
+    c_new.reset_statement(c.move_statement());
+
+    if(id != language::id_else)
+    {
+      c_new.reset_statement_else(c.move_statement_else());
+    }
+
+    return s;
+  }
+
+  namespace ns = sltl::syntax;
+}
+
+ns::branch_pruning::branch_pruning(core::shader_stage)
+{
+}
+
+// Conditionals are stepped out of before the block that contains them, and each 'else if' before
+// the conditional that it follows. The branches are therefore pruned from the end of a chain first.
+
+ns::action_return_t ns::branch_pruning::operator()(block& b, bool is_start)
+{
+  if(!is_start)
+  {
+    // The conditionals whose condition is constant, along with the value of the condition
+    std::vector<std::pair<conditional*, bool>> conditionals;
+
+    for(const statement::ptr& s : b)
+    {
+      if(auto c = node_cast<conditional>(s.get()))
+      {
+        bool value;
+
+        if(get_condition_value(*c, value))
+        {
+          conditionals.emplace_back(c, value);
+        }
+      }
+    }
+
+    for(const std::pair<conditional*, bool>& p : conditionals)
+    {
+      conditional* c = p.first;
+
+      statement::ptr s = (p.second ? c->move_statement() : c->move_statement_else());
+
+      if(auto c_else = node_cast<conditional>(s.get()))
+      {
+        // An 'else' is replaced by its block and an 'else if' (whose condition isn't constant) becomes an 'if'
+        s = ((c_else->_id == language::id_else) ? c_else->move_statement() : make_conditional(language::id_if, *c_else));
+      }
+
+      if(s)
+      {
+        b.replace(*c, std::move(s));
+      }
+      else
+      {
+        b.erase(*c);
+      }
+    }
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::branch_pruning::operator()(conditional& c, bool is_start)
+{
+  if(!is_start && (c._id != language::id_else))
+  {
+    statement::ptr s = c.move_statement_else();
+
+    if(auto c_else = node_cast<conditional>(s.get()))
+    {
+      bool value;
+
+      if(get_condition_value(*c_else, value))
+      {
+        // An 'else if' that is always taken becomes an 'else', one that is never taken is replaced by its own 'else' (if any)
+        s = (value ? make_conditional(language::id_else, *c_else) : c_else->move_statement_else());
+      }
+    }
+
+    c.reset_statement_else(std::move(s));
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::branch_pruning::get_default(bool is_start)
+{
+  return is_start ? action_return_t::step_in :
+                    action_return_t::step_out;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "action.h"
+
+#include <core/shader_stage.h>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // Removes the branches of conditionals whose conditions are boolean literals (e.g. once constant folded). A conditional
+  // that always takes the same branch is replaced by the block of that branch, or removed if it never takes a branch.
+  class branch_pruning : public action
+  {
+  public:
+    branch_pruning(branch_pruning&&) = default;
+    branch_pruning(core::shader_stage);
+
+    // Non-copyable and non-assignable
+    branch_pruning(const branch_pruning&) = delete;
+    branch_pruning& operator=(branch_pruning&&) = delete;
+    branch_pruning& operator=(const branch_pruning&) = delete;
+
+    action_return_t operator()(block& b, bool is_start = true) override;
+    action_return_t operator()(conditional& c, bool is_start = true) override;
+
+  protected:
+    action_return_t get_default(bool is_start) override;
+  };
+}
+}
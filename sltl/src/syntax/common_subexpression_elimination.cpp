@@ -0,0 +1,426 @@
+#include "common_subexpression_elimination.h"
+
+#include "block.h"
+#include "operand.h"
+#include "literal.h"
+#include "reference.h"
+#include "component_accessor.h"
+
+#include <detail/hash.h>
+#include <detail/small_vector.h>
+
+#include <tuple>
+#include <vector>
+#include <numeric>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include <cstring>
+
+
+namespace
+{
+  using namespace sltl;
+  using namespace sltl::syntax;
+
+  // Expressions that may have side effects
+  bool is_barrier(const expression& e)
+  {
+    switch(e.get_kind())
+    {
+      case node_kind::function_call:
+      case node_kind::operator_unary:
+        return true;
+      case node_kind::operator_binary:
+        return language::is_operator_assignment(static_cast<const operator_binary&>(e)._operator_id);
+      default:
+        return false;
+    }
+  }
+
+  // Only expressions that perform some calculation are worth storing in a variable
+  bool is_hoistable(const expression& e)
+  {
+    return (e.get_kind() == node_kind::operator_binary) ||
+           (e.get_kind() == node_kind::intrinsic_call);
+  }
+
+  detail::small_vector<const expression*, 4U> get_operands(const expression& e)
+  {
+    detail::small_vector<const expression*, 4U> operands;
+
+    // The operands are only read, they are never replaced
+    for_each_operand(const_cast<expression&>(e), [&operands](expression::ptr& operand)
+    {
+      operands.push_back(operand.get());
+    });
+
+    return operands;
+  }
+
+  struct accessor_hash
+  {
+    size_t operator()(const component_accessor_scalar& accessor) const
+    {
+      return accessor._count;
+    }
+
+    size_t operator()(const component_accessor_vector& accessor) const
+    {
+      return std::accumulate(accessor.begin(), accessor.end(), size_t(0), detail::hash_combine);
+    }
+
+    size_t operator()(const component_accessor_matrix& accessor) const
+    {
+      return detail::hash_combine(accessor._idx_m, accessor._idx_n);
+    }
+  };
+
+  bool is_equal(const component_accessor& accessor1, const component_accessor& accessor2)
+  {
+    if(accessor1._mode != accessor2._mode)
+    {
+      return false;
+    }
+
+    switch(accessor1._mode)
+    {
+      case component_accessor::mode::scalar:
+        return (static_cast<const component_accessor_scalar&>(accessor1)._count == static_cast<const component_accessor_scalar&>(accessor2)._count);
+      case component_accessor::mode::vector:
+        return std::equal(static_cast<const component_accessor_vector&>(accessor1).begin(), static_cast<const component_accessor_vector&>(accessor1).end(),
+                          static_cast<const component_accessor_vector&>(accessor2).begin());
+      case component_accessor::mode::matrix:
+        return (static_cast<const component_accessor_matrix&>(accessor1)._idx_m == static_cast<const component_accessor_matrix&>(accessor2)._idx_m) &&
+               (static_cast<const component_accessor_matrix&>(accessor1)._idx_n == static_cast<const component_accessor_matrix&>(accessor2)._idx_n);
+      default:
+        return false;
+    }
+  }
+
+  size_t hash_type(const language::type& type)
+  {
+    return detail::hash_combine(detail::hash_combine(type.get_id(), type.get_dimensions().m()), type.get_dimensions().n());
+  }
+
+  // Hashes a single node, ignoring its operands
+  size_t hash_node(const expression& e)
+  {
+    const size_t hash = static_cast<size_t>(e.get_kind());
+
+    switch(e.get_kind())
+    {
+      case node_kind::reference:
+        return detail::hash_combine(hash, std::hash<const declaration*>()(&(static_cast<const reference&>(e)._declaration)));
+      case node_kind::literal:
+        return detail::hash_combine(hash, visit_literal(e, [](const auto& l)
+        {
+          return std::hash<typename std::decay<decltype(l._t)>::type>()(l._t);
+        }));
+      case node_kind::temporary:
+      case node_kind::constructor_call:
+        return detail::hash_combine(hash, hash_type(e.get_type()));
+      case node_kind::intrinsic_call:
+        return detail::hash_combine(hash, static_cast<size_t>(static_cast<const intrinsic_call&>(e).get_intrinsic()));
+      case node_kind::operator_binary:
+        return detail::hash_combine(hash, static_cast<size_t>(static_cast<const operator_binary&>(e)._operator_id));
+      case node_kind::operator_component_access:
+        return detail::hash_combine(hash, visit(*(static_cast<const operator_component_access&>(e)._accessor), accessor_hash()));
+      default:
+        return hash;
+    }
+  }
+
+  // Compares a single node, ignoring its operands. Expressions with side effects are never equal.
+  bool is_equal_node(const expression& e1, const expression& e2)
+  {
+    if(e1.get_kind() != e2.get_kind())
+    {
+      return false;
+    }
+
+    switch(e1.get_kind())
+    {
+      case node_kind::reference:
+        return (&(static_cast<const reference&>(e1)._declaration) == &(static_cast<const reference&>(e2)._declaration));
+      case node_kind::literal:
+        return (e1.get_type() == e2.get_type()) && visit_literal(e1, [&e2](const auto& l1)
+        {
+          const auto& l2 = static_cast<decltype(l1)>(e2);
+
+          // Compare the representation so that, for example, 0.0f and -0.0f are different literals
+          return (std::memcmp(&(l1._t), &(l2._t), sizeof(l1._t)) == 0);
+        });
+      case node_kind::temporary:
+      case node_kind::constructor_call:
+        return (e1.get_type() == e2.get_type());
+      case node_kind::intrinsic_call:
+        return (static_cast<const intrinsic_call&>(e1).get_intrinsic() == static_cast<const intrinsic_call&>(e2).get_intrinsic()) &&
+               (e1.get_type() == e2.get_type());
+      case node_kind::operator_binary:
+        return (static_cast<const operator_binary&>(e1)._operator_id == static_cast<const operator_binary&>(e2)._operator_id) && !is_barrier(e1);
+      case node_kind::operator_component_access:
+        return is_equal(*(static_cast<const operator_component_access&>(e1)._accessor), *(static_cast<const operator_component_access&>(e2)._accessor));
+      default:
+        return false;
+    }
+  }
+
+  bool is_equal(const expression& e1, const expression& e2)
+  {
+    if(!is_equal_node(e1, e2))
+    {
+      return false;
+    }
+
+    const auto operands1 = get_operands(e1);
+    const auto operands2 = get_operands(e2);
+
+    return std::equal(operands1.begin(), operands1.end(), operands2.begin(), operands2.end(), [](const expression* op1, const expression* op2)
+    {
+      return is_equal(*op1, *op2);
+    });
+  }
+
+  // A subexpression that could be replaced with a reference to a variable
+  struct occurrence
+  {
+    expression::ptr* _slot;
+    statement* _statement;
+    variable_declaration* _vd;// Only set if the occurrence is the entire initializer of a variable declaration
+
+    size_t _hash;
+    size_t _size;// The number of nodes in the subexpression
+    size_t _epoch;
+
+    // The subexpression's nodes, numbered in pre-order, occupy the range [_order_begin, _order_end)
+    size_t _order_begin;
+    size_t _order_end;
+  };
+
+  class collector
+  {
+  public:
+    collector() : _epoch(0U), _order(0U) {}
+
+    void collect(statement& s)
+    {
+      const size_t occurrences_size = _occurrences.size();
+
+      expression::ptr* root = nullptr;
+      bool is_barrier_after = false;
+
+      switch(s.get_kind())
+      {
+        case node_kind::variable_declaration:
+        case node_kind::return_statement:
+          for_each_operand(s, [&root](expression::ptr& exp) { root = &exp; });
+          break;
+        case node_kind::expression_statement:
+          for_each_operand(s, [&root](expression::ptr& exp) { root = &exp; });
+
+          // The right hand side of an assignment is evaluated before the assignment takes place
+          if(auto ob = node_cast<operator_binary>(root->get()))
+          {
+            if(language::is_operator_assignment(ob->_operator_id))
+            {
+              root = &(ob->_operand_rhs);
+              is_barrier_after = true;
+            }
+          }
+          break;
+        default:
+          // Nested blocks and conditionals may contain assignments
+          is_barrier_after = true;
+          break;
+      }
+
+      if(root)
+      {
+        if(!collect(*root, s)._is_pure)
+        {
+          // Nothing is shared with a statement that has side effects
+          _occurrences.erase(_occurrences.begin() + occurrences_size, _occurrences.end());
+          is_barrier_after = true;
+        }
+        else if((s.get_kind() == node_kind::variable_declaration) && (_occurrences.size() > occurrences_size) && (_occurrences.back()._slot == root))
+        {
+          _occurrences.back()._vd = static_cast<variable_declaration*>(&s);
+        }
+      }
+
+      if(is_barrier_after)
+      {
+        ++_epoch;
+      }
+    }
+
+    std::vector<occurrence> _occurrences;
+
+  private:
+    struct subtree
+    {
+      size_t _hash;
+      size_t _size;
+      bool _is_pure;
+    };
+
+    subtree collect(expression::ptr& exp, statement& s)
+    {
+      const size_t order_begin = _order++;
+
+      subtree st = { hash_node(*exp), 1U, !is_barrier(*exp) };
+
+      for_each_operand(*exp, [this, &s, &st](expression::ptr& operand)
+      {
+        const subtree st_operand = collect(operand, s);
+
+        st._hash = detail::hash_combine(st._hash, st_operand._hash);
+        st._size += st_operand._size;
+        st._is_pure = st._is_pure && st_operand._is_pure;
+      });
+
+      if(st._is_pure && is_hoistable(*exp))
+      {
+        _occurrences.push_back({ &exp, &s, nullptr, st._hash, st._size, _epoch, order_begin, _order });
+      }
+
+      return st;
+    }
+
+    size_t _epoch;
+    size_t _order;
+  };
+
+  void eliminate(block& b, std::vector<occurrence>& occurrences)
+  {
+    std::vector<size_t> indices(occurrences.size());
+    std::iota(indices.begin(), indices.end(), size_t(0));
+
+    std::sort(indices.begin(), indices.end(), [&occurrences](size_t idx1, size_t idx2)
+    {
+      const occurrence& o1 = occurrences[idx1];
+      const occurrence& o2 = occurrences[idx2];
+
+      return std::tie(o1._epoch, o1._hash, o1._order_begin) < std::tie(o2._epoch, o2._hash, o2._order_begin);
+    });
+
+    // Each group holds the (structurally) equal subexpressions of an epoch, in program order
+    std::vector<std::vector<size_t>> groups;
+
+    for(auto it = indices.begin(); it != indices.end();)
+    {
+      const occurrence& o = occurrences[*it];
+
+      auto it_end = std::find_if(it, indices.end(), [&o, &occurrences](size_t idx)
+      {
+        return (occurrences[idx]._epoch != o._epoch) || (occurrences[idx]._hash != o._hash);
+      });
+
+      const size_t groups_size = groups.size();
+
+      for(; it != it_end; ++it)
+      {
+        auto it_group = std::find_if(groups.begin() + groups_size, groups.end(), [&occurrences, it](const std::vector<size_t>& group)
+        {
+          return is_equal(**(occurrences[group.front()]._slot), **(occurrences[*it]._slot));
+        });
+
+        if(it_group != groups.end())
+        {
+          it_group->push_back(*it);
+        }
+        else
+        {
+          groups.push_back({ *it });
+        }
+      }
+    }
+
+    groups.erase(std::remove_if(groups.begin(), groups.end(), [](const std::vector<size_t>& group) { return group.size() < 2U; }), groups.end());
+
+    // Larger subexpressions are replaced first, which removes any repeats nested within them
+    std::sort(groups.begin(), groups.end(), [&occurrences](const std::vector<size_t>& group1, const std::vector<size_t>& group2)
+    {
+      const occurrence& o1 = occurrences[group1.front()];
+      const occurrence& o2 = occurrences[group2.front()];
+
+      return (o1._size != o2._size) ? (o1._size > o2._size) : (o1._order_begin < o2._order_begin);
+    });
+
+    std::vector<std::pair<size_t, size_t>> erased;
+
+    for(std::vector<size_t>& group : groups)
+    {
+      group.erase(std::remove_if(group.begin(), group.end(), [&occurrences, &erased](size_t idx)
+      {
+        return std::any_of(erased.begin(), erased.end(), [&occurrences, idx](const std::pair<size_t, size_t>& range)
+        {
+          return (occurrences[idx]._order_begin >= range.first) && (occurrences[idx]._order_begin < range.second);
+        });
+      }), group.end());
+
+      if(group.size() < 2U)
+      {
+        continue;
+      }
+
+      occurrence& first = occurrences[group.front()];
+      variable_declaration* vd = first._vd;
+
+      // A new variable is declared unless the first occurrence is already the initializer of one
+      if(!vd)
+      {
+        vd = &(b.insert_variable_declaration(*(first._statement), std::move(*(first._slot))));
+        *(first._slot) = expression::make<reference>(*vd);
+
+        for(occurrence& o : occurrences)
+        {
+          if((o._order_begin >= first._order_begin) && (o._order_end <= first._order_end))
+          {
+            o._statement = vd;
+          }
+        }
+      }
+
+      for(auto it = group.begin() + 1; it != group.end(); ++it)
+      {
+        occurrence& o = occurrences[*it];
+
+        *(o._slot) = expression::make<reference>(*vd);
+        erased.emplace_back(o._order_begin, o._order_end);
+      }
+    }
+  }
+
+  namespace ns = sltl::syntax;
+}
+
+ns::common_subexpression_elimination::common_subexpression_elimination(core::shader_stage)
+{
+}
+
+ns::action_return_t ns::common_subexpression_elimination::operator()(block& b, bool is_start)
+{
+  // Blocks nested within this one have already been processed by the time it is stepped out of
+  if(!is_start)
+  {
+    collector c;
+
+    for(const statement::ptr& s : b)
+    {
+      c.collect(*s);
+    }
+
+    eliminate(b, c._occurrences);
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::common_subexpression_elimination::get_default(bool is_start)
+{
+  return is_start ? action_return_t::step_in :
+                    action_return_t::step_out;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "action.h"
+
+#include <core/shader_stage.h>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // Hoists subexpressions that are repeated within a block into a variable declaration and replaces each
+  // repeat with a reference to it. Assignments, increments, decrements and function calls (which may have
+  // side effects) act as barriers: subexpressions are never shared across a statement that contains one.
+  class common_subexpression_elimination : public action
+  {
+  public:
+    common_subexpression_elimination(common_subexpression_elimination&&) = default;
+    common_subexpression_elimination(core::shader_stage);
+
+    // Non-copyable and non-assignable
+    common_subexpression_elimination(const common_subexpression_elimination&) = delete;
+    common_subexpression_elimination& operator=(common_subexpression_elimination&&) = delete;
+    common_subexpression_elimination& operator=(const common_subexpression_elimination&) = delete;
+
+    action_return_t operator()(block& b, bool is_start = true) override;
+
+  protected:
+    action_return_t get_default(bool is_start) override;
+  };
+}
+}
@@ -1,8 +1,12 @@
 #pragma once
 
+#include "arena.h"
+
 #include <type.h>
 
 #include <memory>
+#include <limits>
+#include <iterator>
 #include <algorithm>
 
 
@@ -22,6 +26,19 @@ namespace syntax
       matrix
     };
 
+    virtual ~component_accessor() = default;
+
+    // Accessors are allocated from the current arena (if any), see arena_manager
+    static void* operator new(std::size_t size)
+    {
+      return allocate_node(size);
+    }
+
+    static void operator delete(void* p)
+    {
+      deallocate_node(p);
+    }
+
     static constexpr language::type_dimension_t _idx_default = std::numeric_limits<language::type_dimension_t>::max();
 
     virtual language::type get_type(const language::type& type_operand) const = 0;
@@ -5,6 +5,8 @@
 
 #include <type.h>
 
+#include <core/branch_hint.h>
+
 #include <cassert>
 
 
@@ -15,12 +17,12 @@ namespace syntax
   class conditional : public statement
   {
   public:
-    conditional(language::conditional_id id) : _id(id)
+    conditional(language::conditional_id id, core::branch_hint hint = core::branch_hint::none) : statement(node_kind::conditional), _id(id), _hint(hint)
     {
       assert(_id == language::id_else);
     }
 
-    conditional(language::conditional_id id, expression::ptr&& condition) : _id(id), _condition(std::move(condition))
+    conditional(language::conditional_id id, expression::ptr&& condition, core::branch_hint hint = core::branch_hint::none) : statement(node_kind::conditional), _id(id), _hint(hint), _condition(std::move(condition))
     {
       assert((_id == language::id_if) || (_id == language::id_else_if));
     }
@@ -47,22 +49,75 @@ namespace syntax
       return apply_action(cact, *this);
     }
 
+    void reset(expression::ptr&& condition)
+    {
+      assert(_id != language::id_else);
+      _condition = std::move(condition);
+    }
+
+    expression::ptr&& move()
+    {
+      return std::move(_condition);
+    }
+
+    void reset_statement(statement::ptr&& s)
+    {
+      _statement = std::move(s);
+    }
+
+    void reset_statement_else(statement::ptr&& s)
+    {
+      assert(_id != language::id_else);
+      _statement_else = std::move(s);
+    }
+
+    statement::ptr&& move_statement()
+    {
+      return std::move(_statement);
+    }
+
+    statement::ptr&& move_statement_else()
+    {
+      return std::move(_statement_else);
+    }
+
     const expression* get_condition() const
     {
       return _condition.get();
     }
 
+    expression* get_condition()
+    {
+      return _condition.get();
+    }
+
     const statement* get_statement() const
     {
       return _statement.get();
     }
 
+    statement* get_statement()
+    {
+      return _statement.get();
+    }
+
     const statement* get_statement_else() const
     {
       return _statement_else.get();
     }
 
+    statement* get_statement_else()
+    {
+      return _statement_else.get();
+    }
+
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::conditional);
+    }
+
     const language::conditional_id _id;
+    const core::branch_hint _hint;
 
   private:
     template<typename A, typename T>
@@ -108,7 +163,7 @@ namespace syntax
       return is_continuing && apply_action_impl(fn, type);
     }
 
-    const expression::ptr _condition;
+    expression::ptr _condition;
 
     statement::ptr _statement;
     statement::ptr _statement_else;
@@ -0,0 +1,332 @@
+#include "constant_folding.h"
+
+#include "literal.h"
+#include "operator.h"
+#include "temporary.h"
+#include "conditional.h"
+#include "constructor_call.h"
+#include "return_statement.h"
+#include "expression_statement.h"
+#include "variable_declaration.h"
+
+#include <type.h>
+
+#include <interpreter/operation.h>
+
+#include <array>
+#include <algorithm>
+
+#include <cassert>
+
+
+namespace
+{
+  using namespace sltl;
+  using namespace sltl::syntax;
+
+  // The components of a constant expression. A double exactly represents every float, int, unsigned int and bool value.
+  class constant
+  {
+  public:
+    constant() : _size(0U) {}
+
+    bool add(double component)
+    {
+      if(_size == _components.size())
+      {
+        return false;
+      }
+
+      _components[_size++] = component;
+      return true;
+    }
+
+    double operator[](size_t idx) const
+    {
+      assert(idx < _size);
+      return _components[idx];
+    }
+
+    size_t size() const
+    {
+      return _size;
+    }
+
+  private:
+    std::array<double, language::type_dimensions::max_dimensions * language::type_dimensions::max_dimensions> _components;
+    size_t _size;
+  };
+
+  // Results that can't be written as a literal (i.e. infinity and NaN) are not folded, nor are signed integer overflow and
+  // integer division by zero which are left for the shader compiler to deal with
+  bool evaluate(language::type_id id, interpreter::operation op, double lhs, double rhs, double& result)
+  {
+    interpreter::calculate_status status;
+
+    result = interpreter::calculate_component(id, op, lhs, rhs, status);
+
+    return (status == interpreter::calculate_status::exact);
+  }
+
+  double get_literal_value(const expression& e)
+  {
+    return visit_literal(e, [](const auto& l) { return static_cast<double>(l._t); });
+  }
+
+  // Appends the components of the expression to 'c', returning false if the expression is not constant
+  bool get_constant(const expression& e, constant& c)
+  {
+    switch(e.get_kind())
+    {
+      case node_kind::literal:
+        return c.add(get_literal_value(e));
+      case node_kind::temporary:
+      {
+        const temporary& t = static_cast<const temporary&>(e);
+
+        if(const expression* initializer = t.get_initializer())
+        {
+          return get_constant(*initializer, c);
+        }
+
+        // A temporary without an initializer is zero initialized
+        for(size_t i = 0U, count = interpreter::get_component_count(t.get_type()); i < count; ++i)
+        {
+          if(!c.add(0.0))
+          {
+            return false;
+          }
+        }
+
+        return true;
+      }
+      case node_kind::constructor_call:
+      {
+        const constructor_call& cc = static_cast<const constructor_call&>(e);
+        const language::type type = cc.get_type();
+        const size_t size = c.size() + interpreter::get_component_count(type);
+
+        for(const expression::ptr& arg : cc.get_args())
+        {
+          if((arg->get_type().get_id() != type.get_id()) || !get_constant(*arg, c))
+          {
+            return false;
+          }
+        }
+
+        // Constructors that broadcast a scalar (or set the diagonal of a matrix) are not folded
+        return (c.size() == size);
+      }
+      default:
+        return false;
+    }
+  }
+
+  expression::ptr make_constant(const language::type& type, const constant& c)
+  {
+    assert(interpreter::get_component_count(type) == c.size());
+
+    if(type.get_dimensions().is_scalar())
+    {
+      return make_literal(type.get_id(), c[0]);
+    }
+
+    expression_list args;
+
+    for(size_t i = 0U; i < c.size(); ++i)
+    {
+      args.add(make_literal(type.get_id(), c[i]));
+    }
+
+    return expression::make<constructor_call>(type, std::move(args));
+  }
+
+  expression::ptr fold_operator_binary(const operator_binary& ob)
+  {
+    // Assignment has side effects and matrix multiplication depends on the output matrix order
+    const interpreter::operation op = (is_operator_assignment(ob._operator_id) ? interpreter::operation::none : interpreter::get_operation(ob._operator_id));
+
+    constant c_lhs;
+    constant c_rhs;
+
+    if((op == interpreter::operation::none) ||
+       !get_constant(*(ob._operand_lhs), c_lhs) ||
+       !get_constant(*(ob._operand_rhs), c_rhs))
+    {
+      return nullptr;
+    }
+
+    // Scalar operands of the scalar-vector and scalar-matrix operators apply to every component
+    const size_t size = std::max(c_lhs.size(), c_rhs.size());
+
+    if(((c_lhs.size() != size) && (c_lhs.size() != 1U)) ||
+       ((c_rhs.size() != size) && (c_rhs.size() != 1U)))
+    {
+      return nullptr;
+    }
+
+    const language::type_id id = ob._operand_lhs->get_type().get_id();
+    const language::type type = ob.get_type();
+
+    constant c;
+
+    for(size_t i = 0U; i < size; ++i)
+    {
+      double component;
+
+      if(!evaluate(id, op, c_lhs[(c_lhs.size() == 1U) ? 0U : i], c_rhs[(c_rhs.size() == 1U) ? 0U : i], component))
+      {
+        return nullptr;
+      }
+
+      c.add(component);
+    }
+
+    return make_constant(type, c);
+  }
+
+  expression::ptr fold(expression::ptr&& exp)
+  {
+    expression::ptr exp_folded;
+
+    if(exp)
+    {
+      switch(exp->get_kind())
+      {
+        case node_kind::operator_binary:
+          exp_folded = fold_operator_binary(static_cast<const operator_binary&>(*exp));
+          break;
+        case node_kind::temporary:
+        {
+          temporary& t = static_cast<temporary&>(*exp);
+          constant c;
+
+          // The initializer of a constant temporary has already been folded. Zero initialized
+          // temporaries of vector and matrix type are shorter than the equivalent constructor call.
+          if(get_constant(t, c))
+          {
+            if(t.has_initializer())
+            {
+              exp_folded = t.move();
+            }
+            else if(t.get_type().get_dimensions().is_scalar())
+            {
+              exp_folded = make_constant(t.get_type(), c);
+            }
+          }
+          break;
+        }
+        case node_kind::constructor_call:
+        {
+          const constructor_call& cc = static_cast<const constructor_call&>(*exp);
+          constant c;
+
+          // Nested constructor calls and temporaries are flattened into a single constructor call of literals
+          const bool is_nested = std::any_of(cc.get_args().begin(), cc.get_args().end(), [](const expression::ptr& arg)
+          {
+            return (arg->get_kind() != node_kind::literal);
+          });
+
+          if(is_nested && get_constant(cc, c))
+          {
+            exp_folded = make_constant(cc.get_type(), c);
+          }
+          break;
+        }
+        default:
+          break;
+      }
+    }
+
+    return exp_folded ? std::move(exp_folded) : std::move(exp);
+  }
+
+  namespace ns = sltl::syntax;
+}
+
+ns::constant_folding::constant_folding(core::shader_stage)
+{
+}
+
+// The operands of each node are folded once the node has been stepped out of, at which point all of its
+// descendants have already been folded. Folding therefore proceeds from the leaves towards the root.
+
+ns::action_return_t ns::constant_folding::operator()(variable_declaration& vd, bool is_start)
+{
+  if(!is_start && vd.has_initializer())
+  {
+    vd.reset(fold(vd.move()));
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::constant_folding::operator()(temporary& t, bool is_start)
+{
+  if(!is_start && t.has_initializer())
+  {
+    t.reset(fold(t.move()));
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::constant_folding::operator()(operator_binary& ob, bool is_start)
+{
+  if(!is_start)
+  {
+    ob._operand_lhs = fold(std::move(ob._operand_lhs));
+    ob._operand_rhs = fold(std::move(ob._operand_rhs));
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::constant_folding::operator()(conditional& c, bool is_start)
+{
+  if(!is_start && c.get_condition())
+  {
+    c.reset(fold(c.move()));
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::constant_folding::operator()(expression_statement& es, bool is_start)
+{
+  if(!is_start)
+  {
+    es.reset(fold(es.move()));
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::constant_folding::operator()(expression_list& el, bool is_start)
+{
+  if(!is_start)
+  {
+    for(expression::ptr& exp : el)
+    {
+      exp = fold(std::move(exp));
+    }
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::constant_folding::operator()(return_statement& rs, bool is_start)
+{
+  if(!is_start)
+  {
+    rs.reset(fold(rs.move()));
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::constant_folding::get_default(bool is_start)
+{
+  return is_start ? action_return_t::step_in :
+                    action_return_t::step_out;
+}
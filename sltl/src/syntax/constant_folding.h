@@ -0,0 +1,37 @@
+#pragma once
+
+#include "action.h"
+
+#include <core/shader_stage.h>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // Replaces expressions whose operands are all constant (literals, temporaries initialized with
+  // literals or constructor calls with literal arguments) with a single literal or constructor call
+  class constant_folding : public action
+  {
+  public:
+    constant_folding(constant_folding&&) = default;
+    constant_folding(core::shader_stage);
+
+    // Non-copyable and non-assignable
+    constant_folding(const constant_folding&) = delete;
+    constant_folding& operator=(constant_folding&&) = delete;
+    constant_folding& operator=(const constant_folding&) = delete;
+
+    action_return_t operator()(variable_declaration& vd, bool is_start = true) override;
+    action_return_t operator()(temporary& t, bool is_start = true) override;
+    action_return_t operator()(operator_binary& ob, bool is_start = true) override;
+    action_return_t operator()(conditional& c, bool is_start = true) override;
+    action_return_t operator()(expression_statement& es, bool is_start = true) override;
+    action_return_t operator()(expression_list& el, bool is_start = true) override;
+    action_return_t operator()(return_statement& rs, bool is_start = true) override;
+
+  protected:
+    action_return_t get_default(bool is_start) override;
+  };
+}
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "expression.h"
+#include "type_cache.h"
 
 #include <type.h>
 
@@ -12,7 +13,7 @@ namespace syntax
   class constructor_call : public expression
   {
   public:
-    constructor_call(const language::type& type, expression_list&& args) : _type(type), _args(std::move(args)) {}
+    constructor_call(const language::type& type, expression_list&& args) : expression(node_kind::constructor_call), _type(type), _args(std::move(args)) {}
 
     virtual bool apply_action(action& act) override
     {
@@ -27,6 +28,7 @@ namespace syntax
     void set_type(const language::type& type)
     {
       _type = type;
+      type_cache::invalidate();
     }
 
     virtual language::type get_type() const override
@@ -34,6 +36,21 @@ namespace syntax
       return _type;
     }
 
+    expression_list& get_args()
+    {
+      return _args;
+    }
+
+    const expression_list& get_args() const
+    {
+      return _args;
+    }
+
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::constructor_call);
+    }
+
   private:
     language::type _type;
     expression_list _args;
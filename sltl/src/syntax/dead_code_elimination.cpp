@@ -0,0 +1,341 @@
+#include "dead_code_elimination.h"
+
+#include "tree.h"
+#include "block.h"
+#include "operand.h"
+#include "reference.h"
+#include "function_definition.h"
+
+#include <algorithm>
+
+
+namespace
+{
+  using namespace sltl;
+  using namespace sltl::syntax;
+
+  expression* get_expression(expression_statement& es)
+  {
+    expression* e = nullptr;
+
+    for_each_operand(es, [&e](expression::ptr& operand)
+    {
+      e = operand.get();
+    });
+
+    return e;
+  }
+
+  // The reference to the variable that is assigned to, ignoring any component access (e.g. 'v' for 'v.x = 1.0f')
+  const reference* get_target(const expression& e)
+  {
+    if(auto oca = node_cast<operator_component_access>(&e))
+    {
+      return get_target(*(oca->_operand));
+    }
+    else
+    {
+      return node_cast<reference>(&e);
+    }
+  }
+
+  namespace ns = sltl::syntax;
+}
+
+ns::dead_code_elimination::dead_code_elimination(core::shader_stage) : _function(nullptr), _is_function_pure(true)
+{
+}
+
+// References are counted as the tree is visited. Once a block has been stepped out of every reference to its variables has
+// been counted, so its statements are then removed in reverse order. Removing a statement releases the references it makes,
+// which allows any earlier statements that only those references depended on to be removed as well.
+
+ns::action_return_t ns::dead_code_elimination::operator()(block& b, bool is_start)
+{
+  if(is_start)
+  {
+    _blocks.push_back(&b);
+  }
+  else
+  {
+    std::vector<statement*> statements;
+
+    for(const statement::ptr& s : b)
+    {
+      statements.push_back(s.get());
+    }
+
+    std::for_each(statements.rbegin(), statements.rend(), [this, &b](statement* s)
+    {
+      if(auto vd = node_cast<variable_declaration>(s))
+      {
+        auto it = _variables.find(vd);
+
+        if((it != _variables.end()) && (it->second._info->get_ref() == 0) && is_pure(*vd))
+        {
+          release(*vd);
+
+          _variables.erase(it);
+          b.erase(*vd);
+        }
+      }
+      else if(auto es = node_cast<expression_statement>(s))
+      {
+        const reference* r = get_dead_store(*get_expression(*es), b);
+
+        if(r || is_pure(*es))
+        {
+          if(r)
+          {
+            --(_variables.at(&(r->_declaration))._stores);
+          }
+
+          release(*es);
+          b.erase(*es);
+        }
+      }
+    });
+
+    _blocks.pop_back();
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::dead_code_elimination::operator()(variable_declaration& vd, bool is_start)
+{
+  // Variables declared within io_blocks are part of the shader's interface and are never removed
+  if(is_start && (vd._qualifier == core::qualifier_storage::none) && !_blocks.empty())
+  {
+    // The reference counts accumulated while the tree was built are recalculated from scratch
+    variable_info* info = _blocks.back()->block_base::variable_info_find(vd._name);
+    info->reset_ref();
+
+    _variables.emplace(&vd, variable{ info, _blocks.back(), 0U });
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::dead_code_elimination::operator()(reference& r)
+{
+  auto it = _variables.find(&(r._declaration));
+
+  if(it != _variables.end())
+  {
+    it->second._info->inc_ref();
+  }
+
+  return get_default(false);
+}
+
+ns::action_return_t ns::dead_code_elimination::operator()(operator_unary& ou, bool is_start)
+{
+  if(is_start)
+  {
+    assign(*(ou._operand));
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::dead_code_elimination::operator()(operator_binary& ob, bool is_start)
+{
+  if(is_start && language::is_operator_assignment(ob._operator_id))
+  {
+    assign(*(ob._operand_lhs));
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::dead_code_elimination::operator()(expression_statement& es, bool is_start)
+{
+  if(is_start)
+  {
+    auto ob = node_cast<operator_binary>(get_expression(es));
+
+    // Only a plain assignment to the whole variable is a store that doesn't also read the variable
+    if(ob && (ob->_operator_id == language::id_assignment))
+    {
+      if(auto r = node_cast<reference>(ob->_operand_lhs.get()))
+      {
+        auto it = _variables.find(&(r->_declaration));
+
+        if(it != _variables.end())
+        {
+          ++(it->second._stores);
+        }
+      }
+    }
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::dead_code_elimination::operator()(function_call& fc, bool is_start)
+{
+  if(is_start)
+  {
+    const function_definition& fd = fc.get_function_definition();
+
+    if(_function)
+    {
+      _function_calls[_function].push_back(&fd);
+    }
+
+    if(_functions_pure.find(&fd) == _functions_pure.end())
+    {
+      _is_function_pure = false;
+    }
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::dead_code_elimination::operator()(function_definition& fd, bool is_start)
+{
+  if(is_start)
+  {
+    _function = &fd;
+    _is_function_pure = true;
+
+    _functions.push_back(&fd);
+  }
+  else
+  {
+    if(_is_function_pure)
+    {
+      _functions_pure.insert(&fd);
+    }
+
+    // The 'main' function is always visited last, by which point every remaining function call is known. Functions
+    // are visited in reverse call order, so each caller is processed before any of the functions that it calls.
+    if(fd._name == L"main")
+    {
+      std::unordered_set<const function_definition*> functions_called = { &fd };
+
+      std::for_each(_functions.rbegin(), _functions.rend(), [this, &functions_called](function_definition* f)
+      {
+        if(functions_called.find(f) != functions_called.end())
+        {
+          const auto& calls = _function_calls[f];
+          functions_called.insert(calls.begin(), calls.end());
+        }
+        else
+        {
+          f->set_unused();
+        }
+      });
+    }
+
+    _function = nullptr;
+  }
+
+  return get_default(is_start);
+}
+
+void ns::dead_code_elimination::complete(tree& t)
+{
+  // Remove the functions marked as unused by the visit of the main function
+  t.remove_unused_functions();
+}
+
+ns::action_return_t ns::dead_code_elimination::get_default(bool is_start)
+{
+  return is_start ? action_return_t::step_in :
+                    action_return_t::step_out;
+}
+
+bool ns::dead_code_elimination::is_pure(node& n) const
+{
+  switch(n.get_kind())
+  {
+    case node_kind::operator_unary:
+      return false;
+    case node_kind::operator_binary:
+      if(language::is_operator_assignment(static_cast<operator_binary&>(n)._operator_id))
+      {
+        return false;
+      }
+      break;
+    case node_kind::function_call:
+      if(_functions_pure.find(&(static_cast<function_call&>(n).get_function_definition())) == _functions_pure.end())
+      {
+        return false;
+      }
+      break;
+    default:
+      break;
+  }
+
+  bool is_operand_pure = true;
+
+  for_each_operand(n, [this, &is_operand_pure](expression::ptr& operand)
+  {
+    is_operand_pure = is_operand_pure && is_pure(*operand);
+  });
+
+  return is_operand_pure;
+}
+
+const ns::reference* ns::dead_code_elimination::get_dead_store(expression& e, const block_base& b) const
+{
+  auto ob = node_cast<operator_binary>(&e);
+
+  if(ob && (ob->_operator_id == language::id_assignment))
+  {
+    if(auto r = node_cast<reference>(ob->_operand_lhs.get()))
+    {
+      auto it = _variables.find(&(r->_declaration));
+
+      // Stores within nested blocks are kept as they are visited before every read of the variable has been counted
+      if((it != _variables.end()) && (it->second._block == &b) && (it->second._info->get_ref() == it->second._stores))
+      {
+        return is_pure(*(ob->_operand_rhs)) ? r : nullptr;
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+void ns::dead_code_elimination::assign(const expression& e)
+{
+  const reference* r = get_target(e);
+
+  // Assigning to a variable declared outside of the function (i.e. within an io_block) is a side effect
+  if(auto vd = (r ? declaration_cast<const variable_declaration>(&(r->_declaration)) : nullptr))
+  {
+    if(vd->_qualifier != core::qualifier_storage::none)
+    {
+      _is_function_pure = false;
+    }
+  }
+}
+
+void ns::dead_code_elimination::release(node& n)
+{
+  if(auto r = node_cast<reference>(&n))
+  {
+    auto it = _variables.find(&(r->_declaration));
+
+    if(it != _variables.end())
+    {
+      it->second._info->dec_ref();
+    }
+  }
+  else if(auto fc = node_cast<function_call>(&n))
+  {
+    if(_function)
+    {
+      auto& calls = _function_calls[_function];
+      calls.erase(std::find(calls.begin(), calls.end(), &(fc->get_function_definition())));
+    }
+  }
+
+  for_each_operand(n, [this](expression::ptr& operand)
+  {
+    release(*operand);
+  });
+}
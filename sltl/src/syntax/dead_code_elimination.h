@@ -0,0 +1,77 @@
+#pragma once
+
+#include "action.h"
+
+#include <core/shader_stage.h>
+
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // Forward declarations - sltl::syntax namespace
+  class node;
+  class expression;
+  class block_base;
+  class declaration;
+  class variable_info;
+
+  // Removes variable declarations that are never read, stores to local variables that are never read and expression
+  // statements without side effects. Functions without side effects are removed along with their last remaining call.
+  class dead_code_elimination : public action
+  {
+  public:
+    dead_code_elimination(dead_code_elimination&&) = default;
+    dead_code_elimination(core::shader_stage);
+
+    // Non-copyable and non-assignable
+    dead_code_elimination(const dead_code_elimination&) = delete;
+    dead_code_elimination& operator=(dead_code_elimination&&) = delete;
+    dead_code_elimination& operator=(const dead_code_elimination&) = delete;
+
+    action_return_t operator()(block& b, bool is_start = true) override;
+    action_return_t operator()(variable_declaration& vd, bool is_start = true) override;
+    action_return_t operator()(reference& r) override;
+    action_return_t operator()(operator_unary& ou, bool is_start = true) override;
+    action_return_t operator()(operator_binary& ob, bool is_start = true) override;
+    action_return_t operator()(expression_statement& es, bool is_start = true) override;
+    action_return_t operator()(function_call& fc, bool is_start = true) override;
+    action_return_t operator()(function_definition& fd, bool is_start = true) override;
+
+    void complete(tree& t) override;
+
+  protected:
+    action_return_t get_default(bool is_start) override;
+
+  private:
+    struct variable
+    {
+      variable_info* _info;
+      block_base* _block;
+      size_t _stores; // The number of references that are only assigned to
+    };
+
+    bool is_pure(node& n) const;
+    // Returns the variable assigned to if the expression is a store to a variable that is never read
+    const reference* get_dead_store(expression& e, const block_base& b) const;
+
+    void assign(const expression& e);
+    void release(node& n);
+
+    std::vector<block_base*> _blocks;
+    std::unordered_map<const declaration*, variable> _variables;
+
+    function_definition* _function;
+    bool _is_function_pure;
+
+    // The functions in the order they were visited (callees before their callers) and the calls made by each of them
+    std::vector<function_definition*> _functions;
+    std::unordered_map<const function_definition*, std::vector<const function_definition*>> _function_calls;
+    std::unordered_set<const function_definition*> _functions_pure;
+  };
+}
+}
@@ -9,6 +9,14 @@ namespace sltl
 {
 namespace syntax
 {
+  enum class declaration_kind : unsigned char
+  {
+    variable_declaration,
+    parameter_declaration,
+    function_definition,
+    intrinsic_declaration
+  };
+
   class declaration
   {
   public:
@@ -23,10 +31,31 @@ namespace syntax
     // Returns a copy, rather than reference, as the type may need to be calculated on demand (e.g. operator_binary)
     virtual language::type get_type() const = 0;
 
+    declaration_kind get_declaration_kind() const
+    {
+      return _declaration_kind;
+    }
+
     const std::wstring _name;
 
   protected:
-    declaration(std::wstring&& name) : _name(std::move(name)) {}
+    declaration(declaration_kind kind, std::wstring&& name) : _name(std::move(name)), _declaration_kind(kind) {}
+
+  private:
+    const declaration_kind _declaration_kind;
   };
+
+  // Returns a pointer to the declaration as type T, or nullptr if the declaration is not a T
+  template<typename T>
+  T* declaration_cast(declaration* d)
+  {
+    return (d && T::is_kind(d->get_declaration_kind())) ? static_cast<T*>(d) : nullptr;
+  }
+
+  template<typename T>
+  const T* declaration_cast(const declaration* d)
+  {
+    return (d && T::is_kind(d->get_declaration_kind())) ? static_cast<const T*>(d) : nullptr;
+  }
 }
 }
@@ -11,7 +11,7 @@ namespace syntax
   class declaration_statement : public declaration, public statement
   {
   public:
-    declaration_statement(std::wstring&& name) : declaration(std::move(name)) {}
+    declaration_statement(declaration_kind kind_declaration, node_kind kind_node, std::wstring&& name) : declaration(kind_declaration, std::move(name)), statement(kind_node) {}
   };
 }
 }
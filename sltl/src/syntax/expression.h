@@ -27,8 +27,13 @@ namespace syntax
     // Returns a copy, rather than reference, as the type may need to be calculated on demand (e.g. operator_binary)
     virtual language::type get_type() const = 0;
 
+    static bool is_kind(node_kind kind)
+    {
+      return (kind >= node_kind::reference) && (kind <= node_kind::operator_component_access);
+    }
+
   protected:
-    expression() = default;
+    expression(node_kind kind) : node(kind) {}
   };
 
   class expression_list : public list<expression, node>
@@ -36,10 +41,10 @@ namespace syntax
     typedef list<expression, node> super_t;
 
   public:
-    expression_list() : super_t() {}
-    expression_list(expression_list&& list) : super_t(std::move(list)) {}
+    expression_list() : super_t(node_kind::expression_list) {}
+    expression_list(expression_list&& list) : super_t(node_kind::expression_list, std::move(list)) {}
 
-    expression_list(expression::ptr&& e, expression_list&& list) : super_t(std::move(list))
+    expression_list(expression::ptr&& e, expression_list&& list) : super_t(node_kind::expression_list, std::move(list))
     {
       _list_items.push_front(std::move(e));
     }
@@ -53,6 +58,11 @@ namespace syntax
     {
       return apply_action_impl(cact, *this, _list_items.begin(), _list_items.end());
     }
+
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::expression_list);
+    }
   };
 }
 }
@@ -8,7 +8,7 @@ namespace
   namespace ns = sltl::syntax;
 }
 
-ns::expression_statement::expression_statement(expression::ptr&& e) : _expression(std::move(e))
+ns::expression_statement::expression_statement(expression::ptr&& e) : statement(node_kind::expression_statement), _expression(std::move(e))
 {
 }
 
@@ -14,12 +14,30 @@ namespace syntax
 
   class expression_statement : public statement
   {
+    template<typename Fn>
+    friend void for_each_operand(node& n, Fn fn);
+
   public:
     expression_statement(expression::ptr&& e);
 
     virtual bool apply_action(action& act) override;
     virtual bool apply_action(const_action& cact) const override;
 
+    expression::ptr&& move()
+    {
+      return std::move(_expression);
+    }
+
+    void reset(expression::ptr&& e)
+    {
+      _expression = std::move(e);
+    }
+
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::expression_statement);
+    }
+
   private:
     expression::ptr _expression;
   };
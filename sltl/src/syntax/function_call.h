@@ -15,7 +15,7 @@ namespace syntax
   class function_call : public expression
   {
   public:
-    function_call(const function_definition& fd, expression_list&& args) : _fd(fd), _args(std::move(args))
+    function_call(const function_definition& fd, expression_list&& args) : expression(node_kind::function_call), _fd(fd), _args(std::move(args))
     {
       const parameter_list& params = fd.get_params();
 
@@ -55,6 +55,26 @@ namespace syntax
       return _fd._name.c_str();
     }
 
+    const function_definition& get_function_definition() const
+    {
+      return _fd;
+    }
+
+    expression_list& get_args()
+    {
+      return _args;
+    }
+
+    const expression_list& get_args() const
+    {
+      return _args;
+    }
+
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::function_call);
+    }
+
   private:
     const function_definition& _fd;
     expression_list _args;
@@ -9,6 +9,7 @@
 #include "declaration.h"
 #include "parameter_declaration.h"
 #include "return_statement.h"
+#include "type_cache.h"
 
 #include <type.h>
 
@@ -25,7 +26,7 @@ namespace syntax
     typedef std::unique_ptr<function_definition> ptr;
 
     template<typename Fn>
-    function_definition(Fn fn, std::wstring&& name, const language::type& type_return) : declaration(std::move(name)), _type_return(type_return), _function_body(block::global), _depth(), _depth_id()
+    function_definition(Fn fn, std::wstring&& name, const language::type& type_return) : declaration(declaration_kind::function_definition, std::move(name)), node(node_kind::function_definition), _type_return(type_return), _function_body(block::global), _depth(), _depth_id(), _is_unused(false)
     {
       block_guard(_function_body, [this, &fn](){ call_fn(fn); });
     }
@@ -43,6 +44,7 @@ namespace syntax
     void set_type(const language::type& type)
     {
       _type_return = type;
+      type_cache::invalidate();
     }
 
     virtual language::type get_type() const override
@@ -70,6 +72,17 @@ namespace syntax
       return _depth_id;
     }
 
+    // Marks a function that is no longer called, it is removed by tree::remove_unused_functions
+    void set_unused()
+    {
+      _is_unused = true;
+    }
+
+    bool is_unused() const
+    {
+      return _is_unused;
+    }
+
     const parameter_list& get_params() const
     {
       return _parameters;
@@ -80,6 +93,16 @@ namespace syntax
       return _function_body;
     }
 
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::function_definition);
+    }
+
+    static bool is_kind(declaration_kind kind)
+    {
+      return (kind == declaration_kind::function_definition);
+    }
+
   private:
     template<typename A, typename T>
     static auto apply_action(A& act, T& type) -> typename std::enable_if<std::is_same<typename std::remove_const<T>::type, function_definition>::value, bool>::type
@@ -201,6 +224,8 @@ namespace syntax
 
     size_t _depth;
     size_t _depth_id;
+
+    bool _is_unused;
   };
 }
 }
@@ -0,0 +1,437 @@
+#include "function_inlining.h"
+
+#include "tree.h"
+#include "block.h"
+#include "operand.h"
+#include "literal.h"
+#include "reference.h"
+#include "function_definition.h"
+#include "component_accessor.h"
+
+#include <functional>
+
+
+namespace
+{
+  using namespace sltl;
+  using namespace sltl::syntax;
+
+  typedef std::unordered_map<const declaration*, const expression*> substitution_map;
+
+  struct accessor_clone
+  {
+    component_accessor::ptr operator()(const component_accessor_scalar& accessor) const
+    {
+      return component_accessor::make<component_accessor::mode::scalar>(accessor._count);
+    }
+
+    component_accessor::ptr operator()(const component_accessor_vector& accessor) const
+    {
+      return component_accessor::make<component_accessor::mode::vector>(accessor._indices[0], accessor._indices[1], accessor._indices[2], accessor._indices[3]);
+    }
+
+    component_accessor::ptr operator()(const component_accessor_matrix& accessor) const
+    {
+      return component_accessor::make<component_accessor::mode::matrix>(accessor._idx_m, accessor._idx_n);
+    }
+  };
+
+  expression* get_operand(node& n)
+  {
+    expression* e = nullptr;
+
+    for_each_operand(n, [&e](expression::ptr& operand)
+    {
+      e = operand.get();
+    });
+
+    return e;
+  }
+
+  // Copies an expression without side effects, replacing each reference to a declaration within 'substitutions'
+  expression::ptr clone(const expression& e, const substitution_map& substitutions)
+  {
+    auto fn_clone_args = [&substitutions](const expression_list& args)
+    {
+      expression_list args_clone;
+
+      for(const expression::ptr& arg : args)
+      {
+        args_clone.add(clone(*arg, substitutions));
+      }
+
+      return args_clone;
+    };
+
+    switch(e.get_kind())
+    {
+      case node_kind::literal:
+        return visit_literal(e, [](const auto& l) -> expression::ptr
+        {
+          return expression::make<std::decay_t<decltype(l)>>(l._t);
+        });
+      case node_kind::reference:
+      {
+        const declaration& d = static_cast<const reference&>(e)._declaration;
+        auto it = substitutions.find(&d);
+
+        return ((it != substitutions.end()) ? clone(*(it->second), substitutions) : expression::make<reference>(d));
+      }
+      case node_kind::temporary:
+      {
+        const temporary& t = static_cast<const temporary&>(e);
+
+        return (t.has_initializer() ?
+          expression::make<temporary>(clone(*(t.get_initializer()), substitutions)) :
+          expression::make<temporary>(t.get_type()));
+      }
+      case node_kind::operator_binary:
+      {
+        const operator_binary& ob = static_cast<const operator_binary&>(e);
+        return expression::make<operator_binary>(ob._operator_id, clone(*(ob._operand_lhs), substitutions), clone(*(ob._operand_rhs), substitutions));
+      }
+      case node_kind::operator_ternary:
+      {
+        const operator_ternary& ot = static_cast<const operator_ternary&>(e);
+        return expression::make<operator_ternary>(clone(*(ot._condition), substitutions), clone(*(ot._operand_true), substitutions), clone(*(ot._operand_false), substitutions));
+      }
+      case node_kind::operator_component_access:
+      {
+        const operator_component_access& oca = static_cast<const operator_component_access&>(e);
+        return expression::make<operator_component_access>(clone(*(oca._operand), substitutions), visit(*(oca._accessor), accessor_clone()));
+      }
+      case node_kind::constructor_call:
+      {
+        const constructor_call& cc = static_cast<const constructor_call&>(e);
+        return expression::make<constructor_call>(cc.get_type(), fn_clone_args(cc.get_args()));
+      }
+      case node_kind::intrinsic_call:
+      {
+        const intrinsic_call& ic = static_cast<const intrinsic_call&>(e);
+        return expression::make<intrinsic_call>(ic.get_intrinsic_declaration(), fn_clone_args(ic.get_args()));
+      }
+      default:
+        throw std::exception();//TODO: exception type and message
+    }
+  }
+
+  size_t get_reference_count(const node& n, const declaration& d)
+  {
+    size_t count = 0U;
+
+    if(auto r = node_cast<reference>(&n))
+    {
+      count = (&(r->_declaration) == &d) ? 1U : 0U;
+    }
+
+    // The operands are only read, they are never replaced
+    for_each_operand(const_cast<node&>(n), [&count, &d](expression::ptr& operand)
+    {
+      count += get_reference_count(*operand, d);
+    });
+
+    return count;
+  }
+
+  size_t get_reference_count(const block& b, const declaration& d)
+  {
+    size_t count = 0U;
+
+    for(const statement::ptr& s : b)
+    {
+      count += get_reference_count(*s, d);
+    }
+
+    return count;
+  }
+
+  size_t get_size(const node& n)
+  {
+    size_t size = 1U;
+
+    for_each_operand(const_cast<node&>(n), [&size](expression::ptr& operand)
+    {
+      size += get_size(*operand);
+    });
+
+    return size;
+  }
+
+  namespace ns = sltl::syntax;
+}
+
+ns::function_inlining::function_inlining(core::shader_stage, size_t size_max, size_t calls_max) : _size_max(size_max), _calls_max(calls_max), _block_depth(0U), _function(nullptr)
+{
+}
+
+// Calls are only inlined once the whole tree has been visited, when the number of calls to each function is known. The
+// functions are visited in reverse call order, so a function's own calls are inlined before it is inlined into its callers.
+
+ns::action_return_t ns::function_inlining::operator()(block& b, bool is_start)
+{
+  if(is_start)
+  {
+    ++_block_depth;
+  }
+  else
+  {
+    _blocks.push_back(&b);
+
+    // A test tree consists of a single block, rather than a 'main' function
+    if((--_block_depth == 0U) && !_function)
+    {
+      inline_calls();
+    }
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::function_inlining::operator()(function_call& fc, bool is_start)
+{
+  if(is_start)
+  {
+    ++_calls[&(fc.get_function_definition())];
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::function_inlining::operator()(function_definition& fd, bool is_start)
+{
+  if(is_start)
+  {
+    _function = &fd;
+    _functions.push_back(&fd);
+  }
+  else
+  {
+    // The 'main' function is always visited last
+    if(fd._name == L"main")
+    {
+      inline_calls();
+    }
+
+    _function = nullptr;
+  }
+
+  return get_default(is_start);
+}
+
+void ns::function_inlining::complete(tree& t)
+{
+  // Remove the functions marked as unused once every call to them has been inlined
+  t.remove_unused_functions();
+}
+
+ns::action_return_t ns::function_inlining::get_default(bool is_start)
+{
+  return is_start ? action_return_t::step_in :
+                    action_return_t::step_out;
+}
+
+bool ns::function_inlining::is_inlinable(const function_definition& fd) const
+{
+  size_t size = 0U;
+  bool is_returned = false;
+
+  for(const statement::ptr& s : fd.get_body())
+  {
+    const bool is_statement_inlinable = !is_returned && (
+      ((s->get_kind() == node_kind::variable_declaration) && (static_cast<const variable_declaration&>(*s)._qualifier == core::qualifier_storage::none)) ||
+      ((s->get_kind() == node_kind::return_statement) && get_operand(*s)));
+
+    if(!is_statement_inlinable)
+    {
+      return false;
+    }
+
+    if(expression* e = get_operand(*s))
+    {
+      if(!is_inlinable(*e))
+      {
+        return false;
+      }
+
+      size += get_size(*e);
+    }
+
+    is_returned = (s->get_kind() == node_kind::return_statement);
+  }
+
+  auto it = _calls.find(&fd);
+
+  return is_returned && ((size <= _size_max) || ((it != _calls.end()) && (it->second <= _calls_max)));
+}
+
+bool ns::function_inlining::is_inlinable(node& n) const
+{
+  switch(n.get_kind())
+  {
+    case node_kind::operator_unary:
+    case node_kind::function_call:
+      return false;
+    case node_kind::operator_binary:
+      if(language::is_operator_assignment(static_cast<operator_binary&>(n)._operator_id))
+      {
+        return false;
+      }
+      break;
+    default:
+      break;
+  }
+
+  bool is_operand_inlinable = true;
+
+  for_each_operand(n, [this, &is_operand_inlinable](expression::ptr& operand)
+  {
+    is_operand_inlinable = is_operand_inlinable && is_inlinable(*operand);
+  });
+
+  return is_operand_inlinable;
+}
+
+void ns::function_inlining::inline_calls()
+{
+  for(block_base* b : _blocks)
+  {
+    std::vector<statement*> statements;
+
+    for(const statement::ptr& s : *b)
+    {
+      statements.push_back(s.get());
+    }
+
+    for(statement* s : statements)
+    {
+      std::vector<expression::ptr*> calls;
+      bool is_statement_inlinable = true;
+
+      // Finds the calls in evaluation order, so the arguments of a call are inlined before the call itself. Inlining
+      // moves the evaluation of arguments and local variables before the statement, so the rest of the statement must
+      // not have side effects. The outermost assignment of an expression statement is evaluated last so is allowed.
+      std::function<void(expression::ptr&)> fn_find = [this, &calls, &is_statement_inlinable, &fn_find](expression::ptr& exp)
+      {
+        for_each_operand(*exp, fn_find);
+
+        switch(exp->get_kind())
+        {
+          case node_kind::function_call:
+            if(is_inlinable(static_cast<function_call&>(*exp).get_function_definition()))
+            {
+              calls.push_back(&exp);
+            }
+            else
+            {
+              is_statement_inlinable = false;
+            }
+            break;
+          case node_kind::operator_unary:
+            is_statement_inlinable = false;
+            break;
+          case node_kind::operator_binary:
+            if(language::is_operator_assignment(static_cast<operator_binary&>(*exp)._operator_id))
+            {
+              is_statement_inlinable = false;
+            }
+            break;
+          default:
+            break;
+        }
+      };
+
+      if(auto es = node_cast<expression_statement>(s))
+      {
+        auto ob = node_cast<operator_binary>(get_operand(*es));
+
+        if(ob && language::is_operator_assignment(ob->_operator_id))
+        {
+          fn_find(ob->_operand_lhs);
+          fn_find(ob->_operand_rhs);
+        }
+        else
+        {
+          for_each_operand(*es, fn_find);
+        }
+      }
+      else if((s->get_kind() == node_kind::variable_declaration) || (s->get_kind() == node_kind::return_statement))
+      {
+        for_each_operand(*s, fn_find);
+      }
+
+      if(is_statement_inlinable)
+      {
+        for(expression::ptr* exp : calls)
+        {
+          inline_call(*b, *s, *exp);
+        }
+      }
+    }
+  }
+
+  // Remove the functions that every call has been inlined into
+  for(function_definition* fd : _functions)
+  {
+    if((fd->_name != L"main") && (_calls[fd] == 0U))
+    {
+      fd->set_unused();
+    }
+  }
+}
+
+void ns::function_inlining::inline_call(block_base& b, const statement& s, expression::ptr& exp)
+{
+  function_call& fc = static_cast<function_call&>(*exp);
+  const function_definition& fd = fc.get_function_definition();
+
+  substitution_map substitutions;
+
+  // The references to the variables declared in place of parameters and local variables
+  std::vector<expression::ptr> references;
+
+  auto fn_declare = [&b, &s, &substitutions, &references](const declaration& d, expression::ptr&& initializer)
+  {
+    variable_declaration& vd = b.insert_variable_declaration(s, std::move(initializer));
+
+    references.push_back(expression::make<reference>(vd));
+    substitutions.emplace(&d, references.back().get());
+  };
+
+  // Arguments are substituted directly for their parameters unless they would then be evaluated more than once
+  auto it_arg = fc.get_args().begin();
+
+  for(const parameter_declaration::ptr& pd : fd.get_params())
+  {
+    expression::ptr& arg = *(it_arg++);
+
+    const bool is_substituted = (arg->get_kind() == node_kind::reference) ||
+                                (arg->get_kind() == node_kind::literal) ||
+                                (get_reference_count(fd.get_body(), *pd) <= 1U);
+
+    if(is_substituted)
+    {
+      substitutions.emplace(pd.get(), arg.get());
+    }
+    else
+    {
+      fn_declare(*pd, std::move(arg));
+    }
+  }
+
+  // Local variables are re-declared in the calling block, where they receive new (and unique) names
+  for(const statement::ptr& st : fd.get_body())
+  {
+    expression* e = get_operand(*st);
+
+    if(auto vd = node_cast<const variable_declaration>(st.get()))
+    {
+      fn_declare(*vd, (e ? clone(*e, substitutions) : expression::make<temporary>(vd->get_type())));
+    }
+    else
+    {
+      exp = clone(*e, substitutions);
+    }
+  }
+
+  --_calls[&fd];
+}
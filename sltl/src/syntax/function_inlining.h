@@ -0,0 +1,64 @@
+#pragma once
+
+#include "action.h"
+#include "expression.h"
+
+#include <core/shader_stage.h>
+
+#include <vector>
+#include <unordered_map>
+
+#include <cstddef>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // Forward declarations - sltl::syntax namespace
+  class statement;
+  class block_base;
+
+  // Replaces calls to small functions with the function's body. A function can be inlined if its body is a sequence of
+  // variable declarations followed by a return statement, none of which have side effects or call other functions. It
+  // is inlined if its body has no more than 'size_max' nodes or if it is called no more than 'calls_max' times.
+  class function_inlining : public action
+  {
+  public:
+    function_inlining(function_inlining&&) = default;
+    function_inlining(core::shader_stage, size_t size_max = 32U, size_t calls_max = 1U);
+
+    // Non-copyable and non-assignable
+    function_inlining(const function_inlining&) = delete;
+    function_inlining& operator=(function_inlining&&) = delete;
+    function_inlining& operator=(const function_inlining&) = delete;
+
+    action_return_t operator()(block& b, bool is_start = true) override;
+    action_return_t operator()(function_call& fc, bool is_start = true) override;
+    action_return_t operator()(function_definition& fd, bool is_start = true) override;
+
+    void complete(tree& t) override;
+
+  protected:
+    action_return_t get_default(bool is_start) override;
+
+  private:
+    bool is_inlinable(const function_definition& fd) const;
+    bool is_inlinable(node& n) const;
+
+    void inline_calls();
+    void inline_call(block_base& b, const statement& s, expression::ptr& exp);
+
+    const size_t _size_max;
+    const size_t _calls_max;
+
+    size_t _block_depth;
+    function_definition* _function;
+
+    // The blocks in the order they were stepped out of (so the blocks of a function precede the blocks of its callers)
+    std::vector<block_base*> _blocks;
+    std::vector<function_definition*> _functions;
+    std::unordered_map<const function_definition*, size_t> _calls;
+  };
+}
+}
@@ -2,9 +2,11 @@
 
 #include "function_definition.h"
 
+#include <detail/hash.h>
 #include <detail/algorithm.h>
 #include <detail/reference.h>
 #include <detail/comparison.h>
+#include <detail/type_traits.h>
 #include <detail/function_traits.h>
 #include <detail/scoped_singleton.h>
 
@@ -37,10 +39,12 @@ namespace syntax
   private:
     struct impl_base
     {
-      impl_base(size_t fn_hash) : m_fn_hash(fn_hash)
+      impl_base(const void* fn_type, size_t fn_hash) : m_fn_type(fn_type), m_fn_hash(detail::hash_combine(std::hash<const void*>()(fn_type), fn_hash))
       {
       }
 
+      virtual ~impl_base() = default;
+
       virtual bool is_equal(const impl_base& other) const = 0;
 
       size_t hash_code() const
@@ -48,13 +52,15 @@ namespace syntax
         return m_fn_hash;
       }
 
+      const void* const m_fn_type;
       const size_t m_fn_hash;
     };
 
     template<typename Fn, bool = detail::is_equality_comparable<Fn>::value>
     struct impl : impl_base
     {
-      impl(Fn fn) : impl_base({}), m_fn(fn) {}
+      // Keys of this type are never equal, so hashing the key's address spreads them evenly across the buckets
+      impl(Fn fn) : impl_base(detail::type_id<Fn>(), std::hash<const void*>()(this)), m_fn(fn) {}
 
       bool is_equal(const impl_base&) const override
       {
@@ -68,13 +74,13 @@ namespace syntax
     template<typename Fn>
     struct impl<Fn, true> : impl_base
     {
-      impl(Fn fn) : impl_base({}), m_fn(fn) {}
+      impl(Fn fn) : impl_base(detail::type_id<Fn>(), hash_value(fn)), m_fn(fn) {}
 
       bool is_equal(const impl_base& other) const override
       {
-        if(auto* other_cast = dynamic_cast<const impl<Fn>*>(&other))
+        if(other.m_fn_type == m_fn_type)
         {
-          return other_cast->m_fn == m_fn; // Call the equality operator on the callable type
+          return static_cast<const impl<Fn>&>(other).m_fn == m_fn; // Call the equality operator on the callable type
         }
         else
         {
@@ -82,6 +88,18 @@ namespace syntax
         }
       }
 
+      template<typename T>
+      static auto hash_value(const T& fn) -> typename std::enable_if<detail::is_hashable<T>::value, size_t>::type
+      {
+        return std::hash<T>()(fn);
+      }
+
+      template<typename T>
+      static auto hash_value(const T&) -> typename std::enable_if<!detail::is_hashable<T>::value, size_t>::type
+      {
+        return 0U; // Only the callable type contributes to the hash
+      }
+
       Fn m_fn;
     };
 
@@ -89,13 +107,13 @@ namespace syntax
     template<typename R, typename ...P>
     struct impl<R(*)(P...), true> : impl_base
     {
-      impl(R(*fn)(P...)) : impl_base(reinterpret_cast<std::intptr_t>(fn)), m_fn(fn) {}
+      impl(R(*fn)(P...)) : impl_base(detail::type_id<R(*)(P...)>(), reinterpret_cast<std::intptr_t>(fn)), m_fn(fn) {}
 
       bool is_equal(const impl_base& other) const override
       {
-        if(auto* other_cast = dynamic_cast<const impl<R(*)(P...)>*>(&other))
+        if(other.m_fn_type == m_fn_type)
         {
-          return other_cast->m_fn == m_fn; // Compare the function pointers
+          return static_cast<const impl<R(*)(P...)>&>(other).m_fn == m_fn; // Compare the function pointers
         }
         else
         {
@@ -16,7 +16,7 @@ namespace syntax
   class intrinsic_call : public expression
   {
   public:
-    intrinsic_call(const intrinsic_declaration& id, expression_list&& args) : _id(id), _args(std::move(args))
+    intrinsic_call(const intrinsic_declaration& id, expression_list&& args) : expression(node_kind::intrinsic_call), _id(id), _args(std::move(args))
     {
     }
 
@@ -40,6 +40,26 @@ namespace syntax
       return _id._intrinsic;
     }
 
+    const intrinsic_declaration& get_intrinsic_declaration() const
+    {
+      return _id;
+    }
+
+    expression_list& get_args()
+    {
+      return _args;
+    }
+
+    const expression_list& get_args() const
+    {
+      return _args;
+    }
+
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::intrinsic_call);
+    }
+
   private:
     const intrinsic_declaration& _id;
     expression_list _args;
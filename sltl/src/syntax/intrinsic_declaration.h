@@ -19,7 +19,7 @@ namespace syntax
     typedef std::unique_ptr<intrinsic_declaration> ptr;
 
     intrinsic_declaration(const intrinsic_declaration&) = delete;
-    intrinsic_declaration(core::intrinsic i, parameter_list&& parameters, const language::type& type_return) : declaration(to_intrinsic_string(i)), _intrinsic(i), _type_return(type_return), _parameters(std::move(parameters)) {}
+    intrinsic_declaration(core::intrinsic i, parameter_list&& parameters, const language::type& type_return) : declaration(declaration_kind::intrinsic_declaration, to_intrinsic_string(i)), node(node_kind::intrinsic_declaration), _intrinsic(i), _type_return(type_return), _parameters(std::move(parameters)) {}
 
     bool apply_action(action& act) override
     {
@@ -36,6 +36,16 @@ namespace syntax
       return _type_return;
     }
 
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::intrinsic_declaration);
+    }
+
+    static bool is_kind(declaration_kind kind)
+    {
+      return (kind == declaration_kind::intrinsic_declaration);
+    }
+
     friend bool operator<(const intrinsic_declaration& id1, const intrinsic_declaration& id2)
     {
       return detail::less(id1._intrinsic, id1._parameters, id2._intrinsic, id2._parameters);
@@ -27,7 +27,7 @@ namespace
   }
 }
 
-ns::io_block::io_block(sltl::detail::pass_key<io_block_manager>, sltl::core::qualifier_storage qualifier) : block_base(::create_name(qualifier)), _qualifier(qualifier) {}
+ns::io_block::io_block(sltl::detail::pass_key<io_block_manager>, sltl::core::qualifier_storage qualifier) : block_base(node_kind::io_block, ::create_name(qualifier)), _qualifier(qualifier) {}
 
 ns::statement& ns::io_block::add_impl(statement::ptr&&)
 {
@@ -63,10 +63,10 @@ void ns::io_block::pop()
 
 bool ns::io_block::apply_action(action& act)
 {
-  return apply_action_impl(act, *this, _statements.begin(), _statements.end());
+  return apply_action_impl(act, *this, begin(), end());
 }
 
 bool ns::io_block::apply_action(const_action& cact) const
 {
-  return apply_action_impl(cact, *this, _statements.begin(), _statements.end());
+  return apply_action_impl(cact, *this, begin(), end());
 }
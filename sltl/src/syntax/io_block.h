@@ -24,7 +24,12 @@ namespace syntax
 
     bool is_empty() const
     {
-      return _statements.empty();
+      return (begin() == end());
+    }
+
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::io_block);
     }
 
     bool apply_action(action& act) override;
@@ -2,7 +2,7 @@
 
 #include "action.h"
 
-#include <deque>
+#include <detail/small_vector.h>
 
 
 namespace sltl
@@ -15,18 +15,31 @@ namespace syntax
     static_assert(std::is_base_of<node, T>::value, "sltl::syntax::list: template parameter T must derive from sltl::syntax::node");
     static_assert(std::is_base_of<node, N>::value, "sltl::syntax::list: template parameter N must derive from sltl::syntax::node");
 
+    // Most lists (e.g. the arguments of a call) are short enough to be stored inline
+    typedef detail::small_vector<typename T::ptr, 4U> list_t;
+
   public:
     void add(typename T::ptr&& item)
     {
       _list_items.push_back(std::move(item));
     }
 
-    typename std::deque<typename T::ptr>::const_iterator begin() const
+    typename list_t::iterator begin()
+    {
+      return _list_items.begin();
+    }
+
+    typename list_t::iterator end()
+    {
+      return _list_items.end();
+    }
+
+    typename list_t::const_iterator begin() const
     {
       return _list_items.begin();
     }
 
-    typename std::deque<typename T::ptr>::const_iterator end() const
+    typename list_t::const_iterator end() const
     {
       return _list_items.end();
     }
@@ -37,10 +50,10 @@ namespace syntax
     }
 
   protected:
-    list() : N(), _list_items() {}
-    list(list&& l) : N(), _list_items(std::move(l._list_items)) {}
+    list(node_kind kind) : N(kind), _list_items() {}
+    list(node_kind kind, list&& l) : N(kind), _list_items(std::move(l._list_items)) {}
 
-    std::deque<typename T::ptr> _list_items;
+    list_t _list_items;
   };
 }
 }
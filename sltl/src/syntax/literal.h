@@ -6,6 +6,8 @@
 
 #include <detail/type_traits.h>
 
+#include <cassert>
+
 
 namespace sltl
 {
@@ -17,7 +19,7 @@ namespace syntax
     static_assert(detail::is_scalar<T>::value, "sltl::literal: Type T is not a valid template parameter type");
 
   public:
-    literal(T t) : _t(t), _type(language::type_helper<T>()) {}
+    literal(T t) : expression(node_kind::literal), _t(t), _type(language::type_helper<T>()) {}
 
     virtual bool apply_action(action& act) override
     {
@@ -34,10 +36,57 @@ namespace syntax
       return _type;
     }
 
+    // The kind of a literal is the same for every T, so node_cast can't downcast to literal<T>. Check the type id of the
+    // expression as well as its kind instead (or use visit_literal).
+    static bool is_kind(node_kind kind) = delete;
+
     const T _t;
 
   private:
     const language::type _type;
   };
+
+  // Calls fn with the literal cast to its concrete literal<T> type
+  template<typename Fn>
+  decltype(auto) visit_literal(const expression& e, Fn fn)
+  {
+    assert(e.get_kind() == node_kind::literal);
+
+    switch(e.get_type().get_id())
+    {
+      case language::id_float:
+        return fn(static_cast<const literal<float>&>(e));
+      case language::id_double:
+        return fn(static_cast<const literal<double>&>(e));
+      case language::id_int:
+        return fn(static_cast<const literal<int>&>(e));
+      case language::id_uint:
+        return fn(static_cast<const literal<unsigned int>&>(e));
+      case language::id_bool:
+        return fn(static_cast<const literal<bool>&>(e));
+      default:
+        throw std::exception();//TODO: exception type and message
+    }
+  }
+
+  // Creates a literal of the given scalar type, a double exactly represents every float, int, unsigned int and bool value
+  inline expression::ptr make_literal(language::type_id id, double value)
+  {
+    switch(id)
+    {
+      case language::id_float:
+        return expression::make<literal<float>>(static_cast<float>(value));
+      case language::id_double:
+        return expression::make<literal<double>>(value);
+      case language::id_int:
+        return expression::make<literal<int>>(static_cast<int>(value));
+      case language::id_uint:
+        return expression::make<literal<unsigned int>>(static_cast<unsigned int>(value));
+      case language::id_bool:
+        return expression::make<literal<bool>>(value != 0.0);
+      default:
+        throw std::exception();//TODO: exception type and message
+    }
+  }
 }
 }
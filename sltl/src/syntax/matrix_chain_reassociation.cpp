@@ -0,0 +1,75 @@
+#include "matrix_chain_reassociation.h"
+
+#include "operator.h"
+
+#include <type.h>
+
+
+namespace
+{
+  using namespace sltl;
+  using namespace sltl::syntax;
+
+  bool is_matrix_product(const expression& e)
+  {
+    return (e.get_kind() == node_kind::operator_binary) && (static_cast<const operator_binary&>(e)._operator_id == language::id_matrix_multiplication) && e.get_type().get_dimensions().is_matrix();
+  }
+
+  void reassociate(operator_binary& ob)
+  {
+    if(ob._operator_id != language::id_matrix_multiplication)
+    {
+      return;
+    }
+
+    if(ob._operand_lhs->get_type().get_dimensions().is_vector() && is_matrix_product(*(ob._operand_rhs)))
+    {
+      // v * (m1 * m2) => (v * m1) * m2
+      operator_binary& ob_rhs = static_cast<operator_binary&>(*(ob._operand_rhs));
+
+      expression::ptr exp_m2 = std::move(ob_rhs._operand_rhs);
+      ob._operand_lhs = expression::make<operator_binary>(language::id_matrix_multiplication, std::move(ob._operand_lhs), std::move(ob_rhs._operand_lhs));
+      ob._operand_rhs = std::move(exp_m2);
+
+      reassociate(static_cast<operator_binary&>(*(ob._operand_lhs)));
+      reassociate(ob);
+    }
+    else if(ob._operand_rhs->get_type().get_dimensions().is_vector() && is_matrix_product(*(ob._operand_lhs)))
+    {
+      // (m1 * m2) * v => m1 * (m2 * v)
+      operator_binary& ob_lhs = static_cast<operator_binary&>(*(ob._operand_lhs));
+
+      expression::ptr exp_m1 = std::move(ob_lhs._operand_lhs);
+      ob._operand_rhs = expression::make<operator_binary>(language::id_matrix_multiplication, std::move(ob_lhs._operand_rhs), std::move(ob._operand_rhs));
+      ob._operand_lhs = std::move(exp_m1);
+
+      reassociate(static_cast<operator_binary&>(*(ob._operand_rhs)));
+      reassociate(ob);
+    }
+  }
+
+  namespace ns = sltl::syntax;
+}
+
+ns::matrix_chain_reassociation::matrix_chain_reassociation(core::shader_stage)
+{
+}
+
+// Each product is re-associated once it has been stepped out of, at which point any products within its operands
+// are already in vector-first form (or contain no vector at all)
+
+ns::action_return_t ns::matrix_chain_reassociation::operator()(operator_binary& ob, bool is_start)
+{
+  if(!is_start)
+  {
+    reassociate(ob);
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::matrix_chain_reassociation::get_default(bool is_start)
+{
+  return is_start ? action_return_t::step_in :
+                    action_return_t::step_out;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "action.h"
+
+#include <core/shader_stage.h>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // Re-associates chains of matrix multiplications that include a vector, so that the vector is multiplied first and
+  // each step is a vector-matrix product, e.g. 'v * (m1 * m2)' becomes '(v * m1) * m2'. Only the association changes
+  // (never the order of the operands) so the result is the same regardless of the matrix order used for the output.
+  class matrix_chain_reassociation : public action
+  {
+  public:
+    matrix_chain_reassociation(matrix_chain_reassociation&&) = default;
+    matrix_chain_reassociation(core::shader_stage);
+
+    // Non-copyable and non-assignable
+    matrix_chain_reassociation(const matrix_chain_reassociation&) = delete;
+    matrix_chain_reassociation& operator=(matrix_chain_reassociation&&) = delete;
+    matrix_chain_reassociation& operator=(const matrix_chain_reassociation&) = delete;
+
+    action_return_t operator()(operator_binary& ob, bool is_start = true) override;
+
+  protected:
+    action_return_t get_default(bool is_start) override;
+  };
+}
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "action.h"
+#include "arena.h"
 
 #include <vector>
 #include <algorithm>
@@ -12,6 +13,43 @@ namespace sltl
 {
 namespace syntax
 {
+  // Identifies the concrete type of a node, which allows nodes to be identified and downcast without RTTI.
+  // Statement and expression kinds are contiguous so that each group can be tested with a range check.
+  enum class node_kind : unsigned char
+  {
+    // Statements
+    block,
+    io_block,
+    conditional,
+    expression_statement,
+    return_statement,
+    variable_declaration,
+
+    // Expressions
+    reference,
+    temporary,
+    literal,
+    constructor_call,
+    function_call,
+    intrinsic_call,
+    operator_unary,
+    operator_binary,
+    operator_ternary,
+    operator_component_access,
+
+    function_definition,
+    intrinsic_declaration,
+    parameter_declaration,
+    parameter_list,
+    expression_list
+  };
+
+  class node;
+
+  // Calls fn for each (expression) operand of the node, see operand.h
+  template<typename Fn>
+  void for_each_operand(node& n, Fn fn);
+
   class node
   {
   public:
@@ -21,13 +59,46 @@ namespace syntax
 
     virtual ~node() = default;
 
+    // Nodes are allocated from the current arena (if any), see arena_manager
+    static void* operator new(std::size_t size)
+    {
+      return allocate_node(size);
+    }
+
+    static void operator delete(void* p)
+    {
+      deallocate_node(p);
+    }
+
     virtual bool apply_action(action& act) = 0;
     virtual bool apply_action(const_action& cact) const = 0;
 
+    node_kind get_kind() const
+    {
+      return _kind;
+    }
+
   protected:
-    node() = default;
+    node(node_kind kind) : _kind(kind) {}
+
+  private:
+    const node_kind _kind;
   };
 
+  // Returns a pointer to the node as type T, or nullptr if the node is not a T. The type T must provide a
+  // static is_kind function that accepts the kinds of all types derived from T (including T itself).
+  template<typename T>
+  T* node_cast(node* n)
+  {
+    return (n && T::is_kind(n->get_kind())) ? static_cast<T*>(n) : nullptr;
+  }
+
+  template<typename T>
+  const T* node_cast(const node* n)
+  {
+    return (n && T::is_kind(n->get_kind())) ? static_cast<const T*>(n) : nullptr;
+  }
+
   template<typename A, typename T>
   bool apply_action_impl(A& act, T& type)
   {
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "expression.h"
+#include "operator.h"
+#include "operator_component_access.h"
+#include "temporary.h"
+#include "constructor_call.h"
+#include "function_call.h"
+#include "intrinsic_call.h"
+#include "return_statement.h"
+#include "expression_statement.h"
+#include "variable_declaration.h"
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // Calls fn for each expression operand of the node, in evaluation order. Operands are passed as a
+  // reference to their owning pointer so that fn is able to replace them with another expression.
+  // The statements of blocks (and conditionals) are not operands and are not visited.
+  template<typename Fn>
+  void for_each_operand(node& n, Fn fn)
+  {
+    auto fn_args = [&fn](expression_list& args)
+    {
+      for(expression::ptr& arg : args)
+      {
+        fn(arg);
+      }
+    };
+
+    switch(n.get_kind())
+    {
+      case node_kind::expression_statement:
+        fn(static_cast<expression_statement&>(n)._expression);
+        break;
+      case node_kind::return_statement:
+        if(static_cast<return_statement&>(n)._expression)
+        {
+          fn(static_cast<return_statement&>(n)._expression);
+        }
+        break;
+      case node_kind::variable_declaration:
+        if(static_cast<variable_declaration&>(n).has_initializer())
+        {
+          fn(static_cast<variable_declaration&>(n)._initializer);
+        }
+        break;
+      case node_kind::temporary:
+        if(static_cast<temporary&>(n).has_initializer())
+        {
+          fn(static_cast<temporary&>(n)._initializer);
+        }
+        break;
+      case node_kind::constructor_call:
+        fn_args(static_cast<constructor_call&>(n).get_args());
+        break;
+      case node_kind::function_call:
+        fn_args(static_cast<function_call&>(n).get_args());
+        break;
+      case node_kind::intrinsic_call:
+        fn_args(static_cast<intrinsic_call&>(n).get_args());
+        break;
+      case node_kind::operator_unary:
+        fn(static_cast<operator_unary&>(n)._operand);
+        break;
+      case node_kind::operator_binary:
+        fn(static_cast<operator_binary&>(n)._operand_lhs);
+        fn(static_cast<operator_binary&>(n)._operand_rhs);
+        break;
+      case node_kind::operator_ternary:
+        fn(static_cast<operator_ternary&>(n)._condition);
+        fn(static_cast<operator_ternary&>(n)._operand_true);
+        fn(static_cast<operator_ternary&>(n)._operand_false);
+        break;
+      case node_kind::operator_component_access:
+        fn(static_cast<operator_component_access&>(n)._operand);
+        break;
+      default:
+        break;
+    }
+  }
+}
+}
@@ -6,12 +6,23 @@ namespace
   namespace ns = sltl::syntax;
 }
 
-ns::operator_unary::operator_unary(sltl::language::operator_unary_id id, expression::ptr&& operand) : super_t(id), _operand(std::move(operand))
+ns::operator_unary::operator_unary(sltl::language::operator_unary_id id, expression::ptr&& operand) : super_t(node_kind::operator_unary, id), _operand(std::move(operand))
 {
 }
 
-ns::operator_binary::operator_binary(sltl::language::operator_binary_id id, expression::ptr&& lhs, expression::ptr&& rhs) : super_t(id),
+ns::operator_binary::operator_binary(sltl::language::operator_binary_id id, expression::ptr&& lhs, expression::ptr&& rhs) : super_t(node_kind::operator_binary, id),
   _operand_lhs(std::move(lhs)),
   _operand_rhs(std::move(rhs))
 {
 }
+
+ns::operator_ternary::operator_ternary(expression::ptr&& condition, expression::ptr&& operand_true, expression::ptr&& operand_false) : operator_base(node_kind::operator_ternary),
+  _condition(std::move(condition)),
+  _operand_true(std::move(operand_true)),
+  _operand_false(std::move(operand_false))
+{
+  if((_condition->get_type() != language::type_helper<bool>()) || (_operand_true->get_type() != _operand_false->get_type()))
+  {
+    throw std::exception();//TODO: exception type and message
+  }
+}
@@ -2,6 +2,7 @@
 
 #include "action.h"
 #include "expression.h"
+#include "type_cache.h"
 
 #include <type.h>
 
@@ -12,8 +13,14 @@ namespace syntax
 {
   class operator_base : public expression
   {
+  public:
+    static bool is_kind(node_kind kind)
+    {
+      return (kind >= node_kind::operator_unary) && (kind <= node_kind::operator_component_access);
+    }
+
   protected:
-    operator_base() = default;
+    operator_base(node_kind kind) : expression(kind) {}
   };
 
   template<typename E>
@@ -25,7 +32,7 @@ namespace syntax
     const E _operator_id;
 
   protected:
-    operator_base_id(E operator_id) : _operator_id(operator_id) {}
+    operator_base_id(node_kind kind, E operator_id) : operator_base(kind), _operator_id(operator_id) {}
   };
 
   class operator_unary : public operator_base_id<language::operator_unary_id>
@@ -48,14 +55,23 @@ namespace syntax
     void reset(expression::ptr&& operand)
     {
       _operand = std::move(operand);
+      type_cache::invalidate();
     }
 
     virtual language::type get_type() const override
     {
-      return _operand->get_type();
+      return _type_cache.get([this]() { return _operand->get_type(); });
+    }
+
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::operator_unary);
     }
 
     expression::ptr _operand;
+
+  private:
+    type_cache _type_cache;
   };
 
   class operator_binary : public operator_base_id<language::operator_binary_id>
@@ -78,9 +94,37 @@ namespace syntax
     void swap_operands()
     {
       _operand_lhs.swap(_operand_rhs);
+      type_cache::invalidate();
+    }
+
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::operator_binary);
     }
 
     virtual language::type get_type() const override
+    {
+      return _type_cache.get([this]() { return calculate_type(); });
+    }
+
+    expression::ptr _operand_lhs;
+    expression::ptr _operand_rhs;
+
+  private:
+    template<typename A, typename T>
+    static auto apply_action(A& act, T& type) -> typename std::enable_if<std::is_same<typename std::remove_const<T>::type, operator_binary>::value, bool>::type
+    {
+      expression* op_lhs = type._operand_lhs.get();
+      expression* op_rhs = type._operand_rhs.get();
+      expression* ops[] = { op_lhs, op_rhs };
+
+      assert(op_lhs);
+      assert(op_rhs);
+
+      return apply_action_impl(act, type, std::begin(ops), std::end(ops));
+    }
+
+    language::type calculate_type() const
     {
       const language::type type_lhs = _operand_lhs->get_type();
       const language::type type_rhs = _operand_rhs->get_type();
@@ -124,22 +168,51 @@ namespace syntax
       }
     }
 
-    expression::ptr _operand_lhs;
-    expression::ptr _operand_rhs;
+    type_cache _type_cache;
+  };
+
+  // Selects one of two operands of the same type, according to a scalar boolean condition (i.e. 'c ? a : b')
+  class operator_ternary : public operator_base
+  {
+  public:
+    operator_ternary(expression::ptr&& condition, expression::ptr&& operand_true, expression::ptr&& operand_false);
+
+    virtual bool apply_action(action& act) override
+    {
+      return apply_action(act, *this);
+    }
+
+    virtual bool apply_action(const_action& cact) const override
+    {
+      return apply_action(cact, *this);
+    }
+
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::operator_ternary);
+    }
+
+    virtual language::type get_type() const override
+    {
+      return _type_cache.get([this]() { return _operand_true->get_type(); });
+    }
+
+    expression::ptr _condition;
+    expression::ptr _operand_true;
+    expression::ptr _operand_false;
 
   private:
     template<typename A, typename T>
-    static auto apply_action(A& act, T& type) -> typename std::enable_if<std::is_same<typename std::remove_const<T>::type, operator_binary>::value, bool>::type
+    static auto apply_action(A& act, T& type) -> typename std::enable_if<std::is_same<typename std::remove_const<T>::type, operator_ternary>::value, bool>::type
     {
-      expression* op_lhs = type._operand_lhs.get();
-      expression* op_rhs = type._operand_rhs.get();
-      expression* ops[] = { op_lhs, op_rhs };
+      expression* ops[] = { type._condition.get(), type._operand_true.get(), type._operand_false.get() };
 
-      assert(op_lhs);
-      assert(op_rhs);
+      assert(std::all_of(std::begin(ops), std::end(ops), [](const expression* op) { return op != nullptr; }));
 
       return apply_action_impl(act, type, std::begin(ops), std::end(ops));
     }
+
+    type_cache _type_cache;
   };
 }
 }
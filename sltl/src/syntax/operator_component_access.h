@@ -14,7 +14,7 @@ namespace syntax
   class operator_component_access : public operator_base
   {
   public:
-    operator_component_access(expression::ptr&& operand, component_accessor::ptr&& accessor) : _operand(std::move(operand)), _accessor(std::move(accessor)), _type(_accessor->get_type(_operand->get_type()))
+    operator_component_access(expression::ptr&& operand, component_accessor::ptr&& accessor) : operator_base(node_kind::operator_component_access), _operand(std::move(operand)), _accessor(std::move(accessor)), _type(_accessor->get_type(_operand->get_type()))
     {
     }
 
@@ -33,10 +33,12 @@ namespace syntax
       return _type;
     }
 
-  private:
-    expression::ptr _operand;
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::operator_component_access);
+    }
 
-  public:
+    expression::ptr _operand;
     const component_accessor::ptr _accessor;
 
   private:
@@ -8,7 +8,7 @@ namespace
   namespace ns = sltl::syntax;
 }
 
-ns::parameter_declaration::parameter_declaration(std::wstring&& name, const sltl::language::type& type, sltl::core::qualifier_param qualifier) : declaration(std::move(name)), _qualifier(qualifier), _type(type)
+ns::parameter_declaration::parameter_declaration(std::wstring&& name, const sltl::language::type& type, sltl::core::qualifier_param qualifier) : declaration(declaration_kind::parameter_declaration, std::move(name)), node(node_kind::parameter_declaration), _qualifier(qualifier), _type(type)
 {
 }
 
@@ -29,6 +29,16 @@ namespace syntax
 
     language::type get_type() const override;
 
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::parameter_declaration);
+    }
+
+    static bool is_kind(declaration_kind kind)
+    {
+      return (kind == declaration_kind::parameter_declaration);
+    }
+
     const core::qualifier_param _qualifier;
 
   private:
@@ -40,10 +50,10 @@ namespace syntax
     typedef list<parameter_declaration, node> super_t;
 
   public:
-    parameter_list() : super_t() {}
-    parameter_list(parameter_list&& list) : super_t(std::move(list)) {}
+    parameter_list() : super_t(node_kind::parameter_list) {}
+    parameter_list(parameter_list&& list) : super_t(node_kind::parameter_list, std::move(list)) {}
 
-    parameter_list(parameter_declaration::ptr&& p, parameter_list&& list) : super_t(std::move(list))
+    parameter_list(parameter_declaration::ptr&& p, parameter_list&& list) : super_t(node_kind::parameter_list, std::move(list))
     {
       _list_items.push_front(std::move(p));
     }
@@ -82,6 +92,11 @@ namespace syntax
     {
       return !(pl1 < pl2);
     }
+
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::parameter_list);
+    }
   };
 }
 }
@@ -22,6 +22,11 @@ namespace syntax
 
     virtual language::type get_type() const override;
 
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::reference);
+    }
+
     //TODO: store the name of the variable and look it up on demand from a variable_map stored in each block
     const declaration& _declaration;
   };
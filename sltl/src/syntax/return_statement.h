@@ -10,8 +10,11 @@ namespace syntax
 {
   class return_statement : public statement
   {
+    template<typename Fn>
+    friend void for_each_operand(node& n, Fn fn);
+
   public:
-    return_statement(expression::ptr&& e) : _expression(std::move(e)) {}
+    return_statement(expression::ptr&& e) : statement(node_kind::return_statement), _expression(std::move(e)) {}
 
     virtual bool apply_action(action& act) override
     {
@@ -23,6 +26,21 @@ namespace syntax
       return apply_action_impl(cact, *this, _expression.get());
     }
 
+    expression::ptr&& move()
+    {
+      return std::move(_expression);
+    }
+
+    void reset(expression::ptr&& e)
+    {
+      _expression = std::move(e);
+    }
+
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::return_statement);
+    }
+
   private:
     expression::ptr _expression;
   };
@@ -0,0 +1,161 @@
+#include "specialization.h"
+
+#include "operand.h"
+#include "literal.h"
+#include "io_block.h"
+#include "reference.h"
+#include "conditional.h"
+
+#include <core/qualifier.h>
+
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace
+{
+  using namespace sltl;
+  using namespace sltl::syntax;
+
+  expression::ptr make_value(const uniform_binding& binding)
+  {
+    if(binding._type.get_dimensions().is_scalar())
+    {
+      return make_literal(binding._type.get_id(), binding._components[0]);
+    }
+
+    expression_list args;
+
+    for(double component : binding._components)
+    {
+      args.add(make_literal(binding._type.get_id(), component));
+    }
+
+    return expression::make<constructor_call>(binding._type, std::move(args));
+  }
+
+  std::string get_binding_name(core::semantic semantic, core::semantic_index_t semantic_index)
+  {
+    return "semantic " + std::to_string(static_cast<std::underlying_type<core::semantic>::type>(semantic)) + " index " + std::to_string(semantic_index);
+  }
+
+  namespace ns = sltl::syntax;
+}
+
+ns::uniform_binding::uniform_binding(core::semantic_pair semantic, const language::type& type, std::vector<double>&& components) :
+  _semantic(semantic._semantic),
+  _semantic_index(semantic._index),
+  _type(type),
+  _components(std::move(components))
+{
+  if(_components.size() != (_type.get_dimensions().m() * _type.get_dimensions().n()))
+  {
+    throw std::invalid_argument("sltl specialization: the component count of the binding for " + get_binding_name(_semantic, _semantic_index) + " doesn't match its type");
+  }
+}
+
+ns::specialization::specialization(core::shader_stage, std::vector<uniform_binding> bindings) : _bindings(std::move(bindings))
+{
+}
+
+ns::action_return_t ns::specialization::operator()(io_block& iob, bool is_start)
+{
+  if(is_start && (iob._qualifier == core::qualifier_storage::uniform))
+  {
+    // Bindings for uniforms that the shader doesn't declare are ignored
+    for(const statement::ptr& s : iob)
+    {
+      const variable_declaration& vd = static_cast<const variable_declaration&>(*s);
+
+      auto it = std::find_if(_bindings.begin(), _bindings.end(), [&vd](const uniform_binding& binding)
+      {
+        return (binding._semantic == vd._semantic) && (binding._semantic_index == vd._semantic_index);
+      });
+
+      if(it != _bindings.end())
+      {
+        if(it->_type != vd.get_type())
+        {
+          throw std::invalid_argument("sltl specialization: the type of the binding for " + get_binding_name(vd._semantic, vd._semantic_index) + " doesn't match the uniform variable");
+        }
+
+        _declarations.emplace(&vd, &(*it));
+      }
+    }
+  }
+
+  return is_start ? action_return_t::step_over :
+                    action_return_t::step_out;
+}
+
+ns::action_return_t ns::specialization::operator()(variable_declaration& vd, bool is_start)
+{
+  if(!is_start)
+  {
+    substitute(vd);
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::specialization::operator()(conditional& c, bool is_start)
+{
+  if(!is_start && c.get_condition())
+  {
+    expression::ptr condition = c.move();
+    substitute(condition);
+    c.reset(std::move(condition));
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::specialization::operator()(expression_statement& es, bool is_start)
+{
+  if(!is_start)
+  {
+    substitute(es);
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::specialization::operator()(return_statement& rs, bool is_start)
+{
+  if(!is_start)
+  {
+    substitute(rs);
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::specialization::get_default(bool is_start)
+{
+  return is_start ? action_return_t::step_in :
+                    action_return_t::step_out;
+}
+
+void ns::specialization::substitute(node& n)
+{
+  for_each_operand(n, [this](expression::ptr& e)
+  {
+    substitute(e);
+  });
+}
+
+void ns::specialization::substitute(expression::ptr& e)
+{
+  auto r = node_cast<reference>(e.get());
+  auto it = (r ? _declarations.find(&(r->_declaration)) : _declarations.end());
+
+  if(it != _declarations.end())
+  {
+    e = make_value(*(it->second));
+  }
+  else
+  {
+    substitute(*e);
+  }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "action.h"
+#include "expression.h"
+
+#include <type.h>
+
+#include <core/semantic.h>
+#include <core/shader_stage.h>
+
+#include <detail/type_traits.h>
+
+#include <vector>
+#include <unordered_map>
+#include <initializer_list>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // Forward declarations - sltl::syntax namespace
+  class node;
+  class declaration;
+
+  // The known value of the uniform bound to a semantic. The components of vector and matrix values are given in the
+  // same order as the arguments of the equivalent constructor call.
+  struct uniform_binding
+  {
+    uniform_binding(core::semantic_pair semantic, const language::type& type, std::vector<double>&& components);
+
+    const core::semantic _semantic;
+    const core::semantic_index_t _semantic_index;
+
+    const language::type _type;
+    const std::vector<double> _components;
+  };
+
+  template<typename T>
+  auto binding_of(core::semantic s, core::semantic_index_t index, T value) -> typename std::enable_if<detail::is_scalar<T>::value, uniform_binding>::type
+  {
+    return uniform_binding(core::semantic_pair(s, index), language::type_helper<T>(), { static_cast<double>(value) });
+  }
+
+  template<typename T>
+  auto binding_of(core::semantic s, core::semantic_index_t index, std::initializer_list<T> values) -> typename std::enable_if<detail::is_scalar<T>::value, uniform_binding>::type
+  {
+    return uniform_binding(core::semantic_pair(s, index), language::type(language::type_helper<T>().get_id(), 1U, static_cast<language::type_dimension_t>(values.size())), std::vector<double>(values.begin(), values.end()));
+  }
+
+  // Replaces each reference to a bound uniform with its value. Constant folding and branch pruning then
+  // remove the code that depends on these values, see shader::specialize.
+  class specialization : public action
+  {
+  public:
+    specialization(specialization&&) = default;
+    specialization(core::shader_stage, std::vector<uniform_binding> bindings);
+
+    // Non-copyable and non-assignable
+    specialization(const specialization&) = delete;
+    specialization& operator=(specialization&&) = delete;
+    specialization& operator=(const specialization&) = delete;
+
+    action_return_t operator()(io_block& iob, bool is_start = true) override;
+    action_return_t operator()(variable_declaration& vd, bool is_start = true) override;
+    action_return_t operator()(conditional& c, bool is_start = true) override;
+    action_return_t operator()(expression_statement& es, bool is_start = true) override;
+    action_return_t operator()(return_statement& rs, bool is_start = true) override;
+
+  protected:
+    action_return_t get_default(bool is_start) override;
+
+  private:
+    void substitute(node& n);
+    void substitute(expression::ptr& e);
+
+    std::vector<uniform_binding> _bindings;
+
+    // The binding of each bound uniform's declaration
+    std::unordered_map<const declaration*, const uniform_binding*> _declarations;
+  };
+}
+}
@@ -21,8 +21,13 @@ namespace syntax
       return ptr(new T(std::forward<A>(a)...));
     }
 
+    static bool is_kind(node_kind kind)
+    {
+      return (kind >= node_kind::block) && (kind <= node_kind::variable_declaration);
+    }
+
   protected:
-    statement() = default;
+    statement(node_kind kind) : node(kind) {}
   };
 }
 }
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "expression.h"
+#include "type_cache.h"
 
 #include <type.h>
 
+#include <detail/optional.h>
+
 
 namespace sltl
 {
@@ -11,9 +14,12 @@ namespace syntax
 {
   class temporary : public expression
   {
+    template<typename Fn>
+    friend void for_each_operand(node& n, Fn fn);
+
   public:
-    temporary(const language::type& type) : _type(std::make_unique<language::type>(type)), _initializer() {}
-    temporary(expression::ptr&& initializer) : _type(), _initializer(std::move(initializer)) {}
+    temporary(const language::type& type) : expression(node_kind::temporary), _type(type), _initializer() {}
+    temporary(expression::ptr&& initializer) : expression(node_kind::temporary), _type(), _initializer(std::move(initializer)) {}
 
     bool has_type() const
     {
@@ -40,6 +46,17 @@ namespace syntax
       return apply_action_impl(cact, *this, _initializer.get());
     }
 
+    void reset(expression::ptr&& initializer)
+    {
+      if(_type)
+      {
+        throw std::exception();//TODO: exception type and message
+      }
+
+      _initializer = std::move(initializer);
+      type_cache::invalidate();
+    }
+
     void set_type(const language::type& type)
     {
       if(_initializer)
@@ -47,12 +64,13 @@ namespace syntax
         throw std::exception();//TODO: exception type and message
       }
 
-      *_type = type;
+      _type = type;
+      type_cache::invalidate();
     }
 
     virtual language::type get_type() const override
     {
-      return (_type ? *_type : _initializer->get_type());
+      return (_type ? *_type : _type_cache.get([this]() { return _initializer->get_type(); }));
     }
 
     const expression* get_initializer() const
@@ -60,10 +78,16 @@ namespace syntax
       return _initializer.get();
     }
 
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::temporary);
+    }
+
   private:
-    //TODO: make this std::optional once available (C++17)
-    std::unique_ptr<language::type> _type;//TODO: const (ptr or expression or both)?
+    detail::optional<language::type> _type;//TODO: const (ptr or expression or both)?
     expression::ptr _initializer;//TODO: const (ptr or expression or both)?
+
+    type_cache _type_cache;
   };
 }
 }
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "arena.h"
 #include "block.h"
+#include "type_cache.h"
 #include "block_guard.h"
 #include "block_manager.h"
 #include "io_block.h"
@@ -46,9 +48,21 @@ namespace syntax
     virtual bool apply_action(action& act) = 0;
     virtual bool apply_action(const_action& cact) const = 0;
 
+    // Removes the function definitions marked as unused, see function_definition::set_unused
+    void remove_unused_functions()
+    {
+      _functions.erase(std::remove_if(_functions.begin(), _functions.end(), [](const function_definition::ptr& fd)
+      {
+        return fd->is_unused();
+      }), _functions.end());
+    }
+
   protected:
     tree() = default;
 
+    // Declared first so that it is destroyed last, after every node allocated from it
+    arena::ptr _arena;
+
     std::vector<function_definition::ptr> _functions;
 
     statement::ptr _io_block_in;
@@ -60,6 +74,7 @@ namespace syntax
   private:
     struct state final
     {
+      arena_manager_guard     _manager_arena;
       block_manager_guard     _manager_block;
       io_block_manager_guard  _manager_io_block;
       function_manager_guard  _manager_function;
@@ -68,6 +83,7 @@ namespace syntax
 
     void move(state& s)
     {
+      _arena = s._manager_arena->transfer();
       _functions = s._manager_function->transfer();
       _intrinsics = s._manager_intrinsic->transfer();
 
@@ -91,7 +107,17 @@ namespace syntax
 
     virtual bool apply_action(action& act) override
     {
-      return apply_action(act, *this);
+      const bool is_continuing = apply_action(act, *this);
+
+      // The action may have replaced operands without using a mutator that invalidates the cached types
+      type_cache::invalidate();
+
+      if(is_continuing)
+      {
+        act.complete(*this);
+      }
+
+      return is_continuing;
     }
 
     virtual bool apply_action(const_action& cact) const override
@@ -145,7 +171,17 @@ namespace syntax
 
     virtual bool apply_action(action& act) override
     {
-      return _root_block.apply_action(act);
+      const bool is_continuing = _root_block.apply_action(act);
+
+      // The action may have replaced operands without using a mutator that invalidates the cached types
+      type_cache::invalidate();
+
+      if(is_continuing)
+      {
+        act.complete(*this);
+      }
+
+      return is_continuing;
     }
 
     virtual bool apply_action(const_action& cact) const override
@@ -0,0 +1,21 @@
+#include "type_cache.h"
+
+#include <atomic>
+
+
+namespace
+{
+  namespace ns = sltl::syntax;
+
+  std::atomic<unsigned long> type_generation(1U);
+}
+
+void ns::type_cache::invalidate()
+{
+  type_generation.fetch_add(1U, std::memory_order_relaxed);
+}
+
+unsigned long ns::type_cache::get_generation()
+{
+  return type_generation.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <type.h>
+
+#include <detail/optional.h>
+
+#include <mutex>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // Stores the type of a syntax tree node that would otherwise be recalculated (e.g. from its operands) on
+  // every request. Any change to a type within a syntax tree invalidates the cached types of all nodes, as
+  // nodes have no links to their parents and any node above the change might depend upon the changed type.
+  // The node mutators, block_base's statement insertion and removal, and tree::apply_action (once a non-const
+  // action completes) invalidate the cache, so actions don't need to. The cache is locked while it is read or
+  // updated, so the types of a tree can be requested by several threads at once.
+  class type_cache
+  {
+  public:
+    type_cache() : _type(), _generation(0U) {}
+
+    // Non-copyable and non-assignable
+    type_cache(const type_cache&) = delete;
+    type_cache& operator=(const type_cache&) = delete;
+
+    template<typename Fn>
+    language::type get(Fn fn) const
+    {
+      const unsigned long generation = get_generation();
+
+      std::lock_guard<std::mutex> lock(_mutex);
+
+      if(!_type || (_generation != generation))
+      {
+        _type = fn();
+        _generation = generation;
+      }
+
+      return *_type;
+    }
+
+    // Called whenever the type of a node, or the arrangement of its operands, is modified
+    static void invalidate();
+
+  private:
+    static unsigned long get_generation();
+
+    mutable std::mutex _mutex;
+    mutable detail::optional<language::type> _type;
+    mutable unsigned long _generation;
+  };
+}
+}
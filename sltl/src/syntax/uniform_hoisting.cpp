@@ -0,0 +1,382 @@
+#include "uniform_hoisting.h"
+
+#include "operand.h"
+#include "literal.h"
+#include "io_block.h"
+#include "reference.h"
+
+#include <core/qualifier.h>
+
+#include <algorithm>
+
+#include <cassert>
+
+
+namespace
+{
+  using namespace sltl;
+  using namespace sltl::syntax;
+
+  struct uniform_info
+  {
+    bool _is_uniform = true;     // every leaf is either a uniform or a literal
+    bool _has_uniform = false;   // at least one leaf is a uniform
+    bool _has_operation = false; // at least one operator or intrinsic is applied (component access and construction are not counted)
+  };
+
+  const variable_declaration* get_uniform(const expression& e)
+  {
+    if(auto r = node_cast<reference>(&e))
+    {
+      if(auto vd = declaration_cast<const variable_declaration>(&(r->_declaration)))
+      {
+        return (vd->_qualifier == core::qualifier_storage::uniform) ? vd : nullptr;
+      }
+    }
+
+    return nullptr;
+  }
+
+  void get_uniform_info(const expression& e, uniform_info& info)
+  {
+    auto fn_args = [&info](const expression_list& args)
+    {
+      for(const expression::ptr& arg : args)
+      {
+        get_uniform_info(*arg, info);
+      }
+    };
+
+    switch(e.get_kind())
+    {
+      case node_kind::literal:
+        break;
+      case node_kind::reference:
+        info._is_uniform = info._is_uniform && (get_uniform(e) != nullptr);
+        info._has_uniform = info._has_uniform || (get_uniform(e) != nullptr);
+        break;
+      case node_kind::temporary:
+        if(auto init = static_cast<const temporary&>(e).get_initializer())
+        {
+          get_uniform_info(*init, info);
+        }
+        else
+        {
+          info._is_uniform = false;
+        }
+        break;
+      case node_kind::operator_binary:
+        if(language::is_operator_assignment(static_cast<const operator_binary&>(e)._operator_id))
+        {
+          info._is_uniform = false;
+        }
+        else
+        {
+          get_uniform_info(*(static_cast<const operator_binary&>(e)._operand_lhs), info);
+          get_uniform_info(*(static_cast<const operator_binary&>(e)._operand_rhs), info);
+          info._has_operation = true;
+        }
+        break;
+      case node_kind::operator_component_access:
+        get_uniform_info(*(static_cast<const operator_component_access&>(e)._operand), info);
+        break;
+      case node_kind::constructor_call:
+        fn_args(static_cast<const constructor_call&>(e).get_args());
+        break;
+      case node_kind::intrinsic_call:
+        fn_args(static_cast<const intrinsic_call&>(e).get_args());
+        info._has_operation = true;
+        break;
+      default:
+        // Unary operators (increment and decrement) and function calls are never uniform
+        info._is_uniform = false;
+        break;
+    }
+  }
+
+  bool is_uniform(const expression& e)
+  {
+    uniform_info info;
+    get_uniform_info(e, info);
+
+    return info._is_uniform;
+  }
+
+  // Hoisting a lone uniform or literal (or only a swizzle or constructor of them) wouldn't save any work
+  bool is_hoistable(const expression& e)
+  {
+    uniform_info info;
+    get_uniform_info(e, info);
+
+    return info._is_uniform && info._has_uniform && info._has_operation;
+  }
+
+  bool is_matrix_multiplication(const expression* e)
+  {
+    auto ob = node_cast<const operator_binary>(e);
+    return ob && (ob->_operator_id == language::id_matrix_multiplication);
+  }
+
+  void reassociate(operator_binary& ob)
+  {
+    if(ob._operator_id != language::id_matrix_multiplication)
+    {
+      return;
+    }
+
+    if(is_matrix_multiplication(ob._operand_lhs.get()))
+    {
+      operator_binary& ob_lhs = static_cast<operator_binary&>(*(ob._operand_lhs));
+
+      if(!is_uniform(*(ob_lhs._operand_lhs)) && is_uniform(*(ob_lhs._operand_rhs)) && is_uniform(*(ob._operand_rhs)))
+      {
+        // (x * a) * b => x * (a * b)
+        expression::ptr exp_x = std::move(ob_lhs._operand_lhs);
+        ob._operand_rhs = expression::make<operator_binary>(language::id_matrix_multiplication, std::move(ob_lhs._operand_rhs), std::move(ob._operand_rhs));
+        ob._operand_lhs = std::move(exp_x);
+
+        return;
+      }
+    }
+
+    if(is_matrix_multiplication(ob._operand_rhs.get()))
+    {
+      operator_binary& ob_rhs = static_cast<operator_binary&>(*(ob._operand_rhs));
+
+      if(!is_uniform(*(ob_rhs._operand_rhs)) && is_uniform(*(ob_rhs._operand_lhs)) && is_uniform(*(ob._operand_lhs)))
+      {
+        // a * (b * x) => (a * b) * x
+        expression::ptr exp_x = std::move(ob_rhs._operand_rhs);
+        ob._operand_lhs = expression::make<operator_binary>(language::id_matrix_multiplication, std::move(ob._operand_lhs), std::move(ob_rhs._operand_lhs));
+        ob._operand_rhs = std::move(exp_x);
+      }
+    }
+  }
+
+  // Appends the instructions that evaluate the (uniform) expression to the program, operands are always evaluated first
+  void compile(const expression& e, std::vector<uniform_instruction>& program)
+  {
+    auto fn_args = [&program](const expression_list& args)
+    {
+      for(const expression::ptr& arg : args)
+      {
+        compile(*arg, program);
+      }
+
+      return args.size();
+    };
+
+    switch(e.get_kind())
+    {
+      case node_kind::literal:
+      {
+        uniform_instruction instruction(uniform_instruction::opcode::load_literal, e.get_type());
+        instruction._value = visit_literal(e, [](const auto& lit) { return static_cast<double>(lit._t); });
+
+        program.push_back(instruction);
+        break;
+      }
+      case node_kind::reference:
+      {
+        const variable_declaration* vd = get_uniform(e);
+        assert(vd);
+
+        uniform_instruction instruction(uniform_instruction::opcode::load_uniform, e.get_type());
+        instruction._semantic = vd->_semantic;
+        instruction._semantic_index = vd->_semantic_index;
+
+        program.push_back(instruction);
+        break;
+      }
+      case node_kind::temporary:
+        compile(*(static_cast<const temporary&>(e).get_initializer()), program);
+        break;
+      case node_kind::operator_binary:
+      {
+        const operator_binary& ob = static_cast<const operator_binary&>(e);
+
+        compile(*(ob._operand_lhs), program);
+        compile(*(ob._operand_rhs), program);
+
+        uniform_instruction instruction(uniform_instruction::opcode::operator_binary, e.get_type());
+        instruction._operator_id = ob._operator_id;
+
+        program.push_back(instruction);
+        break;
+      }
+      case node_kind::operator_component_access:
+      {
+        const operator_component_access& oca = static_cast<const operator_component_access&>(e);
+
+        compile(*(oca._operand), program);
+
+        uniform_instruction instruction(uniform_instruction::opcode::component_access, e.get_type());
+        instruction._accessor_mode = oca._accessor->_mode;
+
+        switch(oca._accessor->_mode)
+        {
+          case component_accessor::mode::scalar:
+            instruction._indices[0] = static_cast<const component_accessor_scalar&>(*(oca._accessor))._count;
+            break;
+          case component_accessor::mode::vector:
+            std::copy(static_cast<const component_accessor_vector&>(*(oca._accessor)).begin(),
+                      static_cast<const component_accessor_vector&>(*(oca._accessor)).end(), std::begin(instruction._indices));
+            break;
+          case component_accessor::mode::matrix:
+            instruction._indices[0] = static_cast<const component_accessor_matrix&>(*(oca._accessor))._idx_m;
+            instruction._indices[1] = static_cast<const component_accessor_matrix&>(*(oca._accessor))._idx_n;
+            break;
+        }
+
+        program.push_back(instruction);
+        break;
+      }
+      case node_kind::constructor_call:
+      {
+        uniform_instruction instruction(uniform_instruction::opcode::constructor_call, e.get_type());
+        instruction._arg_count = fn_args(static_cast<const constructor_call&>(e).get_args());
+
+        program.push_back(instruction);
+        break;
+      }
+      case node_kind::intrinsic_call:
+      {
+        uniform_instruction instruction(uniform_instruction::opcode::intrinsic_call, e.get_type());
+        instruction._arg_count = fn_args(static_cast<const intrinsic_call&>(e).get_args());
+        instruction._intrinsic = static_cast<const intrinsic_call&>(e).get_intrinsic();
+
+        program.push_back(instruction);
+        break;
+      }
+      default:
+        throw std::exception();//TODO: exception type and message
+    }
+  }
+
+  namespace ns = sltl::syntax;
+}
+
+ns::uniform_instruction::uniform_instruction(opcode op, const language::type& type) :
+  _opcode(op),
+  _type(type),
+  _semantic(core::semantic::none),
+  _semantic_index(0U),
+  _value(0.0),
+  _operator_id(language::id_addition),
+  _intrinsic(core::intrinsic::dot),
+  _accessor_mode(component_accessor::mode::scalar),
+  _indices{ component_accessor::_idx_default, component_accessor::_idx_default, component_accessor::_idx_default, component_accessor::_idx_default },
+  _arg_count(0U)
+{
+}
+
+ns::uniform_precompute::uniform_precompute(core::semantic_pair semantic, const language::type& type) : _semantic(semantic._semantic), _semantic_index(semantic._index), _type(type)
+{
+}
+
+ns::uniform_hoisting::uniform_hoisting(core::shader_stage) : _io_block_uniform(nullptr), _semantic_index_next(0U)
+{
+}
+
+ns::action_return_t ns::uniform_hoisting::operator()(io_block& iob, bool is_start)
+{
+  if(is_start && (iob._qualifier == core::qualifier_storage::uniform))
+  {
+    _io_block_uniform = &iob;
+
+    // The new uniforms are bound to user semantic indices that follow any already in use
+    for(const statement::ptr& s : iob)
+    {
+      const variable_declaration& vd = static_cast<const variable_declaration&>(*s);
+
+      if(vd._semantic == core::semantic::user)
+      {
+        _semantic_index_next = std::max<core::semantic_index_t>(_semantic_index_next, vd._semantic_index + 1U);
+      }
+    }
+  }
+
+  return is_start ? action_return_t::step_over :
+                    action_return_t::step_out;
+}
+
+ns::action_return_t ns::uniform_hoisting::operator()(variable_declaration& vd, bool is_start)
+{
+  if(!is_start)
+  {
+    hoist(vd);
+  }
+
+  return get_default(is_start);
+}
+
+// The products are re-associated bottom up, before any hoisting, so that a chain of uniform
+// matrices is gathered into a single subexpression by the time its statement is stepped out of
+
+ns::action_return_t ns::uniform_hoisting::operator()(operator_binary& ob, bool is_start)
+{
+  if(!is_start)
+  {
+    reassociate(ob);
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::uniform_hoisting::operator()(expression_statement& es, bool is_start)
+{
+  if(!is_start)
+  {
+    hoist(es);
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::uniform_hoisting::operator()(return_statement& rs, bool is_start)
+{
+  if(!is_start)
+  {
+    hoist(rs);
+  }
+
+  return get_default(is_start);
+}
+
+std::vector<ns::uniform_precompute> ns::uniform_hoisting::get_result() const
+{
+  return _precomputes;
+}
+
+ns::action_return_t ns::uniform_hoisting::get_default(bool is_start)
+{
+  return is_start ? action_return_t::step_in :
+                    action_return_t::step_out;
+}
+
+void ns::uniform_hoisting::hoist(node& n)
+{
+  for_each_operand(n, [this](expression::ptr& e)
+  {
+    hoist(e);
+  });
+}
+
+void ns::uniform_hoisting::hoist(expression::ptr& e)
+{
+  // Only the largest uniform subexpressions are hoisted, their operands are left as they are
+  if(_io_block_uniform && is_hoistable(*e))
+  {
+    _precomputes.emplace_back(core::semantic_pair(core::semantic::user, _semantic_index_next++), e->get_type());
+    compile(*e, _precomputes.back()._program);
+
+    const uniform_precompute& precompute = _precomputes.back();
+    variable_declaration& vd = _io_block_uniform->add<variable_declaration>(precompute._type, core::semantic_pair(precompute._semantic, precompute._semantic_index));
+
+    e = expression::make<reference>(vd);
+  }
+  else
+  {
+    hoist(*e);
+  }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "action.h"
+#include "expression.h"
+#include "component_accessor.h"
+
+#include <type.h>
+
+#include <core/semantic.h>
+#include <core/intrinsic.h>
+#include <core/shader_stage.h>
+
+#include <vector>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // A single step of a uniform program. Each instruction pops its operands from the top of the stack and pushes its result.
+  struct uniform_instruction
+  {
+    enum class opcode
+    {
+      load_uniform,     // pushes the value of the uniform bound to _semantic and _semantic_index
+      load_literal,     // pushes _value, converted to _type
+      operator_binary,  // applies _operator_id to the top two values (the lhs operand is pushed first)
+      component_access, // applies the accessor described by _accessor_mode and _indices to the top value
+      constructor_call, // constructs a value of _type from the top _arg_count values
+      intrinsic_call    // calls _intrinsic with the top _arg_count values
+    };
+
+    uniform_instruction(opcode op, const language::type& type);
+
+    const opcode _opcode;
+    const language::type _type;
+
+    core::semantic _semantic;
+    core::semantic_index_t _semantic_index;
+
+    double _value;
+
+    language::operator_binary_id _operator_id;
+    core::intrinsic _intrinsic;
+
+    // Scalar accessors store their count in _indices[0] and matrix accessors their row and column in _indices[0] and _indices[1]
+    component_accessor::mode _accessor_mode;
+    language::type_dimension_t _indices[language::type_dimensions::max_dimensions];
+
+    size_t _arg_count;
+  };
+
+  // Describes how the host should compute a hoisted uniform from the values of the shader's original uniforms
+  struct uniform_precompute
+  {
+    uniform_precompute(core::semantic_pair semantic, const language::type& type);
+
+    const core::semantic _semantic;
+    const core::semantic_index_t _semantic_index;
+
+    const language::type _type;
+
+    // Evaluating the instructions in order leaves the value of the hoisted uniform on top of the stack
+    std::vector<uniform_instruction> _program;
+  };
+
+  // Moves each subexpression whose leaves are all uniforms or literals into a new uniform, bound to the user semantic,
+  // so that it is computed once by the host rather than once per invocation. Matrix products are re-associated where
+  // this exposes a product of uniforms, e.g. 'v * view * proj' becomes 'v * viewproj' (with viewproj a new uniform).
+  class uniform_hoisting : public action_result<std::vector<uniform_precompute>>
+  {
+  public:
+    uniform_hoisting(uniform_hoisting&&) = default;
+    uniform_hoisting(core::shader_stage);
+
+    // Non-copyable and non-assignable
+    uniform_hoisting(const uniform_hoisting&) = delete;
+    uniform_hoisting& operator=(uniform_hoisting&&) = delete;
+    uniform_hoisting& operator=(const uniform_hoisting&) = delete;
+
+    action_return_t operator()(io_block& iob, bool is_start = true) override;
+    action_return_t operator()(variable_declaration& vd, bool is_start = true) override;
+    action_return_t operator()(operator_binary& ob, bool is_start = true) override;
+    action_return_t operator()(expression_statement& es, bool is_start = true) override;
+    action_return_t operator()(return_statement& rs, bool is_start = true) override;
+
+    std::vector<uniform_precompute> get_result() const override;
+
+  protected:
+    action_return_t get_default(bool is_start) override;
+
+  private:
+    void hoist(node& n);
+    void hoist(expression::ptr& e);
+
+    io_block* _io_block_uniform;
+    core::semantic_index_t _semantic_index_next;
+
+    std::vector<uniform_precompute> _precomputes;
+  };
+}
+}
@@ -0,0 +1,177 @@
+#include "variable_coalescing.h"
+
+#include "block.h"
+#include "operand.h"
+#include "reference.h"
+#include "conditional.h"
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+
+
+namespace
+{
+  using namespace sltl;
+  using namespace sltl::syntax;
+
+  typedef std::function<void(expression::ptr&)> reference_fn;
+
+  void for_each_reference(expression::ptr& e, const reference_fn& fn)
+  {
+    if(e->get_kind() == node_kind::reference)
+    {
+      fn(e);
+    }
+    else
+    {
+      for_each_operand(*e, [&fn](expression::ptr& operand)
+      {
+        for_each_reference(operand, fn);
+      });
+    }
+  }
+
+  // Calls fn for each reference within the statement, including those within nested blocks and conditionals
+  void for_each_reference(statement& s, const reference_fn& fn)
+  {
+    if(auto b = node_cast<block>(&s))
+    {
+      for(const statement::ptr& st : *b)
+      {
+        for_each_reference(*st, fn);
+      }
+    }
+    else if(auto c = node_cast<conditional>(&s))
+    {
+      if(c->get_condition())
+      {
+        expression::ptr condition = c->move();
+        for_each_reference(condition, fn);
+        c->reset(std::move(condition));
+      }
+
+      for_each_reference(*(c->get_statement()), fn);
+
+      if(c->get_statement_else())
+      {
+        for_each_reference(*(c->get_statement_else()), fn);
+      }
+    }
+    else
+    {
+      for_each_operand(s, [&fn](expression::ptr& operand)
+      {
+        for_each_reference(operand, fn);
+      });
+    }
+  }
+
+  namespace ns = sltl::syntax;
+}
+
+ns::variable_coalescing::variable_coalescing(core::shader_stage)
+{
+}
+
+ns::action_return_t ns::variable_coalescing::operator()(block& b, bool is_start)
+{
+  if(!is_start)
+  {
+    std::vector<statement*> statements;
+    std::unordered_map<const declaration*, size_t> live_end;
+
+    for(const statement::ptr& s : b)
+    {
+      if(auto vd = node_cast<variable_declaration>(s.get()))
+      {
+        live_end.emplace(vd, statements.size());
+      }
+
+      for_each_reference(*s, [&live_end, &statements](expression::ptr& e)
+      {
+        auto it = live_end.find(&(static_cast<reference&>(*e)._declaration));
+
+        if(it != live_end.end())
+        {
+          it->second = statements.size();
+        }
+      });
+
+      statements.push_back(s.get());
+    }
+
+    std::vector<variable_declaration*> live;
+    std::vector<variable_declaration*> free;
+    std::unordered_map<const declaration*, variable_declaration*> substitutions;
+
+    for(size_t i = 0; i < statements.size(); ++i)
+    {
+      if(!substitutions.empty())
+      {
+        for_each_reference(*(statements[i]), [&substitutions](expression::ptr& e)
+        {
+          auto it = substitutions.find(&(static_cast<reference&>(*e)._declaration));
+
+          if(it != substitutions.end())
+          {
+            e = expression::make<reference>(*(it->second));
+          }
+        });
+      }
+
+      auto vd = node_cast<variable_declaration>(statements[i]);
+
+      // A variable last used by the initializer of this declaration is read before it would be written to
+      const size_t i_end = (vd && vd->has_initializer()) ? (i + 1U) : i;
+
+      auto it_live = std::stable_partition(live.begin(), live.end(), [&live_end, i_end](const variable_declaration* vd_live)
+      {
+        return (live_end.at(vd_live) >= i_end);
+      });
+
+      free.insert(free.end(), it_live, live.end());
+      live.erase(it_live, live.end());
+
+      if(!vd)
+      {
+        continue;
+      }
+
+      // Variables without an initializer are left as they are, as reusing a variable would give them its previous value
+      auto it_free = vd->has_initializer() ? std::find_if(free.rbegin(), free.rend(), [vd](const variable_declaration* vd_free)
+      {
+        return (vd_free->get_type() == vd->get_type());
+      }) : free.rend();
+
+      if(it_free != free.rend())
+      {
+        variable_declaration* vd_free = *it_free;
+        free.erase(std::next(it_free).base());
+
+        live_end.at(vd_free) = live_end.at(vd);
+        live.push_back(vd_free);
+        substitutions.emplace(vd, vd_free);
+
+        b.insert(*vd, statement::make<expression_statement>(expression::make<operator_binary>(language::id_assignment, expression::make<reference>(*vd_free), vd->move())));
+
+        // The reference count accumulated while the tree was built is no longer meaningful once the declaration is replaced
+        b.block_base::variable_info_find(vd->_name)->reset_ref();
+        b.erase(*vd);
+      }
+      else
+      {
+        live.push_back(vd);
+      }
+    }
+  }
+
+  return get_default(is_start);
+}
+
+ns::action_return_t ns::variable_coalescing::get_default(bool is_start)
+{
+  return is_start ? action_return_t::step_in :
+                    action_return_t::step_out;
+}
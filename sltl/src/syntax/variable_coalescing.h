@@ -0,0 +1,32 @@
+#pragma once
+
+#include "action.h"
+
+#include <core/shader_stage.h>
+
+
+namespace sltl
+{
+namespace syntax
+{
+  // Merges local variables of the same type whose live ranges don't overlap, so that fewer variables are live at once.
+  // A variable is live from its declaration to the last statement of its block that refers to it. A declaration with
+  // an initializer whose variable can reuse an earlier variable (of the same block) becomes an assignment to that variable.
+  class variable_coalescing : public action
+  {
+  public:
+    variable_coalescing(variable_coalescing&&) = default;
+    variable_coalescing(core::shader_stage);
+
+    // Non-copyable and non-assignable
+    variable_coalescing(const variable_coalescing&) = delete;
+    variable_coalescing& operator=(variable_coalescing&&) = delete;
+    variable_coalescing& operator=(const variable_coalescing&) = delete;
+
+    action_return_t operator()(block& b, bool is_start = true) override;
+
+  protected:
+    action_return_t get_default(bool is_start) override;
+  };
+}
+}
@@ -9,7 +9,7 @@ namespace
   namespace ns = sltl::syntax;
 }
 
-ns::variable_declaration::variable_declaration(std::wstring&& name, ns::expression::ptr&& initializer) : declaration_statement(std::move(name)),
+ns::variable_declaration::variable_declaration(std::wstring&& name, ns::expression::ptr&& initializer) : declaration_statement(declaration_kind::variable_declaration, node_kind::variable_declaration, std::move(name)),
   _semantic(core::semantic_pair::none._semantic),
   _semantic_index(core::semantic_pair::none._index),
   _qualifier(core::qualifier_storage::none),
@@ -19,11 +19,11 @@ ns::variable_declaration::variable_declaration(std::wstring&& name, ns::expressi
   assert(_initializer);
 }
 
-ns::variable_declaration::variable_declaration(std::wstring&& name, const sltl::language::type& type, sltl::core::qualifier_storage qualifier, sltl::core::semantic_pair semantic) : declaration_statement(std::move(name)),
+ns::variable_declaration::variable_declaration(std::wstring&& name, const sltl::language::type& type, sltl::core::qualifier_storage qualifier, sltl::core::semantic_pair semantic) : declaration_statement(declaration_kind::variable_declaration, node_kind::variable_declaration, std::move(name)),
   _semantic(semantic._semantic),
   _semantic_index(semantic._index),
   _qualifier(qualifier),
-  _type(std::make_unique<language::type>(type)),
+  _type(type),
   _initializer()
 {
 }
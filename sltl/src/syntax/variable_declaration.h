@@ -2,9 +2,12 @@
 
 #include "expression.h"
 #include "declaration_statement.h"
+#include "type_cache.h"
 
 #include <type.h>
 
+#include <detail/optional.h>
+
 #include <core/semantic.h>
 #include <core/qualifier.h>
 
@@ -15,6 +18,9 @@ namespace syntax
 {
   class variable_declaration : public declaration_statement
   {
+    template<typename Fn>
+    friend void for_each_operand(node& n, Fn fn);
+
   public:
     variable_declaration(std::wstring&& name, expression::ptr&& initializer);
     variable_declaration(std::wstring&& name, const language::type& type, core::qualifier_storage qualifier, core::semantic_pair semantic);
@@ -44,6 +50,17 @@ namespace syntax
       return apply_action_impl(cact, *this, _initializer.get());
     }
 
+    void reset(expression::ptr&& initializer)
+    {
+      if(_type)
+      {
+        throw std::exception();//TODO: exception type and message
+      }
+
+      _initializer = std::move(initializer);
+      type_cache::invalidate();
+    }
+
     void set_type(const language::type& type)
     {
       if(_initializer)
@@ -51,12 +68,23 @@ namespace syntax
         throw std::exception();//TODO: exception type and message
       }
 
-      *_type = type;
+      _type = type;
+      type_cache::invalidate();
     }
 
     virtual language::type get_type() const override
     {
-      return (_type ? *_type : _initializer->get_type());
+      return (_type ? *_type : _type_cache.get([this]() { return _initializer->get_type(); }));
+    }
+
+    static bool is_kind(node_kind kind)
+    {
+      return (kind == node_kind::variable_declaration);
+    }
+
+    static bool is_kind(declaration_kind kind)
+    {
+      return (kind == declaration_kind::variable_declaration);
     }
 
     const core::semantic _semantic;
@@ -65,9 +93,10 @@ namespace syntax
     const core::qualifier_storage _qualifier;
 
   private:
-    //TODO: make this std::optional once available (C++17)
-    std::unique_ptr<language::type> _type;//TODO: const (ptr or expression or both)?
+    detail::optional<language::type> _type;//TODO: const (ptr or expression or both)?
     expression::ptr _initializer;//TODO: const (ptr or expression or both)?
+
+    type_cache _type_cache;
   };
 }
 }
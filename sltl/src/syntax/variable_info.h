@@ -13,7 +13,7 @@ namespace syntax
   class variable_info
   {
   public:
-    variable_info() : _ref_count(0) {}
+    variable_info(size_t statement_index) : _ref_count(0), _statement_index(statement_index) {}
 
     void inc_ref()
     {
@@ -25,13 +25,30 @@ namespace syntax
       --_ref_count;
     }
 
+    void reset_ref()
+    {
+      _ref_count = 0;
+    }
+
     size_t get_ref() const
     {
       return _ref_count;
     }
 
+    // The position of the variable's declaration within the statements of its block
+    size_t get_statement_index() const
+    {
+      return _statement_index;
+    }
+
+    void set_statement_index(size_t statement_index)
+    {
+      _statement_index = statement_index;
+    }
+
   private:
     size_t _ref_count;
+    size_t _statement_index;
   };
 
   variable_info& get_variable_info(const variable_declaration* vd);
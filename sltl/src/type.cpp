@@ -56,3 +56,12 @@ bool ns::is_operator_asymmetric(operator_binary_id id)
 {
   return !is_operator_symmetric(id);
 }
+
+bool ns::is_operator_assignment(operator_binary_id id)
+{
+  return ((id == ns::id_assignment) ||
+          (id == ns::id_assignment_addition) ||
+          (id == ns::id_assignment_subtraction) ||
+          (id == ns::id_assignment_multiplication) ||
+          (id == ns::id_assignment_division));
+}
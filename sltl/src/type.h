@@ -297,6 +297,7 @@ namespace language
 
   bool is_operator_symmetric(operator_binary_id id);
   bool is_operator_asymmetric(operator_binary_id id);
+  bool is_operator_assignment(operator_binary_id id);
 
   enum conditional_id
   {
@@ -21,7 +21,7 @@ ns::variable::variable(syntax::parameter_declaration* pd) : _declaration(pd) {}
 
 ns::syntax::expression::ptr ns::variable::make_reference() const
 {
-  if(auto vd = dynamic_cast<syntax::variable_declaration*>(_declaration))
+  if(auto vd = syntax::declaration_cast<syntax::variable_declaration>(_declaration))
   {
     get_variable_info(vd).inc_ref();
   }
@@ -31,7 +31,7 @@ ns::syntax::expression::ptr ns::variable::make_reference() const
 
 ns::syntax::expression::ptr ns::variable::make_reference_or_temporary()
 {
-  if(auto vd = dynamic_cast<syntax::variable_declaration*>(_declaration))
+  if(auto vd = syntax::declaration_cast<syntax::variable_declaration>(_declaration))
   {
     if(get_variable_info(vd).get_ref() > 0)
     {
@@ -42,7 +42,7 @@ ns::syntax::expression::ptr ns::variable::make_reference_or_temporary()
       return make_temporary();
     }
   }
-  else if(auto pd = dynamic_cast<syntax::parameter_declaration*>(_declaration))
+  else if(auto pd = syntax::declaration_cast<syntax::parameter_declaration>(_declaration))
   {
     return make_reference();
   }
@@ -54,7 +54,7 @@ ns::syntax::expression::ptr ns::variable::make_reference_or_temporary()
 
 ns::syntax::expression::ptr ns::variable::make_temporary()
 {
-  if(auto vd = dynamic_cast<syntax::variable_declaration*>(_declaration))
+  if(auto vd = syntax::declaration_cast<syntax::variable_declaration>(_declaration))
   {
     assert(get_variable_info(vd).get_ref() == 0);
 
@@ -0,0 +1,172 @@
+#include "literal_benchmark.h"
+
+#include "output/literal.h"
+
+#include "detail/numeric.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+
+
+namespace
+{
+  namespace ns = sltl_cmd;
+
+  const size_t iteration_count = 2000U;
+  const size_t repeat_count = 5U;
+
+  // The literals are written to a string, as an output_sink_buffer would, which is cleared after each iteration
+  struct literals
+  {
+    std::vector<float> _floats;
+    std::vector<int> _ints;
+    std::vector<unsigned int> _uints;
+  };
+
+  literals make_literals()
+  {
+    literals l;
+
+    // The constants found in typical shaders, followed by arbitrary values (e.g. material parameters)
+    l._floats = { 0.0f, 0.5f, 1.0f, 2.0f, 0.25f, 0.04f, 3.14159265f, 0.31830988f, 1.0e-3f, 255.0f, 0.2126f, 0.7152f, 0.0722f, 2.2f, 0.454545f, 16.0f };
+
+    unsigned int seed = 1U;
+
+    while(l._floats.size() < 64U)
+    {
+      seed = (seed * 1664525U) + 1013904223U;
+      l._floats.push_back(static_cast<float>(seed >> 8U) / 16777216.0f * 100.0f);
+    }
+
+    for(int i = 0; i < 16; ++i)
+    {
+      l._ints.push_back((i * 37) - 100);
+      l._uints.push_back(static_cast<unsigned int>(i) * 1000U);
+    }
+
+    return l;
+  }
+
+  // The string stream based formatting replaced by detail::format_literal
+  template<typename T>
+  std::wstring to_string_stream_real(T t)
+  {
+    std::wstringstream ss;
+
+    if(sltl::detail::has_fractional_part(t))
+    {
+      ss << t;
+    }
+    else
+    {
+      ss << t << L".0";
+    }
+
+    return ss.str();
+  }
+
+  std::wstring to_string_stream(float f)
+  {
+    return to_string_stream_real(f) + L'f';
+  }
+
+  std::wstring to_string_stream(int i)
+  {
+    std::wstringstream ss;
+    ss << i;
+    return ss.str();
+  }
+
+  std::wstring to_string_stream(unsigned int ui)
+  {
+    std::wstringstream ss;
+    ss << ui << L'U';
+    return ss.str();
+  }
+
+  struct format_stream
+  {
+    template<typename T>
+    void operator()(std::wstring& str, T t) const
+    {
+      str += to_string_stream(t);
+    }
+  };
+
+  struct format_buffer
+  {
+    template<typename T>
+    void operator()(std::wstring& str, T t) const
+    {
+      char buffer[sltl::detail::literal_length_max];
+      const size_t length = sltl::detail::format_literal(buffer, t);
+
+      str.append(buffer, buffer + length);
+    }
+  };
+
+  // Returns the shortest time taken to format every literal 'iteration_count' times, in nanoseconds per literal
+  template<typename Fn>
+  double time_literals(const literals& l, Fn fn, size_t& length)
+  {
+    const size_t literal_count = (l._floats.size() + l._ints.size() + l._uints.size()) * iteration_count;
+
+    auto duration = std::chrono::steady_clock::duration::max();
+
+    std::wstring str;
+
+    for(size_t r = 0U; r < repeat_count; ++r)
+    {
+      length = 0U;
+
+      const auto start = std::chrono::steady_clock::now();
+
+      for(size_t i = 0U; i < iteration_count; ++i)
+      {
+        str.clear();
+
+        for(float f : l._floats)
+        {
+          fn(str, f);
+        }
+
+        for(int n : l._ints)
+        {
+          fn(str, n);
+        }
+
+        for(unsigned int u : l._uints)
+        {
+          fn(str, u);
+        }
+
+        length += str.size();
+      }
+
+      duration = std::min(duration, std::chrono::steady_clock::now() - start);
+    }
+
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()) / literal_count;
+  }
+}
+
+void ns::run_literal_benchmark(std::wostream& os)
+{
+  const literals l = make_literals();
+
+  // The length of the output is reported so that the formatting can't be optimized away
+  size_t length_stream;
+  size_t length_literal;
+
+  const double ns_stream = time_literals(l, format_stream(), length_stream);
+  const double ns_literal = time_literals(l, format_buffer(), length_literal);
+
+  os << L"--- Literal Formatting ---" << L"\n\n";
+  os << L"literals:       " << (l._floats.size() + l._ints.size() + l._uints.size()) << L" x " << iteration_count << L"\n";
+  os << L"string stream:  " << ns_stream << L" ns/literal (" << length_stream << L" characters)\n";
+  os << L"format_literal: " << ns_literal << L" ns/literal (" << length_literal << L" characters)\n";
+  os << L"speedup:        " << (ns_stream / ns_literal) << L"x" << std::endl;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <ostream>
+
+
+namespace sltl_cmd
+{
+  // Times the formatting of typical shader literals by detail::format_literal against the string stream based
+  // formatting that it replaced, then writes the time per literal of each to 'os'
+  void run_literal_benchmark(std::wostream& os);
+}
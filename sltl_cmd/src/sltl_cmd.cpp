@@ -13,6 +13,9 @@
 #include "core/qualifier.h"
 #include "core/shader_stage.h"
 
+#include "literal_benchmark.h"
+
+#include <string>
 #include <iostream>
 
 
@@ -226,12 +229,21 @@ namespace
   }
 }
 
-int main()
+int main(int argc, char* argv[])
 {
   constexpr bool is_glsl = false;
 
-  std::wstring shader_vs_text;
-  std::wstring shader_fs_text;
+  if((argc > 1) && (std::string(argv[1]) == "--benchmark-literals"))
+  {
+    sltl_cmd::run_literal_benchmark(std::wcout);
+    return 0;
+  }
+
+  // Write the generated text straight to the console rather than building intermediate strings
+  sltl::output_sink_callback sink([](const wchar_t* str, size_t length)
+  {
+    std::wcout.write(str, length);
+  });
 
   //TODO: make sltl::newline<2> to replace "\n\n"
 
@@ -242,14 +254,17 @@ int main()
 
     if(is_glsl)
     {
-      shader_vs_text = shader_vs.apply_action<sltl::glsl::output_glsl>(sltl::glsl::output_version::v330, sltl::output_flags::flag_extra_newlines);
+      sltl::glsl::output_glsl output_vs(shader_vs._stage, sink, sltl::glsl::output_version::v330, sltl::output_flags::flag_extra_newlines);
+      shader_vs.apply_action(output_vs);
     }
     else
     {
-      shader_vs_text = shader_vs.apply_action<sltl::hlsl::output_hlsl>(sltl::output_flags::flag_extra_newlines);
+      sltl::hlsl::output_hlsl output_vs(shader_vs._stage, sink, sltl::output_flags::flag_extra_newlines);
+      shader_vs.apply_action(output_vs);
     }
 
-    std::wcout << shader_vs_text.c_str() << L"\n\n";
+    sink.flush();
+    std::wcout << L"\n\n";
   }
 
   std::wcout << L"--- Fragment Shader ---" << L"\n\n";
@@ -259,14 +274,17 @@ int main()
 
     if(is_glsl)
     {
-      shader_fs_text = shader_fs.apply_action<sltl::glsl::output_glsl>(sltl::glsl::output_version::v330, sltl::output_flags::flag_extra_newlines);
+      sltl::glsl::output_glsl output_fs(shader_fs._stage, sink, sltl::glsl::output_version::v330, sltl::output_flags::flag_extra_newlines);
+      shader_fs.apply_action(output_fs);
     }
     else
     {
-      shader_fs_text = shader_fs.apply_action<sltl::hlsl::output_hlsl>(sltl::output_flags::flag_extra_newlines);
+      sltl::hlsl::output_hlsl output_fs(shader_fs._stage, sink, sltl::output_flags::flag_extra_newlines);
+      shader_fs.apply_action(output_fs);
     }
 
-    std::wcout << shader_fs_text.c_str() << std::endl;
+    sink.flush();
+    std::wcout << std::endl;
   }
 
   return 0;
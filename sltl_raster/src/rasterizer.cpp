@@ -0,0 +1,469 @@
+#include "rasterizer.h"
+#include "thread_pool.h"
+
+#include "core/qualifier.h"
+
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+
+#include <cmath>
+
+
+namespace
+{
+  namespace ns = sltl_raster;
+
+  // The number of vertices shaded by each task of the vertex stage
+  constexpr size_t vertex_chunk_size = 256U;
+
+  // The components of the system position held at the start of each vertex shader output (and fragment) record
+  constexpr size_t position_component_count = 4U;
+
+  constexpr std::uint32_t id_none = std::numeric_limits<std::uint32_t>::max();
+
+  typedef std::chrono::steady_clock clock;
+
+  double get_elapsed_ms(clock::time_point start)
+  {
+    return std::chrono::duration<double, std::milli>(clock::now() - start).count();
+  }
+
+  sltl::core::semantic_pair get_semantic_position()
+  {
+    return sltl::core::semantic_pair(sltl::core::semantic::system, sltl::core::detail::to_semantic_index(sltl::core::semantic_system::position, 0U));
+  }
+
+  sltl::core::semantic_pair get_semantic_target()
+  {
+    return sltl::core::semantic_pair(sltl::core::semantic::system, sltl::core::detail::to_semantic_index(sltl::core::semantic_system::target, 0U));
+  }
+
+  size_t get_component_count(const std::vector<ns::attribute>& attributes)
+  {
+    return std::accumulate(attributes.begin(), attributes.end(), size_t(0U), [](size_t count, const ns::attribute& a)
+    {
+      return count + a._component_count;
+    });
+  }
+
+  bool is_covered(float w, bool is_inclusive)
+  {
+    return (w > 0.0f) || ((w == 0.0f) && is_inclusive);
+  }
+
+  std::uint32_t to_unorm8(float f)
+  {
+    // Written so that NaN is clamped to zero
+    return (f > 0.0f) ? static_cast<std::uint32_t>((std::min(f, 1.0f) * 255.0f) + 0.5f) : 0U;
+  }
+
+  std::uint32_t to_rgba8(const float* colour)
+  {
+    return to_unorm8(colour[0]) | (to_unorm8(colour[1]) << 8) | (to_unorm8(colour[2]) << 16) | (to_unorm8(colour[3]) << 24);
+  }
+}
+
+ns::attribute::attribute(sltl::core::semantic_pair semantic, size_t component_count) : _semantic(semantic), _component_count(component_count)
+{
+}
+
+ns::rasterizer::rasterizer(thread_pool& pool, size_t width, size_t height, size_t tile_size) : _pool(pool),
+  _width(width),
+  _height(height),
+  _tile_size(tile_size),
+  _tile_count_x((tile_size > 0U) ? ((width + tile_size - 1U) / tile_size) : 0U),
+  _tile_count_y((tile_size > 0U) ? ((height + tile_size - 1U) / tile_size) : 0U),
+  _target(width * height),
+  _bins(_tile_count_x * _tile_count_y),
+  _scratch(pool.get_thread_count())
+{
+  if((width == 0U) || (height == 0U) || (tile_size == 0U))
+  {
+    throw std::exception();//TODO: exception type and message
+  }
+
+  for(scratch& s : _scratch)
+  {
+    s._depth.resize(tile_size * tile_size);
+    s._id.resize(tile_size * tile_size);
+    s._b1.resize(tile_size * tile_size);
+    s._b2.resize(tile_size * tile_size);
+  }
+}
+
+ns::render_stats ns::rasterizer::render(const draw_call& dc, std::uint32_t clear)
+{
+  if((dc._index_count % 3U) != 0U)
+  {
+    throw std::exception();//TODO: exception type and message
+  }
+
+  const size_t record_size = position_component_count + get_component_count(dc._varyings);
+
+  render_stats stats = {};
+  stats._triangles = dc._index_count / 3U;
+
+  std::fill(_target.begin(), _target.end(), clear);
+
+  clock::time_point start = clock::now();
+  run_vertex(dc, record_size);
+  stats._vertex_ms = get_elapsed_ms(start);
+
+  start = clock::now();
+  run_setup(dc, record_size);
+  stats._setup_ms = get_elapsed_ms(start);
+  stats._triangles_visible = _triangles.size();
+
+  for(scratch& s : _scratch)
+  {
+    s._raster_ms = 0.0;
+    s._fragment_ms = 0.0;
+    s._pixels.clear();
+  }
+
+  std::vector<size_t> fragment_counts(_bins.size());
+
+  start = clock::now();
+  _pool.run(_bins.size(), [this, &dc, record_size, &fragment_counts](size_t tile, size_t thread_idx)
+  {
+    run_tile(dc, record_size, tile, _scratch[thread_idx]);
+    fragment_counts[tile] = _scratch[thread_idx]._pixels.size();
+  });
+  stats._tile_ms = get_elapsed_ms(start);
+
+  for(const scratch& s : _scratch)
+  {
+    stats._raster_ms += s._raster_ms;
+    stats._fragment_ms += s._fragment_ms;
+  }
+
+  stats._tiles = static_cast<size_t>(std::count_if(_bins.begin(), _bins.end(), [](const std::vector<std::uint32_t>& bin)
+  {
+    return !bin.empty();
+  }));
+
+  stats._fragments = std::accumulate(fragment_counts.begin(), fragment_counts.end(), size_t(0U));
+
+  return stats;
+}
+
+size_t ns::rasterizer::get_width() const
+{
+  return _width;
+}
+
+size_t ns::rasterizer::get_height() const
+{
+  return _height;
+}
+
+const std::vector<std::uint32_t>& ns::rasterizer::get_target() const
+{
+  return _target;
+}
+
+void ns::rasterizer::run_vertex(const draw_call& dc, size_t record_size)
+{
+  const size_t vertex_size = get_component_count(dc._layout);
+
+  _vertices_out.resize(dc._vertex_count * record_size);
+
+  _pool.run((dc._vertex_count + vertex_chunk_size - 1U) / vertex_chunk_size, [this, &dc, record_size, vertex_size](size_t chunk, size_t)
+  {
+    const size_t first = chunk * vertex_chunk_size;
+    const size_t count = std::min(vertex_chunk_size, dc._vertex_count - first);
+
+    const float* vertices = dc._vertices + (first * vertex_size);
+    float* vertices_out = _vertices_out.data() + (first * record_size);
+
+    std::vector<sltl::interpreter::binding> bindings(dc._uniforms);
+    bindings.reserve(dc._uniforms.size() + dc._layout.size());
+
+    for(const attribute& a : dc._layout)
+    {
+      bindings.emplace_back(sltl::core::qualifier_storage::in, a._semantic, vertices, vertex_size * sizeof(float));
+      vertices += a._component_count;
+    }
+
+    std::vector<sltl::interpreter::output_binding> outputs;
+    outputs.reserve(dc._varyings.size() + 1U);
+    outputs.emplace_back(get_semantic_position(), vertices_out, record_size * sizeof(float));
+
+    vertices_out += position_component_count;
+
+    for(const attribute& a : dc._varyings)
+    {
+      outputs.emplace_back(a._semantic, vertices_out, record_size * sizeof(float));
+      vertices_out += a._component_count;
+    }
+
+    dc._vs(bindings, outputs, count);
+  });
+}
+
+void ns::rasterizer::run_setup(const draw_call& dc, size_t record_size)
+{
+  _triangles.clear();
+
+  for(std::vector<std::uint32_t>& bin : _bins)
+  {
+    bin.clear();
+  }
+
+  const float width = static_cast<float>(_width);
+  const float height = static_cast<float>(_height);
+
+  for(size_t i = 0U; i < dc._index_count; i += 3U)
+  {
+    triangle t;
+
+    bool is_visible = true;
+
+    for(size_t v = 0U; v < 3U; ++v)
+    {
+      const unsigned int index = dc._indices[i + v];
+
+      if(index >= dc._vertex_count)
+      {
+        throw std::exception();//TODO: exception type and message
+      }
+
+      const float* position = _vertices_out.data() + (index * record_size);
+
+      // Triangles that cross the w = 0 plane would need to be clipped
+      if(!(position[3] > 0.0f))
+      {
+        is_visible = false;
+        break;
+      }
+
+      const float inv_w = 1.0f / position[3];
+
+      t._x[v] = ((position[0] * inv_w) + 1.0f) * 0.5f * width;
+      t._y[v] = (1.0f - (position[1] * inv_w)) * 0.5f * height;
+      t._z[v] = position[2] * inv_w;
+      t._inv_w[v] = inv_w;
+      t._index[v] = index;
+    }
+
+    if(!is_visible)
+    {
+      continue;
+    }
+
+    const float area = ((t._x[1] - t._x[0]) * (t._y[2] - t._y[0])) - ((t._x[2] - t._x[0]) * (t._y[1] - t._y[0]));
+
+    // Degenerate (or NaN) triangles are skipped while triangles with the opposite winding are reversed, there is no culling
+    if((area == 0.0f) || std::isnan(area))
+    {
+      continue;
+    }
+    else if(area < 0.0f)
+    {
+      std::swap(t._x[1], t._x[2]);
+      std::swap(t._y[1], t._y[2]);
+      std::swap(t._z[1], t._z[2]);
+      std::swap(t._inv_w[1], t._inv_w[2]);
+      std::swap(t._index[1], t._index[2]);
+    }
+
+    if((std::min({ t._z[0], t._z[1], t._z[2] }) >= 1.0f) || (std::max({ t._z[0], t._z[1], t._z[2] }) < -1.0f))
+    {
+      continue;
+    }
+
+    // The range of pixels whose centre may be covered by the triangle
+    const float x_min = std::ceil(std::min({ t._x[0], t._x[1], t._x[2] }) - 0.5f);
+    const float x_max = std::floor(std::max({ t._x[0], t._x[1], t._x[2] }) - 0.5f);
+    const float y_min = std::ceil(std::min({ t._y[0], t._y[1], t._y[2] }) - 0.5f);
+    const float y_max = std::floor(std::max({ t._y[0], t._y[1], t._y[2] }) - 0.5f);
+
+    if((x_max < 0.0f) || (y_max < 0.0f) || (x_min >= width) || (y_min >= height) || (x_min > x_max) || (y_min > y_max))
+    {
+      continue;
+    }
+
+    const size_t tile_x_min = static_cast<size_t>(std::max(x_min, 0.0f)) / _tile_size;
+    const size_t tile_x_max = static_cast<size_t>(std::min(x_max, width - 1.0f)) / _tile_size;
+    const size_t tile_y_min = static_cast<size_t>(std::max(y_min, 0.0f)) / _tile_size;
+    const size_t tile_y_max = static_cast<size_t>(std::min(y_max, height - 1.0f)) / _tile_size;
+
+    const std::uint32_t id = static_cast<std::uint32_t>(_triangles.size());
+
+    for(size_t tile_y = tile_y_min; tile_y <= tile_y_max; ++tile_y)
+    {
+      for(size_t tile_x = tile_x_min; tile_x <= tile_x_max; ++tile_x)
+      {
+        _bins[(tile_y * _tile_count_x) + tile_x].push_back(id);
+      }
+    }
+
+    _triangles.push_back(t);
+  }
+}
+
+void ns::rasterizer::run_tile(const draw_call& dc, size_t record_size, size_t tile, scratch& s)
+{
+  s._pixels.clear();
+
+  const std::vector<std::uint32_t>& bin = _bins[tile];
+
+  if(bin.empty())
+  {
+    return;
+  }
+
+  clock::time_point start = clock::now();
+
+  const size_t tile_x = (tile % _tile_count_x) * _tile_size;
+  const size_t tile_y = (tile / _tile_count_x) * _tile_size;
+  const size_t tile_width = std::min(_tile_size, _width - tile_x);
+  const size_t tile_height = std::min(_tile_size, _height - tile_y);
+
+  std::fill(s._depth.begin(), s._depth.end(), 1.0f);
+  std::fill(s._id.begin(), s._id.end(), id_none);
+
+  // Find the nearest triangle at each pixel, triangles are tested in submission order so the result doesn't depend on the threads
+  for(std::uint32_t id : bin)
+  {
+    const triangle& t = _triangles[id];
+
+    // The edge function of each edge, w(x, y) = (a * x) + (b * y) + c, is the (doubled) area of the triangle formed by the edge
+    // and the point, where edge i is opposite vertex i. Points on an edge are only covered if the edge's a (or b) is positive,
+    // so that a point on an edge shared by two triangles is covered by exactly one of them.
+    float a[3], b[3], c[3];
+    bool is_inclusive[3];
+
+    for(size_t e = 0U; e < 3U; ++e)
+    {
+      const size_t j = (e + 1U) % 3U;
+      const size_t k = (e + 2U) % 3U;
+
+      a[e] = t._y[j] - t._y[k];
+      b[e] = t._x[k] - t._x[j];
+      c[e] = -((a[e] * t._x[j]) + (b[e] * t._y[j]));
+
+      is_inclusive[e] = (a[e] > 0.0f) || ((a[e] == 0.0f) && (b[e] > 0.0f));
+    }
+
+    const float area = c[0] + (a[0] * t._x[0]) + (b[0] * t._y[0]);
+
+    const float x_min = std::max(std::ceil(std::min({ t._x[0], t._x[1], t._x[2] }) - 0.5f), static_cast<float>(tile_x));
+    const float x_max = std::min(std::floor(std::max({ t._x[0], t._x[1], t._x[2] }) - 0.5f), static_cast<float>(tile_x + tile_width - 1U));
+    const float y_min = std::max(std::ceil(std::min({ t._y[0], t._y[1], t._y[2] }) - 0.5f), static_cast<float>(tile_y));
+    const float y_max = std::min(std::floor(std::max({ t._y[0], t._y[1], t._y[2] }) - 0.5f), static_cast<float>(tile_y + tile_height - 1U));
+
+    for(float y = y_min; y <= y_max; y += 1.0f)
+    {
+      const float py = y + 0.5f;
+
+      for(float x = x_min; x <= x_max; x += 1.0f)
+      {
+        const float px = x + 0.5f;
+
+        const float w0 = (a[0] * px) + (b[0] * py) + c[0];
+        const float w1 = (a[1] * px) + (b[1] * py) + c[1];
+        const float w2 = (a[2] * px) + (b[2] * py) + c[2];
+
+        if(!is_covered(w0, is_inclusive[0]) || !is_covered(w1, is_inclusive[1]) || !is_covered(w2, is_inclusive[2]))
+        {
+          continue;
+        }
+
+        const float l0 = w0 / area;
+        const float l1 = w1 / area;
+        const float l2 = w2 / area;
+
+        const float z = (l0 * t._z[0]) + (l1 * t._z[1]) + (l2 * t._z[2]);
+
+        const size_t p = ((static_cast<size_t>(y) - tile_y) * _tile_size) + (static_cast<size_t>(x) - tile_x);
+
+        if((z < -1.0f) || !(z < s._depth[p]))
+        {
+          continue;
+        }
+
+        // Perspective correct barycentric coordinates, the varyings are interpolated once the visible triangle is known
+        const float p0 = l0 * t._inv_w[0];
+        const float p1 = l1 * t._inv_w[1];
+        const float p2 = l2 * t._inv_w[2];
+        const float inv_sum = 1.0f / (p0 + p1 + p2);
+
+        s._depth[p] = z;
+        s._id[p] = id;
+        s._b1[p] = p1 * inv_sum;
+        s._b2[p] = p2 * inv_sum;
+      }
+    }
+  }
+
+  s._raster_ms += get_elapsed_ms(start);
+  start = clock::now();
+
+  s._fragments.clear();
+
+  for(size_t y = 0U; y < tile_height; ++y)
+  {
+    for(size_t x = 0U; x < tile_width; ++x)
+    {
+      const size_t p = (y * _tile_size) + x;
+
+      if(s._id[p] == id_none)
+      {
+        continue;
+      }
+
+      const triangle& t = _triangles[s._id[p]];
+
+      const float b1 = s._b1[p];
+      const float b2 = s._b2[p];
+      const float b0 = 1.0f - b1 - b2;
+
+      const float* v0 = _vertices_out.data() + (t._index[0] * record_size);
+      const float* v1 = _vertices_out.data() + (t._index[1] * record_size);
+      const float* v2 = _vertices_out.data() + (t._index[2] * record_size);
+
+      // The system position of a fragment is the pixel centre, its depth and its interpolated 1/w
+      s._fragments.push_back(static_cast<float>(tile_x + x) + 0.5f);
+      s._fragments.push_back(static_cast<float>(tile_y + y) + 0.5f);
+      s._fragments.push_back(s._depth[p]);
+      s._fragments.push_back(1.0f / ((b0 * v0[3]) + (b1 * v1[3]) + (b2 * v2[3])));
+
+      for(size_t i = position_component_count; i < record_size; ++i)
+      {
+        s._fragments.push_back((b0 * v0[i]) + (b1 * v1[i]) + (b2 * v2[i]));
+      }
+
+      s._pixels.push_back(((tile_y + y) * _width) + (tile_x + x));
+    }
+  }
+
+  if(!s._pixels.empty())
+  {
+    std::vector<sltl::interpreter::binding> bindings(dc._uniforms);
+    bindings.reserve(dc._uniforms.size() + dc._varyings.size() + 1U);
+    bindings.emplace_back(sltl::core::qualifier_storage::in, get_semantic_position(), s._fragments.data(), record_size * sizeof(float));
+
+    const float* fragments = s._fragments.data() + position_component_count;
+
+    for(const attribute& a : dc._varyings)
+    {
+      bindings.emplace_back(sltl::core::qualifier_storage::in, a._semantic, fragments, record_size * sizeof(float));
+      fragments += a._component_count;
+    }
+
+    s._colours.resize(s._pixels.size() * 4U);
+
+    dc._fs(bindings, { sltl::interpreter::output_binding(get_semantic_target(), s._colours.data(), 4U * sizeof(float)) }, s._pixels.size());
+
+    // Each pixel belongs to a single tile so the target can be written without synchronisation
+    for(size_t i = 0U; i < s._pixels.size(); ++i)
+    {
+      _target[s._pixels[i]] = to_rgba8(s._colours.data() + (i * 4U));
+    }
+  }
+
+  s._fragment_ms += get_elapsed_ms(start);
+}
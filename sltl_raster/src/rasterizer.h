@@ -0,0 +1,138 @@
+#pragma once
+
+#include "interpreter/batch.h"
+
+#include "core/semantic.h"
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+
+namespace sltl_raster
+{
+  // Forward declarations - sltl_raster namespace
+  class thread_pool;
+
+  // Runs a batch of shader invocations, e.g. sltl::interpreter::batch_program::run or sltl::interpreter::bytecode_program::run
+  typedef std::function<void(const std::vector<sltl::interpreter::binding>&, const std::vector<sltl::interpreter::output_binding>&, size_t)> program_fn;
+
+  // A float (or vector of floats) that is read by the vertex shader, or written by the vertex shader and read by the fragment shader
+  struct attribute
+  {
+    attribute(sltl::core::semantic_pair semantic, size_t component_count);
+
+    const sltl::core::semantic_pair _semantic;
+    const size_t _component_count;
+  };
+
+  struct draw_call
+  {
+    program_fn _vs;
+    program_fn _fs;
+
+    // Interleaved vertex data, each vertex holds the components of each attribute of the layout in turn
+    const float* _vertices;
+    size_t _vertex_count;
+    std::vector<attribute> _layout;
+
+    // Three indices for each triangle
+    const unsigned int* _indices;
+    size_t _index_count;
+
+    // The vertex shader outputs interpolated for the fragment shader, other than the system position (which is always written)
+    std::vector<attribute> _varyings;
+
+    // Bound to both the vertex and fragment shader
+    std::vector<sltl::interpreter::binding> _uniforms;
+  };
+
+  struct render_stats
+  {
+    size_t _triangles;
+    size_t _triangles_visible;
+    size_t _tiles;
+    size_t _fragments;
+
+    // Elapsed times in milliseconds, the raster and fragment times are totals for every thread of the tile stage
+    double _vertex_ms;
+    double _setup_ms;
+    double _tile_ms;
+    double _raster_ms;
+    double _fragment_ms;
+  };
+
+  // Renders triangles into an RGBA8 target by running the shaders on the CPU. The vertex shader is run over the vertex buffer
+  // in parallel chunks before the visible triangles are binned into square tiles. Each tile is then rasterised by a single task,
+  // the nearest triangle at each pixel is found with a depth test and the fragment shader is run once for every covered pixel
+  // of the tile (as a single batch). The fragment shader's system position input is the pixel centre, depth and 1/w.
+  class rasterizer
+  {
+  public:
+    rasterizer(thread_pool& pool, size_t width, size_t height, size_t tile_size);
+
+    // Non-copyable and non-assignable
+    rasterizer(const rasterizer&) = delete;
+    rasterizer& operator=(rasterizer&&) = delete;
+    rasterizer& operator=(const rasterizer&) = delete;
+
+    // Clears the target and depth to 'clear' and the far plane before drawing. Triangles are not clipped, any triangle with a
+    // vertex behind the camera (w <= 0) is discarded while pixels outside of the depth range are discarded by the depth test.
+    render_stats render(const draw_call& dc, std::uint32_t clear);
+
+    size_t get_width() const;
+    size_t get_height() const;
+
+    // Each pixel is packed as 0xAABBGGRR, i.e. the bytes are in RGBA order on a little-endian machine
+    const std::vector<std::uint32_t>& get_target() const;
+
+  private:
+    struct triangle
+    {
+      // Screen space x and y, depth and 1/w of each vertex
+      float _x[3];
+      float _y[3];
+      float _z[3];
+      float _inv_w[3];
+
+      unsigned int _index[3];
+    };
+
+    struct scratch
+    {
+      std::vector<float> _depth;
+      std::vector<std::uint32_t> _id;
+      std::vector<float> _b1;
+      std::vector<float> _b2;
+
+      // The pixels covered within the tile along with their fragment shader inputs and outputs
+      std::vector<size_t> _pixels;
+      std::vector<float> _fragments;
+      std::vector<float> _colours;
+
+      double _raster_ms;
+      double _fragment_ms;
+    };
+
+    void run_vertex(const draw_call& dc, size_t record_size);
+    void run_setup(const draw_call& dc, size_t record_size);
+    void run_tile(const draw_call& dc, size_t record_size, size_t tile, scratch& s);
+
+    thread_pool& _pool;
+
+    const size_t _width;
+    const size_t _height;
+    const size_t _tile_size;
+    const size_t _tile_count_x;
+    const size_t _tile_count_y;
+
+    std::vector<std::uint32_t> _target;
+
+    // Vertex shader output, each record holds the system position followed by the varyings
+    std::vector<float> _vertices_out;
+
+    std::vector<triangle> _triangles;
+    std::vector<std::vector<std::uint32_t>> _bins;
+    std::vector<scratch> _scratch;
+  };
+}
@@ -0,0 +1,448 @@
+#include "rasterizer.h"
+#include "thread_pool.h"
+
+#include "shader.h"
+
+#include "if.h"
+#include "basic_operators.h"
+
+#include "io/io.h"
+
+#include "interpreter/batch.h"
+#include "interpreter/bytecode.h"
+
+#include "core/qualifier.h"
+#include "core/shader_stage.h"
+
+#include <array>
+#include <string>
+#include <thread>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include <cmath>
+
+
+namespace sltl_glsl
+{
+  template<typename T>
+  using scalar = sltl::scalar<T>;
+
+  typedef sltl::vector<float, 3> vec3;
+  typedef sltl::vector<float, 4> vec4;
+
+  template<typename ...T>
+  using io_block =  sltl::io::block<T...>;
+
+  template<typename T, sltl::core::semantic S, sltl::core::semantic_index_t N = 0U>
+  using io_var = sltl::io::variable<T, S, N>;
+
+  template<sltl::core::semantic_system S, sltl::core::semantic_index_t N = 0U>
+  using io_var_sys = sltl::io::variable_system<S, N>;
+
+  template<sltl::core::semantic_transform S>
+  using io_var_trans = sltl::io::variable_transform<S>;
+
+  typedef sltl::core::semantic semantic;
+  typedef sltl::core::semantic_system semantic_sys;
+  typedef sltl::core::semantic_transform semantic_trans;
+
+  constexpr sltl::core::qualifier_storage tag_in = sltl::core::qualifier_storage::in;
+  constexpr sltl::core::qualifier_storage tag_out = sltl::core::qualifier_storage::out;
+  constexpr sltl::core::qualifier_storage tag_uniform = sltl::core::qualifier_storage::uniform;
+}
+
+namespace
+{
+  using namespace sltl_glsl;
+
+  // --- In block ---
+
+  typedef io_block<
+    io_var<vec3, semantic::position>,
+    io_var<vec3, semantic::normal>,
+    io_var<vec3, semantic::colour>> vs_in_t;
+
+  // --- In/Out block ---
+
+  typedef io_block<
+    io_var_sys<semantic_sys::position>,
+    io_var<vec3, semantic::normal>,
+    io_var<vec3, semantic::colour>> vs_fs_t;
+
+  // --- Uniform block ---
+
+  //1. mat4 model
+  //2. mat4 modelviewproj
+  //3. vec3 light (direction towards the light, normalised)
+
+  typedef io_block<
+    io_var_trans<semantic_trans::model>,
+    io_var_trans<semantic_trans::modelviewproj>,
+    io_var<vec3, semantic::light>> uniform_t;
+
+  namespace vs
+  {
+    using in_t  = vs_in_t;
+    using out_t = vs_fs_t;
+
+    out_t lambert_vs(sltl::shader_tag_vertex, in_t in)
+    {
+      uniform_t uniform(tag_uniform);
+
+      vec4 normal = vec4(in.get<semantic::normal>(), 0.0f) * uniform.get<semantic_trans::model>();
+
+      out_t out(tag_out);
+
+      out.get<semantic_sys::position>() = vec4(in.get<semantic::position>(), 1.0f) * uniform.get<semantic_trans::modelviewproj>();
+      out.get<semantic::normal>() = normal.xyz;
+      out.get<semantic::colour>() = in.get<semantic::colour>();
+
+      return out;
+    }
+  }
+
+  // --- Out block ---
+  typedef io_block<io_var_sys<semantic_sys::target>> fs_out_t;
+
+  namespace fs
+  {
+    using in_t  = vs_fs_t;
+    using out_t = fs_out_t;
+
+    out_t lambert_fs(sltl::shader_tag_fragment, in_t in)
+    {
+      uniform_t uniform(tag_uniform);
+
+      vec3 N = sltl::normalize(in.get<semantic::normal>());
+      vec3 L = uniform.get<semantic::light>();
+
+      scalar<float> dot_NL = sltl::clamp(sltl::dot(N, L), 0.0f, 1.0f);
+      vec3 colour = in.get<semantic::colour>() * (0.15f + (0.85f * dot_NL));
+
+      // The specular term is only calculated by the lanes facing the light, so the batch is divergent at the terminator
+      sltl::if_then(dot_NL > 0.0f, [&]()
+      {
+        vec3 H = sltl::normalize(L + vec3(0.0f, 0.0f, 1.0f));
+        scalar<float> specular = sltl::pow(sltl::clamp(sltl::dot(N, H), 0.0f, 1.0f), 32.0f) * 0.5f;
+
+        colour += vec3(1.0f, 1.0f, 1.0f) * specular;
+      });
+
+      out_t out(tag_out);
+      out.get<semantic_sys::target>() = vec4(colour, 1.0f);
+
+      return out;
+    }
+  }
+
+  // Row-major with row vectors, i.e. a vector is transformed by multiplying it on the left of the matrix
+  typedef std::array<float, 16> matrix4;
+
+  matrix4 multiply(const matrix4& a, const matrix4& b)
+  {
+    matrix4 m = {};
+
+    for(size_t i = 0U; i < 4U; ++i)
+    {
+      for(size_t j = 0U; j < 4U; ++j)
+      {
+        for(size_t k = 0U; k < 4U; ++k)
+        {
+          m[(i * 4U) + j] += a[(i * 4U) + k] * b[(k * 4U) + j];
+        }
+      }
+    }
+
+    return m;
+  }
+
+  matrix4 rotation_y(float angle)
+  {
+    const float c = std::cos(angle);
+    const float s = std::sin(angle);
+
+    return { c,    0.0f, -s,   0.0f,
+             0.0f, 1.0f, 0.0f, 0.0f,
+             s,    0.0f, c,    0.0f,
+             0.0f, 0.0f, 0.0f, 1.0f };
+  }
+
+  matrix4 translation(float x, float y, float z)
+  {
+    return { 1.0f, 0.0f, 0.0f, 0.0f,
+             0.0f, 1.0f, 0.0f, 0.0f,
+             0.0f, 0.0f, 1.0f, 0.0f,
+             x,    y,    z,    1.0f };
+  }
+
+  // Maps the view space z range [-z_near, -z_far] to the clip space depth range [-1, 1]
+  matrix4 perspective(float fov_y, float aspect, float z_near, float z_far)
+  {
+    const float f = 1.0f / std::tan(fov_y * 0.5f);
+
+    return { f / aspect, 0.0f, 0.0f,                                    0.0f,
+             0.0f,       f,    0.0f,                                    0.0f,
+             0.0f,       0.0f, (z_far + z_near) / (z_near - z_far),     -1.0f,
+             0.0f,       0.0f, (2.0f * z_far * z_near) / (z_near - z_far), 0.0f };
+  }
+
+  // A grid of UV spheres, each vertex is a position, normal and colour (matching vs_in_t)
+  struct scene
+  {
+    static constexpr size_t vertex_size = 9U;
+
+    scene(size_t columns, size_t rows, size_t slices, size_t stacks, float spacing)
+    {
+      constexpr float PI = 3.14159265359f;
+
+      for(size_t row = 0U; row < rows; ++row)
+      {
+        for(size_t column = 0U; column < columns; ++column)
+        {
+          const float centre_x = (static_cast<float>(column) - (static_cast<float>(columns - 1U) * 0.5f)) * spacing;
+          const float centre_y = (static_cast<float>(row) - (static_cast<float>(rows - 1U) * 0.5f)) * spacing;
+
+          const float hue = static_cast<float>((row * columns) + column) / static_cast<float>(rows * columns);
+          const float colour[3] = {
+            0.5f + (0.5f * std::cos(2.0f * PI * hue)),
+            0.5f + (0.5f * std::cos(2.0f * PI * (hue - (1.0f / 3.0f)))),
+            0.5f + (0.5f * std::cos(2.0f * PI * (hue - (2.0f / 3.0f))))
+          };
+
+          const unsigned int first = static_cast<unsigned int>(_vertices.size() / vertex_size);
+
+          for(size_t stack = 0U; stack <= stacks; ++stack)
+          {
+            const float theta = PI * static_cast<float>(stack) / static_cast<float>(stacks);
+
+            for(size_t slice = 0U; slice <= slices; ++slice)
+            {
+              const float phi = 2.0f * PI * static_cast<float>(slice) / static_cast<float>(slices);
+              const float normal[3] = { std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+
+              _vertices.insert(_vertices.end(), { centre_x + normal[0], centre_y + normal[1], normal[2] });
+              _vertices.insert(_vertices.end(), std::begin(normal), std::end(normal));
+              _vertices.insert(_vertices.end(), std::begin(colour), std::end(colour));
+            }
+          }
+
+          for(size_t stack = 0U; stack < stacks; ++stack)
+          {
+            for(size_t slice = 0U; slice < slices; ++slice)
+            {
+              const unsigned int i0 = first + static_cast<unsigned int>((stack * (slices + 1U)) + slice);
+              const unsigned int i1 = i0 + static_cast<unsigned int>(slices + 1U);
+
+              _indices.insert(_indices.end(), { i0, i1, i0 + 1U, i0 + 1U, i1, i1 + 1U });
+            }
+          }
+        }
+      }
+    }
+
+    size_t get_vertex_count() const
+    {
+      return _vertices.size() / vertex_size;
+    }
+
+    std::vector<float> _vertices;
+    std::vector<unsigned int> _indices;
+  };
+
+  struct options
+  {
+    size_t _width = 1280U;
+    size_t _height = 720U;
+    size_t _threads = std::max(std::thread::hardware_concurrency(), 1U);
+    size_t _frames = 10U;
+    size_t _tile = 64U;
+    bool _is_bytecode = false;
+    std::string _output;
+  };
+
+  bool parse_options(int argc, char* argv[], options& opt)
+  {
+    for(int i = 1; i < argc; i += 2)
+    {
+      const std::string name = argv[i];
+
+      if((i + 1) >= argc)
+      {
+        return false;
+      }
+
+      const std::string value = argv[i + 1];
+
+      try
+      {
+        if(name == "--width")
+        {
+          opt._width = std::stoul(value);
+        }
+        else if(name == "--height")
+        {
+          opt._height = std::stoul(value);
+        }
+        else if(name == "--threads")
+        {
+          opt._threads = std::stoul(value);
+        }
+        else if(name == "--frames")
+        {
+          opt._frames = std::stoul(value);
+        }
+        else if(name == "--tile")
+        {
+          opt._tile = std::stoul(value);
+        }
+        else if((name == "--program") && ((value == "batch") || (value == "bytecode")))
+        {
+          opt._is_bytecode = (value == "bytecode");
+        }
+        else if(name == "--output")
+        {
+          opt._output = value;
+        }
+        else
+        {
+          return false;
+        }
+      }
+      catch(const std::exception&)
+      {
+        return false;
+      }
+    }
+
+    return (opt._width > 0U) && (opt._height > 0U) && (opt._threads > 0U) && (opt._frames > 0U) && (opt._tile > 0U);
+  }
+
+  // FNV-1a hash of the target's RGBA bytes, so that the output can be compared between thread counts or program types
+  std::uint32_t get_checksum(const std::vector<std::uint32_t>& target)
+  {
+    std::uint32_t hash = 2166136261U;
+
+    for(std::uint32_t pixel : target)
+    {
+      for(size_t i = 0U; i < 4U; ++i)
+      {
+        hash = (hash ^ ((pixel >> (i * 8U)) & 0xFFU)) * 16777619U;
+      }
+    }
+
+    return hash;
+  }
+
+  void write_ppm(const std::string& filename, const sltl_raster::rasterizer& r)
+  {
+    std::ofstream file(filename, std::ios::binary);
+    file << "P6\n" << r.get_width() << ' ' << r.get_height() << "\n255\n";
+
+    for(std::uint32_t pixel : r.get_target())
+    {
+      const char rgb[3] = { static_cast<char>(pixel & 0xFFU), static_cast<char>((pixel >> 8) & 0xFFU), static_cast<char>((pixel >> 16) & 0xFFU) };
+      file.write(rgb, 3);
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  options opt;
+
+  if(!parse_options(argc, argv, opt))
+  {
+    std::cerr << "usage: sltl_raster [--width N] [--height N] [--threads N] [--frames N] [--tile N] [--program batch|bytecode] [--output file.ppm]" << std::endl;
+    return 1;
+  }
+
+  const sltl::interpreter::batch_program program_vs = sltl::make_shader(&vs::lambert_vs).apply_action<sltl::interpreter::batch_compiler>();
+  const sltl::interpreter::batch_program program_fs = sltl::make_shader(&fs::lambert_fs).apply_action<sltl::interpreter::batch_compiler>();
+
+  const sltl::interpreter::bytecode_program bytecode_vs(program_vs);
+  const sltl::interpreter::bytecode_program bytecode_fs(program_fs);
+
+  const scene s(8U, 5U, 48U, 24U, 2.2f);
+
+  sltl_raster::thread_pool pool(opt._threads);
+  sltl_raster::rasterizer r(pool, opt._width, opt._height, opt._tile);
+
+  const matrix4 viewproj = multiply(translation(0.0f, 0.0f, -16.0f), perspective(0.8f, static_cast<float>(opt._width) / static_cast<float>(opt._height), 1.0f, 100.0f));
+  const float light[3] = { 0.36f, 0.48f, 0.8f };
+
+  matrix4 model;
+  matrix4 modelviewproj;
+
+  sltl_raster::draw_call dc = {
+    nullptr,
+    nullptr,
+    s._vertices.data(),
+    s.get_vertex_count(),
+    { { semantic::position, 3U }, { semantic::normal, 3U }, { semantic::colour, 3U } },
+    s._indices.data(),
+    s._indices.size(),
+    { { semantic::normal, 3U }, { semantic::colour, 3U } },
+    {
+      { tag_uniform, sltl::core::semantic_pair(semantic::transform, sltl::core::detail::to_semantic_index(semantic_trans::model)), model.data() },
+      { tag_uniform, sltl::core::semantic_pair(semantic::transform, sltl::core::detail::to_semantic_index(semantic_trans::modelviewproj)), modelviewproj.data() },
+      { tag_uniform, semantic::light, light }
+    }
+  };
+
+  if(opt._is_bytecode)
+  {
+    dc._vs = [&bytecode_vs](const std::vector<sltl::interpreter::binding>& b, const std::vector<sltl::interpreter::output_binding>& o, size_t count) { bytecode_vs.run(b, o, count); };
+    dc._fs = [&bytecode_fs](const std::vector<sltl::interpreter::binding>& b, const std::vector<sltl::interpreter::output_binding>& o, size_t count) { bytecode_fs.run(b, o, count); };
+  }
+  else
+  {
+    dc._vs = [&program_vs](const std::vector<sltl::interpreter::binding>& b, const std::vector<sltl::interpreter::output_binding>& o, size_t count) { program_vs.run(b, o, count); };
+    dc._fs = [&program_fs](const std::vector<sltl::interpreter::binding>& b, const std::vector<sltl::interpreter::output_binding>& o, size_t count) { program_fs.run(b, o, count); };
+  }
+
+  std::cout << opt._width << 'x' << opt._height << ", " << pool.get_thread_count() << " threads, " << opt._tile << "px tiles, "
+            << (opt._is_bytecode ? "bytecode" : "batch") << " program" << std::endl;
+  std::cout << s._indices.size() / 3U << " triangles, " << s.get_vertex_count() << " vertices" << std::endl << std::endl;
+
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "frame   visible  tiles  fragments  vertex ms  setup ms  tiles ms  (raster ms  fragment ms)  Mpixels/s" << std::endl;
+
+  double total_ms = 0.0;
+  size_t total_fragments = 0U;
+
+  for(size_t frame = 0U; frame < opt._frames; ++frame)
+  {
+    model = rotation_y(0.05f * static_cast<float>(frame));
+    modelviewproj = multiply(model, viewproj);
+
+    const sltl_raster::render_stats stats = r.render(dc, 0xFF332211U);
+    const double frame_ms = stats._vertex_ms + stats._setup_ms + stats._tile_ms;
+
+    total_ms += frame_ms;
+    total_fragments += stats._fragments;
+
+    std::cout << std::setw(5) << frame
+              << std::setw(10) << stats._triangles_visible
+              << std::setw(7) << stats._tiles
+              << std::setw(11) << stats._fragments
+              << std::setw(11) << stats._vertex_ms
+              << std::setw(10) << stats._setup_ms
+              << std::setw(10) << stats._tile_ms
+              << std::setw(13) << stats._raster_ms
+              << std::setw(13) << stats._fragment_ms
+              << std::setw(12) << (static_cast<double>(stats._fragments) / (frame_ms * 1000.0)) << std::endl;
+  }
+
+  std::cout << std::endl << "mean " << (total_ms / static_cast<double>(opt._frames)) << " ms per frame, "
+            << (static_cast<double>(total_fragments) / (total_ms * 1000.0)) << " Mpixels/s (shaded)" << std::endl;
+  std::cout << "checksum " << std::hex << std::setw(8) << std::setfill('0') << get_checksum(r.get_target()) << std::endl;
+
+  if(!opt._output.empty())
+  {
+    write_ppm(opt._output, r);
+  }
+
+  return 0;
+}
@@ -0,0 +1,181 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+
+namespace
+{
+  namespace ns = sltl_raster;
+}
+
+ns::thread_pool::thread_pool(size_t thread_count) : _fn(nullptr), _generation(0U), _idle_count(0U), _remaining(0U), _is_stopping(false)
+{
+  thread_count = std::max<size_t>(thread_count, 1U);
+
+  for(size_t i = 0U; i < thread_count; ++i)
+  {
+    _queues.emplace_back(std::make_unique<queue>());
+  }
+
+  for(size_t i = 0U; i < thread_count; ++i)
+  {
+    _threads.emplace_back(&thread_pool::work, this, i);
+  }
+}
+
+ns::thread_pool::~thread_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _is_stopping = true;
+  }
+
+  _cv_start.notify_all();
+
+  for(std::thread& t : _threads)
+  {
+    t.join();
+  }
+}
+
+void ns::thread_pool::run(size_t count, const task_fn& fn)
+{
+  if(count == 0U)
+  {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  // Every worker must be waiting for the next run before any tasks are queued, so that the tasks of this run can't
+  // be taken by a worker that is still looking for tasks from the previous run
+  _cv_done.wait(lock, [this]()
+  {
+    return (_idle_count == _threads.size());
+  });
+
+  _fn = &fn;
+  _exception = nullptr;
+  _idle_count = 0U;
+  _remaining = count;
+
+  const size_t thread_count = _threads.size();
+
+  for(size_t i = 0U; i < thread_count; ++i)
+  {
+    std::lock_guard<std::mutex> lock_queue(_queues[i]->_mutex);
+
+    for(size_t task = (count * i) / thread_count; task < (count * (i + 1U)) / thread_count; ++task)
+    {
+      _queues[i]->_tasks.push_back(task);
+    }
+  }
+
+  ++_generation;
+  _cv_start.notify_all();
+
+  _cv_done.wait(lock, [this]()
+  {
+    return (_remaining == 0U);
+  });
+
+  _fn = nullptr;
+
+  if(_exception)
+  {
+    std::rethrow_exception(_exception);
+  }
+}
+
+size_t ns::thread_pool::get_thread_count() const
+{
+  return _threads.size();
+}
+
+void ns::thread_pool::work(size_t thread_idx)
+{
+  size_t generation = 0U;
+
+  for(;;)
+  {
+    const task_fn* fn;
+
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+
+      ++_idle_count;
+      _cv_done.notify_all();
+
+      _cv_start.wait(lock, [this, generation]()
+      {
+        return _is_stopping || (_generation != generation);
+      });
+
+      if(_is_stopping)
+      {
+        return;
+      }
+
+      generation = _generation;
+      fn = _fn;
+    }
+
+    size_t task;
+
+    while(pop(thread_idx, task))
+    {
+      try
+      {
+        (*fn)(task, thread_idx);
+      }
+      catch(...)
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if(!_exception)
+        {
+          _exception = std::current_exception();
+        }
+      }
+
+      if(--_remaining == 0U)
+      {
+        // The mutex is locked so that the notification can't be missed by run
+        std::lock_guard<std::mutex> lock(_mutex);
+        _cv_done.notify_all();
+      }
+    }
+  }
+}
+
+bool ns::thread_pool::pop(size_t thread_idx, size_t& task)
+{
+  {
+    queue& q = *_queues[thread_idx];
+    std::lock_guard<std::mutex> lock(q._mutex);
+
+    if(!q._tasks.empty())
+    {
+      task = q._tasks.front();
+      q._tasks.pop_front();
+      return true;
+    }
+  }
+
+  const size_t thread_count = _queues.size();
+
+  for(size_t i = 1U; i < thread_count; ++i)
+  {
+    queue& q = *_queues[(thread_idx + i) % thread_count];
+    std::lock_guard<std::mutex> lock(q._mutex);
+
+    if(!q._tasks.empty())
+    {
+      task = q._tasks.back();
+      q._tasks.pop_back();
+      return true;
+    }
+  }
+
+  return false;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+
+namespace sltl_raster
+{
+  // A fixed set of worker threads, each with its own queue of tasks. A worker takes tasks from the front of its own queue
+  // and, once that is empty, steals tasks from the back of the other queues so that uneven tasks are balanced across workers.
+  class thread_pool
+  {
+  public:
+    // The task and the index of the worker thread running it, which is less than get_thread_count
+    typedef std::function<void(size_t, size_t)> task_fn;
+
+    thread_pool(size_t thread_count);
+    ~thread_pool();
+
+    // Non-copyable and non-assignable
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(thread_pool&&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    // Runs fn for each task in the range [0, count) and returns once every task has completed. Each worker is initially given
+    // a contiguous range of tasks. If a task throws then the first exception is rethrown (once the remaining tasks have run).
+    void run(size_t count, const task_fn& fn);
+
+    size_t get_thread_count() const;
+
+  private:
+    struct queue
+    {
+      std::mutex _mutex;
+      std::deque<size_t> _tasks;
+    };
+
+    void work(size_t thread_idx);
+    bool pop(size_t thread_idx, size_t& task);
+
+    std::vector<std::unique_ptr<queue>> _queues;
+    std::vector<std::thread> _threads;
+
+    std::mutex _mutex;
+    std::condition_variable _cv_start;
+    std::condition_variable _cv_done;
+
+    const task_fn* _fn;
+    std::exception_ptr _exception;
+
+    size_t _generation;
+    size_t _idle_count;
+    std::atomic<size_t> _remaining;
+
+    bool _is_stopping;
+  };
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include "scalar.h"
+#include "vector.h"
+#include "matrix.h"
+#include "element_wise.h"
+#include "basic_operators.h"
+#include "shader.h"
+
+#include "syntax/algebraic_simplification.h"
+
+#include "output/glsl/output_glsl.h"
+
+
+namespace
+{
+  std::wstring to_string(sltl::shader&& shader, sltl::detail::enum_flags<sltl::syntax::simplification_flags> flags = sltl::syntax::simplification_flags::flag_all)
+  {
+    shader.apply_action<sltl::syntax::algebraic_simplification>(flags);
+
+    // Prepend a newline character to exactly match the raw string literals
+    return L'\n' + shader.apply_action<sltl::glsl::output_glsl>(sltl::glsl::output_version::none, sltl::output_flags::flag_indent_space);
+  }
+
+  typedef sltl::vector<float, 3> vec3;
+
+  auto test_shader = []()
+  {
+    sltl::scalar<float> a = 2.0f;
+    vec3 v;
+
+    sltl::scalar<float> p1 = sltl::pow(a, 5.0f);
+    sltl::scalar<float> p2 = sltl::pow(a, 2.5f);
+    vec3 p3 = sltl::pow(v, vec3(3.0f, 3.0f, 3.0f));
+
+    sltl::scalar<float> r1 = a / 4.0f;
+    sltl::scalar<float> r2 = a / 0.0f;
+    vec3 r3 = v / 5.0f;
+
+    sltl::scalar<float> i1 = (a * 1.0f) + (0.0f + a);
+    vec3 i2 = (v - vec3(0.0f, 0.0f, 0.0f)) / 1.0f;
+    vec3 i3 = a * vec3(1.0f, 1.0f, 1.0f);
+
+    vec3 n1 = sltl::normalize(v);
+    vec3 n2 = sltl::normalize(sltl::normalize(v) + sltl::normalize(n1));
+    n1 = v;
+    vec3 n3 = sltl::normalize(n1);
+    vec3 n4 = sltl::normalize(sltl::normalize(v));
+  };
+}
+
+TEST(algebraic_simplification, all)
+{
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f1 = 2.0f;
+  vec3 v2;
+  float f3 = (((f1 * f1) * f1) * f1) * f1;
+  float f4 = pow(f1, 2.5f);
+  vec3 v6 = (v2 * v2) * v2;
+  float f7 = f1 * 0.25f;
+  float f8 = f1 / 0.0f;
+  vec3 v9 = v2 * 0.2f;
+  float f10 = f1 + f1;
+  vec3 v12 = v2;
+  vec3 v14 = f1 * vec3(1.0f, 1.0f, 1.0f);
+  vec3 v15 = normalize(v2);
+  vec3 v16 = normalize(normalize(v2) + v15);
+  v15 = v2;
+  vec3 v17 = normalize(v15);
+  vec3 v18 = normalize(v2);
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(algebraic_simplification, flags)
+{
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader), sltl::syntax::simplification_flags::flag_pow | sltl::syntax::simplification_flags::flag_normalize);
+  const std::wstring expected = LR"(
+{
+  float f1 = 2.0f;
+  vec3 v2;
+  float f3 = (((f1 * f1) * f1) * f1) * f1;
+  float f4 = pow(f1, 2.5f);
+  vec3 v6 = (v2 * v2) * v2;
+  float f7 = f1 / 4.0f;
+  float f8 = f1 / 0.0f;
+  vec3 v9 = v2 / 5.0f;
+  float f10 = (f1 * 1.0f) + (0.0f + f1);
+  vec3 v12 = (v2 - vec3(0.0f, 0.0f, 0.0f)) / 1.0f;
+  vec3 v14 = f1 * vec3(1.0f, 1.0f, 1.0f);
+  vec3 v15 = normalize(v2);
+  vec3 v16 = normalize(normalize(v2) + v15);
+  v15 = v2;
+  vec3 v17 = normalize(v15);
+  vec3 v18 = normalize(v2);
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
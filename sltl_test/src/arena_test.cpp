@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include "scalar.h"
+#include "basic_operators.h"
+#include "shader.h"
+
+#include "syntax/arena.h"
+#include "syntax/literal.h"
+
+#include <cstdint>
+
+
+TEST(arena, allocate)
+{
+  sltl::syntax::arena a;
+
+  ASSERT_EQ(0U, a.get_size());
+  ASSERT_EQ(0U, a.get_capacity());
+
+  void* p1 = a.allocate(1U);
+  void* p2 = a.allocate(3U);
+
+  ASSERT_NE(p1, p2);
+  ASSERT_EQ(0U, reinterpret_cast<std::uintptr_t>(p1) % alignof(std::max_align_t));
+  ASSERT_EQ(0U, reinterpret_cast<std::uintptr_t>(p2) % alignof(std::max_align_t));
+  ASSERT_EQ(sltl::syntax::arena::chunk_size_min, a.get_capacity());
+
+  // Allocations larger than the maximum chunk size are given a chunk of their own
+  a.allocate(sltl::syntax::arena::chunk_size_max + 1U);
+
+  ASSERT_LE(sltl::syntax::arena::chunk_size_min + sltl::syntax::arena::chunk_size_max + 1U, a.get_capacity());
+}
+
+TEST(arena, reset)
+{
+  sltl::syntax::arena a;
+
+  void* p1 = a.allocate(sltl::syntax::arena::chunk_size_min);
+  void* p2 = a.allocate(sltl::syntax::arena::chunk_size_min);
+
+  const size_t capacity = a.get_capacity();
+
+  a.reset();
+
+  ASSERT_EQ(0U, a.get_size());
+  ASSERT_EQ(capacity, a.get_capacity());
+
+  // The memory reserved before the reset is reused, in the same order
+  ASSERT_EQ(p1, a.allocate(sltl::syntax::arena::chunk_size_min));
+  ASSERT_EQ(p2, a.allocate(sltl::syntax::arena::chunk_size_min));
+  ASSERT_EQ(capacity, a.get_capacity());
+}
+
+TEST(arena, manager)
+{
+  ASSERT_EQ(nullptr, sltl::syntax::get_current_arena());
+
+  {
+    sltl::syntax::arena_manager_guard manager;
+
+    sltl::syntax::arena* a = sltl::syntax::get_current_arena();
+    ASSERT_NE(nullptr, a);
+
+    const size_t size = a->get_size();
+
+    auto e = sltl::syntax::expression::make<sltl::syntax::literal<float>>(1.0f);
+
+    ASSERT_LT(size, a->get_size());
+  }
+
+  ASSERT_EQ(nullptr, sltl::syntax::get_current_arena());
+
+  // Nodes created without an active arena manager are allocated from the free store
+  auto e = sltl::syntax::expression::make<sltl::syntax::literal<float>>(1.0f);
+
+  ASSERT_NE(nullptr, e.get());
+}
+
+TEST(arena, recycle)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> f = 1.0f;
+    f = f + f;
+  };
+
+  sltl::syntax::arena::clear_cache();
+
+  sltl::syntax::arena* a1 = nullptr;
+  sltl::syntax::arena* a2 = nullptr;
+  sltl::syntax::arena* a3 = nullptr;
+
+  {
+    sltl::syntax::arena_manager_guard manager;
+    a1 = sltl::syntax::get_current_arena();
+  }
+
+  {
+    // The shader takes ownership of the recycled arena
+    sltl::shader s = sltl::make_test(test_shader);
+
+    sltl::syntax::arena_manager_guard manager;
+    a2 = sltl::syntax::get_current_arena();
+
+    ASSERT_NE(a1, a2);
+  }
+
+  // The arena of the destroyed shader is reused, as it is the largest recycled arena
+  {
+    sltl::syntax::arena_manager_guard manager;
+    a3 = sltl::syntax::get_current_arena();
+
+    ASSERT_EQ(0U, a3->get_size());
+  }
+
+  ASSERT_EQ(a1, a3);
+
+  sltl::syntax::arena::clear_cache();
+}
@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+
+#include "io/io.h"
+
+#include "if.h"
+#include "call.h"
+#include "shader.h"
+#include "scalar.h"
+#include "vector.h"
+#include "matrix.h"
+#include "basic_operators.h"
+
+#include "syntax/branch_flattening.h"
+
+#include "interpreter/batch.h"
+#include "interpreter/interpreter.h"
+
+
+namespace
+{
+  struct vertex
+  {
+    float _position[3];
+    float _material;
+  };
+
+  struct vertex_out
+  {
+    float _position[4];
+    int _index;
+  };
+
+  typedef sltl::io::block<
+    sltl::io::variable<sltl::matrix<float, 4, 4>, sltl::core::semantic::user>> io_block_uniform;
+
+  typedef sltl::io::block<
+    sltl::io::variable<sltl::vector<float, 3>, sltl::core::semantic::position>,
+    sltl::io::variable<sltl::scalar<float>, sltl::core::semantic::material>> io_block_in;
+
+  typedef sltl::io::block<
+    sltl::io::variable<sltl::vector<float, 4>, sltl::core::semantic::position>,
+    sltl::io::variable<sltl::scalar<int>, sltl::core::semantic::user>> io_block_out;
+
+  sltl::scalar<float> fn_scale(sltl::scalar<float> f, sltl::scalar<float> s)
+  {
+    return sltl::pow(f, s);
+  }
+
+  auto test_shader = [](sltl::shader::tag<sltl::core::shader_stage::test>, io_block_in input)
+  {
+    io_block_uniform uniform(sltl::core::qualifier_storage::uniform);
+    io_block_out output;
+
+    sltl::vector<float, 3> p = input.get<sltl::core::semantic::position>();
+    sltl::scalar<float> f = input.get<sltl::core::semantic::material>();
+    sltl::scalar<int> i = 0;
+
+    sltl::if_then(f > sltl::scalar<float>(0.5f), [&]()
+    {
+      p -= sltl::vector<float, 3>(1.0f, 1.0f, 1.0f);
+      i += 1;
+    }).else_if(f > sltl::scalar<float>(0.25f), [&]()
+    {
+      p += sltl::vector<float, 3>(p.z, p.y, p.x);
+      i += 2;
+    }).else_end([&]()
+    {
+      p.xy = p.yx;
+    });
+
+    output.get<sltl::core::semantic::position>() = sltl::vector<float, 4>(sltl::normalize(p), sltl::call(fn_scale, f, 2.0f)) * uniform.get<sltl::core::semantic::user>();
+    output.get<sltl::core::semantic::user>() = i;
+
+    return output;
+  };
+
+  // The user output is only written by the invocations that take the branch
+  auto test_shader_conditional = [](sltl::shader::tag<sltl::core::shader_stage::test>, io_block_in input)
+  {
+    io_block_out output;
+
+    sltl::if_then(input.get<sltl::core::semantic::material>() > sltl::scalar<float>(0.5f), [&]()
+    {
+      output.get<sltl::core::semantic::user>() = 1;
+    });
+
+    return output;
+  };
+
+  const float transform[] = { 1.0f, 0.0f, 0.0f, 0.0f,
+                              0.0f, 2.0f, 0.0f, 0.0f,
+                              0.0f, 0.0f, 3.0f, 0.0f,
+                              1.0f, 1.0f, 1.0f, 1.0f };
+
+  std::vector<vertex> make_vertices(size_t count)
+  {
+    std::vector<vertex> vertices(count);
+
+    for(size_t i = 0U; i < count; ++i)
+    {
+      vertices[i] = { { 1.0f + i, 2.0f, 3.0f - i }, (i % 4U) * 0.25f };
+    }
+
+    return vertices;
+  }
+
+  std::vector<vertex_out> run(const sltl::shader& shader, const std::vector<vertex>& vertices, sltl::interpreter::batch_width width)
+  {
+    std::vector<vertex_out> vertices_out(vertices.size());
+
+    const sltl::interpreter::batch_program program = shader.apply_action<sltl::interpreter::batch_compiler>();
+
+    program.run({ sltl::interpreter::binding(sltl::core::qualifier_storage::in, sltl::core::semantic::position, vertices.data()->_position, sizeof(vertex)),
+                  sltl::interpreter::binding(sltl::core::qualifier_storage::in, sltl::core::semantic::material, &(vertices.data()->_material), sizeof(vertex)),
+                  sltl::interpreter::binding(sltl::core::qualifier_storage::uniform, sltl::core::semantic::user, transform) },
+                { sltl::interpreter::output_binding(sltl::core::semantic::position, vertices_out.data()->_position, sizeof(vertex_out)),
+                  sltl::interpreter::output_binding(sltl::core::semantic::user, &(vertices_out.data()->_index), sizeof(vertex_out)) }, vertices.size(), width);
+
+    return vertices_out;
+  }
+
+  // Compares each invocation of the batch program with the evaluator
+  std::vector<vertex_out> test_batch(const sltl::shader& shader, const std::vector<vertex>& vertices, sltl::interpreter::batch_width width = sltl::interpreter::batch_width::automatic)
+  {
+    const std::vector<vertex_out> actual = ::run(shader, vertices, width);
+
+    for(size_t i = 0U; i < vertices.size(); ++i)
+    {
+      const std::vector<sltl::interpreter::output_value> expected = shader.apply_action<sltl::interpreter::evaluator>(std::vector<sltl::interpreter::binding>{
+        sltl::interpreter::binding(sltl::core::qualifier_storage::in, sltl::core::semantic::position, vertices[i]._position),
+        sltl::interpreter::binding(sltl::core::qualifier_storage::in, sltl::core::semantic::material, &(vertices[i]._material)),
+        sltl::interpreter::binding(sltl::core::qualifier_storage::uniform, sltl::core::semantic::user, transform) });
+
+      EXPECT_EQ(2U, expected.size());
+
+      for(size_t j = 0U; j < 4U; ++j)
+      {
+        EXPECT_EQ(static_cast<float>(expected[0]._components[j]), actual[i]._position[j]);
+      }
+
+      EXPECT_EQ(static_cast<int>(expected[1]._components[0]), actual[i]._index);
+    }
+
+    return actual;
+  }
+}
+
+TEST(batch, run)
+{
+  // The count isn't a multiple of the batch size, so the last batch has inactive lanes
+  const std::vector<vertex_out> actual = ::test_batch(sltl::make_shader(test_shader), ::make_vertices((sltl::interpreter::get_batch_size() * 2U) + 3U));
+
+  // Each branch is taken by some of the invocations in every batch
+  ASSERT_EQ(0, actual[1]._index);
+  ASSERT_EQ(2, actual[2]._index);
+  ASSERT_EQ(1, actual[3]._index);
+  ASSERT_EQ(2, actual.back()._index);
+}
+
+TEST(batch, run_width)
+{
+  ASSERT_EQ(8U, sltl::interpreter::get_batch_size(sltl::interpreter::batch_width::lanes_8));
+  ASSERT_EQ(16U, sltl::interpreter::get_batch_size(sltl::interpreter::batch_width::lanes_16));
+
+  // Each width is run with the best kernel the CPU supports, whichever width the CPU would select
+  for(sltl::interpreter::batch_width width : { sltl::interpreter::batch_width::lanes_8, sltl::interpreter::batch_width::lanes_16 })
+  {
+    const std::vector<vertex_out> actual = ::test_batch(sltl::make_shader(test_shader), ::make_vertices((sltl::interpreter::get_batch_size(width) * 2U) + 3U), width);
+
+    ASSERT_EQ(2, actual.back()._index);
+  }
+}
+
+TEST(batch, run_uniform)
+{
+  // Every invocation takes the same branch, so the other branches are skipped
+  std::vector<vertex> vertices = ::make_vertices(sltl::interpreter::get_batch_size());
+
+  for(vertex& v : vertices)
+  {
+    v._material = 1.0f;
+  }
+
+  ::test_batch(sltl::make_shader(test_shader), vertices);
+}
+
+TEST(batch, run_conditional_output)
+{
+  // Each invocation of the first batch takes the branch and none of the second, whose outputs must still be zero
+  const size_t batch_size = sltl::interpreter::get_batch_size(sltl::interpreter::batch_width::lanes_8);
+
+  std::vector<vertex> vertices = ::make_vertices(batch_size * 2U);
+
+  for(size_t i = 0U; i < vertices.size(); ++i)
+  {
+    vertices[i]._material = ((i < batch_size) ? 1.0f : 0.0f);
+  }
+
+  const std::vector<vertex_out> actual = ::test_batch(sltl::make_shader(test_shader_conditional), vertices, sltl::interpreter::batch_width::lanes_8);
+
+  ASSERT_EQ(1, actual.front()._index);
+  ASSERT_EQ(0, actual.back()._index);
+}
+
+TEST(batch, run_flattened)
+{
+  sltl::shader shader = sltl::make_shader(test_shader);
+  shader.apply_action<sltl::syntax::branch_flattening>();
+
+  ::test_batch(shader, ::make_vertices(sltl::interpreter::get_batch_size() + 1U));
+}
+
+TEST(batch, unbound)
+{
+  const sltl::interpreter::batch_program program = sltl::make_shader(test_shader).apply_action<sltl::interpreter::batch_compiler>();
+
+  ASSERT_THROW(program.run({}, {}, 1U), std::exception);
+}
@@ -5,6 +5,8 @@
 
 #include "scalar.h"
 
+#include <vector>
+
 
 TEST(block, push_empty_stack)
 {
@@ -92,7 +94,7 @@ TEST(block, variable_info_find)
 
   b1.pop();
 
-  ASSERT_TRUE(bm->get_block_stack().empty());
+  ASSERT_TRUE(bm->is_empty());
 }
 
 TEST(block, variable_info_find_scope_parent)
@@ -129,7 +131,7 @@ TEST(block, variable_info_find_scope_parent)
   b2.pop();
   b1.pop();
 
-  ASSERT_TRUE(bm->get_block_stack().empty());
+  ASSERT_TRUE(bm->is_empty());
 }
 
 TEST(block, variable_info_find_scope_block_type)
@@ -171,3 +173,107 @@ TEST(block, variable_info_find_scope_block_type)
   b2.pop();
   b1.pop();
 }
+
+namespace
+{
+  std::vector<const sltl::syntax::statement*> get_statements(const sltl::syntax::block& b)
+  {
+    std::vector<const sltl::syntax::statement*> statements;
+
+    for(const auto& s : b)
+    {
+      statements.push_back(s.get());
+    }
+
+    return statements;
+  }
+}
+
+TEST(block, erase_order)
+{
+  sltl::syntax::block_manager_guard bm;
+  sltl::syntax::block b1(sltl::syntax::block::global);
+
+  b1.push();
+
+  std::vector<sltl::syntax::variable_declaration*> vds;
+
+  for(size_t i = 0; i < 6; ++i)
+  {
+    vds.push_back(&b1.add<sltl::syntax::variable_declaration>(sltl::language::type_helper<sltl::scalar<float>>()));
+  }
+
+  // Erasing statements from the middle of the block must not change the order of the remaining statements
+  b1.erase(*vds[1]);
+  b1.erase(*vds[3]);
+  b1.erase(*vds[0]);
+
+  ASSERT_EQ((std::vector<const sltl::syntax::statement*>{ vds[2], vds[4], vds[5] }), get_statements(b1));
+
+  // Erased statements are removed once they outnumber the remaining statements
+  b1.erase(*vds[4]);
+
+  ASSERT_EQ((std::vector<const sltl::syntax::statement*>{ vds[2], vds[5] }), get_statements(b1));
+
+  const std::wstring vd_name = vds[2]->_name;
+
+  b1.erase(*vds[2]);
+
+  ASSERT_FALSE(b1.variable_info_find(vd_name));
+  ASSERT_EQ((std::vector<const sltl::syntax::statement*>{ vds[5] }), get_statements(b1));
+
+  b1.erase(*vds[5]);
+
+  ASSERT_TRUE(get_statements(b1).empty());
+
+  b1.pop();
+}
+
+TEST(block, variable_info_find_nested)
+{
+  const size_t depth = 32U;
+
+  sltl::syntax::block_manager_guard bm;
+  sltl::syntax::block b1(sltl::syntax::block::global);
+
+  b1.push();
+
+  std::vector<sltl::syntax::block*> blocks = { &b1 };
+  std::vector<sltl::syntax::variable_declaration*> vds = { &b1.add<sltl::syntax::variable_declaration>(sltl::language::type_helper<sltl::scalar<float>>()) };
+
+  for(size_t i = 0; i < depth; ++i)
+  {
+    blocks.push_back(&blocks.back()->add<sltl::syntax::block>(sltl::syntax::block::local));
+    blocks.back()->push();
+
+    vds.push_back(&blocks.back()->add<sltl::syntax::variable_declaration>(sltl::language::type_helper<sltl::scalar<float>>()));
+
+    // The symbol table of the 'global' block holds every variable visible from the current block, however deeply it is nested
+    ASSERT_EQ(vds.size(), b1.get_symbol_count());
+  }
+
+  // A lookup from the innermost block finds the variable_info of the block that declared the variable
+  for(size_t i = 0; i < vds.size(); ++i)
+  {
+    ASSERT_EQ(blocks[i]->block_base::variable_info_find(vds[i]->_name), blocks.back()->variable_info_find(vds[i]->_name));
+  }
+
+  // Popping a block removes its variables from the symbol table
+  while(blocks.size() > 1U)
+  {
+    const std::wstring vd_name = vds.back()->_name;
+
+    blocks.back()->pop();
+    blocks.pop_back();
+    vds.pop_back();
+
+    ASSERT_EQ(vds.size(), b1.get_symbol_count());
+    ASSERT_FALSE(blocks.back()->variable_info_find(vd_name));
+    ASSERT_TRUE(blocks.back()->variable_info_find(vds.front()->_name));
+  }
+
+  b1.pop();
+
+  ASSERT_EQ(0U, b1.get_symbol_count());
+  ASSERT_TRUE(bm->is_empty());
+}
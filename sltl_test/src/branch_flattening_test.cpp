@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+
+#include "if.h"
+#include "call.h"
+#include "scalar.h"
+#include "vector.h"
+#include "basic_operators.h"
+#include "shader.h"
+
+#include "syntax/branch_flattening.h"
+
+#include "output/glsl/output_glsl.h"
+
+
+namespace
+{
+  std::wstring to_string(sltl::shader&& shader)
+  {
+    shader.apply_action<sltl::syntax::branch_flattening>();
+
+    // Prepend a newline character to exactly match the raw string literals
+    return L'\n' + shader.apply_action<sltl::glsl::output_glsl>(sltl::glsl::output_version::none, sltl::output_flags::flag_indent_space);
+  }
+
+  sltl::scalar<float> fn_square(sltl::scalar<float> f)
+  {
+    return f * f;
+  }
+}
+
+TEST(branch_flattening, if_then)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> a = 1.0f;
+    sltl::vector<float, 3> colour(0.0f, 0.0f, 0.0f);
+
+    sltl::if_then(a > sltl::scalar<float>(0.0f), [&]()
+    {
+      colour += sltl::vector<float, 3>(a, a, a);
+    });
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f1 = 1.0f;
+  vec3 v2 = vec3(0.0f, 0.0f, 0.0f);
+  v2 = (f1 > float(0.0f) ? v2 + vec3(f1, f1, f1) : v2);
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(branch_flattening, if_then_local)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> a = 1.0f;
+    sltl::scalar<float> b = 2.0f;
+
+    sltl::if_then(a > b, [&]()
+    {
+      sltl::scalar<float> c = a - b;
+      a = c * c;
+      b -= c;
+    });
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f1 = 1.0f;
+  float f2 = 2.0f;
+  bool b4 = f1 > f2;
+  float f5 = f1 - f2;
+  f1 = (b4 ? f5 * f5 : f1);
+  f2 = (b4 ? f2 - f5 : f2);
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(branch_flattening, if_then_else_if_else_end)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> a = 1.0f;
+    sltl::scalar<float> b = 2.0f;
+
+    sltl::if_then(a > b, [&]()
+    {
+      a = b;
+    }).else_if(a < b, [&]()
+    {
+      b = a;
+    }).else_end([&]()
+    {
+      a = 0.0f;
+    });
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f1 = 1.0f;
+  float f2 = 2.0f;
+  bool b6 = f1 > f2;
+  bool b7 = f1 < f2;
+  f1 = (b6 ? f2 : f1);
+  f2 = (b6 ? f2 : (b7 ? f1 : f2));
+  f1 = (b6 ? f1 : (b7 ? f1 : 0.0f));
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(branch_flattening, nested)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> a = 1.0f;
+    sltl::scalar<float> b = 2.0f;
+
+    sltl::if_then(a > b, [&]()
+    {
+      sltl::if_then(b > sltl::scalar<float>(0.0f), [&]()
+      {
+        a = b;
+      });
+    });
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f1 = 1.0f;
+  float f2 = 2.0f;
+  f1 = (f1 > f2 ? (f2 > float(0.0f) ? f2 : f1) : f1);
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(branch_flattening, side_effect)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> a = 1.0f;
+
+    sltl::if_then(a > sltl::scalar<float>(0.0f), [&]()
+    {
+      a++;
+    });
+
+    sltl::if_then(a > sltl::scalar<float>(0.0f), [&]()
+    {
+      a = sltl::call(fn_square, a);
+    });
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f1 = 1.0f;
+  if(f1 > float(0.0f))
+  {
+    f1++;
+  }
+  if(f1 > float(0.0f))
+  {
+    f1 = fn0(f1);
+  }
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(branch_flattening, hint)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> a = 1.0f;
+    sltl::scalar<float> b = 2.0f;
+
+    sltl::if_then(a > b, [&]()
+    {
+      a = b;
+    }, sltl::core::branch_hint::branch);
+
+    sltl::if_then(a > b, [&]()
+    {
+      a += b;
+      b -= a;
+      a += b;
+      b -= a;
+      a = b;
+    }, sltl::core::branch_hint::flatten);
+
+    sltl::if_then(a > b, [&]()
+    {
+      a += b;
+      b -= a;
+      a += b;
+      b -= a;
+      a = b;
+    });
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f1 = 1.0f;
+  float f2 = 2.0f;
+  if(f1 > f2)
+  {
+    f1 = f2;
+  }
+  bool b6 = f1 > f2;
+  f1 = (b6 ? f1 + f2 : f1);
+  f2 = (b6 ? f2 - f1 : f2);
+  f1 = (b6 ? f1 + f2 : f1);
+  f2 = (b6 ? f2 - f1 : f2);
+  f1 = (b6 ? f2 : f1);
+  if(f1 > f2)
+  {
+    f1 += f2;
+    f2 -= f1;
+    f1 += f2;
+    f2 -= f1;
+    f1 = f2;
+  }
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
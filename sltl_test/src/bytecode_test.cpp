@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+
+#include "io/io.h"
+
+#include "if.h"
+#include "call.h"
+#include "shader.h"
+#include "scalar.h"
+#include "vector.h"
+#include "matrix.h"
+#include "basic_operators.h"
+
+#include "interpreter/batch.h"
+#include "interpreter/bytecode.h"
+#include "interpreter/interpreter.h"
+
+#include <sstream>
+#include <stdexcept>
+
+
+namespace
+{
+  struct vertex
+  {
+    float _position[3];
+    float _material;
+  };
+
+  struct vertex_out
+  {
+    float _position[4];
+    int _index;
+  };
+
+  typedef sltl::io::block<
+    sltl::io::variable<sltl::matrix<float, 4, 4>, sltl::core::semantic::user>> io_block_uniform;
+
+  typedef sltl::io::block<
+    sltl::io::variable<sltl::vector<float, 3>, sltl::core::semantic::position>,
+    sltl::io::variable<sltl::scalar<float>, sltl::core::semantic::material>> io_block_in;
+
+  typedef sltl::io::block<
+    sltl::io::variable<sltl::vector<float, 4>, sltl::core::semantic::position>,
+    sltl::io::variable<sltl::scalar<int>, sltl::core::semantic::user>> io_block_out;
+
+  sltl::scalar<float> fn_shade(sltl::scalar<float> f, sltl::vector<float, 3> v)
+  {
+    return sltl::lerp(sltl::dot(v, v), sltl::clamp(f, 0.0f, 1.0f), f);
+  }
+
+  auto test_shader = [](sltl::shader::tag<sltl::core::shader_stage::test>, io_block_in input)
+  {
+    io_block_uniform uniform(sltl::core::qualifier_storage::uniform);
+    io_block_out output;
+
+    sltl::vector<float, 3> p = input.get<sltl::core::semantic::position>();
+    sltl::scalar<float> f = input.get<sltl::core::semantic::material>();
+    sltl::scalar<int> i = 0;
+
+    sltl::if_then(f > sltl::scalar<float>(0.5f), [&]()
+    {
+      p -= sltl::vector<float, 3>(1.0f, 1.0f, 1.0f);
+      i += 1;
+    }).else_if(f > sltl::scalar<float>(0.25f), [&]()
+    {
+      p.xz = p.zx;
+      i += 2;
+    }).else_end([&]()
+    {
+      i -= 1;
+    });
+
+    output.get<sltl::core::semantic::position>() = sltl::vector<float, 4>(sltl::normalize(p), sltl::call(fn_shade, f, p)) * uniform.get<sltl::core::semantic::user>();
+    output.get<sltl::core::semantic::user>() = i;
+
+    return output;
+  };
+
+  // The user output is only written by the invocations that take the branch
+  auto test_shader_conditional = [](sltl::shader::tag<sltl::core::shader_stage::test>, io_block_in input)
+  {
+    io_block_out output;
+
+    sltl::if_then(input.get<sltl::core::semantic::material>() < sltl::scalar<float>(0.5f), [&]()
+    {
+      output.get<sltl::core::semantic::user>() = 1;
+    });
+
+    return output;
+  };
+
+  const float transform[] = { 1.0f, 0.0f, 0.0f, 0.0f,
+                              0.0f, 2.0f, 0.0f, 0.0f,
+                              0.0f, 0.0f, 3.0f, 0.0f,
+                              1.0f, 1.0f, 1.0f, 1.0f };
+
+  const vertex vertices[] = { { { 1.0f, 2.0f, 3.0f }, 0.0f  },
+                              { { 2.0f, 2.0f, 2.0f }, 0.25f },
+                              { { 3.0f, 2.0f, 1.0f }, 0.5f  },
+                              { { 4.0f, 2.0f, 0.0f }, 0.75f } };
+
+  const size_t vertex_count = sizeof(vertices) / sizeof(vertex);
+
+  std::vector<vertex_out> run(const sltl::interpreter::bytecode_program& program)
+  {
+    std::vector<vertex_out> vertices_out(vertex_count);
+
+    program.run({ sltl::interpreter::binding(sltl::core::qualifier_storage::in, sltl::core::semantic::position, vertices->_position, sizeof(vertex)),
+                  sltl::interpreter::binding(sltl::core::qualifier_storage::in, sltl::core::semantic::material, &(vertices->_material), sizeof(vertex)),
+                  sltl::interpreter::binding(sltl::core::qualifier_storage::uniform, sltl::core::semantic::user, transform) },
+                { sltl::interpreter::output_binding(sltl::core::semantic::position, vertices_out.data()->_position, sizeof(vertex_out)),
+                  sltl::interpreter::output_binding(sltl::core::semantic::user, &(vertices_out.data()->_index), sizeof(vertex_out)) }, vertex_count);
+
+    return vertices_out;
+  }
+
+  // Compares each invocation of the bytecode program with the evaluator
+  void test_bytecode(const sltl::shader& shader, const sltl::interpreter::bytecode_program& program)
+  {
+    const std::vector<vertex_out> actual = ::run(program);
+
+    for(size_t i = 0U; i < vertex_count; ++i)
+    {
+      const std::vector<sltl::interpreter::output_value> expected = shader.apply_action<sltl::interpreter::evaluator>(std::vector<sltl::interpreter::binding>{
+        sltl::interpreter::binding(sltl::core::qualifier_storage::in, sltl::core::semantic::position, vertices[i]._position),
+        sltl::interpreter::binding(sltl::core::qualifier_storage::in, sltl::core::semantic::material, &(vertices[i]._material)),
+        sltl::interpreter::binding(sltl::core::qualifier_storage::uniform, sltl::core::semantic::user, transform) });
+
+      ASSERT_EQ(2U, expected.size());
+
+      for(size_t j = 0U; j < 4U; ++j)
+      {
+        ASSERT_EQ(static_cast<float>(expected[0]._components[j]), actual[i]._position[j]);
+      }
+
+      ASSERT_EQ(static_cast<int>(expected[1]._components[0]), actual[i]._index);
+    }
+  }
+}
+
+TEST(bytecode, run)
+{
+  const sltl::shader shader = sltl::make_shader(test_shader);
+  const sltl::interpreter::bytecode_program program(shader.apply_action<sltl::interpreter::batch_compiler>());
+
+  ::test_bytecode(shader, program);
+
+  // Every branch of the conditional is taken by one of the vertices
+  const std::vector<vertex_out> actual = ::run(program);
+
+  ASSERT_EQ(-1, actual[0]._index);
+  ASSERT_EQ(-1, actual[1]._index);
+  ASSERT_EQ(2, actual[2]._index);
+  ASSERT_EQ(1, actual[3]._index);
+}
+
+TEST(bytecode, run_conditional_output)
+{
+  const sltl::shader shader = sltl::make_shader(test_shader_conditional);
+  const sltl::interpreter::bytecode_program program(shader.apply_action<sltl::interpreter::batch_compiler>());
+
+  ::test_bytecode(shader, program);
+
+  // The invocations that skip the branch follow those that take it, but their output must still be zero
+  const std::vector<vertex_out> actual = ::run(program);
+
+  ASSERT_EQ(1, actual[1]._index);
+  ASSERT_EQ(0, actual[2]._index);
+  ASSERT_EQ(0, actual[3]._index);
+}
+
+TEST(bytecode, save)
+{
+  const sltl::shader shader = sltl::make_shader(test_shader);
+  const sltl::interpreter::bytecode_program program(shader.apply_action<sltl::interpreter::batch_compiler>());
+
+  std::stringstream ss;
+  program.save(ss);
+
+  const sltl::interpreter::bytecode_program program_loaded(ss);
+
+  ASSERT_EQ(program.get_code(), program_loaded.get_code());
+  ASSERT_EQ(program.get_constants(), program_loaded.get_constants());
+
+  ::test_bytecode(shader, program_loaded);
+}
+
+TEST(bytecode, load_invalid)
+{
+  const sltl::interpreter::bytecode_program program(sltl::make_shader(test_shader).apply_action<sltl::interpreter::batch_compiler>());
+
+  std::stringstream ss;
+  program.save(ss);
+
+  const std::string saved = ss.str();
+
+  // A truncated program
+  std::stringstream ss_truncated(saved.substr(0U, saved.size() - 4U));
+  ASSERT_THROW(sltl::interpreter::bytecode_program program_loaded(ss_truncated), std::exception);
+
+  // A program with an invalid opcode
+  std::string saved_opcode = saved;
+  saved_opcode[saved_opcode.size() - (program.get_code().size() * 4U)] = static_cast<char>(sltl::interpreter::bytecode_op::count);
+
+  std::stringstream ss_opcode(saved_opcode);
+  ASSERT_THROW(sltl::interpreter::bytecode_program program_loaded(ss_opcode), std::exception);
+
+  std::stringstream ss_empty;
+  ASSERT_THROW(sltl::interpreter::bytecode_program program_loaded(ss_empty), std::exception);
+
+  // The first variable follows the magic, version, row count and variable count words. Its qualifier, semantic,
+  // semantic index, type id and dimensions must all be within the range of valid values.
+  auto fn_load_variable_word = [&saved](size_t word_idx, std::uint32_t word)
+  {
+    std::string saved_word = saved;
+
+    for(size_t i = 0U; i < 4U; ++i)
+    {
+      saved_word[16U + (word_idx * 4U) + i] = static_cast<char>((word >> (i * 8U)) & 0xFFU);
+    }
+
+    std::stringstream ss_word(saved_word);
+    sltl::interpreter::bytecode_program program_loaded(ss_word);
+  };
+
+  ASSERT_THROW(fn_load_variable_word(0U, static_cast<std::uint32_t>(sltl::core::qualifier_storage::none)), std::runtime_error);
+  ASSERT_THROW(fn_load_variable_word(0U, 4U), std::runtime_error);
+  ASSERT_THROW(fn_load_variable_word(1U, static_cast<std::uint32_t>(sltl::core::semantic::count)), std::runtime_error);
+  ASSERT_THROW(fn_load_variable_word(2U, 0x10000U), std::runtime_error);
+  ASSERT_THROW(fn_load_variable_word(3U, sltl::language::id_void), std::runtime_error);
+  ASSERT_THROW(fn_load_variable_word(3U, sltl::language::id_bool + 1U), std::runtime_error);
+  ASSERT_THROW(fn_load_variable_word(4U, 0U), std::runtime_error);
+  ASSERT_THROW(fn_load_variable_word(5U, 5U), std::runtime_error);
+}
@@ -10,6 +10,9 @@
 
 #include "io/io.h"
 
+#include <vector>
+#include <unordered_set>
+
 
 namespace
 {
@@ -552,3 +555,32 @@ void main()
 
   ASSERT_EQ(expected, actual);
 }
+
+TEST(call, function_key_hash)
+{
+  using sltl::syntax::function_key;
+
+  const function_key key_void(fn_empty_returns_void);
+  const function_key key_int(fn_empty_returns_int);
+
+  // Keys for the same function pointer are equal and share a hash, keys for different functions don't
+  ASSERT_TRUE(key_void == function_key(fn_empty_returns_void));
+  ASSERT_EQ(function_key::hash()(key_void), function_key::hash()(function_key(fn_empty_returns_void)));
+  ASSERT_FALSE(key_void == key_int);
+  ASSERT_NE(function_key::hash()(key_void), function_key::hash()(key_int));
+
+  // Callables that aren't equality comparable (such as capturing lambdas) never compare equal, so each key must have a
+  // distinct hash rather than every key of the same callable type sharing a single bucket of the function map
+  const size_t count = 1000U;
+
+  std::vector<function_key> keys;
+  std::unordered_set<size_t> hashes;
+
+  for(size_t i = 0; i < count; ++i)
+  {
+    keys.emplace_back([value = i]{});
+    hashes.insert(function_key::hash()(keys.back()));
+  }
+
+  ASSERT_EQ(count, hashes.size());
+}
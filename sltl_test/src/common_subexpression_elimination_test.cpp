@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include "scalar.h"
+#include "vector.h"
+#include "call.h"
+#include "basic_operators.h"
+#include "shader.h"
+
+#include "syntax/common_subexpression_elimination.h"
+
+#include "output/glsl/output_glsl.h"
+
+#include "io/io.h"
+
+
+namespace
+{
+  typedef sltl::io::block<> io_block_empty;
+
+  sltl::scalar<float> fn_one_param(sltl::scalar<float> f)
+  {
+    return f * f;
+  }
+
+  std::wstring to_string(sltl::shader&& shader)
+  {
+    shader.apply_action<sltl::syntax::common_subexpression_elimination>();
+
+    // Prepend a newline character to exactly match the raw string literals
+    return L'\n' + shader.apply_action<sltl::glsl::output_glsl>(sltl::glsl::output_version::none, sltl::output_flags::flag_indent_space);
+  }
+}
+
+TEST(common_subexpression_elimination, hoist)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> a, b;
+
+    sltl::scalar<float> c = (a * b) + 1.0f;
+    sltl::scalar<float> d = (a * b) + 2.0f;
+    sltl::scalar<float> e = ((a * b) + 2.0f) * (a * b);
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f1;
+  float f2;
+  float f6 = f1 * f2;
+  float f3 = f6 + 1.0f;
+  float f4 = f6 + 2.0f;
+  float f5 = f4 * f6;
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(common_subexpression_elimination, intrinsic)
+{
+  auto test_shader = []()
+  {
+    typedef sltl::vector<float, 3> vec3;
+
+    vec3 n, v;
+
+    sltl::scalar<float> a = sltl::clamp(sltl::dot(n, v), 0.0f, 1.0f);
+    sltl::scalar<float> b = sltl::dot(n, v) * sltl::dot(n, v);
+    sltl::scalar<float> c = sltl::dot(n, v) * sltl::dot(n, n);
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  vec3 v1;
+  vec3 v2;
+  float f6 = dot(v1, v2);
+  float f3 = clamp(f6, 0.0f, 1.0f);
+  float f4 = f6 * f6;
+  float f5 = f6 * dot(v1, v1);
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(common_subexpression_elimination, barrier)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> a, b;
+
+    sltl::scalar<float> c = a * b;
+    a = c + (a * b);
+    sltl::scalar<float> d = a * b;
+    sltl::scalar<float> e = (a * b) + (a * b);
+    a += 1.0f;
+    sltl::scalar<float> f = (a * b) - (b * a);
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f1;
+  float f2;
+  float f3 = f1 * f2;
+  f1 = (f3 + f3);
+  float f4 = f1 * f2;
+  float f5 = f4 + f4;
+  f1 += 1.0f;
+  float f6 = (f1 * f2) - (f2 * f1);
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(common_subexpression_elimination, barrier_call)
+{
+  auto test_shader = [](sltl::shader::tag<sltl::core::shader_stage::test>, io_block_empty) -> void
+  {
+    sltl::scalar<float> a, b;
+
+    sltl::scalar<float> c = (a * b) + sltl::call(fn_one_param, a * b);
+    sltl::scalar<float> d = (a * b) + 1.0f;
+    sltl::scalar<float> e = (a * b) + 2.0f;
+  };
+
+  // This test uses make_shader as make_test doesn't output function definitions
+  const std::wstring actual = ::to_string(sltl::make_shader(test_shader));
+  const std::wstring expected = LR"(
+float fn1(float p_f1)
+{
+  return p_f1 * p_f1;
+}
+void main()
+{
+  float f1;
+  float f2;
+  float f3 = (f1 * f2) + fn1(f1 * f2);
+  float f6 = f1 * f2;
+  float f4 = f6 + 1.0f;
+  float f5 = f6 + 2.0f;
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "scalar.h"
+#include "vector.h"
+#include "basic_operators.h"
+#include "shader.h"
+
+#include "syntax/constant_folding.h"
+
+#include "output/glsl/output_glsl.h"
+
+
+namespace
+{
+  std::wstring to_string(sltl::shader&& shader)
+  {
+    shader.apply_action<sltl::syntax::constant_folding>();
+
+    // Prepend a newline character to exactly match the raw string literals
+    return L'\n' + shader.apply_action<sltl::glsl::output_glsl>(sltl::glsl::output_version::none, sltl::output_flags::flag_indent_space);
+  }
+}
+
+TEST(constant_folding, scalar)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> r;
+
+    sltl::scalar<float> f1 = sltl::scalar<float>(4.0f) * 1.0f;
+    sltl::scalar<float> f2 = (sltl::scalar<float>(4.0f) * 2.0f) / 8.0f;
+    sltl::scalar<float> f3 = (r * r) / (sltl::scalar<float>(4.0f) + 4.0f);
+    sltl::scalar<float> f4 = sltl::scalar<float>() + 1.0f;
+
+    sltl::scalar<int> i1 = sltl::scalar<int>(7) / 2;
+    sltl::scalar<unsigned int> u1 = sltl::scalar<unsigned int>(1U) - 2U;
+    sltl::scalar<unsigned int> u2 = sltl::scalar<unsigned int>(4294967295U) * 4294967295U;
+    sltl::scalar<bool> b1 = sltl::scalar<float>(1.0f) < 2.0f;
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f1;
+  float f3 = 4.0f;
+  float f5 = 1.0f;
+  float f7 = (f1 * f1) / 8.0f;
+  float f9 = 1.0f;
+  int i11 = 3;
+  unsigned int u13 = 4294967295U;
+  unsigned int u15 = 1U;
+  bool b17 = true;
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(constant_folding, vector)
+{
+  auto test_shader = []()
+  {
+    typedef sltl::vector<float, 2> vec2;
+    typedef sltl::vector<float, 3> vec3;
+
+    vec3 v;
+
+    vec3 v1 = vec3(1.0f, 2.0f, 3.0f) + vec3(1.0f, 1.0f, 1.0f);
+    vec3 v2 = vec3(1.0f, 2.0f, 3.0f) * 2.0f;
+    vec3 v3 = vec3(vec2(1.0f, 2.0f), 3.0f);
+    vec3 v4 = v + (vec3(1.0f, 2.0f, 3.0f) - vec3());
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  vec3 v1;
+  vec3 v4 = vec3(2.0f, 3.0f, 4.0f);
+  vec3 v6 = vec3(2.0f, 4.0f, 6.0f);
+  vec3 v8 = vec3(1.0f, 2.0f, 3.0f);
+  vec3 v11 = v1 + vec3(1.0f, 2.0f, 3.0f);
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(constant_folding, unfoldable)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> f1 = sltl::scalar<float>(1.0f) / 0.0f;
+    sltl::scalar<int> i1 = sltl::scalar<int>(1) / 0;
+    sltl::scalar<int> i2 = sltl::scalar<int>(2147483647) + 1;
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f2 = 1.0f / 0.0f;
+  int i4 = 1 / 0;
+  int i6 = 2147483647 + 1;
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
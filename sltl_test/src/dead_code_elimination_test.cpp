@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include "scalar.h"
+#include "vector.h"
+#include "call.h"
+#include "basic_operators.h"
+#include "shader.h"
+
+#include "syntax/dead_code_elimination.h"
+
+#include "output/glsl/output_glsl.h"
+
+#include "io/io.h"
+
+
+namespace
+{
+  typedef sltl::io::block<sltl::io::variable<sltl::scalar<float>, sltl::core::semantic::user>> io_block_out;
+
+  std::wstring to_string(sltl::shader&& shader)
+  {
+    shader.apply_action<sltl::syntax::dead_code_elimination>();
+
+    // Prepend a newline character to exactly match the raw string literals
+    return L'\n' + shader.apply_action<sltl::glsl::output_glsl>(sltl::glsl::output_version::none, sltl::output_flags::flag_indent_space);
+  }
+
+  sltl::scalar<float> fn_square(sltl::scalar<float> f)
+  {
+    return f * f;
+  }
+
+  sltl::scalar<float> fn_square_twice(sltl::scalar<float> f)
+  {
+    return sltl::call(fn_square, sltl::call(fn_square, f));
+  }
+}
+
+TEST(dead_code_elimination, variable)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> a = 1.0f;
+    sltl::scalar<float> b = a * 2.0f;
+    sltl::scalar<float> c = b + a;
+    sltl::scalar<float> d = 4.0f;
+    d++;
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f4 = 4.0f;
+  f4++;
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(dead_code_elimination, store)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> a, b, c;
+    sltl::vector<float, 2> v;
+
+    a = 1.0f;
+    b = a + 1.0f;
+    c = b * 2.0f;
+    a = 2.0f;
+    v.x = b;
+    a + b;
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f1;
+  float f2;
+  vec2 v4;
+  f1 = 1.0f;
+  f2 = (f1 + 1.0f);
+  f1 = 2.0f;
+  v4.x = f2;
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(dead_code_elimination, function)
+{
+  auto test_shader = [](sltl::shader::tag<sltl::core::shader_stage::test>, sltl::io::block<>)
+  {
+    io_block_out output;
+
+    sltl::scalar<float> a = sltl::call(fn_square_twice, 2.0f);
+    output.get<sltl::core::semantic::user>() = sltl::call(fn_square, 3.0f);
+
+    return output;
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_shader(test_shader));
+  const std::wstring expected = LR"(
+out float o_f1;
+float fn2(float p_f1)
+{
+  return p_f1 * p_f1;
+}
+void main()
+{
+  o_f1 = fn2(3.0f);
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
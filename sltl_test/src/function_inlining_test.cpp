@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include "scalar.h"
+#include "vector.h"
+#include "call.h"
+#include "basic_operators.h"
+#include "shader.h"
+
+#include "syntax/function_inlining.h"
+
+#include "output/glsl/output_glsl.h"
+
+#include "io/io.h"
+
+
+namespace
+{
+  typedef sltl::io::block<sltl::io::variable<sltl::scalar<float>, sltl::core::semantic::user>> io_block_out;
+
+  template<typename ...T>
+  std::wstring to_string(sltl::shader&& shader, T&& ...t)
+  {
+    shader.apply_action<sltl::syntax::function_inlining>(std::forward<T>(t)...);
+
+    // Prepend a newline character to exactly match the raw string literals
+    return L'\n' + shader.apply_action<sltl::glsl::output_glsl>(sltl::glsl::output_version::none, sltl::output_flags::flag_indent_space);
+  }
+
+  sltl::scalar<float> fn_square(sltl::scalar<float> f)
+  {
+    return f * f;
+  }
+
+  sltl::scalar<float> fn_locals(sltl::scalar<float> x, sltl::scalar<float> y)
+  {
+    sltl::scalar<float> xy = x * y;
+    sltl::scalar<float> xyy = xy * y;
+
+    return sltl::clamp(xy + xyy, x, 1.0f);
+  }
+
+  sltl::scalar<float> fn_nested(sltl::scalar<float> f)
+  {
+    return sltl::call(fn_square, f) + 1.0f;
+  }
+
+  sltl::scalar<float> fn_side_effect(sltl::scalar<float> f)
+  {
+    f += 1.0f;
+    return f;
+  }
+}
+
+TEST(function_inlining, substitute)
+{
+  auto test_shader = [](sltl::shader::tag<sltl::core::shader_stage::test>, sltl::io::block<>)
+  {
+    io_block_out output;
+
+    sltl::scalar<float> a = 2.0f;
+    sltl::scalar<float> b = sltl::call(fn_square, a) + sltl::call(fn_square, a + 1.0f);
+    output.get<sltl::core::semantic::user>() = sltl::call(fn_nested, b);
+
+    return output;
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_shader(test_shader));
+  const std::wstring expected = LR"(
+out float o_f1;
+void main()
+{
+  float f1 = 2.0f;
+  float f3 = f1 + 1.0f;
+  float f2 = (f1 * f1) + (f3 * f3);
+  o_f1 = ((f2 * f2) + 1.0f);
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(function_inlining, locals)
+{
+  auto test_shader = [](sltl::shader::tag<sltl::core::shader_stage::test>, sltl::io::block<>)
+  {
+    io_block_out output;
+
+    sltl::scalar<float> xy = 2.0f;
+    sltl::scalar<float> result = 1.0f;
+    result += sltl::call(fn_locals, xy * 2.0f, xy);
+
+    output.get<sltl::core::semantic::user>() = result;
+
+    return output;
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_shader(test_shader));
+  const std::wstring expected = LR"(
+out float o_f1;
+void main()
+{
+  float f1 = 2.0f;
+  float f2 = 1.0f;
+  float f3 = f1 * 2.0f;
+  float f4 = f3 * f1;
+  float f5 = f4 * f1;
+  f2 += clamp(f4 + f5, f3, 1.0f);
+  o_f1 = f2;
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(function_inlining, threshold)
+{
+  auto test_shader = [](sltl::shader::tag<sltl::core::shader_stage::test>, sltl::io::block<>)
+  {
+    io_block_out output;
+
+    sltl::scalar<float> a = sltl::call(fn_locals, 1.0f, 2.0f);
+    sltl::scalar<float> b = sltl::call(fn_locals, a, 3.0f);
+    sltl::scalar<float> c = sltl::call(fn_square, b) + 1.0f;
+
+    // The call to fn_square can't be inlined as the rest of the statement calls a function with side effects
+    output.get<sltl::core::semantic::user>() = sltl::call(fn_square, c) + sltl::call(fn_side_effect, c);
+
+    return output;
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_shader(test_shader), 4U, 1U);
+  const std::wstring expected = LR"(
+out float o_f1;
+float fn3(float p_f1)
+{
+  p_f1 += 1.0f;
+  return p_f1;
+}
+float fn2(float p_f1)
+{
+  return p_f1 * p_f1;
+}
+float fn1(float p_f1, float p_f2)
+{
+  float f1 = p_f1 * p_f2;
+  float f2 = f1 * p_f2;
+  return clamp(f1 + f2, p_f1, 1.0f);
+}
+void main()
+{
+  float f1 = fn1(1.0f, 2.0f);
+  float f2 = fn1(f1, 3.0f);
+  float f3 = (f2 * f2) + 1.0f;
+  o_f1 = (fn2(f3) + fn3(f3));
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include "io/io.h"
+
+#include "if.h"
+#include "call.h"
+#include "shader.h"
+#include "scalar.h"
+#include "vector.h"
+#include "matrix.h"
+#include "basic_operators.h"
+
+#include "syntax/constant_folding.h"
+#include "syntax/branch_flattening.h"
+
+#include "interpreter/interpreter.h"
+
+
+namespace
+{
+  typedef sltl::io::block<
+    sltl::io::variable<sltl::scalar<float>, sltl::core::semantic::material>,
+    sltl::io::variable<sltl::matrix<float, 4, 4>, sltl::core::semantic::user>> io_block_uniform;
+
+  typedef sltl::io::block<
+    sltl::io::variable<sltl::vector<float, 3>, sltl::core::semantic::position>> io_block_in;
+
+  typedef sltl::io::block<
+    sltl::io::variable<sltl::vector<float, 4>, sltl::core::semantic::position>,
+    sltl::io::variable<sltl::scalar<float>, sltl::core::semantic::user>> io_block_out;
+
+  sltl::scalar<float> fn_scale(sltl::scalar<float> f, sltl::scalar<float> s)
+  {
+    return f * s;
+  }
+
+  auto test_shader = [](sltl::shader::tag<sltl::core::shader_stage::test>, io_block_in input)
+  {
+    io_block_uniform uniform(sltl::core::qualifier_storage::uniform);
+    io_block_out output;
+
+    sltl::vector<float, 3> p = input.get<sltl::core::semantic::position>();
+    sltl::scalar<float> f = uniform.get<sltl::core::semantic::material>();
+
+    sltl::if_then(f > sltl::scalar<float>(0.5f), [&]()
+    {
+      p -= sltl::vector<float, 3>(1.0f, 1.0f, 1.0f);
+    }).else_end([&]()
+    {
+      p += sltl::vector<float, 3>(p.z, p.y, p.x);
+    });
+
+    output.get<sltl::core::semantic::position>() = sltl::vector<float, 4>(p, 1.0f) * uniform.get<sltl::core::semantic::user>();
+    output.get<sltl::core::semantic::user>() = sltl::call(fn_scale, sltl::dot(p, p), 2.0f) + sltl::clamp(f * 4.0f, 0.0f, 1.0f);
+
+    return output;
+  };
+
+  std::vector<sltl::interpreter::output_value> evaluate(const sltl::shader& shader, float material)
+  {
+    static const float position[] = { 1.0f, 2.0f, 3.0f };
+    static const float transform[] = { 1.0f, 0.0f, 0.0f, 0.0f,
+                                       0.0f, 2.0f, 0.0f, 0.0f,
+                                       0.0f, 0.0f, 3.0f, 0.0f,
+                                       1.0f, 1.0f, 1.0f, 1.0f };
+
+    return shader.apply_action<sltl::interpreter::evaluator>(std::vector<sltl::interpreter::binding>{
+      sltl::interpreter::binding(sltl::core::qualifier_storage::in, sltl::core::semantic::position, position),
+      sltl::interpreter::binding(sltl::core::qualifier_storage::uniform, sltl::core::semantic::material, &material),
+      sltl::interpreter::binding(sltl::core::qualifier_storage::uniform, sltl::core::semantic::user, transform) });
+  }
+}
+
+TEST(interpreter, evaluate)
+{
+  const std::vector<sltl::interpreter::output_value> actual = ::evaluate(sltl::make_shader(test_shader), 0.25f);
+
+  ASSERT_EQ(2U, actual.size());
+
+  // p = (1,2,3) + (3,2,1) = (4,4,4)
+  ASSERT_EQ(sltl::core::semantic::position, actual[0]._semantic);
+  ASSERT_EQ(std::vector<double>({ 5.0, 9.0, 13.0, 1.0 }), actual[0]._components);
+
+  // dot(p, p) * 2 + clamp(1, 0, 1)
+  ASSERT_EQ(sltl::core::semantic::user, actual[1]._semantic);
+  ASSERT_EQ(std::vector<double>({ 97.0 }), actual[1]._components);
+}
+
+TEST(interpreter, evaluate_else)
+{
+  const std::vector<sltl::interpreter::output_value> actual = ::evaluate(sltl::make_shader(test_shader), 0.75f);
+
+  ASSERT_EQ(2U, actual.size());
+  ASSERT_EQ(std::vector<double>({ 1.0, 3.0, 7.0, 1.0 }), actual[0]._components);
+  ASSERT_EQ(std::vector<double>({ 11.0 }), actual[1]._components);
+}
+
+TEST(interpreter, swizzle)
+{
+  auto test_shader = [](sltl::shader::tag<sltl::core::shader_stage::test>, sltl::io::block<>)
+  {
+    sltl::io::block<sltl::io::variable<sltl::vector<int, 4>, sltl::core::semantic::user>> output;
+
+    sltl::vector<int, 4> v(1, 2, 3, 4);
+    sltl::vector<int, 2> v_zx = v.zx;
+    sltl::scalar<int> i = v.w;
+    i++;
+    v.xy = v_zx + sltl::vector<int, 2>(i, --i);
+    output.get<sltl::core::semantic::user>() = v;
+
+    return output;
+  };
+
+  const std::vector<sltl::interpreter::output_value> actual = sltl::make_shader(test_shader).apply_action<sltl::interpreter::evaluator>(std::vector<sltl::interpreter::binding>());
+
+  ASSERT_EQ(1U, actual.size());
+  ASSERT_EQ(std::vector<double>({ 8.0, 5.0, 3.0, 4.0 }), actual[0]._components);
+}
+
+TEST(interpreter, optimization)
+{
+  for(float material : { 0.25f, 0.75f })
+  {
+    sltl::shader shader = sltl::make_shader(test_shader);
+
+    const std::vector<sltl::interpreter::output_value> expected = ::evaluate(shader, material);
+
+    shader.apply_action<sltl::syntax::branch_flattening>();
+    shader.apply_action<sltl::syntax::constant_folding>();
+
+    const std::vector<sltl::interpreter::output_value> actual = ::evaluate(shader, material);
+
+    ASSERT_EQ(expected.size(), actual.size());
+
+    for(size_t i = 0U; i < expected.size(); ++i)
+    {
+      ASSERT_EQ(expected[i]._components, actual[i]._components);
+    }
+  }
+}
+
+TEST(interpreter, unbound)
+{
+  sltl::shader shader = sltl::make_shader(test_shader);
+
+  ASSERT_THROW(shader.apply_action<sltl::interpreter::evaluator>(std::vector<sltl::interpreter::binding>()), std::exception);
+}
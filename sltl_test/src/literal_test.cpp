@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "output/literal.h"
+
+#include <limits>
+#include <string>
+
+#include <cstdlib>
+
+
+namespace
+{
+  template<typename T>
+  std::string to_string(T t)
+  {
+    char buffer[sltl::detail::literal_length_max];
+    return std::string(buffer, sltl::detail::format_literal(buffer, t));
+  }
+
+  template<typename T>
+  T parse(const std::string& str);
+
+  template<>
+  float parse<float>(const std::string& str)
+  {
+    return std::strtof(str.c_str(), nullptr);
+  }
+
+  template<>
+  double parse<double>(const std::string& str)
+  {
+    return std::strtod(str.c_str(), nullptr);
+  }
+
+  // Strips the literal suffix and parses the remaining text
+  template<typename T>
+  T round_trip(T t, size_t suffix_length)
+  {
+    const std::string str = ::to_string(t);
+    return parse<T>(str.substr(0U, str.size() - suffix_length));
+  }
+}
+
+TEST(literal, format_float)
+{
+  ASSERT_EQ("0.0f", ::to_string(0.0f));
+  ASSERT_EQ("-0.0f", ::to_string(-0.0f));
+  ASSERT_EQ("1.0f", ::to_string(1.0f));
+  ASSERT_EQ("-2.5f", ::to_string(-2.5f));
+  ASSERT_EQ("0.1f", ::to_string(0.1f));
+  ASSERT_EQ("100.0f", ::to_string(100.0f));
+  ASSERT_EQ("3.1415927f", ::to_string(3.14159265f));
+  ASSERT_EQ("0.00001f", ::to_string(0.00001f));
+  ASSERT_EQ("1.0e-6f", ::to_string(0.000001f));
+  ASSERT_EQ("1.0e+20f", ::to_string(1e20f));
+  ASSERT_EQ("1.5e+30f", ::to_string(1.5e30f));
+}
+
+TEST(literal, format_double)
+{
+  ASSERT_EQ("0.0lf", ::to_string(0.0));
+  ASSERT_EQ("1.0lf", ::to_string(1.0));
+  ASSERT_EQ("0.1lf", ::to_string(0.1));
+  ASSERT_EQ("0.30000000000000004lf", ::to_string(0.1 + 0.2));
+  ASSERT_EQ("1.0e-300lf", ::to_string(1e-300));
+}
+
+TEST(literal, format_integral)
+{
+  ASSERT_EQ("0", ::to_string(0));
+  ASSERT_EQ("-42", ::to_string(-42));
+  ASSERT_EQ(std::to_string(std::numeric_limits<int>::min()), ::to_string(std::numeric_limits<int>::min()));
+  ASSERT_EQ("0U", ::to_string(0U));
+  ASSERT_EQ(std::to_string(std::numeric_limits<unsigned int>::max()) + "U", ::to_string(std::numeric_limits<unsigned int>::max()));
+  ASSERT_EQ("true", ::to_string(true));
+  ASSERT_EQ("false", ::to_string(false));
+}
+
+TEST(literal, round_trip)
+{
+  const float floats[] = { 1.0f / 3.0f, 0.7f, 1e-38f, std::numeric_limits<float>::max(), std::numeric_limits<float>::denorm_min(), 16777216.0f, 123456.789f };
+  const double doubles[] = { 1.0 / 3.0, 0.7, 1e-308, std::numeric_limits<double>::max(), std::numeric_limits<double>::denorm_min(), 9007199254740992.0, 123456.789 };
+
+  for(float f : floats)
+  {
+    ASSERT_EQ(f, round_trip(f, 1U));
+    ASSERT_EQ(-f, round_trip(-f, 1U));
+  }
+
+  for(double d : doubles)
+  {
+    ASSERT_EQ(d, round_trip(d, 2U));
+    ASSERT_EQ(-d, round_trip(-d, 2U));
+  }
+}
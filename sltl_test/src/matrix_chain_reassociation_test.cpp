@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include "matrix.h"
+#include "basic_operators.h"
+#include "shader.h"
+
+#include "syntax/matrix_chain_reassociation.h"
+
+#include "output/glsl/output_glsl.h"
+#include "output/output_matrix_order.h"
+
+
+namespace
+{
+  std::wstring to_string_glsl(const sltl::shader& shader, sltl::detail::enum_flags<sltl::output_flags> flags = sltl::output_flags::flag_none)
+  {
+    // Prepend a newline character to exactly match the raw string literals
+    return L'\n' + shader.apply_action<sltl::glsl::output_glsl>(sltl::glsl::output_version::none, flags | sltl::output_flags::flag_indent_space);
+  }
+
+  auto test_shader = []()
+  {
+    sltl::matrix<float, 4, 4> m1;
+    sltl::matrix<float, 4, 3> m2;
+    sltl::matrix<float, 3, 2> m3;
+    sltl::vector<float, 4> v1;
+
+    sltl::vector<float, 2> v2 = v1 * (m1 * (m2 * m3));
+    sltl::vector<float, 2> v3 = v1 * m1 * m2 * m3;
+    sltl::matrix<float, 4, 2> m4 = m1 * m2 * m3;
+  };
+}
+
+TEST(matrix_chain_reassociation, row_order)
+{
+  sltl::shader shader = sltl::make_test(test_shader);
+  shader.apply_action<sltl::syntax::matrix_chain_reassociation>();
+
+  const std::wstring actual = ::to_string_glsl(shader);
+  const std::wstring expected = LR"(
+{
+  mat4x4 m1;
+  mat3x4 m2;
+  mat2x3 m3;
+  vec4 v4;
+  vec2 v5 = ((v4 * m1) * m2) * m3;
+  vec2 v6 = ((v4 * m1) * m2) * m3;
+  mat2x4 m7 = (m1 * m2) * m3;
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(matrix_chain_reassociation, column_order)
+{
+  sltl::shader shader = sltl::make_test(test_shader);
+  shader.apply_action<sltl::syntax::matrix_chain_reassociation>();
+  shader.apply_action<sltl::output_matrix_order>();
+
+  const std::wstring actual = ::to_string_glsl(shader, sltl::output_flags::flag_transpose_type);
+  const std::wstring expected = LR"(
+{
+  mat4x4 m1;
+  mat3x4 m2;
+  mat2x3 m3;
+  vec4 v4;
+  vec2 v5 = m3 * (m2 * (m1 * v4));
+  vec2 v6 = m3 * (m2 * (m1 * v4));
+  mat2x4 m7 = m3 * (m2 * m1);
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(matrix_chain_reassociation, column_order_reversed)
+{
+  // The matrix order is converted first, so the chains to re-associate have the vector as the right-hand operand
+  sltl::shader shader = sltl::make_test(test_shader);
+  shader.apply_action<sltl::output_matrix_order>();
+  shader.apply_action<sltl::syntax::matrix_chain_reassociation>();
+
+  const std::wstring actual = ::to_string_glsl(shader, sltl::output_flags::flag_transpose_type);
+  const std::wstring expected = LR"(
+{
+  mat4x4 m1;
+  mat3x4 m2;
+  mat2x3 m3;
+  vec4 v4;
+  vec2 v5 = m3 * (m2 * (m1 * v4));
+  vec2 v6 = m3 * (m2 * (m1 * v4));
+  mat2x4 m7 = m3 * (m2 * m1);
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include "shader.h"
+#include "scalar.h"
+#include "basic_operators.h"
+
+#include "syntax/block.h"
+#include "syntax/io_block.h"
+#include "syntax/literal.h"
+#include "syntax/operator.h"
+#include "syntax/reference.h"
+#include "syntax/temporary.h"
+#include "syntax/variable_declaration.h"
+#include "syntax/parameter_declaration.h"
+
+#include <detail/type_traits.h>
+
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+
+TEST(node, node_cast_expression)
+{
+  using namespace sltl::syntax;
+
+  expression::ptr exp = expression::make<operator_binary>(sltl::language::id_addition,
+    expression::make<literal<float>>(1.0f),
+    expression::make<literal<float>>(2.0f));
+
+  ASSERT_EQ(node_kind::operator_binary, exp->get_kind());
+
+  ASSERT_EQ(exp.get(), node_cast<operator_binary>(exp.get()));
+  ASSERT_EQ(exp.get(), node_cast<operator_base>(exp.get()));
+  ASSERT_EQ(exp.get(), node_cast<expression>(exp.get()));
+
+  ASSERT_EQ(nullptr, node_cast<operator_unary>(exp.get()));
+  ASSERT_EQ(nullptr, node_cast<temporary>(exp.get()));
+  ASSERT_EQ(nullptr, node_cast<statement>(exp.get()));
+  ASSERT_EQ(nullptr, node_cast<expression>(static_cast<node*>(nullptr)));
+
+  const operator_binary& ob = *node_cast<const operator_binary>(static_cast<const expression*>(exp.get()));
+
+  ASSERT_TRUE(sltl::detail::is_type<literal<float>>(ob._operand_lhs.get()));
+  ASSERT_FALSE(sltl::detail::is_type<literal<int>>(ob._operand_lhs.get()));
+  ASSERT_FALSE(sltl::detail::is_type<reference>(ob._operand_rhs.get()));
+}
+
+TEST(node, node_cast_statement)
+{
+  using namespace sltl::syntax;
+
+  block b(block::global);
+
+  statement::ptr vd = statement::make<variable_declaration>(L"vd", sltl::language::type_helper<float>(), sltl::core::qualifier_storage::in, sltl::core::semantic_pair::none);
+
+  ASSERT_EQ(node_kind::block, b.get_kind());
+  ASSERT_EQ(node_kind::variable_declaration, vd->get_kind());
+
+  ASSERT_EQ(&b, node_cast<block_base>(&b));
+  ASSERT_EQ(&b, node_cast<statement>(&b));
+  ASSERT_EQ(nullptr, node_cast<io_block>(&b));
+  ASSERT_EQ(nullptr, node_cast<expression>(&b));
+
+  ASSERT_EQ(vd.get(), node_cast<variable_declaration>(vd.get()));
+  ASSERT_EQ(nullptr, node_cast<block_base>(vd.get()));
+}
+
+TEST(node, declaration_cast)
+{
+  using namespace sltl::syntax;
+
+  variable_declaration vd(L"vd", sltl::language::type_helper<float>(), sltl::core::qualifier_storage::in, sltl::core::semantic_pair::none);
+  parameter_declaration pd(L"pd", sltl::language::type_helper<float>(), sltl::core::qualifier_param::in);
+
+  const declaration& d_vd = vd;
+  const declaration& d_pd = pd;
+
+  ASSERT_EQ(declaration_kind::variable_declaration, d_vd.get_declaration_kind());
+  ASSERT_EQ(declaration_kind::parameter_declaration, d_pd.get_declaration_kind());
+
+  ASSERT_EQ(&vd, declaration_cast<const variable_declaration>(&d_vd));
+  ASSERT_EQ(&pd, declaration_cast<const parameter_declaration>(&d_pd));
+
+  ASSERT_EQ(nullptr, declaration_cast<const parameter_declaration>(&d_vd));
+  ASSERT_EQ(nullptr, declaration_cast<const variable_declaration>(&d_pd));
+}
+
+TEST(node, get_type_invalidation)
+{
+  using namespace sltl::syntax;
+
+  expression::ptr lhs = expression::make<temporary>(sltl::language::type(sltl::language::id_float, 2U, 3U));
+  expression::ptr rhs = expression::make<temporary>(sltl::language::type(sltl::language::id_float, 3U, 4U));
+
+  temporary& t_lhs = *node_cast<temporary>(lhs.get());
+  temporary& t_rhs = *node_cast<temporary>(rhs.get());
+
+  operator_binary ob(sltl::language::id_matrix_multiplication, std::move(lhs), std::move(rhs));
+
+  ASSERT_EQ(sltl::language::type(sltl::language::id_float, 2U, 4U), ob.get_type());
+
+  // Changing the operand types, or their order, must be reflected in the (cached) type of the operator
+  t_lhs.set_type(t_lhs.get_type().transpose());
+  t_rhs.set_type(t_rhs.get_type().transpose());
+
+  ob.swap_operands();
+
+  ASSERT_EQ(sltl::language::type(sltl::language::id_float, 4U, 2U), ob.get_type());
+}
+
+namespace
+{
+  // Replaces the operands of each binary operator with temporaries of type T, without invalidating the cached types
+  template<typename T>
+  class replace_operands : public sltl::syntax::action
+  {
+  public:
+    replace_operands() : _types_before(), _operators() {}
+
+    sltl::syntax::action_return_t operator()(sltl::syntax::operator_binary& ob, bool is_start) override
+    {
+      // The operands are replaced once they have been visited
+      if(!is_start)
+      {
+        _types_before.push_back(ob.get_type());
+        _operators.push_back(&ob);
+
+        ob._operand_lhs = sltl::syntax::expression::make<sltl::syntax::temporary>(sltl::language::type_helper<T>());
+        ob._operand_rhs = sltl::syntax::expression::make<sltl::syntax::temporary>(sltl::language::type_helper<T>());
+      }
+
+      return get_default(is_start);
+    }
+
+    std::vector<sltl::language::type> _types_before;
+    std::vector<const sltl::syntax::operator_binary*> _operators;
+
+  protected:
+    sltl::syntax::action_return_t get_default(bool is_start) override
+    {
+      return is_start ? sltl::syntax::action_return_t::step_in :
+                        sltl::syntax::action_return_t::step_out;
+    }
+  };
+
+  std::chrono::steady_clock::duration get_type_chain(size_t length)
+  {
+    using namespace sltl::syntax;
+
+    std::vector<const expression*> chain;
+
+    expression::ptr exp = expression::make<literal<float>>(0.0f);
+
+    for(size_t i = 0; i < length; ++i)
+    {
+      exp = expression::make<operator_binary>(sltl::language::id_addition, std::move(exp), expression::make<literal<float>>(1.0f));
+      chain.push_back(exp.get());
+    }
+
+    auto duration = std::chrono::steady_clock::duration::max();
+
+    for(size_t i = 0; i < 3; ++i)
+    {
+      const auto start = std::chrono::steady_clock::now();
+
+      // Emitters query the type of each expression within a chain
+      for(const expression* e : chain)
+      {
+        EXPECT_EQ(sltl::language::type_helper<float>(), e->get_type());
+      }
+
+      duration = std::min(duration, std::chrono::steady_clock::now() - start);
+    }
+
+    return duration;
+  }
+}
+
+TEST(node, get_type_action_invalidation)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> f;
+    sltl::scalar<float> g = f + f;
+  };
+
+  sltl::shader shader = sltl::make_test(test_shader);
+
+  replace_operands<int> act;
+  shader.apply_action(act);
+
+  // Applying an action invalidates the cached types, so the action doesn't have to
+  ASSERT_EQ(1U, act._operators.size());
+  ASSERT_EQ(sltl::language::type_helper<float>(), act._types_before.front());
+  ASSERT_EQ(sltl::language::type_helper<int>(), act._operators.front()->get_type());
+}
+
+TEST(node, get_type_chain_linear)
+{
+  const auto duration_small = get_type_chain(1000U);
+  const auto duration_large = get_type_chain(4000U);
+
+  // Four times the chain length should take roughly four times as long. The bound
+  // is deliberately loose, to avoid spurious failures, but still rejects quadratic growth.
+  ASSERT_LT(duration_large.count(), duration_small.count() * 10);
+}
@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include "io/io.h"
+
+#include "if.h"
+#include "call.h"
+#include "shader.h"
+#include "scalar.h"
+#include "vector.h"
+#include "matrix.h"
+#include "basic_operators.h"
+
+#include "output/cpp/output_cpp.h"
+
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+
+// The output of test_shader (see the output_cpp.dispatch test) compiled as C++
+#include "output_cpp_test_shader.h"
+
+
+namespace
+{
+  typedef sltl::io::block<
+    sltl::io::variable<sltl::scalar<float>, sltl::core::semantic::material>,
+    sltl::io::variable<sltl::matrix<float, 4, 4>, sltl::core::semantic::user>> io_block_uniform;
+
+  typedef sltl::io::block<
+    sltl::io::variable<sltl::vector<float, 3>, sltl::core::semantic::position>> io_block_in;
+
+  typedef sltl::io::block<
+    sltl::io::variable<sltl::vector<float, 4>, sltl::core::semantic::position>,
+    sltl::io::variable<sltl::scalar<float>, sltl::core::semantic::user>> io_block_out;
+
+  sltl::scalar<float> fn_scale(sltl::scalar<float> f, sltl::scalar<float> s)
+  {
+    return f * s;
+  }
+
+  auto test_shader = [](sltl::shader::tag<sltl::core::shader_stage::test>, io_block_in input)
+  {
+    io_block_uniform uniform(sltl::core::qualifier_storage::uniform);
+    io_block_out output;
+
+    sltl::vector<float, 3> p = input.get<sltl::core::semantic::position>();
+    sltl::scalar<float> f = uniform.get<sltl::core::semantic::material>();
+
+    sltl::if_then(f > sltl::scalar<float>(0.5f), [&]()
+    {
+      p -= sltl::vector<float, 3>(1.0f, 1.0f, 1.0f);
+    }).else_end([&]()
+    {
+      p += sltl::vector<float, 3>(p.z, p.y, p.x);
+    });
+
+    output.get<sltl::core::semantic::position>() = sltl::vector<float, 4>(p, 1.0f) * uniform.get<sltl::core::semantic::user>();
+    output.get<sltl::core::semantic::user>() = sltl::call(fn_scale, sltl::dot(p, p), 2.0f) + sltl::clamp(f * 4.0f, 0.0f, 1.0f);
+
+    return output;
+  };
+
+  std::wstring to_string_cpp(const sltl::shader& shader)
+  {
+    // Prepend a newline character to exactly match the raw string literals
+    return L'\n' + shader.apply_action<sltl::cpp::output_cpp>(sltl::output_flags::flag_indent_space);
+  }
+
+  // Reads a file in the same directory as this source file, ignoring any carriage return characters
+  std::string read_source_file(const char* name)
+  {
+    std::string path(__FILE__);
+    path.erase(path.find_last_of("/\\") + 1U);
+
+    std::ifstream file(path + name, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    contents.erase(std::remove(contents.begin(), contents.end(), '\r'), contents.end());
+    return contents;
+  }
+}
+
+TEST(output_cpp, shader)
+{
+  const std::wstring actual = ::to_string_cpp(sltl::make_shader(test_shader));
+  const std::wstring expected = LR"(
+#include "output/cpp/cpp_math.h"
+namespace test
+{
+using namespace sltl::cpp::math;
+struct uniform
+{
+  float f1;
+  matrix<float, 4, 4> m2;
+};
+struct input
+{
+  vector<float, 3> v1;
+};
+struct output
+{
+  vector<float, 4> v1;
+  float f2;
+};
+float fn1(float p_f1, float p_f2)
+{
+  return p_f1 * p_f2;
+}
+void invoke(const input& in, output& out, const uniform& cb)
+{
+  vector<float, 3> v1 = in.v1;
+  float f2 = cb.f1;
+  if(f2 > float(0.5f))
+  {
+    v1 -= vector<float, 3>{1.0f, 1.0f, 1.0f};
+  }
+  else
+  {
+    v1 += vector<float, 3>{swizzle<2>(v1), swizzle<1>(v1), swizzle<0>(v1)};
+  }
+  out.v1 = mul(vector<float, 4>{v1, 1.0f}, cb.m2);
+  out.f2 = (fn1(dot(v1, v1), 2.0f) + clamp(f2 * 4.0f, 0.0f, 1.0f));
+}
+void dispatch(const input* in, output* out, const uniform& cb, std::size_t count)
+{
+  for(std::size_t i = 0U; i < count; ++i)
+  {
+    invoke(in[i], out[i], cb);
+  }
+}
+}
+)";
+
+  EXPECT_EQ(expected, actual);
+}
+
+TEST(output_cpp, swizzle)
+{
+  auto test_shader = [](sltl::shader::tag<sltl::core::shader_stage::test>, sltl::io::block<>)
+  {
+    sltl::io::block<sltl::io::variable<sltl::vector<int, 4>, sltl::core::semantic::user>> output;
+
+    sltl::vector<int, 4> v(1, 2, 3, 4);
+    sltl::vector<int, 2> v_zx = v.zx;
+    sltl::scalar<int> i = v.w;
+    i++;
+    v.xy = v_zx + sltl::vector<int, 2>(i, --i);
+    output.get<sltl::core::semantic::user>() = v;
+
+    return output;
+  };
+
+  const std::wstring actual = ::to_string_cpp(sltl::make_shader(test_shader));
+  const std::wstring expected = LR"(
+#include "output/cpp/cpp_math.h"
+namespace test
+{
+using namespace sltl::cpp::math;
+struct output
+{
+  vector<int, 4> v1;
+};
+void invoke(output& out)
+{
+  vector<int, 4> v1 = vector<int, 4>{1, 2, 3, 4};
+  vector<int, 2> v2 = swizzle<2, 0>(v1);
+  int i3 = swizzle<3>(v1);
+  i3++;
+  swizzle_ref<0, 1>(v1) = (v2 + vector<int, 2>{i3, --i3});
+  out.v1 = v1;
+}
+void dispatch(output* out, std::size_t count)
+{
+  for(std::size_t i = 0U; i < count; ++i)
+  {
+    invoke(out[i]);
+  }
+}
+}
+)";
+
+  EXPECT_EQ(expected, actual);
+}
+
+TEST(output_cpp, dispatch)
+{
+  using namespace sltl::cpp::math;
+
+  // The compiled code must be the current output of test_shader
+  const std::string actual = sltl::make_shader(test_shader).apply_action<sltl::cpp::output_cpp_narrow>(sltl::output_flags::flag_indent_space);
+  const std::string expected = ::read_source_file("output_cpp_test_shader.h");
+
+  ASSERT_EQ(expected, actual);
+
+  test::uniform cb;
+  cb.f1 = 0.25f;
+  cb.m2 = matrix<float, 4, 4>(1.0f, 0.0f, 0.0f, 0.0f,
+                              0.0f, 2.0f, 0.0f, 0.0f,
+                              0.0f, 0.0f, 3.0f, 0.0f,
+                              1.0f, 1.0f, 1.0f, 1.0f);
+
+  test::input in[2];
+  in[0].v1 = vector<float, 3>(1.0f, 2.0f, 3.0f);
+  in[1].v1 = vector<float, 3>(3.0f, 2.0f, 1.0f);
+
+  test::output out[2];
+  test::dispatch(in, out, cb, 2U);
+
+  // The results match those of the interpreter (see the interpreter.evaluate test)
+  EXPECT_EQ(5.0f, out[0].v1[0]);
+  EXPECT_EQ(9.0f, out[0].v1[1]);
+  EXPECT_EQ(13.0f, out[0].v1[2]);
+  EXPECT_EQ(1.0f, out[0].v1[3]);
+  EXPECT_EQ(97.0f, out[0].f2);
+
+  EXPECT_EQ(5.0f, out[1].v1[0]);
+  EXPECT_EQ(9.0f, out[1].v1[1]);
+  EXPECT_EQ(13.0f, out[1].v1[2]);
+  EXPECT_EQ(1.0f, out[1].v1[3]);
+  EXPECT_EQ(97.0f, out[1].f2);
+}
@@ -0,0 +1,45 @@
+#include "output/cpp/cpp_math.h"
+namespace test
+{
+using namespace sltl::cpp::math;
+struct uniform
+{
+  float f1;
+  matrix<float, 4, 4> m2;
+};
+struct input
+{
+  vector<float, 3> v1;
+};
+struct output
+{
+  vector<float, 4> v1;
+  float f2;
+};
+float fn1(float p_f1, float p_f2)
+{
+  return p_f1 * p_f2;
+}
+void invoke(const input& in, output& out, const uniform& cb)
+{
+  vector<float, 3> v1 = in.v1;
+  float f2 = cb.f1;
+  if(f2 > float(0.5f))
+  {
+    v1 -= vector<float, 3>{1.0f, 1.0f, 1.0f};
+  }
+  else
+  {
+    v1 += vector<float, 3>{swizzle<2>(v1), swizzle<1>(v1), swizzle<0>(v1)};
+  }
+  out.v1 = mul(vector<float, 4>{v1, 1.0f}, cb.m2);
+  out.f2 = (fn1(dot(v1, v1), 2.0f) + clamp(f2 * 4.0f, 0.0f, 1.0f));
+}
+void dispatch(const input* in, output* out, const uniform& cb, std::size_t count)
+{
+  for(std::size_t i = 0U; i < count; ++i)
+  {
+    invoke(in[i], out[i], cb);
+  }
+}
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include "shader.h"
+#include "scalar.h"
+#include "basic_operators.h"
+
+#include "output/output_sink.h"
+#include "output/character.h"
+#include "output/glsl/output_glsl.h"
+#include "output/hlsl/output_hlsl.h"
+
+#include "io/io.h"
+
+#include <cstdio>
+
+
+namespace
+{
+  auto test_shader = [](sltl::shader::tag<sltl::core::shader_stage::test>, sltl::io::block<>)
+  {
+    sltl::scalar<float> f1 = 1.0f;
+    sltl::scalar<float> f2 = f1 * 2.0f;
+  };
+
+  std::wstring to_string(const sltl::shader& shader)
+  {
+    return shader.apply_action<sltl::glsl::output_glsl>(sltl::glsl::output_version::v330, sltl::output_flags::flag_indent_space);
+  }
+}
+
+TEST(output_sink, buffer)
+{
+  const sltl::shader shader = sltl::make_shader(test_shader);
+
+  sltl::output_sink_buffer sink;
+  sltl::glsl::output_glsl output(shader._stage, sink, sltl::glsl::output_version::v330, sltl::output_flags::flag_indent_space);
+
+  shader.apply_action(output);
+
+  ASSERT_EQ(::to_string(shader), sink.get_buffer());
+  ASSERT_EQ(::to_string(shader), output.get_result());
+
+  const std::wstring released = sink.release();
+
+  ASSERT_EQ(::to_string(shader), released);
+  ASSERT_TRUE(sink.get_buffer().empty());
+}
+
+TEST(output_sink, callback)
+{
+  const sltl::shader shader = sltl::make_shader(test_shader);
+
+  std::wstring text;
+  size_t chunk_count = 0U;
+
+  {
+    sltl::output_sink_callback sink([&text, &chunk_count](const wchar_t* str, size_t length)
+    {
+      text.append(str, length);
+      ++chunk_count;
+    }, 8U);
+
+    sltl::glsl::output_glsl output(shader._stage, sink, sltl::glsl::output_version::v330, sltl::output_flags::flag_indent_space);
+
+    shader.apply_action(output);
+
+    // The result is only available when writing to a buffer sink
+    ASSERT_THROW(output.get_result(), std::exception);
+
+    output.flush();
+  }
+
+  ASSERT_EQ(::to_string(shader), text);
+  ASSERT_LE(text.size() / 8U, chunk_count);
+}
+
+TEST(output_sink, fd)
+{
+  const sltl::shader shader = sltl::make_shader(test_shader);
+
+  std::FILE* file = std::tmpfile();
+  ASSERT_TRUE(file != nullptr);
+
+  {
+    sltl::output_sink_fd sink(fileno(file));
+    sltl::hlsl::output_hlsl output(shader._stage, sink, sltl::output_flags::flag_indent_space);
+
+    shader.apply_action(output);
+  }
+
+  std::string text;
+  char buffer[256];
+
+  std::rewind(file);
+
+  while(const size_t count = std::fread(buffer, 1U, sizeof(buffer), file))
+  {
+    text.append(buffer, count);
+  }
+
+  std::fclose(file);
+
+  const std::wstring expected = shader.apply_action<sltl::hlsl::output_hlsl>(sltl::output_flags::flag_indent_space);
+
+  // The generated text is ASCII, so the UTF-8 encoding has the same characters
+  ASSERT_EQ(expected, std::wstring(text.begin(), text.end()));
+}
+
+TEST(output_sink, narrow)
+{
+  const sltl::shader shader = sltl::make_shader(test_shader);
+
+  const std::string glsl = shader.apply_action<sltl::glsl::output_glsl_narrow>(sltl::glsl::output_version::v330, sltl::output_flags::flag_indent_space);
+  const std::string hlsl = shader.apply_action<sltl::hlsl::output_hlsl_narrow>(sltl::output_flags::flag_indent_space);
+
+  const std::wstring glsl_wide = ::to_string(shader);
+  const std::wstring hlsl_wide = shader.apply_action<sltl::hlsl::output_hlsl>(sltl::output_flags::flag_indent_space);
+
+  // The generated text is ASCII, so the narrow output has the same characters as the wide output
+  ASSERT_EQ(glsl_wide, std::wstring(glsl.begin(), glsl.end()));
+  ASSERT_EQ(hlsl_wide, std::wstring(hlsl.begin(), hlsl.end()));
+}
+
+TEST(output_sink, narrow_utf8)
+{
+  const std::string text = sltl::detail::to_basic_string<char>(L"aé€");
+
+  ASSERT_EQ(std::string("a\xc3\xa9\xe2\x82\xac"), text);
+
+  sltl::output_sink_buffer_narrow sink;
+
+  {
+    sltl::output_stream_narrow os(sink);
+    os << "x = " << std::string("1.5") << ';';
+  }
+
+  ASSERT_EQ(std::string("x = 1.5;"), sink.get_buffer());
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <detail/small_vector.h>
+
+#include <memory>
+#include <utility>
+
+
+TEST(small_vector, inline_storage)
+{
+  sltl::detail::small_vector<int, 4U> sv;
+
+  ASSERT_TRUE(sv.empty());
+  ASSERT_TRUE(sv.is_inline());
+
+  for(int i = 0; i < 4; ++i)
+  {
+    sv.push_back(int(i));
+  }
+
+  ASSERT_EQ(4U, sv.size());
+  ASSERT_TRUE(sv.is_inline());
+
+  sv.push_back(4);
+
+  ASSERT_EQ(5U, sv.size());
+  ASSERT_FALSE(sv.is_inline());
+
+  for(int i = 0; i < 5; ++i)
+  {
+    ASSERT_EQ(i, sv[i]);
+  }
+}
+
+TEST(small_vector, push_front)
+{
+  sltl::detail::small_vector<std::unique_ptr<int>, 2U> sv;
+
+  for(int i = 0; i < 5; ++i)
+  {
+    sv.push_front(std::unique_ptr<int>(new int(i)));
+  }
+
+  ASSERT_EQ(5U, sv.size());
+
+  int expected = 4;
+
+  for(const auto& ptr : sv)
+  {
+    ASSERT_EQ(expected--, *ptr);
+  }
+}
+
+TEST(small_vector, move)
+{
+  sltl::detail::small_vector<std::unique_ptr<int>, 2U> sv_inline;
+  sltl::detail::small_vector<std::unique_ptr<int>, 2U> sv_heap;
+
+  sv_inline.push_back(std::unique_ptr<int>(new int(1)));
+
+  for(int i = 0; i < 3; ++i)
+  {
+    sv_heap.push_back(std::unique_ptr<int>(new int(i)));
+  }
+
+  const int* const data_heap = sv_heap.begin()->get();
+
+  sltl::detail::small_vector<std::unique_ptr<int>, 2U> sv_moved(std::move(sv_inline));
+
+  ASSERT_TRUE(sv_inline.empty());
+  ASSERT_EQ(1U, sv_moved.size());
+  ASSERT_EQ(1, *sv_moved[0]);
+
+  // Moving from a vector that has spilled to the free store transfers the allocation
+  sv_moved = std::move(sv_heap);
+
+  ASSERT_TRUE(sv_heap.empty());
+  ASSERT_TRUE(sv_heap.is_inline());
+  ASSERT_FALSE(sv_moved.is_inline());
+  ASSERT_EQ(3U, sv_moved.size());
+  ASSERT_EQ(data_heap, sv_moved[0].get());
+}
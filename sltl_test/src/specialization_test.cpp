@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include "io/io.h"
+
+#include "if.h"
+#include "shader.h"
+#include "scalar.h"
+#include "vector.h"
+#include "basic_operators.h"
+
+#include "syntax/branch_pruning.h"
+
+#include "output/glsl/output_glsl.h"
+
+
+namespace
+{
+  std::wstring to_string_glsl(const sltl::shader& shader)
+  {
+    // Prepend a newline character to exactly match the raw string literals
+    return L'\n' + shader.apply_action<sltl::glsl::output_glsl>(sltl::glsl::output_version::none, sltl::output_flags::flag_indent_space);
+  }
+
+  typedef sltl::io::block<
+    sltl::io::variable<sltl::scalar<bool>, sltl::core::semantic::material, 0U>,
+    sltl::io::variable<sltl::scalar<float>, sltl::core::semantic::material, 1U>,
+    sltl::io::variable<sltl::vector<float, 3>, sltl::core::semantic::material, 2U>> io_block_uniform;
+
+  auto test_shader = [](sltl::shader::tag<sltl::core::shader_stage::test>, sltl::io::block<>)
+  {
+    io_block_uniform uniform(sltl::core::qualifier_storage::uniform);
+
+    sltl::vector<float, 3> colour = uniform.get<sltl::core::semantic::material, 2U>();
+
+    sltl::if_then(uniform.get<sltl::core::semantic::material, 0U>(), [&]()
+    {
+      colour = colour * 0.5f;
+    }).else_end([&]()
+    {
+      colour = colour * 2.0f;
+    });
+
+    sltl::if_then(uniform.get<sltl::core::semantic::material, 1U>() > sltl::scalar<float>(0.5f), [&]()
+    {
+      colour = colour + colour;
+    });
+  };
+}
+
+TEST(specialization, specialize)
+{
+  sltl::shader shader = sltl::make_shader(test_shader);
+  shader.specialize({ sltl::syntax::binding_of(sltl::core::semantic::material, 0U, false),
+                      sltl::syntax::binding_of(sltl::core::semantic::material, 1U, 0.25f) });
+
+  const std::wstring actual = ::to_string_glsl(shader);
+  const std::wstring expected = LR"(
+uniform bool u_b1;
+uniform float u_f2;
+uniform vec3 u_v3;
+void main()
+{
+  vec3 v1 = u_v3;
+  {
+    v1 = (v1 * 2.0f);
+  }
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(specialization, specialize_vector)
+{
+  sltl::shader shader = sltl::make_shader(test_shader);
+  shader.specialize({ sltl::syntax::binding_of(sltl::core::semantic::material, 2U, { 1.0f, 0.5f, 0.25f }) });
+
+  const std::wstring actual = ::to_string_glsl(shader);
+  const std::wstring expected = LR"(
+uniform bool u_b1;
+uniform float u_f2;
+uniform vec3 u_v3;
+void main()
+{
+  vec3 v1 = vec3(1.0f, 0.5f, 0.25f);
+  if(u_b1)
+  {
+    v1 = (v1 * 0.5f);
+  }
+  else
+  {
+    v1 = (v1 * 2.0f);
+  }
+  if(u_f2 > 0.5f)
+  {
+    v1 = (v1 + v1);
+  }
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(specialization, specialize_type_mismatch)
+{
+  sltl::shader shader = sltl::make_shader(test_shader);
+
+  ASSERT_THROW(shader.specialize({ sltl::syntax::binding_of(sltl::core::semantic::material, 1U, 1) }), std::invalid_argument);
+  ASSERT_THROW(sltl::syntax::uniform_binding(sltl::core::semantic::material, sltl::language::type(sltl::language::id_float, 1U, 1U), { 1.0, 2.0 }), std::invalid_argument);
+}
+
+TEST(specialization, branch_pruning)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<bool> b;
+    sltl::scalar<int> i;
+
+    sltl::if_then(b, [&]()
+    {
+      i = 1;
+    }).else_if(false, [&]()
+    {
+      i = 2;
+    }).else_if(true, [&]()
+    {
+      i = 3;
+    }).else_end([&]()
+    {
+      i = 4;
+    });
+
+    sltl::if_then(false, [&]()
+    {
+      i = 5;
+    }).else_if(b, [&]()
+    {
+      i = 6;
+    });
+
+    sltl::if_then(false, [&]()
+    {
+      i = 7;
+    });
+  };
+
+  sltl::shader shader = sltl::make_test(test_shader);
+  shader.apply_action<sltl::syntax::branch_pruning>();
+
+  const std::wstring actual = ::to_string_glsl(shader);
+  const std::wstring expected = LR"(
+{
+  bool b1;
+  int i2;
+  if(b1)
+  {
+    i2 = 1;
+  }
+  else
+  {
+    i2 = 3;
+  }
+  if(b1)
+  {
+    i2 = 6;
+  }
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include "io/io.h"
+
+#include "shader.h"
+#include "scalar.h"
+#include "vector.h"
+#include "matrix.h"
+#include "basic_operators.h"
+
+#include "syntax/uniform_hoisting.h"
+
+#include "output/glsl/output_glsl.h"
+
+
+namespace
+{
+  std::wstring to_string_glsl(const sltl::shader& shader)
+  {
+    // Prepend a newline character to exactly match the raw string literals
+    return L'\n' + shader.apply_action<sltl::glsl::output_glsl>(sltl::glsl::output_version::none, sltl::output_flags::flag_indent_space);
+  }
+
+  typedef sltl::io::block<
+    sltl::io::variable_transform<sltl::core::semantic_transform::view>,
+    sltl::io::variable_transform<sltl::core::semantic_transform::proj>,
+    sltl::io::variable<sltl::scalar<float>, sltl::core::semantic::material>,
+    sltl::io::variable<sltl::scalar<float>, sltl::core::semantic::user, 3U>> io_block_uniform;
+
+  auto test_shader = [](sltl::shader::tag<sltl::core::shader_stage::test>, sltl::io::block<>)
+  {
+    io_block_uniform uniform(sltl::core::qualifier_storage::uniform);
+
+    sltl::vector<float, 4> v;
+    sltl::vector<float, 4> v_pos = v * uniform.get<sltl::core::semantic_transform::view>() * uniform.get<sltl::core::semantic_transform::proj>();
+
+    sltl::scalar<float> f = uniform.get<sltl::core::semantic::user, 3U>();
+    sltl::scalar<float> f_factor = f * (uniform.get<sltl::core::semantic::material>() * 0.5f);
+  };
+}
+
+TEST(uniform_hoisting, hoist)
+{
+  sltl::shader shader = sltl::make_shader(test_shader);
+  shader.apply_action<sltl::syntax::uniform_hoisting>();
+
+  const std::wstring actual = ::to_string_glsl(shader);
+  const std::wstring expected = LR"(
+uniform mat4x4 u_m1;
+uniform mat4x4 u_m2;
+uniform float u_f3;
+uniform float u_f4;
+uniform mat4x4 u_m5;
+uniform float u_f6;
+void main()
+{
+  vec4 v1;
+  vec4 v2 = v1 * u_m5;
+  float f3 = u_f4;
+  float f4 = f3 * u_f6;
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(uniform_hoisting, program)
+{
+  sltl::shader shader = sltl::make_shader(test_shader);
+  const std::vector<sltl::syntax::uniform_precompute> precomputes = shader.apply_action<sltl::syntax::uniform_hoisting>();
+
+  ASSERT_EQ(2U, precomputes.size());
+
+  typedef sltl::syntax::uniform_instruction::opcode opcode;
+
+  // view * proj
+  {
+    const sltl::syntax::uniform_precompute& precompute = precomputes[0];
+
+    ASSERT_EQ(sltl::core::semantic::user, precompute._semantic);
+    ASSERT_EQ(4U, precompute._semantic_index);
+    ASSERT_EQ((sltl::language::type_helper<sltl::matrix<float, 4>>()), precompute._type);
+
+    ASSERT_EQ(3U, precompute._program.size());
+    ASSERT_EQ(opcode::load_uniform, precompute._program[0]._opcode);
+    ASSERT_EQ(sltl::core::semantic::transform, precompute._program[0]._semantic);
+    ASSERT_EQ(sltl::core::detail::to_semantic_index(sltl::core::semantic_transform::view), precompute._program[0]._semantic_index);
+    ASSERT_EQ(opcode::load_uniform, precompute._program[1]._opcode);
+    ASSERT_EQ(sltl::core::detail::to_semantic_index(sltl::core::semantic_transform::proj), precompute._program[1]._semantic_index);
+    ASSERT_EQ(opcode::operator_binary, precompute._program[2]._opcode);
+    ASSERT_EQ(sltl::language::id_matrix_multiplication, precompute._program[2]._operator_id);
+  }
+
+  // material * 0.5f
+  {
+    const sltl::syntax::uniform_precompute& precompute = precomputes[1];
+
+    ASSERT_EQ(sltl::core::semantic::user, precompute._semantic);
+    ASSERT_EQ(5U, precompute._semantic_index);
+    ASSERT_EQ(sltl::language::type_helper<float>(), precompute._type);
+
+    ASSERT_EQ(3U, precompute._program.size());
+    ASSERT_EQ(opcode::load_uniform, precompute._program[0]._opcode);
+    ASSERT_EQ(sltl::core::semantic::material, precompute._program[0]._semantic);
+    ASSERT_EQ(opcode::load_literal, precompute._program[1]._opcode);
+    ASSERT_EQ(0.5, precompute._program[1]._value);
+    ASSERT_EQ(opcode::operator_binary, precompute._program[2]._opcode);
+    ASSERT_EQ(sltl::language::id_multiplication, precompute._program[2]._operator_id);
+  }
+}
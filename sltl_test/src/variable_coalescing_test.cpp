@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include "if.h"
+#include "scalar.h"
+#include "vector.h"
+#include "basic_operators.h"
+#include "shader.h"
+
+#include "syntax/variable_coalescing.h"
+
+#include "output/glsl/output_glsl.h"
+
+
+namespace
+{
+  std::wstring to_string(sltl::shader&& shader)
+  {
+    shader.apply_action<sltl::syntax::variable_coalescing>();
+
+    // Prepend a newline character to exactly match the raw string literals
+    return L'\n' + shader.apply_action<sltl::glsl::output_glsl>(sltl::glsl::output_version::none, sltl::output_flags::flag_indent_space);
+  }
+}
+
+TEST(variable_coalescing, coalesce)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> a = 1.0f;
+    sltl::scalar<float> b = a * 2.0f;
+    sltl::scalar<float> c = b + b;
+    sltl::scalar<float> d = c * c;
+    d += d;
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f1 = 1.0f;
+  f1 = (f1 * 2.0f);
+  f1 = (f1 + f1);
+  f1 = (f1 * f1);
+  f1 += f1;
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(variable_coalescing, type)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> a = 1.0f;
+    sltl::vector<float, 3> v1(a, a, a);
+    sltl::vector<float, 3> v2 = v1 + v1;
+    sltl::scalar<float> b = 2.0f;
+    v2 += sltl::vector<float, 3>(b, b, b);
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f1 = 1.0f;
+  vec3 v2 = vec3(f1, f1, f1);
+  v2 = (v2 + v2);
+  f1 = 2.0f;
+  v2 += vec3(f1, f1, f1);
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(variable_coalescing, live)
+{
+  auto test_shader = []()
+  {
+    sltl::scalar<float> a = 1.0f;
+    sltl::scalar<float> b = 2.0f;
+    sltl::scalar<float> c;
+
+    sltl::if_then(a > b, [&]()
+    {
+      sltl::scalar<float> d = a - b;
+      c = d;
+    });
+
+    sltl::scalar<float> e = c + c;
+    sltl::scalar<float> f = b + e;
+    f += f;
+  };
+
+  const std::wstring actual = ::to_string(sltl::make_test(test_shader));
+  const std::wstring expected = LR"(
+{
+  float f1 = 1.0f;
+  float f2 = 2.0f;
+  float f3;
+  if(f1 > f2)
+  {
+    float f4_1 = f1 - f2;
+    f3 = f4_1;
+  }
+  f3 = (f3 + f3);
+  f3 = (f2 + f3);
+  f3 += f3;
+}
+)";
+
+  ASSERT_EQ(expected, actual);
+}